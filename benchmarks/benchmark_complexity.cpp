@@ -8,6 +8,15 @@
 #include <cmath>
 #include <memory>
 #include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <filesystem>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
 
 // Include all implementations
 #include "include/factory/rmq_factory.h"
@@ -15,15 +24,28 @@
 #include "include/algorithms/rmq_dp.h"
 #include "include/algorithms/rmq_sparse_table.h"
 #include "include/algorithms/rmq_block.h"
+#include "include/algorithms/rmq_block_tuner.h"
 #include "include/algorithms/rmq_lca.h"
+#include "include/algorithms/rmq_stree.h"
+#include "include/algorithms/rmq_monotone.h"
+#include "include/algorithms/rmq_external.h"
+#include "include/core/rmq_recording.h"
+#include "include/core/rmq_adversarial.h"
 
 // Include source files
 #include "src/core/rmq_base.cpp"
+#include "src/core/rmq_compressed.cpp"
+#include "src/core/rmq_recording.cpp"
 #include "src/algorithms/rmq_naive.cpp"
 #include "src/algorithms/rmq_dp.cpp"
 #include "src/algorithms/rmq_sparse_table.cpp"
 #include "src/algorithms/rmq_block.cpp"
+#include "src/algorithms/rmq_block_concurrent.cpp"
+#include "src/algorithms/rmq_block_tuner.cpp"
 #include "src/algorithms/rmq_lca.cpp"
+#include "src/algorithms/rmq_stree.cpp"
+#include "src/algorithms/rmq_monotone.cpp"
+#include "src/algorithms/rmq_external.cpp"
 #include "src/factory/rmq_factory.cpp"
 
 using namespace rmq;
@@ -42,6 +64,85 @@ struct BenchmarkResult {
     size_t num_queries;
 };
 
+/**
+ * @brief Cold-cache vs. warm-cache query cost for a single algorithm
+ */
+struct CacheModeResult {
+    std::string algorithm_name;
+    size_t array_size;
+    double warm_query_ns;         // Same index queried repeatedly (hot caches)
+    double sweep_query_ns;        // Caches evicted by a buffer sweep before each query
+    double rotate_query_ns;       // Round-robin over instances larger than the eviction size
+    size_t rotate_instances;      // Number of instances in the rotation
+    size_t rotate_footprint_bytes;  // Estimated footprint of the whole rotation
+};
+
+/**
+ * @brief Throughput and latency of one mixed read/update workload
+ */
+struct MixedWorkloadResult {
+    std::string algorithm_name;
+    std::string strategy;         // "in-place" (update/batchUpdate) or "rebuild" (preprocess)
+    std::string locality;
+    size_t array_size;
+    int read_percent;
+    size_t batch_size;
+    size_t operations;            // Operations completed within the time budget
+    bool complete;                // Every step of the workload ran
+    double throughput_ops;        // Operations per second (reads + individual updates)
+    double read_p50_us;
+    double read_p99_us;
+    double write_p50_us;          // Per write batch
+    double write_p99_us;
+};
+
+/**
+ * @brief Throughput and latency of one algorithm replaying a recording
+ */
+struct ReplayResult {
+    std::string algorithm_name;
+    std::string strategy;         // "in-place" (update) or "rebuild" (preprocess per update)
+    size_t operations;            // Operations replayed within the time budget
+    bool complete;                // Whole recording replayed
+    double throughput_ops;        // Operations per second, waits included at recorded speed
+    double query_p50_us;
+    double query_p99_us;
+    double query_p999_us;
+    double update_p50_us;
+    double update_p99_us;
+    long long answer_sum;         // Sum of all query answers, equal across algorithms
+};
+
+/**
+ * @brief Build throughput and query latency at one scale point
+ */
+struct ScaleResult {
+    std::string algorithm_name;
+    size_t array_size;
+    size_t predicted_bytes;       // RMQFactory::calculateMemoryUsage before building
+    size_t actual_bytes;          // getMemoryUsage() after building (0 if skipped)
+    double build_ms;
+    double build_elements_per_s;
+    double query_mean_us;
+    double query_p99_us;
+    size_t queries;
+    std::string status;           // "ok" or why it was skipped
+};
+
+/**
+ * @brief Worst case found by the adversarial search for one algorithm
+ */
+struct AdversarialResult {
+    std::string algorithm_name;
+    std::string objective;        // "query" (ns per query) or "build" (ns per element)
+    double baseline_cost;         // Random input, uniform queries
+    double worst_cost;
+    size_t evaluations;           // Inputs and query sets measured
+    std::string description;      // Seed pattern, accepted mutations and query shape
+    std::string snapshot_path;
+    std::string recording_path;   // Query objective only
+};
+
 /**
  * @brief Benchmark suite for RMQ algorithms
  */
@@ -273,7 +374,1267 @@ public:
         std::cout << std::string(120, '=') << std::endl;
     }
     
+    /**
+     * @brief Benchmark the out-of-core RMQ under a resident memory budget
+     * 
+     * The data file is generated in chunks, so neither the benchmark nor the
+     * index ever holds the full array in memory. Resident memory is bounded by
+     * the block index plus cache_bytes of cached blocks.
+     */
+    void runExternalBenchmark(size_t num_elements, size_t cache_bytes, size_t block_elements) {
+        const std::string data_path = "benchmark_external_data.bin";
+        const size_t CHUNK_ELEMENTS = 1 << 20;
+        
+        std::cout << "Running External Memory RMQ Benchmark..." << std::endl;
+        std::cout << "=============================================" << std::endl;
+        std::cout << "Elements: " << num_elements
+                  << " (" << (num_elements * sizeof(Value)) / (1024.0 * 1024.0) << " MB on disk)"
+                  << ", cache budget: " << cache_bytes / (1024.0 * 1024.0) << " MB" << std::endl << std::endl;
+        
+        // Generate the data file chunk by chunk
+        std::remove(data_path.c_str());
+        for (size_t written = 0; written < num_elements; written += CHUNK_ELEMENTS) {
+            auto chunk = generateData(std::min(CHUNK_ELEMENTS, num_elements - written));
+            RMQExternalMemory::writeDataFile(data_path, chunk, true);
+        }
+        
+        AlgorithmConfig config;
+        config.withBlockSize(block_elements);
+        RMQExternalMemory rmq(config, cache_bytes);
+        
+        auto start = high_resolution_clock::now();
+        rmq.open(data_path);
+        auto end = high_resolution_clock::now();
+        double open_ms = duration_cast<duration<double, std::milli>>(end - start).count();
+        
+        std::cout << "Index build: " << std::fixed << std::setprecision(3) << open_ms << " ms ("
+                  << (num_elements / (open_ms / 1000.0)) / 1e6 << " M elements/s), "
+                  << rmq.getNumBlocks() << " blocks of " << rmq.getBlockSize() << " elements, "
+                  << "cache capacity " << rmq.getCacheCapacity() << " blocks" << std::endl << std::endl;
+        
+        // Range length classes: within a block, a few blocks, and unrestricted
+        struct Workload {
+            std::string name;
+            size_t max_length;
+        };
+        std::vector<Workload> workloads = {
+            {"short (<= 1 block)", rmq.getBlockSize()},
+            {"medium (<= 16 blocks)", rmq.getBlockSize() * 16},
+            {"random", num_elements}
+        };
+        
+        std::ofstream csv("benchmark_external.csv");
+        csv << "Workload,ArraySize,CacheBytes,QueryTime_us,BlockReads,BytesRead,CacheHitRate,ResidentBytes" << std::endl;
+        
+        std::cout << std::left << std::setw(24) << "Workload"
+                  << std::setw(15) << "Query (μs)"
+                  << std::setw(15) << "Block reads"
+                  << std::setw(15) << "Reads/query"
+                  << std::setw(12) << "Hit rate"
+                  << std::setw(15) << "Resident (MB)" << std::endl;
+        std::cout << std::string(96, '-') << std::endl;
+        
+        for (const auto& workload : workloads) {
+            std::uniform_int_distribution<size_t> left_dist(0, num_elements - 1);
+            std::uniform_int_distribution<size_t> length_dist(1, std::min(workload.max_length, num_elements));
+            std::vector<std::pair<Index, Index>> queries;
+            for (size_t i = 0; i < QUERIES_PER_SIZE; ++i) {
+                size_t left = left_dist(gen_);
+                size_t right = std::min(num_elements - 1, left + length_dist(gen_) - 1);
+                queries.push_back({left, right});
+            }
+            
+            rmq.dropCache();
+            rmq.resetIOStats();
+            
+            start = high_resolution_clock::now();
+            for (const auto& [left, right] : queries) {
+                volatile Value v = rmq.query(left, right);
+                (void)v;
+            }
+            end = high_resolution_clock::now();
+            
+            double query_us = duration_cast<duration<double, std::micro>>(end - start).count() / queries.size();
+            ExternalIOStats stats = rmq.getIOStats();
+            size_t resident = rmq.getMemoryUsage();
+            
+            std::cout << std::left << std::setw(24) << workload.name
+                      << std::setw(15) << std::fixed << std::setprecision(3) << query_us
+                      << std::setw(15) << stats.block_reads
+                      << std::setw(15) << std::setprecision(3) << static_cast<double>(stats.block_reads) / queries.size()
+                      << std::setw(12) << std::setprecision(3) << stats.hitRate()
+                      << std::setw(15) << std::setprecision(2) << resident / (1024.0 * 1024.0) << std::endl;
+            
+            csv << workload.name << "," << num_elements << "," << cache_bytes << ","
+                << query_us << "," << stats.block_reads << "," << stats.bytes_read << ","
+                << stats.hitRate() << "," << resident << std::endl;
+        }
+        
+        rmq.close();
+        std::remove(data_path.c_str());
+        
+        std::cout << std::endl << "Results written to benchmark_external.csv" << std::endl;
+    }
+
+    /**
+     * @brief Compare warm-cache and cold-cache per-query cost
+     * 
+     * The default benchmark warms up and then queries one index with every
+     * cache hot, which hides the cost of a request touching an index nobody
+     * has used recently. For every algorithm and size this reports:
+     * - warm:   the same index, after warmup
+     * - sweep:  a buffer of eviction_bytes is read before each query, so the
+     *           index and its data start out of cache (and out of the TLB)
+     * - rotate: queries go round-robin over copies of the index whose total
+     *           estimated footprint is at least eviction_bytes
+     * 
+     * Every query is timed individually in all three modes and the measured
+     * timer overhead is subtracted, so the columns are directly comparable.
+     * eviction_bytes should be a few times the last-level cache size.
+     */
+    void runCacheModeBenchmark(size_t eviction_bytes, size_t num_queries) {
+        const size_t MAX_ROTATE_INSTANCES = 4096;
+        
+        std::cout << "Running RMQ Cold/Warm Cache Benchmarks..." << std::endl;
+        std::cout << "=============================================" << std::endl;
+        
+        std::vector<unsigned char> sweep_buffer(eviction_bytes, 1);
+        double timer_ns = measureTimerOverhead();
+        std::cout << "Eviction buffer: " << eviction_bytes / (1024.0 * 1024.0) << " MB, "
+                  << num_queries << " queries per mode, timer overhead "
+                  << std::fixed << std::setprecision(1) << timer_ns << " ns (subtracted)" << std::endl << std::endl;
+        
+        std::vector<CacheModeResult> cache_results;
+        
+        for (size_t size : test_sizes_) {
+            std::cout << "Testing with array size: " << size << std::endl;
+            
+            auto data = generateData(size);
+            auto queries = generateQueries(size, num_queries);
+            
+            for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+                // Skip DP for large arrays, as in the complexity benchmark
+                if (type == AlgorithmType::DYNAMIC_PROGRAMMING && size > 2000) {
+                    continue;
+                }
+                
+                std::cout << "  - Benchmarking " << algorithmTypeToString(type) << "... " << std::flush;
+                
+                try {
+                    CacheModeResult result;
+                    result.array_size = size;
+                    
+                    auto algorithm = RMQFactory::create(type);
+                    algorithm->preprocess(data);
+                    result.algorithm_name = algorithm->getName();
+                    
+                    // Warm: repeated queries against one index
+                    for (size_t i = 0; i < std::min(WARMUP_QUERIES, queries.size()); ++i) {
+                        algorithm->query(queries[i].first, queries[i].second);
+                    }
+                    double total_ns = 0;
+                    for (const auto& [left, right] : queries) {
+                        total_ns += timeQuery(*algorithm, left, right);
+                    }
+                    result.warm_query_ns = std::max(0.0, total_ns / queries.size() - timer_ns);
+                    
+                    // Sweep: evict everything before each query
+                    total_ns = 0;
+                    for (const auto& [left, right] : queries) {
+                        sweepCache(sweep_buffer);
+                        total_ns += timeQuery(*algorithm, left, right);
+                    }
+                    result.sweep_query_ns = std::max(0.0, total_ns / queries.size() - timer_ns);
+                    
+                    // Rotate: enough independent copies that each one has been
+                    // pushed out of cache by the time it is queried again
+                    size_t footprint = std::max<size_t>(RMQFactory::calculateMemoryUsage(type, size), 1);
+                    size_t instances = std::min(MAX_ROTATE_INSTANCES, (eviction_bytes + footprint - 1) / footprint);
+                    instances = std::max<size_t>(instances, 2);
+                    
+                    std::vector<std::unique_ptr<IRMQAlgorithm>> rotation;
+                    rotation.reserve(instances);
+                    for (size_t i = 0; i < instances; ++i) {
+                        rotation.push_back(RMQFactory::create(type));
+                        rotation.back()->preprocess(data);
+                    }
+                    result.rotate_instances = instances;
+                    result.rotate_footprint_bytes = instances * footprint;
+                    
+                    total_ns = 0;
+                    for (size_t i = 0; i < queries.size(); ++i) {
+                        total_ns += timeQuery(*rotation[i % instances], queries[i].first, queries[i].second);
+                    }
+                    result.rotate_query_ns = std::max(0.0, total_ns / queries.size() - timer_ns);
+                    
+                    cache_results.push_back(result);
+                    std::cout << "Done (warm: " << std::fixed << std::setprecision(1) << result.warm_query_ns
+                              << "ns, sweep: " << result.sweep_query_ns
+                              << "ns, rotate: " << result.rotate_query_ns << "ns)" << std::endl;
+                } catch (const std::exception& e) {
+                    std::cout << "Skipped (" << e.what() << ")" << std::endl;
+                }
+            }
+            std::cout << std::endl;
+        }
+        
+        std::ofstream csv("benchmark_cache_modes.csv");
+        csv << "Algorithm,ArraySize,WarmQuery_ns,SweepQuery_ns,RotateQuery_ns,RotateInstances,RotateFootprint_MB" << std::endl;
+        
+        std::cout << "\nCold vs. Warm Cache Summary:" << std::endl;
+        std::cout << std::string(120, '=') << std::endl;
+        std::cout << std::left << std::setw(35) << "Algorithm"
+                  << std::setw(12) << "Size"
+                  << std::setw(14) << "Warm (ns)"
+                  << std::setw(14) << "Sweep (ns)"
+                  << std::setw(14) << "Rotate (ns)"
+                  << std::setw(14) << "Sweep/Warm"
+                  << std::setw(17) << "Rotation (MB)" << std::endl;
+        std::cout << std::string(120, '-') << std::endl;
+        
+        for (const auto& result : cache_results) {
+            double footprint_mb = result.rotate_footprint_bytes / (1024.0 * 1024.0);
+            double ratio = result.warm_query_ns > 0 ? result.sweep_query_ns / result.warm_query_ns : 0;
+            
+            std::cout << std::left << std::setw(35) << result.algorithm_name
+                      << std::setw(12) << result.array_size
+                      << std::setw(14) << std::fixed << std::setprecision(1) << result.warm_query_ns
+                      << std::setw(14) << result.sweep_query_ns
+                      << std::setw(14) << result.rotate_query_ns
+                      << std::setw(14) << std::setprecision(2) << ratio
+                      << std::setw(17) << std::setprecision(2) << footprint_mb << std::endl;
+            
+            csv << result.algorithm_name << "," << result.array_size << ","
+                << result.warm_query_ns << "," << result.sweep_query_ns << ","
+                << result.rotate_query_ns << "," << result.rotate_instances << ","
+                << footprint_mb << std::endl;
+        }
+        std::cout << std::string(120, '=') << std::endl;
+        std::cout << "Note: a rotation smaller than the eviction buffer (tiny arrays hit the "
+                  << MAX_ROTATE_INSTANCES << "-instance cap) stays partly cached." << std::endl;
+        std::cout << std::endl << "Results written to benchmark_cache_modes.csv" << std::endl;
+    }
+
+    /**
+     * @brief Benchmark mixed read/update workloads
+     * 
+     * A workload is a stream of range queries interleaved with write batches
+     * of batch_size point updates; read_percent counts individual operations.
+     * Algorithms with supportsUpdate() apply a batch in place (update() for a
+     * batch of one, batchUpdate() otherwise). The others pay what they would
+     * in production: the batch is applied to a copy of the array and the
+     * index is rebuilt with preprocess().
+     * 
+     * Update locality:
+     * - uniform:    any position
+     * - hot:        90% of updates land in a window of 1% of the array
+     * - sequential: positions advance in order and wrap (tick-data append)
+     * 
+     * Each workload runs for at most time_budget_ms so rebuild-heavy cells
+     * finish; throughput is computed over the operations completed.
+     */
+    void runMixedBenchmark(size_t array_size, size_t num_operations, double time_budget_ms) {
+        const std::vector<int> read_percents = {99, 90, 50};
+        const std::vector<size_t> batch_sizes = {1, 64};
+        const std::vector<std::string> localities = {"uniform", "hot", "sequential"};
+        
+        std::cout << "Running RMQ Mixed Read/Update Benchmarks..." << std::endl;
+        std::cout << "=============================================" << std::endl;
+        std::cout << "Array size: " << array_size << ", " << num_operations << " operations per workload, "
+                  << "time budget " << time_budget_ms << " ms" << std::endl << std::endl;
+        
+        auto data = generateData(array_size);
+        std::vector<MixedWorkloadResult> mixed_results;
+        
+        for (const auto& locality : localities) {
+            for (int read_percent : read_percents) {
+                for (size_t batch_size : batch_sizes) {
+                    auto operations = generateMixedWorkload(array_size, num_operations,
+                                                            read_percent, batch_size, locality);
+                    
+                    std::cout << "Workload: " << locality << ", " << read_percent << "% reads, batch "
+                              << batch_size << std::endl;
+                    
+                    for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+                        // Skip DP for large arrays, as in the complexity benchmark
+                        if (type == AlgorithmType::DYNAMIC_PROGRAMMING && array_size > 2000) {
+                            continue;
+                        }
+                        
+                        try {
+                            auto result = runMixedWorkload(type, data, operations, time_budget_ms);
+                            result.locality = locality;
+                            result.read_percent = read_percent;
+                            result.batch_size = batch_size;
+                            mixed_results.push_back(result);
+                            
+                            std::cout << "  - " << std::left << std::setw(35) << result.algorithm_name
+                                      << std::setw(10) << result.strategy
+                                      << std::fixed << std::setprecision(0) << result.throughput_ops << " ops/s"
+                                      << (result.complete ? "" : " (time budget hit)")
+                                      << std::endl;
+                        } catch (const std::exception& e) {
+                            std::cout << "  - " << algorithmTypeToString(type) << " skipped (" << e.what() << ")" << std::endl;
+                        }
+                    }
+                    std::cout << std::endl;
+                }
+            }
+        }
+        
+        std::ofstream csv("benchmark_mixed.csv");
+        csv << "Algorithm,Strategy,ArraySize,Locality,ReadPercent,BatchSize,Operations,"
+            << "Throughput_ops_s,ReadP50_us,ReadP99_us,WriteBatchP50_us,WriteBatchP99_us" << std::endl;
+        
+        std::cout << "\nMixed Workload Summary:" << std::endl;
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::left << std::setw(35) << "Algorithm"
+                  << std::setw(10) << "Strategy"
+                  << std::setw(12) << "Locality"
+                  << std::setw(8) << "Read%"
+                  << std::setw(8) << "Batch"
+                  << std::setw(15) << "Ops/s"
+                  << std::setw(14) << "Read p99(μs)"
+                  << std::setw(14) << "Write p50(μs)"
+                  << std::setw(14) << "Write p99(μs)" << std::endl;
+        std::cout << std::string(130, '-') << std::endl;
+        
+        for (const auto& result : mixed_results) {
+            std::cout << std::left << std::setw(35) << result.algorithm_name
+                      << std::setw(10) << result.strategy
+                      << std::setw(12) << result.locality
+                      << std::setw(8) << result.read_percent
+                      << std::setw(8) << result.batch_size
+                      << std::setw(15) << std::fixed << std::setprecision(0) << result.throughput_ops
+                      << std::setw(14) << std::setprecision(3) << result.read_p99_us
+                      << std::setw(14) << result.write_p50_us
+                      << std::setw(14) << result.write_p99_us << std::endl;
+            
+            csv << result.algorithm_name << "," << result.strategy << "," << result.array_size << ","
+                << result.locality << "," << result.read_percent << "," << result.batch_size << ","
+                << result.operations << "," << result.throughput_ops << ","
+                << result.read_p50_us << "," << result.read_p99_us << ","
+                << result.write_p50_us << "," << result.write_p99_us << std::endl;
+        }
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::endl << "Results written to benchmark_mixed.csv" << std::endl;
+    }
+
+    /**
+     * @brief Sweep array sizes by powers of ten up to max_elements
+     * 
+     * Before building, each structure's footprint is predicted with
+     * RMQFactory::calculateMemoryUsage(); it is skipped when that plus the
+     * benchmark's own copy of the data exceeds budget_bytes. The sweep stops
+     * at the first size whose data alone does not fit. Reports build
+     * throughput (elements/s), query latency, and predicted vs. measured
+     * memory so the prediction itself is checked.
+     */
+    void runScaleBenchmark(size_t budget_bytes, size_t max_elements) {
+        const size_t SCALE_QUERIES = 1000;
+        const double QUERY_BUDGET_MS = 2000.0;
+        
+        std::cout << "Running RMQ Scale Benchmarks..." << std::endl;
+        std::cout << "=============================================" << std::endl;
+        std::cout << "Memory budget: " << budget_bytes / (1024.0 * 1024.0) << " MB, "
+                  << "up to " << max_elements << " elements" << std::endl << std::endl;
+        
+        std::vector<size_t> sizes;
+        for (size_t size = 10000; size <= max_elements; size *= 10) {
+            sizes.push_back(size);
+        }
+        if (sizes.empty() || sizes.back() != max_elements) {
+            sizes.push_back(max_elements);
+        }
+        
+        std::vector<ScaleResult> scale_results;
+        
+        for (size_t size : sizes) {
+            size_t data_bytes = size * sizeof(Value);
+            if (data_bytes > budget_bytes) {
+                std::cout << "Stopping at " << size << " elements: the data alone exceeds the budget" << std::endl;
+                break;
+            }
+            
+            std::cout << "Testing with array size: " << size << std::endl;
+            auto data = generateData(size);
+            auto queries = generateQueries(size, SCALE_QUERIES);
+            
+            for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+                ScaleResult result;
+                result.algorithm_name = algorithmTypeToString(type);
+                result.array_size = size;
+                result.predicted_bytes = RMQFactory::calculateMemoryUsage(type, size);
+                result.actual_bytes = 0;
+                result.build_ms = -1;
+                result.build_elements_per_s = 0;
+                result.query_mean_us = -1;
+                result.query_p99_us = -1;
+                result.queries = 0;
+                
+                std::cout << "  - " << std::left << std::setw(22) << result.algorithm_name << std::flush;
+                
+                if (data_bytes + result.predicted_bytes > budget_bytes) {
+                    result.status = "over budget";
+                    scale_results.push_back(result);
+                    std::cout << "Skipped (needs " << std::fixed << std::setprecision(1)
+                              << (data_bytes + result.predicted_bytes) / (1024.0 * 1024.0) << " MB)" << std::endl;
+                    continue;
+                }
+                
+                try {
+                    AlgorithmConfig config;
+                    config.withMaxArraySize(size);
+                    auto algorithm = RMQFactory::create(type, config);
+                    result.algorithm_name = algorithm->getName();
+                    
+                    auto start = high_resolution_clock::now();
+                    algorithm->preprocess(data);
+                    auto end = high_resolution_clock::now();
+                    result.build_ms = duration_cast<duration<double, std::milli>>(end - start).count();
+                    result.build_elements_per_s = result.build_ms > 0 ? size / (result.build_ms / 1000.0) : 0;
+                    result.actual_bytes = memoryUsageOf(*algorithm);
+                    
+                    std::vector<double> latencies;
+                    auto queries_start = high_resolution_clock::now();
+                    for (const auto& [left, right] : queries) {
+                        start = high_resolution_clock::now();
+                        volatile Value v = algorithm->query(left, right);  // volatile to prevent optimization
+                        end = high_resolution_clock::now();
+                        (void)v;
+                        latencies.push_back(duration_cast<duration<double, std::micro>>(end - start).count());
+                        
+                        if (duration_cast<duration<double, std::milli>>(end - queries_start).count() > QUERY_BUDGET_MS) {
+                            break;
+                        }
+                    }
+                    
+                    double total_us = 0;
+                    for (double latency : latencies) total_us += latency;
+                    result.queries = latencies.size();
+                    result.query_mean_us = total_us / latencies.size();
+                    result.query_p99_us = percentile(latencies, 0.99);
+                    result.status = "ok";
+                    
+                    std::cout << "build " << std::fixed << std::setprecision(1) << result.build_ms << " ms ("
+                              << std::setprecision(2) << result.build_elements_per_s / 1e6 << " M elem/s), query "
+                              << std::setprecision(3) << result.query_mean_us << " μs" << std::endl;
+                } catch (const std::exception& e) {
+                    result.status = e.what();
+                    std::cout << "Skipped (" << e.what() << ")" << std::endl;
+                }
+                
+                scale_results.push_back(result);
+            }
+            std::cout << std::endl;
+        }
+        
+        std::ofstream csv("benchmark_scale.csv");
+        csv << "Algorithm,ArraySize,PredictedMemory_MB,ActualMemory_MB,BuildTime_ms,BuildThroughput_elements_s,"
+            << "QueryMean_us,QueryP99_us,Queries,Status" << std::endl;
+        
+        std::cout << "\nScale Summary:" << std::endl;
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::left << std::setw(35) << "Algorithm"
+                  << std::setw(13) << "Size"
+                  << std::setw(16) << "Pred (MB)"
+                  << std::setw(14) << "Actual (MB)"
+                  << std::setw(14) << "Build (ms)"
+                  << std::setw(14) << "M elem/s"
+                  << std::setw(14) << "Query (μs)"
+                  << std::setw(14) << "p99 (μs)" << std::endl;
+        std::cout << std::string(130, '-') << std::endl;
+        
+        for (const auto& result : scale_results) {
+            double predicted_mb = result.predicted_bytes / (1024.0 * 1024.0);
+            double actual_mb = result.actual_bytes / (1024.0 * 1024.0);
+            
+            std::cout << std::left << std::setw(35) << result.algorithm_name
+                      << std::setw(13) << result.array_size
+                      << std::setw(16) << std::fixed << std::setprecision(1) << predicted_mb;
+            if (result.status == "ok") {
+                std::cout << std::setw(14) << actual_mb
+                          << std::setw(14) << result.build_ms
+                          << std::setw(14) << std::setprecision(2) << result.build_elements_per_s / 1e6
+                          << std::setw(14) << std::setprecision(3) << result.query_mean_us
+                          << std::setw(14) << result.query_p99_us << std::endl;
+            } else {
+                std::cout << "skipped: " << result.status << std::endl;
+            }
+            
+            csv << result.algorithm_name << "," << result.array_size << ","
+                << predicted_mb << "," << actual_mb << "," << result.build_ms << ","
+                << result.build_elements_per_s << "," << result.query_mean_us << ","
+                << result.query_p99_us << "," << result.queries << ",\"" << result.status << "\"" << std::endl;
+        }
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::endl << "Results written to benchmark_scale.csv" << std::endl;
+    }
+    
+    /**
+     * @brief Tune the block size for short, medium and full-range queries
+     * 
+     * For each workload, BlockSizeTuner measures the cache-line multiples
+     * on a query sample and the chosen size is compared to the default
+     * sqrt(n) + 1. Choices are kept in the profile file, so a second run
+     * with the same array size and workloads reuses them without measuring.
+     */
+    void runBlockTuningBenchmark(size_t array_size, const std::string& profile_path) {
+        const size_t SAMPLE_QUERIES = 2000;
+        const double MS_PER_CANDIDATE = 5.0;
+        
+        std::cout << "Running Block Size Tuning..." << std::endl;
+        std::cout << "============================" << std::endl;
+        std::cout << "Array size: " << array_size << ", profile " << profile_path << std::endl << std::endl;
+        
+        auto data = generateData(array_size);
+        BlockSizeProfile profile = BlockSizeProfile::load(profile_path);
+        
+        size_t sqrt_length = static_cast<size_t>(std::sqrt(static_cast<double>(array_size))) + 1;
+        const std::vector<std::pair<std::string, size_t>> workloads = {
+            {"short (<= 64)", std::min<size_t>(64, array_size)},
+            {"medium (<= sqrt n)", sqrt_length},
+            {"full range", array_size}
+        };
+        
+        std::cout << std::left << std::setw(22) << "Workload"
+                  << std::setw(12) << "Block"
+                  << std::setw(16) << "Tuned (ns/q)"
+                  << std::setw(18) << "Default (ns/q)"
+                  << "Source" << std::endl;
+        std::cout << std::string(80, '-') << std::endl;
+        
+        for (const auto& [name, max_length] : workloads) {
+            std::uniform_int_distribution<size_t> length_dist(1, max_length);
+            std::vector<Query> sample;
+            for (size_t i = 0; i < SAMPLE_QUERIES; ++i) {
+                size_t length = length_dist(gen_);
+                std::uniform_int_distribution<size_t> left_dist(0, array_size - length);
+                size_t left = left_dist(gen_);
+                sample.emplace_back(left, left + length - 1);
+            }
+            
+            BlockSizeTuning tuning = BlockSizeTuner::tune(data, sample, profile, MS_PER_CANDIDATE);
+            std::cout << std::left << std::setw(22) << name
+                      << std::setw(12) << tuning.block_size;
+            if (tuning.from_profile) {
+                std::cout << std::setw(16) << "-" << std::setw(18) << "-" << "profile" << std::endl;
+            } else {
+                std::cout << std::setw(16) << std::fixed << std::setprecision(1) << tuning.ns_per_query
+                          << std::setw(18) << tuning.default_ns_per_query << "measured" << std::endl;
+            }
+        }
+        
+        profile.save(profile_path);
+        std::cout << std::endl << "Profile written to " << profile_path << std::endl;
+    }
+    
+    /**
+     * @brief Record a synthetic mixed workload, as a stand-in for a production capture
+     * 
+     * Writes the array to snapshot_path and the operations, served by a
+     * block decomposition with a RecordingWriter attached, to recording_path.
+     */
+    void runRecordWorkload(const std::string& recording_path, const std::string& snapshot_path,
+                           size_t array_size, size_t num_operations) {
+        auto data = generateData(array_size);
+        RMQExternalMemory::writeDataFile(snapshot_path, data);
+        
+        WorkloadStats stats;
+        for (int i = 0; i < 9; ++i) {
+            stats.recordQuery(0, array_size / 64);
+        }
+        stats.recordUpdate();
+        auto workload = synthesizeTrace(stats, array_size, num_operations, 7);
+        
+        RMQBlockDecomposition rmq;
+        rmq.preprocess(data);
+        size_t dropped = 0;
+        {
+            recording::RecordingWriter writer(recording_path, snapshot_path, data);
+            rmq.setRecorder(&writer);
+            for (const auto& op : workload) {
+                if (op.kind == OperationKind::QUERY) {
+                    volatile Value v = rmq.query(op.left, op.right);
+                    (void)v;
+                } else {
+                    rmq.update(op.left, op.value);
+                }
+            }
+            rmq.setRecorder(nullptr);
+            writer.flush();
+            dropped = writer.droppedCount();
+        }
+        
+        std::ifstream written(recording_path, std::ios::binary | std::ios::ate);
+        double bytes = static_cast<double>(written.tellg());
+        std::cout << "Recorded " << workload.size() << " operations on " << array_size << " elements"
+                  << (dropped > 0 ? " (" + std::to_string(dropped) + " dropped)" : "") << std::endl;
+        std::cout << "  " << recording_path << ": " << std::fixed << std::setprecision(1)
+                  << bytes / workload.size() << " bytes per operation" << std::endl;
+        std::cout << "  " << snapshot_path << ": array snapshot" << std::endl;
+    }
+    
+    /**
+     * @brief Replay a recording against every algorithm
+     * 
+     * The array is loaded from snapshot_path (by default the reference in
+     * the recording) and checked against the recorded size and checksum.
+     * At maximum speed operations run back to back; at recorded speed each
+     * one waits for its recorded time, so throughput and queueing match
+     * production and latency is the service time of each operation.
+     * Algorithms without updates rebuild from a copy of the array. The sum
+     * of all answers must be the same for every algorithm.
+     */
+    void runReplayBenchmark(const std::string& recording_path, std::string snapshot_path,
+                            bool recorded_speed, double time_budget_ms) {
+        recording::Recording trace = recording::readRecording(recording_path);
+        if (snapshot_path.empty()) {
+            snapshot_path = trace.snapshot;
+        }
+        auto data = recording::loadSnapshot(snapshot_path);
+        if (data.size() != trace.array_size || recording::snapshotChecksum(data) != trace.checksum) {
+            throw InvalidDataException("Snapshot " + snapshot_path + " is not the array of " + recording_path);
+        }
+        
+        WorkloadStats stats = WorkloadStats::fromTrace(trace.workload());
+        std::cout << "Replaying " << recording_path << std::endl;
+        std::cout << "=============================================" << std::endl;
+        std::cout << "Array size: " << data.size() << ", " << stats.queries << " queries, "
+                  << stats.updates << " updates over " << std::fixed << std::setprecision(1)
+                  << trace.durationNs() / 1e6 << " ms recorded" << std::endl;
+        std::cout << "Speed: " << (recorded_speed ? "recorded" : "maximum")
+                  << ", time budget " << time_budget_ms << " ms" << std::endl << std::endl;
+        
+        std::vector<ReplayResult> replay_results;
+        for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+            if (type == AlgorithmType::DYNAMIC_PROGRAMMING && data.size() > 2000) {
+                continue;
+            }
+            try {
+                AlgorithmConfig config;
+                config.withMaxArraySize(std::max(config.max_array_size, data.size()));
+                replay_results.push_back(replayRecording(type, config, data, trace, recorded_speed, time_budget_ms));
+                const auto& result = replay_results.back();
+                std::cout << "  - " << std::left << std::setw(35) << result.algorithm_name
+                          << std::setw(10) << result.strategy
+                          << std::fixed << std::setprecision(0) << result.throughput_ops << " ops/s"
+                          << (result.complete ? "" : " (time budget hit)") << std::endl;
+            } catch (const std::exception& e) {
+                std::cout << "  - " << algorithmTypeToString(type) << " skipped (" << e.what() << ")" << std::endl;
+            }
+        }
+        
+        // Answers are compared among the replays that finished
+        const ReplayResult* reference = nullptr;
+        for (const auto& result : replay_results) {
+            if (result.complete) {
+                reference = &result;
+                break;
+            }
+        }
+        
+        std::ofstream csv("benchmark_replay.csv");
+        csv << "Algorithm,Strategy,Operations,Complete,Throughput_ops_s,QueryP50_us,QueryP99_us,"
+            << "QueryP999_us,UpdateP50_us,UpdateP99_us,AnswersMatch" << std::endl;
+        
+        std::cout << "\nReplay Summary:" << std::endl;
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::left << std::setw(35) << "Algorithm"
+                  << std::setw(10) << "Strategy"
+                  << std::setw(15) << "Ops/s"
+                  << std::setw(16) << "Query p50(μs)"
+                  << std::setw(16) << "Query p99(μs)"
+                  << std::setw(18) << "Query p99.9(μs)"
+                  << std::setw(17) << "Update p99(μs)"
+                  << "Answers" << std::endl;
+        std::cout << std::string(130, '-') << std::endl;
+        
+        for (const auto& result : replay_results) {
+            std::string answers = !result.complete ? "-" :
+                                  result.answer_sum == reference->answer_sum ? "match" : "DIFFER";
+            std::cout << std::left << std::setw(35) << result.algorithm_name
+                      << std::setw(10) << result.strategy
+                      << std::setw(15) << std::fixed << std::setprecision(0) << result.throughput_ops
+                      << std::setw(15) << std::setprecision(3) << result.query_p50_us
+                      << std::setw(15) << result.query_p99_us
+                      << std::setw(17) << result.query_p999_us
+                      << std::setw(16) << result.update_p99_us
+                      << answers << std::endl;
+            
+            csv << result.algorithm_name << "," << result.strategy << "," << result.operations << ","
+                << (result.complete ? 1 : 0) << "," << result.throughput_ops << ","
+                << result.query_p50_us << "," << result.query_p99_us << "," << result.query_p999_us << ","
+                << result.update_p50_us << "," << result.update_p99_us << "," << answers << std::endl;
+        }
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::endl << "Results written to benchmark_replay.csv" << std::endl;
+    }
+    
+    /**
+     * @brief Search for the inputs and query sets that are slowest for each algorithm
+     * 
+     * Random data rarely hits the bad cases: deep Cartesian trees for the
+     * LCA-based algorithm, nearly whole partial blocks for the block
+     * decomposition, long runs and ties. For each algorithm the search
+     * starts from every structured input and query shape in
+     * rmq_adversarial.h, then hill-climbs with random mutations of the
+     * input or the shape, keeping a change only when it is at least 3%
+     * slower on two measurements. Query cost is ns per query, build cost
+     * ns per element.
+     * 
+     * The worst cases are written to corpus_dir as a stress corpus: array
+     * snapshots (raw format, see RMQExternalMemory::writeDataFile), and
+     * for query cost a recording of the query set that --replay runs
+     * against every algorithm, plus a corpus.csv index.
+     */
+    void runAdversarialSearch(size_t array_size, size_t iterations, const std::string& corpus_dir) {
+        std::cout << "Running Adversarial Input Search..." << std::endl;
+        std::cout << "===================================" << std::endl;
+        std::cout << "Array size: " << array_size << ", " << iterations
+                  << " mutations per objective, corpus " << corpus_dir << std::endl << std::endl;
+        
+        std::error_code ec;
+        std::filesystem::create_directories(corpus_dir, ec);
+        if (ec) {
+            throw InvalidDataException("Cannot create corpus directory " + corpus_dir + ": " + ec.message());
+        }
+        
+        std::mt19937 search_gen(1234);
+        std::vector<AdversarialResult> adversarial_results;
+        for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+            if (type == AlgorithmType::DYNAMIC_PROGRAMMING && array_size > 2000) {
+                continue;
+            }
+            try {
+                AlgorithmConfig config;
+                config.withMaxArraySize(std::max(config.max_array_size, array_size));
+                std::string slug = corpusSlug(algorithmTypeToString(type));
+                
+                std::vector<Value> worst_data;
+                std::vector<Query> worst_queries;
+                AdversarialResult query_result = searchQueryWorstCase(type, config, array_size, iterations,
+                                                                      search_gen, worst_data, worst_queries);
+                query_result.snapshot_path = (std::filesystem::path(corpus_dir) / (slug + "-query.bin")).string();
+                query_result.recording_path = (std::filesystem::path(corpus_dir) / (slug + "-query.rec")).string();
+                RMQExternalMemory::writeDataFile(query_result.snapshot_path, worst_data);
+                {
+                    recording::RecordingWriter writer(query_result.recording_path, query_result.snapshot_path,
+                                                      worst_data);
+                    for (const Query& query : worst_queries) {
+                        writer.recordQuery(query.left, query.right);
+                    }
+                }
+                adversarial_results.push_back(query_result);
+                
+                AdversarialResult build_result = searchBuildWorstCase(type, config, array_size, iterations,
+                                                                      search_gen, worst_data);
+                build_result.snapshot_path = (std::filesystem::path(corpus_dir) / (slug + "-build.bin")).string();
+                RMQExternalMemory::writeDataFile(build_result.snapshot_path, worst_data);
+                adversarial_results.push_back(build_result);
+                
+                std::cout << "  - " << std::left << std::setw(35) << query_result.algorithm_name
+                          << std::fixed << std::setprecision(1)
+                          << "query x" << query_result.worst_cost / query_result.baseline_cost
+                          << ", build x" << build_result.worst_cost / build_result.baseline_cost << std::endl;
+            } catch (const std::exception& e) {
+                std::cout << "  - " << algorithmTypeToString(type) << " skipped (" << e.what() << ")" << std::endl;
+            }
+        }
+        
+        std::string index_path = (std::filesystem::path(corpus_dir) / "corpus.csv").string();
+        std::ofstream csv(index_path);
+        csv << "Algorithm,Objective,Baseline,Worst,Ratio,Evaluations,Snapshot,Recording,Description" << std::endl;
+        
+        std::cout << "\nAdversarial Summary (query: ns/query, build: ns/element):" << std::endl;
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::left << std::setw(35) << "Algorithm"
+                  << std::setw(11) << "Objective"
+                  << std::setw(12) << "Baseline"
+                  << std::setw(12) << "Worst"
+                  << std::setw(9) << "Ratio"
+                  << "Worst case" << std::endl;
+        std::cout << std::string(130, '-') << std::endl;
+        
+        for (const auto& result : adversarial_results) {
+            double ratio = result.baseline_cost > 0 ? result.worst_cost / result.baseline_cost : 0.0;
+            std::cout << std::left << std::setw(35) << result.algorithm_name
+                      << std::setw(11) << result.objective
+                      << std::setw(12) << std::fixed << std::setprecision(1) << result.baseline_cost
+                      << std::setw(12) << result.worst_cost
+                      << std::setw(9) << std::setprecision(2) << ratio
+                      << result.description << std::endl;
+            
+            csv << result.algorithm_name << "," << result.objective << "," << result.baseline_cost << ","
+                << result.worst_cost << "," << ratio << "," << result.evaluations << ","
+                << result.snapshot_path << "," << result.recording_path << ",\"" << result.description
+                << "\"" << std::endl;
+        }
+        std::cout << std::string(130, '=') << std::endl;
+        std::cout << std::endl << "Corpus written to " << corpus_dir << " (index " << index_path
+                  << "); replay a worst case with --replay <recording>" << std::endl;
+    }
+    
 private:
+    /**
+     * @brief Measured footprint of a built algorithm
+     */
+    static size_t memoryUsageOf(const IRMQAlgorithm& algorithm) {
+        if (auto* naive = dynamic_cast<const RMQNaive*>(&algorithm)) return naive->getMemoryUsage();
+        if (auto* dp = dynamic_cast<const RMQDynamicProgramming*>(&algorithm)) return dp->getMemoryUsage();
+        if (auto* sparse = dynamic_cast<const RMQSparseTable*>(&algorithm)) return sparse->getMemoryUsage();
+        if (auto* block = dynamic_cast<const RMQBlockDecomposition*>(&algorithm)) return block->getMemoryUsage();
+        if (auto* lca = dynamic_cast<const RMQLCABased*>(&algorithm)) return lca->getMemoryUsage();
+        if (auto* stree = dynamic_cast<const RMQSTree*>(&algorithm)) return stree->getMemoryUsage();
+        if (auto* runs = dynamic_cast<const RMQMonotoneRuns*>(&algorithm)) return runs->getMemoryUsage();
+        return 0;
+    }
+    
+    /**
+     * @brief Replay one recording against one algorithm
+     */
+    ReplayResult replayRecording(AlgorithmType type, const AlgorithmConfig& config,
+                                 const std::vector<Value>& data, const recording::Recording& trace,
+                                 bool recorded_speed, double time_budget_ms) {
+        ReplayResult result;
+        auto algorithm = RMQFactory::create(type, config);
+        algorithm->preprocess(data);
+        result.algorithm_name = algorithm->getName();
+        
+        bool in_place = algorithm->supportsUpdate();
+        result.strategy = in_place ? "in-place" : "rebuild";
+        std::vector<Value> current = in_place ? std::vector<Value>() : data;
+        
+        std::vector<double> query_us;
+        std::vector<double> update_us;
+        long long answer_sum = 0;
+        size_t completed_ops = 0;
+        uint64_t first_timestamp = trace.operations.empty() ? 0 : trace.operations.front().timestamp_ns;
+        
+        auto replay_start = high_resolution_clock::now();
+        for (const auto& recorded : trace.operations) {
+            if (recorded_speed) {
+                std::this_thread::sleep_until(replay_start + nanoseconds(recorded.timestamp_ns - first_timestamp));
+            }
+            
+            const WorkloadOperation& op = recorded.operation;
+            auto start = high_resolution_clock::now();
+            if (op.kind == OperationKind::QUERY) {
+                answer_sum += algorithm->query(op.left, op.right);
+            } else if (in_place) {
+                algorithm->update(op.left, op.value);
+            } else {
+                current[op.left] = op.value;
+                algorithm->preprocess(current);
+            }
+            auto end = high_resolution_clock::now();
+            
+            double elapsed_us = duration_cast<duration<double, std::micro>>(end - start).count();
+            (op.kind == OperationKind::QUERY ? query_us : update_us).push_back(elapsed_us);
+            
+            // Check the time budget every few operations
+            if (++completed_ops % 16 == 0 &&
+                duration_cast<duration<double, std::milli>>(end - replay_start).count() > time_budget_ms) {
+                break;
+            }
+        }
+        auto replay_end = high_resolution_clock::now();
+        
+        double total_s = duration_cast<duration<double>>(replay_end - replay_start).count();
+        result.operations = completed_ops;
+        result.complete = completed_ops == trace.operations.size();
+        result.throughput_ops = total_s > 0 ? completed_ops / total_s : 0;
+        result.query_p50_us = percentile(query_us, 0.50);
+        result.query_p99_us = percentile(query_us, 0.99);
+        result.query_p999_us = percentile(query_us, 0.999);
+        result.update_p50_us = percentile(update_us, 0.50);
+        result.update_p99_us = percentile(update_us, 0.99);
+        result.answer_sum = answer_sum;
+        
+        return result;
+    }
+    
+    /**
+     * @brief Corpus file prefix for an algorithm name ("LCA-based" -> "lca-based")
+     */
+    static std::string corpusSlug(const std::string& name) {
+        std::string slug;
+        for (char c : name) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                slug += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            } else if (!slug.empty() && slug.back() != '-') {
+                slug += '-';
+            }
+        }
+        return slug;
+    }
+    
+    /**
+     * @brief Mean ns per query over queries, the fastest of three passes
+     */
+    static double adversarialQueryCost(const IRMQAlgorithm& algorithm, const std::vector<Query>& queries) {
+        volatile Value sink = 0;
+        double best_ns = std::numeric_limits<double>::infinity();
+        for (int pass = 0; pass < 3; ++pass) {
+            auto start = high_resolution_clock::now();
+            for (const Query& query : queries) {
+                sink = algorithm.query(query.left, query.right);
+            }
+            auto end = high_resolution_clock::now();
+            best_ns = std::min(best_ns, duration_cast<duration<double, std::nano>>(end - start).count());
+        }
+        (void)sink;
+        return best_ns / static_cast<double>(queries.size());
+    }
+    
+    /**
+     * @brief Preprocessing ns per element, the fastest of three builds
+     */
+    static double adversarialBuildCost(IRMQAlgorithm& algorithm, const std::vector<Value>& data) {
+        double best_ns = std::numeric_limits<double>::infinity();
+        for (int pass = 0; pass < 3; ++pass) {
+            auto start = high_resolution_clock::now();
+            algorithm.preprocess(data);
+            auto end = high_resolution_clock::now();
+            best_ns = std::min(best_ns, duration_cast<duration<double, std::nano>>(end - start).count());
+        }
+        return best_ns / static_cast<double>(data.size());
+    }
+    
+    /**
+     * @brief Join a seed and its accepted mutations into a description
+     */
+    static std::string describeMutations(const std::string& seed, const std::vector<std::string>& mutations) {
+        std::string text = seed;
+        for (const auto& mutation : mutations) {
+            text += " + " + mutation;
+        }
+        return text;
+    }
+    
+    /**
+     * @brief Hill-climb towards the input and query set with the highest ns per query
+     */
+    AdversarialResult searchQueryWorstCase(AlgorithmType type, const AlgorithmConfig& config, size_t array_size,
+                                           size_t iterations, std::mt19937& search_gen,
+                                           std::vector<Value>& worst_data, std::vector<Query>& worst_queries) {
+        using namespace adversarial;
+        const size_t SAMPLE_QUERIES = 500;
+        const double ACCEPT_FACTOR = 1.03;
+        
+        AdversarialResult result;
+        auto algorithm = RMQFactory::create(type, config);
+        result.algorithm_name = algorithm->getName();
+        result.objective = "query";
+        result.evaluations = 0;
+        
+        algorithm->preprocess(generateInput(InputPattern::RANDOM, array_size));
+        auto uniform_queries = adversarial::generateQueries(QueryShape(), array_size, SAMPLE_QUERIES);
+        result.baseline_cost = adversarialQueryCost(*algorithm, uniform_queries);
+        
+        // Seeds: every structured input against every structured query shape
+        result.worst_cost = 0.0;
+        std::string seed;
+        QueryShape worst_shape;
+        for (InputPattern pattern : allInputPatterns()) {
+            auto data = generateInput(pattern, array_size);
+            algorithm->preprocess(data);
+            for (const QueryShape& shape : structuredQueryShapes(array_size)) {
+                auto queries = adversarial::generateQueries(shape, array_size, SAMPLE_QUERIES);
+                double cost = adversarialQueryCost(*algorithm, queries);
+                result.evaluations++;
+                if (cost > result.worst_cost) {
+                    result.worst_cost = cost;
+                    seed = inputPatternToString(pattern);
+                    worst_data = data;
+                    worst_shape = shape;
+                    worst_queries = queries;
+                }
+            }
+        }
+        
+        // Mutations: the input (rebuilt in a second instance) or the query shape
+        algorithm->preprocess(worst_data);
+        auto candidate_algorithm = RMQFactory::create(type, config);
+        std::vector<std::string> mutations;
+        for (size_t i = 0; i < iterations; ++i) {
+            bool mutate_input = std::uniform_int_distribution<int>(0, 1)(search_gen) == 0;
+            std::vector<Value> data;
+            QueryShape shape = worst_shape;
+            std::string mutation;
+            if (mutate_input) {
+                data = worst_data;
+                mutation = mutateInput(data, search_gen);
+                candidate_algorithm->preprocess(data);
+            } else {
+                mutation = std::string("shape ") + mutateShape(shape, array_size, search_gen);
+            }
+            
+            const IRMQAlgorithm& measured = mutate_input ? *candidate_algorithm : *algorithm;
+            auto queries = adversarial::generateQueries(shape, array_size, SAMPLE_QUERIES);
+            double cost = adversarialQueryCost(measured, queries);
+            result.evaluations++;
+            if (cost > result.worst_cost * ACCEPT_FACTOR) {
+                cost = std::min(cost, adversarialQueryCost(measured, queries));
+            }
+            if (cost <= result.worst_cost * ACCEPT_FACTOR) {
+                continue;
+            }
+            
+            result.worst_cost = cost;
+            worst_shape = shape;
+            worst_queries = queries;
+            mutations.push_back(mutation);
+            if (mutate_input) {
+                worst_data = std::move(data);
+                std::swap(algorithm, candidate_algorithm);
+            }
+        }
+        
+        result.description = describeMutations(seed, mutations) + "; queries " + worst_shape.describe();
+        return result;
+    }
+    
+    /**
+     * @brief Hill-climb towards the input with the highest preprocessing ns per element
+     */
+    AdversarialResult searchBuildWorstCase(AlgorithmType type, const AlgorithmConfig& config, size_t array_size,
+                                           size_t iterations, std::mt19937& search_gen,
+                                           std::vector<Value>& worst_data) {
+        using namespace adversarial;
+        const double ACCEPT_FACTOR = 1.03;
+        
+        AdversarialResult result;
+        auto algorithm = RMQFactory::create(type, config);
+        result.algorithm_name = algorithm->getName();
+        result.objective = "build";
+        result.evaluations = 0;
+        result.baseline_cost = adversarialBuildCost(*algorithm, generateInput(InputPattern::RANDOM, array_size));
+        
+        result.worst_cost = 0.0;
+        std::string seed;
+        for (InputPattern pattern : allInputPatterns()) {
+            auto data = generateInput(pattern, array_size);
+            double cost = adversarialBuildCost(*algorithm, data);
+            result.evaluations++;
+            if (cost > result.worst_cost) {
+                result.worst_cost = cost;
+                seed = inputPatternToString(pattern);
+                worst_data = std::move(data);
+            }
+        }
+        
+        std::vector<std::string> mutations;
+        for (size_t i = 0; i < iterations; ++i) {
+            std::vector<Value> data = worst_data;
+            std::string mutation = mutateInput(data, search_gen);
+            double cost = adversarialBuildCost(*algorithm, data);
+            result.evaluations++;
+            if (cost > result.worst_cost * ACCEPT_FACTOR) {
+                cost = std::min(cost, adversarialBuildCost(*algorithm, data));
+            }
+            if (cost > result.worst_cost * ACCEPT_FACTOR) {
+                result.worst_cost = cost;
+                worst_data = std::move(data);
+                mutations.push_back(mutation);
+            }
+        }
+        
+        result.description = describeMutations(seed, mutations);
+        return result;
+    }
+    
+    /**
+     * @brief One step of a mixed workload: a range query or a write batch
+     */
+    struct MixedOperation {
+        bool is_write;
+        Index left;
+        Index right;
+        std::vector<std::pair<Index, Value>> updates;
+    };
+    
+    /**
+     * @brief Generate a read/write stream with the given ratio, batching and locality
+     */
+    std::vector<MixedOperation> generateMixedWorkload(size_t array_size, size_t num_operations,
+                                                      int read_percent, size_t batch_size,
+                                                      const std::string& locality) {
+        size_t write_ops = num_operations * (100 - read_percent) / 100;
+        size_t num_batches = write_ops / batch_size;
+        size_t num_reads = num_operations - num_batches * batch_size;
+        
+        // Interleave reads and write batches in random order
+        std::vector<bool> is_write(num_reads + num_batches, false);
+        std::fill(is_write.begin(), is_write.begin() + num_batches, true);
+        std::shuffle(is_write.begin(), is_write.end(), gen_);
+        
+        std::uniform_int_distribution<size_t> index_dist(0, array_size - 1);
+        std::uniform_real_distribution<double> unit_dist(0.0, 1.0);
+        size_t hot_width = std::max<size_t>(1, array_size / 100);
+        size_t hot_start = index_dist(gen_) % (array_size - hot_width + 1);
+        size_t cursor = 0;
+        
+        auto nextIndex = [&]() -> Index {
+            if (locality == "hot") {
+                if (unit_dist(gen_) < 0.9) {
+                    return hot_start + index_dist(gen_) % hot_width;
+                }
+                return index_dist(gen_);
+            }
+            if (locality == "sequential") {
+                Index index = cursor;
+                cursor = (cursor + 1) % array_size;
+                return index;
+            }
+            return index_dist(gen_);
+        };
+        
+        std::vector<MixedOperation> operations;
+        operations.reserve(is_write.size());
+        for (bool write : is_write) {
+            MixedOperation op;
+            op.is_write = write;
+            op.left = 0;
+            op.right = 0;
+            if (write) {
+                op.updates.reserve(batch_size);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    op.updates.push_back({nextIndex(), value_dist_(gen_)});
+                }
+            } else {
+                op.left = index_dist(gen_);
+                op.right = index_dist(gen_);
+                if (op.left > op.right) std::swap(op.left, op.right);
+            }
+            operations.push_back(std::move(op));
+        }
+        
+        return operations;
+    }
+    
+    /**
+     * @brief Replay a mixed workload against one algorithm
+     */
+    MixedWorkloadResult runMixedWorkload(AlgorithmType type, const std::vector<Value>& data,
+                                         const std::vector<MixedOperation>& operations,
+                                         double time_budget_ms) {
+        MixedWorkloadResult result;
+        result.array_size = data.size();
+        
+        auto algorithm = RMQFactory::create(type);
+        algorithm->preprocess(data);
+        result.algorithm_name = algorithm->getName();
+        
+        bool in_place = algorithm->supportsUpdate();
+        result.strategy = in_place ? "in-place" : "rebuild";
+        
+        // Rebuild strategy keeps the authoritative array outside the index
+        std::vector<Value> current = in_place ? std::vector<Value>() : data;
+        
+        std::vector<double> read_us;
+        std::vector<double> write_us;
+        size_t completed_ops = 0;
+        size_t steps = 0;
+        
+        auto workload_start = high_resolution_clock::now();
+        for (const auto& op : operations) {
+            auto start = high_resolution_clock::now();
+            if (!op.is_write) {
+                volatile Value v = algorithm->query(op.left, op.right);  // volatile to prevent optimization
+                (void)v;
+            } else if (in_place && op.updates.size() == 1) {
+                algorithm->update(op.updates[0].first, op.updates[0].second);
+            } else if (in_place) {
+                algorithm->batchUpdate(op.updates);
+            } else {
+                for (const auto& [index, value] : op.updates) {
+                    current[index] = value;
+                }
+                algorithm->preprocess(current);
+            }
+            auto end = high_resolution_clock::now();
+            
+            double elapsed_us = duration_cast<duration<double, std::micro>>(end - start).count();
+            if (op.is_write) {
+                write_us.push_back(elapsed_us);
+                completed_ops += op.updates.size();
+            } else {
+                read_us.push_back(elapsed_us);
+                completed_ops++;
+            }
+            
+            // Check the time budget every few steps
+            if (++steps % 16 == 0 &&
+                duration_cast<duration<double, std::milli>>(end - workload_start).count() > time_budget_ms) {
+                break;
+            }
+        }
+        auto workload_end = high_resolution_clock::now();
+        
+        double total_s = duration_cast<duration<double>>(workload_end - workload_start).count();
+        result.operations = completed_ops;
+        result.complete = steps == operations.size();
+        result.throughput_ops = total_s > 0 ? completed_ops / total_s : 0;
+        result.read_p50_us = percentile(read_us, 0.50);
+        result.read_p99_us = percentile(read_us, 0.99);
+        result.write_p50_us = percentile(write_us, 0.50);
+        result.write_p99_us = percentile(write_us, 0.99);
+        
+        return result;
+    }
+    
+    /**
+     * @brief Percentile of a sample (0 for an empty sample)
+     */
+    static double percentile(std::vector<double> samples, double fraction) {
+        if (samples.empty()) {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(fraction * (samples.size() - 1));
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+        return samples[rank];
+    }
+    
+    /**
+     * @brief Time a single query in nanoseconds
+     */
+    static double timeQuery(const IRMQAlgorithm& algorithm, Index left, Index right) {
+        auto start = high_resolution_clock::now();
+        volatile Value v = algorithm.query(left, right);  // volatile to prevent optimization
+        auto end = high_resolution_clock::now();
+        (void)v;
+        return duration_cast<duration<double, std::nano>>(end - start).count();
+    }
+    
+    /**
+     * @brief Mean cost of an empty timed interval in nanoseconds
+     */
+    static double measureTimerOverhead() {
+        const size_t SAMPLES = 10000;
+        double total_ns = 0;
+        for (size_t i = 0; i < SAMPLES; ++i) {
+            auto start = high_resolution_clock::now();
+            auto end = high_resolution_clock::now();
+            total_ns += duration_cast<duration<double, std::nano>>(end - start).count();
+        }
+        return total_ns / SAMPLES;
+    }
+    
+    /**
+     * @brief Touch every cache line of a buffer to evict other data
+     */
+    static void sweepCache(std::vector<unsigned char>& buffer) {
+        const size_t CACHE_LINE = 64;
+        unsigned sum = 0;
+        for (size_t i = 0; i < buffer.size(); i += CACHE_LINE) {
+            sum += buffer[i];
+            buffer[i] = static_cast<unsigned char>(sum);  // Dirty lines force write-back, like real traffic
+        }
+        volatile unsigned sink = sum;
+        (void)sink;
+    }
+    
     std::string getPreprocessingComplexity(const std::string& algorithm) {
         if (algorithm.find("Naive") != std::string::npos) return "O(1)";
         if (algorithm.find("Dynamic Programming") != std::string::npos) return "O(n²)";
@@ -302,9 +1663,157 @@ private:
     }
 };
 
-int main() {
+void printUsage(const char* program) {
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  " << program << "                                   Complexity benchmark (default)" << std::endl;
+    std::cout << "  " << program << " --external <elements> <cache_mb> [block_elements]" << std::endl;
+    std::cout << "      Out-of-core RMQ with a resident memory budget of <cache_mb> MB of cached blocks" << std::endl;
+    std::cout << "  " << program << " --cache-modes [evict_mb] [queries]" << std::endl;
+    std::cout << "      Warm vs. cold-cache query cost (default: 32 MB eviction buffer, 200 queries)" << std::endl;
+    std::cout << "  " << program << " --mixed [size] [operations] [budget_ms]" << std::endl;
+    std::cout << "      Mixed read/update workloads (default: 100000 elements, 20000 operations, 500 ms)" << std::endl;
+    std::cout << "  " << program << " --scale [budget_mb] [max_elements]" << std::endl;
+    std::cout << "      Sizes 10^4.. up to max_elements (default 10^9) within a memory budget" << std::endl;
+    std::cout << "      (default: half of physical memory)" << std::endl;
+    std::cout << "  " << program << " --tune-block [size] [profile]" << std::endl;
+    std::cout << "      Measure block sizes for the block decomposition and save the choices" << std::endl;
+    std::cout << "      (default: 1000000 elements, block_profile.txt)" << std::endl;
+    std::cout << "  " << program << " --record <recording> <snapshot> [size] [operations]" << std::endl;
+    std::cout << "      Record a synthetic workload and its array (default: 100000 elements, 50000 operations)" << std::endl;
+    std::cout << "  " << program << " --replay <recording> [snapshot] [max|recorded] [budget_ms]" << std::endl;
+    std::cout << "      Replay a recording against every algorithm (default: the recorded snapshot," << std::endl;
+    std::cout << "      maximum speed, 10000 ms per algorithm)" << std::endl;
+    std::cout << "  " << program << " --adversarial [size] [iterations] [corpus_dir]" << std::endl;
+    std::cout << "      Search for the slowest inputs and queries per algorithm and save them as a corpus" << std::endl;
+    std::cout << "      (default: 100000 elements, 100 mutations, adversarial_corpus)" << std::endl;
+}
+
+/**
+ * @brief Half of physical memory, or 4 GB where it cannot be queried
+ */
+size_t defaultMemoryBudget() {
+#if defined(__unix__) || defined(__APPLE__)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page_size > 0) {
+        return static_cast<size_t>(pages) * static_cast<size_t>(page_size) / 2;
+    }
+#endif
+    return size_t(4) * 1024 * 1024 * 1024;
+}
+
+int main(int argc, char* argv[]) {
     RMQBenchmark benchmark;
     
+    if (argc > 1) {
+        std::string mode = argv[1];
+        
+        if (mode == "--external" && argc >= 4) {
+            size_t elements = std::strtoull(argv[2], nullptr, 10);
+            size_t cache_bytes = std::strtoull(argv[3], nullptr, 10) * 1024 * 1024;
+            size_t block_elements = argc >= 5 ? std::strtoull(argv[4], nullptr, 10) : 0;
+            if (elements == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runExternalBenchmark(elements, cache_bytes, block_elements);
+            return 0;
+        }
+        
+        if (mode == "--cache-modes") {
+            size_t evict_mb = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 32;
+            size_t queries = argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 200;
+            if (evict_mb == 0 || queries == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runCacheModeBenchmark(evict_mb * 1024 * 1024, queries);
+            return 0;
+        }
+        
+        if (mode == "--mixed") {
+            size_t size = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+            size_t operations = argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 20000;
+            double budget_ms = argc >= 5 ? std::strtod(argv[4], nullptr) : 500.0;
+            if (size == 0 || operations == 0 || budget_ms <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runMixedBenchmark(size, operations, budget_ms);
+            return 0;
+        }
+        
+        if (mode == "--scale") {
+            size_t budget_bytes = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) * 1024 * 1024 : defaultMemoryBudget();
+            size_t max_elements = argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 1000000000;
+            if (budget_bytes == 0 || max_elements == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runScaleBenchmark(budget_bytes, max_elements);
+            return 0;
+        }
+        
+        if (mode == "--tune-block") {
+            size_t size = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+            std::string profile_path = argc >= 4 ? argv[3] : "block_profile.txt";
+            if (size == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runBlockTuningBenchmark(size, profile_path);
+            return 0;
+        }
+        
+        if (mode == "--record" && argc >= 4) {
+            size_t size = argc >= 5 ? std::strtoull(argv[4], nullptr, 10) : 100000;
+            size_t operations = argc >= 6 ? std::strtoull(argv[5], nullptr, 10) : 50000;
+            if (size == 0 || operations == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            benchmark.runRecordWorkload(argv[2], argv[3], size, operations);
+            return 0;
+        }
+        
+        if (mode == "--replay" && argc >= 3) {
+            std::string snapshot = argc >= 4 ? argv[3] : "";
+            std::string speed = argc >= 5 ? argv[4] : "max";
+            double budget_ms = argc >= 6 ? std::strtod(argv[5], nullptr) : 10000.0;
+            if ((speed != "max" && speed != "recorded") || budget_ms <= 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            try {
+                benchmark.runReplayBenchmark(argv[2], snapshot, speed == "recorded", budget_ms);
+            } catch (const RMQException& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        
+        if (mode == "--adversarial") {
+            size_t size = argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+            size_t iterations = argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 100;
+            std::string corpus_dir = argc >= 5 ? argv[4] : "adversarial_corpus";
+            if (size == 0) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            try {
+                benchmark.runAdversarialSearch(size, iterations, corpus_dir);
+            } catch (const RMQException& e) {
+                std::cerr << e.what() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+        
+        printUsage(argv[0]);
+        return mode == "--help" ? 0 : 1;
+    }
+    
     // Run benchmarks
     benchmark.runBenchmarks();
     
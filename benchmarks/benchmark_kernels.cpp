@@ -0,0 +1,578 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+// Kernels are header-only; this is the code the algorithms call
+#include "include/core/rmq_kernels.h"
+#include "include/algorithms/rmq_static.h"
+
+using namespace rmq;
+using namespace std::chrono;
+
+/**
+ * @brief Keep a value alive without storing it to memory
+ *
+ * The empty asm statement claims to read the value and clobber memory, so
+ * the compiler must compute the value and cannot hoist the kernel out of
+ * the timing loop or fold repeated calls on unchanged inputs.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+#else
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    static volatile T sink;
+    sink = value;
+}
+
+inline void clobberMemory() {
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+#endif
+
+/**
+ * @brief Timing of one kernel at one input size
+ */
+struct KernelResult {
+    std::string kernel;
+    size_t size;
+    size_t iterations;        // Kernel calls per repetition (auto-scaled)
+    size_t repetitions;
+    double items_per_op;      // Elements processed per call (1 for a query)
+    double ns_min;            // Per call, fastest repetition
+    double ns_median;         // Per call, median repetition
+    double ns_mean;           // Per call, mean over repetitions
+};
+
+/**
+ * @brief Microbenchmarks for the kernels in rmq_kernels.h
+ */
+class KernelBenchmark {
+private:
+    double min_time_ms_;
+    size_t repetitions_;
+    std::string filter_;
+    std::vector<KernelResult> results_;
+    std::mt19937 gen_;
+    
+    static constexpr size_t QUERY_RING = 4096;  // Precomputed inputs cycled through
+
+public:
+    KernelBenchmark(double min_time_ms, size_t repetitions, const std::string& filter)
+        : min_time_ms_(min_time_ms), repetitions_(repetitions), filter_(filter), gen_(42) {}
+    
+    /**
+     * @brief Run every kernel at every size
+     */
+    void runAll() {
+        for (size_t size : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20}) {
+            auto data = generateData(size);
+            benchScan(data);
+            benchPartialBlockScan(data);
+            benchPackedScan(data);
+            benchSparseTable(data);
+            benchNodeMin(data);
+            benchCartesianTree(data);
+        }
+        
+        benchStaticRMQ<32>();
+        benchStaticRMQ<64>();
+        benchStaticRMQ<256>();
+    }
+    
+    void printTable() const {
+        std::cout << std::left << std::setw(24) << "Kernel"
+                  << std::setw(10) << "Size"
+                  << std::setw(12) << "Iterations"
+                  << std::setw(14) << "Min (ns)"
+                  << std::setw(14) << "Median (ns)"
+                  << std::setw(14) << "Mean (ns)"
+                  << std::setw(12) << "ns/item" << std::endl;
+        std::cout << std::string(100, '-') << std::endl;
+        
+        for (const auto& r : results_) {
+            std::cout << std::left << std::setw(24) << r.kernel
+                      << std::setw(10) << r.size
+                      << std::setw(12) << r.iterations
+                      << std::setw(14) << std::fixed << std::setprecision(2) << r.ns_min
+                      << std::setw(14) << r.ns_median
+                      << std::setw(14) << r.ns_mean
+                      << std::setw(12) << std::setprecision(4) << r.ns_median / r.items_per_op << std::endl;
+        }
+    }
+    
+    void writeCSV(const std::string& path) const {
+        std::ofstream csv(path);
+        csv << "Kernel,Size,Iterations,Repetitions,ItemsPerOp,MinNs,MedianNs,MeanNs,MedianNsPerItem" << std::endl;
+        for (const auto& r : results_) {
+            csv << r.kernel << "," << r.size << "," << r.iterations << "," << r.repetitions << ","
+                << r.items_per_op << "," << r.ns_min << "," << r.ns_median << "," << r.ns_mean << ","
+                << r.ns_median / r.items_per_op << std::endl;
+        }
+    }
+    
+    void writeJSON(std::ostream& out) const {
+        out << "[" << std::endl;
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& r = results_[i];
+            out << "  {\"kernel\": \"" << r.kernel << "\", \"size\": " << r.size
+                << ", \"iterations\": " << r.iterations << ", \"repetitions\": " << r.repetitions
+                << ", \"items_per_op\": " << r.items_per_op
+                << ", \"ns_min\": " << r.ns_min << ", \"ns_median\": " << r.ns_median
+                << ", \"ns_mean\": " << r.ns_mean << "}"
+                << (i + 1 < results_.size() ? "," : "") << std::endl;
+        }
+        out << "]" << std::endl;
+    }
+
+private:
+    std::vector<Value> generateData(size_t size) {
+        std::uniform_int_distribution<> dist(-1000000, 1000000);
+        std::vector<Value> data(size);
+        for (auto& value : data) {
+            value = dist(gen_);
+        }
+        return data;
+    }
+    
+    bool selected(const std::string& kernel) const {
+        return filter_.empty() || kernel.find(filter_) != std::string::npos;
+    }
+    
+    /**
+     * @brief Time body(iterations) with auto-scaled iterations and repetitions
+     *
+     * The iteration count grows until one batch takes at least min_time_ms,
+     * then repetitions_ batches are timed. Clock reads happen once per batch,
+     * never per call.
+     */
+    template <typename Body>
+    void measure(const std::string& kernel, size_t size, double items_per_op, Body&& body) {
+        if (!selected(kernel)) {
+            return;
+        }
+        
+        auto timeBatch = [&](size_t iterations) {
+            clobberMemory();
+            auto start = steady_clock::now();
+            body(iterations);
+            clobberMemory();
+            auto end = steady_clock::now();
+            return duration_cast<duration<double, std::nano>>(end - start).count();
+        };
+        
+        // Calibrate
+        size_t iterations = 1;
+        double target_ns = min_time_ms_ * 1e6;
+        while (true) {
+            double elapsed = timeBatch(iterations);
+            if (elapsed >= target_ns || iterations >= (size_t(1) << 40)) {
+                break;
+            }
+            double scale = elapsed > 0 ? 1.4 * target_ns / elapsed : 10.0;
+            iterations = static_cast<size_t>(iterations * std::min(10.0, std::max(2.0, scale)));
+        }
+        
+        std::vector<double> per_op;
+        for (size_t rep = 0; rep < repetitions_; ++rep) {
+            per_op.push_back(timeBatch(iterations) / iterations);
+        }
+        std::sort(per_op.begin(), per_op.end());
+        
+        KernelResult result;
+        result.kernel = kernel;
+        result.size = size;
+        result.iterations = iterations;
+        result.repetitions = repetitions_;
+        result.items_per_op = items_per_op;
+        result.ns_min = per_op.front();
+        result.ns_median = per_op[per_op.size() / 2];
+        double total = 0;
+        for (double ns : per_op) total += ns;
+        result.ns_mean = total / per_op.size();
+        results_.push_back(result);
+        
+        std::cerr << "  " << std::left << std::setw(24) << kernel << std::setw(10) << size
+                  << std::fixed << std::setprecision(2) << result.ns_median << " ns/op" << std::endl;
+    }
+    
+    /**
+     * @brief Naive full-array scans (RMQNaive::performQuery / findMinimumIndex)
+     */
+    void benchScan(const std::vector<Value>& data) {
+        const Value* values = data.data();
+        Index last = data.size() - 1;
+        
+        measure("scan_min", data.size(), static_cast<double>(data.size()), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                doNotOptimize(kernels::scanMin(values, 0, last));
+            }
+        });
+        
+        measure("scan_min_index", data.size(), static_cast<double>(data.size()), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                doNotOptimize(kernels::scanMinIndex(values, 0, last));
+            }
+        });
+    }
+    
+    /**
+     * @brief Scans of at most one sqrt(n) block (RMQBlockDecomposition partial blocks)
+     */
+    void benchPartialBlockScan(const std::vector<Value>& data) {
+        size_t block = static_cast<size_t>(std::sqrt(data.size())) + 1;
+        std::uniform_int_distribution<size_t> start_dist(0, data.size() - 1);
+        std::uniform_int_distribution<size_t> length_dist(1, block);
+        
+        std::vector<std::pair<Index, Index>> ranges(QUERY_RING);
+        double total_length = 0;
+        for (auto& [left, right] : ranges) {
+            left = start_dist(gen_);
+            right = std::min(data.size() - 1, left + length_dist(gen_) - 1);
+            total_length += right - left + 1;
+        }
+        
+        const Value* values = data.data();
+        measure("partial_block_scan", data.size(), total_length / QUERY_RING, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& range = ranges[it % QUERY_RING];
+                doNotOptimize(kernels::scanMin(values, range.first, range.second));
+            }
+        });
+    }
+    
+    /**
+     * @brief Full scans of bit-packed values (CompressedArray partial blocks)
+     *
+     * The data is reduced to 12 bits, a range a frame-of-reference block
+     * stores at 12/32 of the raw size; compare with scan_min.
+     */
+    void benchPackedScan(const std::vector<Value>& data) {
+        const unsigned width = 12;
+        std::vector<uint32_t> narrow(data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            narrow[i] = static_cast<uint32_t>(data[i]) & ((1u << width) - 1);
+        }
+        std::vector<uint32_t> words(kernels::packedWords(data.size(), width), 0);
+        kernels::packBits(narrow.data(), narrow.size(), width, words.data());
+        
+        measure("packed_scan_min", data.size(), static_cast<double>(data.size()), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                doNotOptimize(kernels::scanMinPacked(words.data(), width, 0, data.size()));
+            }
+        });
+    }
+    
+    /**
+     * @brief Sparse table level build and O(1) lookup (RMQSparseTable)
+     */
+    void benchSparseTable(const std::vector<Value>& data) {
+        size_t n = data.size();
+        size_t levels = 1;
+        while ((size_t(1) << levels) <= n) levels++;
+        
+        std::vector<std::vector<Value>> values(levels);
+        std::vector<std::vector<Index>> indices(levels);
+        size_t entries = 0;
+        for (size_t j = 0; j < levels; ++j) {
+            values[j].resize(n - (size_t(1) << j) + 1);
+            indices[j].resize(values[j].size());
+            entries += values[j].size();
+        }
+        for (Index i = 0; i < n; ++i) {
+            values[0][i] = data[i];
+            indices[0][i] = i;
+        }
+        
+        auto buildLevels = [&]() {
+            for (size_t j = 1; j < levels; ++j) {
+                kernels::buildSparseLevel(values[j - 1].data(), indices[j - 1].data(),
+                                          values[j].size(), size_t(1) << (j - 1),
+                                          values[j].data(), indices[j].data());
+            }
+        };
+        
+        measure("sparse_build", n, static_cast<double>(entries - n), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                buildLevels();
+                doNotOptimize(values.back()[0]);
+            }
+        });
+        
+        buildLevels();
+        
+        struct SparseQuery {
+            Index left;
+            Index right_start;
+            size_t level;
+        };
+        std::vector<SparseQuery> queries(QUERY_RING);
+        std::uniform_int_distribution<size_t> index_dist(0, n - 1);
+        for (auto& query : queries) {
+            size_t left = index_dist(gen_);
+            size_t right = index_dist(gen_);
+            if (left > right) std::swap(left, right);
+            size_t k = 0;
+            while ((size_t(2) << k) <= right - left + 1) k++;
+            query = {left, right - (size_t(1) << k) + 1, k};
+        }
+        
+        measure("sparse_lookup", n, 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& query = queries[it % QUERY_RING];
+                doNotOptimize(kernels::sparseLookup(values[query.level].data(), query.left, query.right_start));
+            }
+        });
+        
+        measure("sparse_argmin", n, 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& query = queries[it % QUERY_RING];
+                doNotOptimize(kernels::sparseLookupIndex(values[query.level].data(), indices[query.level].data(),
+                                                         query.left, query.right_start));
+            }
+        });
+        
+        // The same levels as packed (value, index) keys
+        std::vector<std::vector<kernels::PackedEntry>> packed(levels);
+        for (size_t j = 0; j < levels; ++j) {
+            packed[j].resize(values[j].size());
+        }
+        for (Index i = 0; i < n; ++i) {
+            packed[0][i] = kernels::packEntry(data[i], i);
+        }
+        
+        auto buildPacked = [&]() {
+            for (size_t j = 1; j < levels; ++j) {
+                kernels::buildPackedLevel(packed[j - 1].data(), packed[j].size(), size_t(1) << (j - 1),
+                                          packed[j].data());
+            }
+        };
+        
+        measure("sparse_packed_build", n, static_cast<double>(entries - n), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                buildPacked();
+                doNotOptimize(packed.back()[0]);
+            }
+        });
+        
+        buildPacked();
+        
+        measure("sparse_packed_argmin", n, 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& query = queries[it % QUERY_RING];
+                doNotOptimize(kernels::packedIndex(
+                    kernels::packedLookup(packed[query.level].data(), query.left, query.right_start)));
+            }
+        });
+    }
+    
+    /**
+     * @brief S-tree level build and partial-node minima (RMQSTree)
+     *
+     * node_min masks one 16-key node; node_scan answers the same partial
+     * ranges with scanMin for comparison.
+     */
+    void benchNodeMin(const std::vector<Value>& data) {
+        size_t nodes = data.size() / kernels::NODE_KEYS;
+        std::vector<Value> parents(nodes);
+        
+        measure("node_build", data.size(), static_cast<double>(data.size()), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                kernels::buildNodeLevel(data.data(), nodes, parents.data());
+                doNotOptimize(parents.back());
+            }
+        });
+        
+        struct NodeRange {
+            Index node;
+            Index first;
+            Index last;
+        };
+        std::vector<NodeRange> ranges(QUERY_RING);
+        std::uniform_int_distribution<size_t> node_dist(0, nodes - 1);
+        std::uniform_int_distribution<size_t> key_dist(0, kernels::NODE_KEYS - 1);
+        for (auto& range : ranges) {
+            range.node = node_dist(gen_) * kernels::NODE_KEYS;
+            range.first = key_dist(gen_);
+            range.last = key_dist(gen_);
+            if (range.first > range.last) std::swap(range.first, range.last);
+        }
+        
+        const Value* values = data.data();
+        measure("node_min", data.size(), 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& range = ranges[it % QUERY_RING];
+                doNotOptimize(kernels::minNode(values + range.node, range.first, range.last));
+            }
+        });
+        
+        measure("node_scan", data.size(), 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& range = ranges[it % QUERY_RING];
+                doNotOptimize(kernels::scanMin(values, range.node + range.first, range.node + range.last));
+            }
+        });
+    }
+    
+    /**
+     * @brief Fixed-size StaticRMQ build and query (bitmask up to 64, sparse table above)
+     */
+    template <Size N>
+    void benchStaticRMQ() {
+        std::array<Value, N> values{};
+        std::uniform_int_distribution<Value> value_dist(-1000000, 1000000);
+        for (auto& value : values) {
+            value = value_dist(gen_);
+        }
+        
+        measure("static_build", N, static_cast<double>(N), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                clobberMemory();
+                StaticRMQ<Value, N> rmq(values);
+                doNotOptimize(rmq);
+            }
+        });
+        
+        std::vector<std::pair<Index, Index>> ranges(QUERY_RING);
+        std::uniform_int_distribution<size_t> index_dist(0, N - 1);
+        for (auto& [left, right] : ranges) {
+            left = index_dist(gen_);
+            right = index_dist(gen_);
+            if (left > right) std::swap(left, right);
+        }
+        
+        StaticRMQ<Value, N> rmq(values);
+        measure("static_query", N, 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& range = ranges[it % QUERY_RING];
+                doNotOptimize(rmq.query(range.first, range.second));
+            }
+        });
+    }
+    
+    /**
+     * @brief Cartesian tree build and binary-lifting LCA (RMQLCABased)
+     */
+    void benchCartesianTree(const std::vector<Value>& data) {
+        size_t n = data.size();
+        std::vector<kernels::CartesianNode> fresh(n);
+        for (Index i = 0; i < n; ++i) {
+            fresh[i].value = data[i];
+            fresh[i].array_index = i;
+        }
+        
+        std::vector<kernels::CartesianNode> nodes(n);
+        std::vector<int> stack;
+        stack.reserve(64);
+        
+        // Includes resetting the nodes, which the algorithm also pays
+        measure("cartesian_build", n, static_cast<double>(n), [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                std::copy(fresh.begin(), fresh.end(), nodes.begin());
+                doNotOptimize(kernels::buildCartesianTree(nodes.data(), n, stack));
+            }
+        });
+        
+        std::copy(fresh.begin(), fresh.end(), nodes.begin());
+        int root = kernels::buildCartesianTree(nodes.data(), n, stack);
+        kernels::computeDepths(nodes.data(), root, stack);
+        
+        size_t levels = 1;
+        while ((size_t(1) << (levels - 1)) < n) levels++;
+        std::vector<std::vector<int>> up(levels, std::vector<int>(n, -1));
+        for (Index i = 0; i < n; ++i) {
+            up[0][i] = nodes[i].parent;
+        }
+        for (size_t j = 1; j < levels; ++j) {
+            for (Index i = 0; i < n; ++i) {
+                if (up[j - 1][i] != -1) {
+                    up[j][i] = up[j - 1][up[j - 1][i]];
+                }
+            }
+        }
+        
+        std::vector<std::pair<int, int>> pairs(QUERY_RING);
+        std::uniform_int_distribution<int> node_dist(0, static_cast<int>(n) - 1);
+        for (auto& pair : pairs) {
+            pair = {node_dist(gen_), node_dist(gen_)};
+        }
+        
+        measure("lca_lifting", n, 1.0, [&](size_t iterations) {
+            for (size_t it = 0; it < iterations; ++it) {
+                const auto& pair = pairs[it % QUERY_RING];
+                doNotOptimize(kernels::liftLCA(nodes.data(), up, pair.first, pair.second));
+            }
+        });
+    }
+};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [--filter <substring>] [--min-time-ms <ms>] [--repetitions <n>] [--json]" << std::endl;
+    std::cout << "  --filter       Only run kernels whose name contains <substring>" << std::endl;
+    std::cout << "  --min-time-ms  Minimum duration of one timed batch (default 50)" << std::endl;
+    std::cout << "  --repetitions  Timed batches per kernel and size (default 7)" << std::endl;
+    std::cout << "  --json         Print results as JSON instead of a table" << std::endl;
+    std::cout << "Results are always written to benchmark_kernels.csv." << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    double min_time_ms = 50.0;
+    size_t repetitions = 7;
+    bool json = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time-ms" && i + 1 < argc) {
+            min_time_ms = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--json") {
+            json = true;
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    
+    if (min_time_ms <= 0 || repetitions == 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    // Progress goes to stderr so stdout stays machine-readable with --json
+    std::cerr << "Running RMQ kernel microbenchmarks (" << repetitions << " x >= "
+              << min_time_ms << " ms batches)..." << std::endl;
+    
+    KernelBenchmark benchmark(min_time_ms, repetitions, filter);
+    benchmark.runAll();
+    benchmark.writeCSV("benchmark_kernels.csv");
+    
+    if (json) {
+        benchmark.writeJSON(std::cout);
+    } else {
+        std::cout << std::endl;
+        benchmark.printTable();
+        std::cout << std::endl << "Results written to benchmark_kernels.csv" << std::endl;
+    }
+    
+    return 0;
+}
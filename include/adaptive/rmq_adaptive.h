@@ -0,0 +1,219 @@
+#ifndef RMQ_ADAPTIVE_RMQ_ADAPTIVE_H
+#define RMQ_ADAPTIVE_RMQ_ADAPTIVE_H
+
+#include "../core/rmq_base.h"
+#include "../core/rmq_workload.h"
+#include <future>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Settings for AdaptiveRMQ
+ */
+struct AdaptiveConfig {
+    Size window_operations = 4096;      ///< Operations per evaluation window
+    double switch_margin = 1.5;         ///< Candidate must be this many times cheaper
+    Size payback_windows = 4;           ///< Build cost must be recovered within this many windows
+    Size latency_sample_interval = 16;  ///< Time every Nth operation
+    bool background = true;             ///< Build replacements on a background thread
+    AlgorithmConfig algorithm_config;   ///< Configuration for every algorithm built
+    
+    AdaptiveConfig() = default;
+    
+    AdaptiveConfig& withWindow(Size operations) {
+        window_operations = operations;
+        return *this;
+    }
+    
+    AdaptiveConfig& withSwitchMargin(double margin) {
+        switch_margin = margin;
+        return *this;
+    }
+    
+    AdaptiveConfig& withPaybackWindows(Size windows) {
+        payback_windows = windows;
+        return *this;
+    }
+    
+    AdaptiveConfig& withBackground(bool enable) {
+        background = enable;
+        return *this;
+    }
+    
+    AdaptiveConfig& withAlgorithmConfig(const AlgorithmConfig& config) {
+        algorithm_config = config;
+        return *this;
+    }
+};
+
+/**
+ * @brief Counters reported by AdaptiveRMQ
+ */
+struct AdaptiveStats {
+    Size windows = 0;                ///< Evaluation windows completed
+    Size migrations = 0;             ///< Replacements swapped in
+    Size failed_migrations = 0;      ///< Replacements whose build threw
+    Size rebuilds = 0;               ///< Rebuilds of a static algorithm after updates
+    double mean_latency_ns = 0.0;    ///< Sampled mean latency of the last window
+    double ns_per_cost_unit = 0.0;   ///< Measured ns per modelled cost unit of the current algorithm
+    WorkloadStats last_window;       ///< Workload observed in the last window
+};
+
+/**
+ * @brief RMQ wrapper that switches algorithm as the workload drifts
+ *
+ * Every window of operations the observed read/write mix and range lengths
+ * are fed to a cost model, which counts element touches. The model is
+ * calibrated by measurement: the current algorithm's cost is its sampled
+ * latency times the window's operations plus the time spent rebuilding,
+ * and dividing by its modelled cost gives its ns per cost unit. A
+ * candidate's modelled cost is converted with its own ns per unit from
+ * the last time it served, or with the current algorithm's if it has not
+ * served yet. So an algorithm that runs slower than its model (cache
+ * misses on a deep tree, say) is left sooner and not chosen again lightly.
+ *
+ * When a candidate is predicted to be cheaper than the measured cost by
+ * switch_margin, and its build pays for itself within payback_windows, it
+ * is built from a snapshot of the data (on a background thread by
+ * default). The current algorithm keeps serving until
+ * the replacement is ready; updates made meanwhile are replayed onto it and
+ * the two are swapped between operations.
+ *
+ * Algorithms without update support absorb updates by rebuilding before the
+ * next query. The wrapper is used from a single thread, like DurableRMQ;
+ * the background build is its only concurrency.
+ */
+class AdaptiveRMQ {
+private:
+    AdaptiveConfig config_;
+    std::vector<Value> data_;                    ///< Master copy, always current
+    std::shared_ptr<IRMQAlgorithm> current_;     ///< Algorithm serving operations
+    bool dirty_;                                 ///< current_ is static and behind data_
+    
+    // Migration in flight
+    std::future<RMQAlgorithmPtr> pending_build_;
+    std::vector<std::pair<Index, Value>> pending_updates_;  ///< Updates since the snapshot
+    
+    // Monitoring
+    WorkloadStats window_;
+    Size window_ops_;
+    double sampled_ns_;
+    Size sampled_ops_;
+    double rebuild_ns_;                          ///< Time rebuilding static algorithms this window
+    std::map<AlgorithmType, double> ns_per_unit_;  ///< Calibration of every algorithm that served
+    AdaptiveStats stats_;
+    
+    /**
+     * @brief Measured ns per cost unit of type, else of the current algorithm, else 1
+     */
+    double nsPerUnit(AlgorithmType type) const;
+    
+    /**
+     * @brief Algorithms the cost model considers for n elements
+     */
+    static std::vector<AlgorithmType> candidatesFor(Size n);
+    
+    void pollMigration(bool wait);
+    void startMigration(AlgorithmType type);
+    void endWindow();
+    void recordLatency(double ns);
+
+public:
+    /**
+     * @brief Constructor
+     * @param initial Algorithm to start with
+     * @param config Adaptation settings
+     */
+    explicit AdaptiveRMQ(AlgorithmType initial = AlgorithmType::BLOCK_DECOMPOSITION,
+                         const AdaptiveConfig& config = AdaptiveConfig());
+    
+    /**
+     * @brief Destructor - waits for an in-flight build
+     */
+    ~AdaptiveRMQ();
+    
+    AdaptiveRMQ(const AdaptiveRMQ&) = delete;
+    AdaptiveRMQ& operator=(const AdaptiveRMQ&) = delete;
+    
+    /**
+     * @brief Build the current algorithm over data
+     */
+    void preprocess(const std::vector<Value>& data);
+    
+    /**
+     * @brief Range minimum of [left, right]
+     *
+     * Non-const: records the query and may swap in a finished replacement or
+     * rebuild a static algorithm after updates.
+     */
+    Value query(Index left, Index right);
+    
+    /**
+     * @brief Set data[index] = value
+     * @throws BoundsException if index is out of range
+     */
+    void update(Index index, Value value);
+    
+    /**
+     * @brief Apply several updates
+     * @throws BoundsException if any index is out of range (nothing applied)
+     */
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates);
+    
+    /**
+     * @brief Block until an in-flight replacement is built and swapped in
+     */
+    void waitForMigration();
+    
+    /**
+     * @brief Whether a replacement is being built
+     */
+    bool migrationInProgress() const {
+        return pending_build_.valid();
+    }
+    
+    /**
+     * @brief Type of the algorithm currently serving operations
+     */
+    AlgorithmType currentType() const;
+    
+    /**
+     * @brief Number of elements
+     */
+    Size size() const {
+        return data_.size();
+    }
+    
+    /**
+     * @brief Adaptation counters
+     */
+    const AdaptiveStats& stats() const {
+        return stats_;
+    }
+    
+    /**
+     * @brief Modelled cost of serving a window (in element touches)
+     * @param type Candidate algorithm
+     * @param window Observed operations
+     * @param n Array size
+     */
+    static double estimateWindowCost(AlgorithmType type, const WorkloadStats& window, Size n);
+    
+    /**
+     * @brief Modelled cost of building type over n elements (same units)
+     */
+    static double estimateBuildCost(AlgorithmType type, Size n);
+    
+    /**
+     * @brief Cheapest algorithm for a window under the uncalibrated cost model
+     */
+    static AlgorithmType cheapestFor(const WorkloadStats& window, Size n);
+};
+
+} // namespace rmq
+
+#endif // RMQ_ADAPTIVE_RMQ_ADAPTIVE_H
@@ -0,0 +1,207 @@
+#ifndef RMQ_ADAPTIVE_RMQ_OVERLAY_H
+#define RMQ_ADAPTIVE_RMQ_OVERLAY_H
+
+#include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Settings for OverlayRMQ
+ */
+struct OverlayConfig {
+    Size merge_threshold = 0;           ///< Overlay entries that start a merge (0: sqrt(n), at least 64)
+    bool background = true;             ///< Build the merged index on a background thread
+    AlgorithmConfig algorithm_config;   ///< Configuration for the static index
+    
+    OverlayConfig() = default;
+    
+    OverlayConfig& withMergeThreshold(Size entries) {
+        merge_threshold = entries;
+        return *this;
+    }
+    
+    OverlayConfig& withBackground(bool enable) {
+        background = enable;
+        return *this;
+    }
+    
+    OverlayConfig& withAlgorithmConfig(const AlgorithmConfig& config) {
+        algorithm_config = config;
+        return *this;
+    }
+};
+
+/**
+ * @brief Counters reported by OverlayRMQ
+ */
+struct OverlayStats {
+    Size merges = 0;             ///< Merged indexes swapped in
+    Size failed_merges = 0;      ///< Merges whose build threw
+    Size repair_probes = 0;      ///< Extra static queries around overwritten minima
+};
+
+/**
+ * @brief Point updates on a static algorithm through a small sorted overlay
+ *
+ * The static index (sparse table by default) is built once and never
+ * updated. Each update goes into an overlay sorted by position, holding
+ * the new value as a packed (value, index) entry, so the overlay minimum
+ * of a range is a binary search and one kernels::scanMinEntry().
+ *
+ * A query takes the smaller of the overlay minimum and the static
+ * minimum. If the static minimum sits at an overwritten position whose
+ * value went up, the range is split around it and both sides are asked
+ * again; a side whose static minimum cannot beat the best so far is
+ * dropped, so a decrease never costs an extra query. Ties resolve to the
+ * leftmost minimum, as everywhere else.
+ *
+ * Once the overlay reaches merge_threshold entries a fresh static index is
+ * built from a snapshot of the data (on a background thread by default).
+ * The old index and the overlay keep serving until it is ready; the
+ * overlay then restarts with the updates made during the build.
+ *
+ * The wrapper is used from a single thread, like AdaptiveRMQ; the
+ * background build is its only concurrency.
+ *
+ * @complexity
+ * - Update: O(k) for k overlay entries (insertion into a sorted vector)
+ * - Query: one static query plus O(log k + overlay entries in range),
+ *   plus two static queries per overwritten minimum that went up
+ * - Merge: one static build, off the query path
+ */
+class OverlayRMQ {
+private:
+    OverlayConfig config_;
+    AlgorithmType base_type_;
+    std::vector<Value> data_;                    ///< Master copy, always current
+    std::shared_ptr<IRMQAlgorithm> base_;        ///< Static index over an older snapshot
+    Size threshold_;                             ///< Resolved merge_threshold
+    
+    /**
+     * @brief Overwritten positions (sorted) and their packed (value, index) entries
+     */
+    std::vector<Index> overlay_index_;
+    std::vector<kernels::PackedEntry> overlay_entries_;
+    
+    // Merge in flight
+    std::future<RMQAlgorithmPtr> pending_build_;
+    std::vector<std::pair<Index, Value>> pending_updates_;  ///< Updates since the snapshot
+    
+    std::vector<std::pair<Index, Index>> ranges_;  ///< Scratch for query()
+    OverlayStats stats_;
+    
+    void ensurePreprocessed() const;
+    void validateQuery(Index left, Index right) const;
+    void insertOverlay(Index index, Value value);
+    bool overwritten(Index index) const;
+    kernels::PackedEntry minimumEntry(Index left, Index right);
+    void startMerge();
+    void pollMerge(bool wait);
+
+public:
+    /**
+     * @brief Constructor
+     * @param base Static algorithm to build (see RMQFactory::create)
+     * @param config Overlay settings
+     */
+    explicit OverlayRMQ(AlgorithmType base = AlgorithmType::SPARSE_TABLE,
+                        const OverlayConfig& config = OverlayConfig());
+    
+    /**
+     * @brief Destructor - waits for an in-flight merge
+     */
+    ~OverlayRMQ();
+    
+    OverlayRMQ(const OverlayRMQ&) = delete;
+    OverlayRMQ& operator=(const OverlayRMQ&) = delete;
+    
+    /**
+     * @brief Build the static index over data and empty the overlay
+     * @throws InvalidDataException if data holds more than 2^32 elements
+     */
+    void preprocess(const std::vector<Value>& data);
+    
+    /**
+     * @brief Range minimum of [left, right]
+     *
+     * Non-const: may swap in a finished merge.
+     * @throws InvalidQueryException if left > right
+     * @throws BoundsException if right is out of range
+     */
+    Value query(Index left, Index right);
+    
+    /**
+     * @brief Leftmost position of the range minimum of [left, right]
+     * @throws InvalidQueryException if left > right
+     * @throws BoundsException if right is out of range
+     */
+    Index queryIndex(Index left, Index right);
+    
+    /**
+     * @brief Set data[index] = value
+     * @throws BoundsException if index is out of range
+     */
+    void update(Index index, Value value);
+    
+    /**
+     * @brief Apply several updates
+     * @throws BoundsException if any index is out of range (nothing applied)
+     */
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates);
+    
+    /**
+     * @brief Block until an in-flight merge is built and swapped in
+     */
+    void waitForMerge();
+    
+    /**
+     * @brief Whether a merge is being built
+     */
+    bool mergeInProgress() const {
+        return pending_build_.valid();
+    }
+    
+    /**
+     * @brief Positions currently answered from the overlay
+     */
+    Size overlaySize() const {
+        return overlay_index_.size();
+    }
+    
+    /**
+     * @brief Overlay entries that start a merge
+     */
+    Size mergeThreshold() const {
+        return threshold_;
+    }
+    
+    /**
+     * @brief Type of the static index
+     */
+    AlgorithmType baseType() const {
+        return base_type_;
+    }
+    
+    /**
+     * @brief Number of elements
+     */
+    Size size() const {
+        return data_.size();
+    }
+    
+    /**
+     * @brief Merge and repair counters
+     */
+    const OverlayStats& stats() const {
+        return stats_;
+    }
+};
+
+} // namespace rmq
+
+#endif // RMQ_ADAPTIVE_RMQ_OVERLAY_H
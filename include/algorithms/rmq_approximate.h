@@ -0,0 +1,145 @@
+#ifndef RMQ_ALGORITHMS_RMQ_APPROXIMATE_H
+#define RMQ_ALGORITHMS_RMQ_APPROXIMATE_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Settings for RMQApproximate
+ */
+struct ApproximateConfig {
+    Size max_buckets = 1024;     ///< Memory budget: at most this many buckets
+    Size max_range_error = 0;    ///< If set, elements a range may be off by at each end (overrides max_buckets)
+    
+    ApproximateConfig() = default;
+    
+    ApproximateConfig& withMaxBuckets(Size buckets) {
+        max_buckets = buckets;
+        return *this;
+    }
+    
+    ApproximateConfig& withMaxRangeError(Size elements) {
+        max_range_error = elements;
+        return *this;
+    }
+};
+
+/**
+ * @brief Answer of RMQApproximate::query()
+ *
+ * value is the exact minimum of [covered_left, covered_right], the query
+ * range widened to bucket boundaries, so it never exceeds the true minimum.
+ * The true minimum of the query range lies in [value, upper_bound].
+ */
+struct ApproximateMinimum {
+    Value value;            ///< Minimum of the covering range (a lower bound)
+    Value upper_bound;      ///< The true minimum is at most this
+    Index covered_left;     ///< Start of the covering range (<= left)
+    Index covered_right;    ///< End of the covering range (>= right)
+    
+    /**
+     * @brief Largest possible difference to the true minimum
+     */
+    int64_t valueError() const {
+        return static_cast<int64_t>(upper_bound) - value;
+    }
+    
+    /**
+     * @brief Whether value is the true minimum
+     */
+    bool exact() const {
+        return value == upper_bound;
+    }
+};
+
+/**
+ * @brief Range minimum with bounded error in a fixed amount of memory
+ *
+ * The array is cut into equal buckets and only the minimum and maximum of
+ * each bucket are kept; the data itself is not. Memory is 8 bytes per
+ * bucket, set by max_buckets whatever the length of the series, so
+ * thousands of long series can stay resident.
+ *
+ * A query reads the buckets the range touches:
+ * - value: the smallest bucket minimum, i.e. the exact minimum of the range
+ *   widened to bucket boundaries (less than one bucket at each end);
+ * - upper_bound: the smallest minimum of a bucket inside the range, or the
+ *   smallest maximum of a partly covered one, whichever is lower (every
+ *   bucket touched holds some element of the range).
+ *
+ * The bounds are hard, not probabilistic. A range aligned to buckets is
+ * exact, and on smooth series the spread within a bucket is small.
+ *
+ * @code
+ * RMQApproximate rmq(series, ApproximateConfig().withMaxBuckets(256));
+ * ApproximateMinimum result = rmq.query(1000, 50000);
+ * result.value;         // <= true minimum
+ * result.valueError();  // true minimum - value is at most this
+ * @endcode
+ *
+ * @complexity
+ * - Build: O(n)
+ * - Query: O(buckets touched), a vectorized scan
+ * - Space: O(max_buckets), independent of n
+ */
+class RMQApproximate {
+private:
+    static constexpr const char* ALGORITHM_NAME = "Approximate Bucket Minima";
+    
+    Size size_;
+    Size bucket_width_;
+    std::vector<Value> bucket_min_;
+    std::vector<Value> bucket_max_;
+
+public:
+    /**
+     * @brief Build the buckets over data
+     * @throws InvalidDataException if data is empty
+     * @throws ConfigurationException if neither max_buckets nor max_range_error is set
+     */
+    explicit RMQApproximate(const std::vector<Value>& data,
+                            const ApproximateConfig& config = ApproximateConfig());
+    
+    /**
+     * @brief Approximate minimum of [left, right] and its error bounds
+     * @throws InvalidQueryException if left > right
+     * @throws BoundsException if right is out of range
+     */
+    ApproximateMinimum query(Index left, Index right) const;
+    
+    std::string getName() const {
+        return ALGORITHM_NAME;
+    }
+    
+    /**
+     * @brief Number of elements summarized
+     */
+    Size size() const {
+        return size_;
+    }
+    
+    /**
+     * @brief Elements per bucket (the last one may be shorter)
+     */
+    Size getBucketWidth() const {
+        return bucket_width_;
+    }
+    
+    Size getBucketCount() const {
+        return bucket_min_.size();
+    }
+    
+    /**
+     * @brief Bytes held: two values per bucket
+     */
+    size_t getMemoryUsage() const;
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_APPROXIMATE_H
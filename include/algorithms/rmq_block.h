@@ -2,6 +2,8 @@
 #define RMQ_ALGORITHMS_RMQ_BLOCK_H
 
 #include "../core/rmq_base.h"
+#include "../core/rmq_compressed.h"
+#include "../core/rmq_kernels.h"
 #include <vector>
 #include <cmath>
 
@@ -21,6 +23,15 @@ namespace rmq {
  * - Total Space: O(n + √n)
  * 
  * @note This provides a good balance between query time and update time
+ *
+ * With AlgorithmConfig::compress_data the array is held as a
+ * CompressedArray whose blocks are the decomposition blocks: the block
+ * minima are its uncompressed minima, and partial blocks are decoded on
+ * the fly. data_ is released after preprocessing.
+ *
+ * With AlgorithmConfig::packed_entries each block minimum and its index
+ * are one 64-bit key (kernels::packEntry), so the middle blocks of a
+ * query are a single unsigned min scan that yields the leftmost argmin.
  */
 class RMQBlockDecomposition final : public RMQBase {
 private:
@@ -47,6 +58,35 @@ private:
      */
     std::vector<Index> block_min_index_;
     
+    /**
+     * @brief Packed (minimum, index) key of each block; replaces block_min_
+     * and block_min_index_ with packed_entries
+     */
+    std::vector<kernels::PackedEntry> packed_block_min_;
+    
+    /**
+     * @brief Compressed data and block minima (compress_data only)
+     */
+    CompressedArray compressed_;
+    
+    bool isCompressed() const {
+        return !compressed_.empty();
+    }
+    
+    bool isPacked() const {
+        return !packed_block_min_.empty();
+    }
+    
+    /**
+     * @brief Replace block_min_ and block_min_index_ with packed_block_min_
+     */
+    void packBlockMinima();
+    
+    /**
+     * @brief Replace data_ and the block minima with compressed_
+     */
+    void compressData();
+    
     /**
      * @brief Calculate optimal block size
      */
@@ -71,7 +111,7 @@ private:
      */
     Index getBlockEnd(size_t block) const {
         Index end = (block + 1) * block_size_ - 1;
-        return std::min(end, static_cast<Index>(data_.size() - 1));
+        return std::min(end, static_cast<Index>(size_ - 1));
     }
     
     /**
@@ -127,6 +167,20 @@ protected:
      */
     Index findMinimumIndex(Index left, Index right) const override;
     
+    /**
+     * @brief Write block size and block minima to a binary index
+     */
+    void saveStructure(std::ostream& out) const override;
+    
+    /**
+     * @brief Restore block size and minima, checking each against its block
+     */
+    void loadStructure(std::istream& in) override;
+    
+    Value valueAt(Index index) const override;
+    
+    std::vector<Value> copyData() const override;
+    
 public:
     /**
      * @brief Default constructor
@@ -181,7 +235,7 @@ public:
      * @throws BoundsException if index is out of bounds
      * @throws NotPreprocessedException if not preprocessed
      */
-    void update(Index index, Value value);
+    void update(Index index, Value value) override;
     
     /**
      * @brief Batch update multiple elements
@@ -189,7 +243,7 @@ public:
      * @throws BoundsException if any index is out of bounds
      * @throws NotPreprocessedException if not preprocessed
      */
-    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates);
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates) override;
     
     /**
      * @brief Clear all preprocessed data
@@ -210,6 +264,12 @@ public:
         return block_size_;
     }
     
+    /**
+     * @brief Block size chosen for n elements when none is configured
+     * @return sqrt(n) + 1
+     */
+    static size_t defaultBlockSize(size_t n);
+    
     /**
      * @brief Get number of blocks
      * @return Total number of blocks
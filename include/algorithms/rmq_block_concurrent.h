@@ -0,0 +1,196 @@
+#ifndef RMQ_ALGORITHMS_RMQ_BLOCK_CONCURRENT_H
+#define RMQ_ALGORITHMS_RMQ_BLOCK_CONCURRENT_H
+
+#include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace rmq {
+
+/**
+ * @brief Block decomposition that accepts point updates from many threads
+ *
+ * Same layout and complexity as RMQBlockDecomposition, but array elements
+ * and block minima are accessed atomically:
+ * - Each block minimum is one 64-bit key (value, offset in block), so
+ *   readers load it in one step and ties order to the leftmost offset.
+ * - Elements are written with an atomic exchange, so every writer learns
+ *   the value it replaced.
+ * - Decreases lower the key with an atomic-min CAS and never lock, unless
+ *   another writer replaced the element meanwhile; then they repair.
+ * - Increases repair: they take a per-block spin lock (other blocks are
+ *   unaffected) and, if the element was the block minimum, clear the key
+ *   while the block is rescanned. Readers that see a cleared key scan the
+ *   block themselves.
+ *
+ * Queries never block. A query running concurrently with updates returns
+ * the minimum of some mix of old and new values; once updates stop, every
+ * query is exact. Detailed queries take the value and index from one key.
+ *
+ * @note Any threads may update any indices, including the same ones.
+ * preprocess(), saveIndex() and clear() require that no updates are in
+ * flight. getLastQueryTime() reports whichever query finished last.
+ */
+class RMQConcurrentBlockDecomposition final : public RMQBase {
+private:
+    static constexpr const char* ALGORITHM_NAME = "Block Decomposition (Concurrent)";
+    static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::BLOCK_DECOMPOSITION;
+    
+    /**
+     * @brief Key of a block with no published minimum (being rescanned)
+     */
+    static constexpr uint64_t EMPTY_KEY = ~uint64_t(0);
+    
+    size_t block_size_;
+    size_t num_blocks_;
+    
+    /**
+     * @brief Minimum key of each block (see encodeKey)
+     */
+    std::unique_ptr<std::atomic<uint64_t>[]> block_key_;
+    
+    /**
+     * @brief Per-block lock taken by increases
+     */
+    std::unique_ptr<std::atomic<bool>[]> block_lock_;
+    
+    /**
+     * @brief data_ viewed as atomics (std::atomic_ref before C++20)
+     */
+    std::atomic<Value>* values() const {
+        return reinterpret_cast<std::atomic<Value>*>(const_cast<Value*>(data_.data()));
+    }
+    
+    /**
+     * @brief Order-preserving key: value in the high half, offset in the low
+     */
+    static uint64_t encodeKey(Value value, size_t offset) {
+        return kernels::packEntry(value, offset);
+    }
+    
+    static Value keyValue(uint64_t key) {
+        return kernels::packedValue(key);
+    }
+    
+    static size_t keyOffset(uint64_t key) {
+        return kernels::packedIndex(key);
+    }
+    
+    /**
+     * @brief Lower target to key unless it is already smaller
+     */
+    static void atomicMin(std::atomic<uint64_t>& target, uint64_t key);
+    
+    size_t getBlockNumber(Index idx) const {
+        return idx / block_size_;
+    }
+    
+    Index getBlockStart(size_t block) const {
+        return block * block_size_;
+    }
+    
+    Index getBlockEnd(size_t block) const {
+        Index end = (block + 1) * block_size_ - 1;
+        return std::min(end, static_cast<Index>(data_.size() - 1));
+    }
+    
+    size_t calculateBlockSize(size_t n) const;
+    
+    /**
+     * @brief Minimum key of [left, right] within one block, from the elements
+     */
+    uint64_t scanKey(size_t block, Index left, Index right) const;
+    
+    /**
+     * @brief Minimum key of a whole block (published key, or a scan if cleared)
+     */
+    uint64_t blockKey(size_t block) const;
+    
+    /**
+     * @brief Minimum key of [left, right], as (block, key)
+     */
+    std::pair<size_t, uint64_t> rangeKey(Index left, Index right) const;
+    
+    void lockBlock(size_t block);
+    void unlockBlock(size_t block);
+    
+    /**
+     * @brief Rescan a block if its key points at offset (under the block lock)
+     */
+    void repairBlock(size_t block, size_t offset);
+    
+    void clearBlocks();
+
+protected:
+    void performPreprocess() override;
+    
+    Value performQuery(Index left, Index right) const override;
+    
+    Index findMinimumIndex(Index left, Index right) const override;
+    
+    std::pair<Value, Index> findMinimum(Index left, Index right) const override;
+    
+    Value valueAt(Index index) const override {
+        return values()[index].load(std::memory_order_acquire);
+    }
+    
+    std::vector<Value> copyData() const override;
+
+public:
+    RMQConcurrentBlockDecomposition();
+    
+    explicit RMQConcurrentBlockDecomposition(const AlgorithmConfig& config);
+    
+    ~RMQConcurrentBlockDecomposition() override;
+    
+    std::string getName() const override {
+        return ALGORITHM_NAME;
+    }
+    
+    AlgorithmType getType() const override {
+        return ALGORITHM_TYPE;
+    }
+    
+    ComplexityInfo getComplexity() const override;
+    
+    bool supportsUpdate() const override {
+        return true;
+    }
+    
+    /**
+     * @brief Update a single element; safe to call from many threads
+     * @throws BoundsException if index is out of bounds
+     * @throws NotPreprocessedException if not preprocessed
+     */
+    void update(Index index, Value value) override;
+    
+    /**
+     * @brief Apply updates one by one; safe to call from many threads
+     * @throws BoundsException if any index is out of bounds (nothing applied)
+     * @throws NotPreprocessedException if not preprocessed
+     */
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates) override;
+    
+    void clear() override;
+    
+    /**
+     * @brief Get memory usage in bytes
+     */
+    size_t getMemoryUsage() const;
+    
+    size_t getBlockSize() const {
+        return block_size_;
+    }
+    
+    size_t getNumBlocks() const {
+        return num_blocks_;
+    }
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_BLOCK_CONCURRENT_H
@@ -0,0 +1,152 @@
+#ifndef RMQ_ALGORITHMS_RMQ_BLOCK_TUNER_H
+#define RMQ_ALGORITHMS_RMQ_BLOCK_TUNER_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include "../core/rmq_workload.h"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Measured cost of one candidate block size
+ */
+struct BlockSizeTrial {
+    Size block_size;
+    double ns_per_query;
+};
+
+/**
+ * @brief Result of BlockSizeTuner::tune()
+ */
+struct BlockSizeTuning {
+    Size block_size = 0;                  ///< Fastest block size (feed to AlgorithmConfig::withBlockSize)
+    double ns_per_query = 0.0;            ///< Its measured cost
+    double default_ns_per_query = 0.0;    ///< Cost of the default sqrt(n) + 1, one of the trials (0 if not measured)
+    bool from_profile = false;            ///< Taken from a BlockSizeProfile, nothing measured
+    std::vector<BlockSizeTrial> trials;   ///< Every candidate measured, in increasing size
+};
+
+/**
+ * @brief Tuned block sizes keyed by (array size, workload) profile
+ *
+ * A profile is the power-of-two bucket of n and of the mean query length
+ * (WorkloadStats::lengthBucket), so arrays and workloads of similar shape
+ * share one measurement.
+ *
+ * Saved as text: a "rmq-block-profile 1" header, then one
+ * "n_bucket length_bucket block_size" line per profile.
+ */
+class BlockSizeProfile {
+private:
+    static constexpr const char* HEADER = "rmq-block-profile";
+    static constexpr int VERSION = 1;
+    
+    using Key = std::pair<size_t, size_t>;
+    std::map<Key, Size> block_sizes_;
+    
+    static Key keyOf(Size n, const WorkloadStats& workload);
+
+public:
+    /**
+     * @brief Tuned block size for this profile, or 0 if none is recorded
+     */
+    Size lookup(Size n, const WorkloadStats& workload) const;
+    
+    /**
+     * @brief Record (or replace) the block size for this profile
+     */
+    void record(Size n, const WorkloadStats& workload, Size block_size);
+    
+    /**
+     * @brief Number of profiles recorded
+     */
+    Size size() const {
+        return block_sizes_.size();
+    }
+    
+    /**
+     * @brief Write all profiles to path
+     * @throws AlgorithmException if the file cannot be written
+     */
+    void save(const std::string& path) const;
+    
+    /**
+     * @brief Read profiles from path; a missing file gives an empty profile
+     * @throws InvalidDataException if the file is malformed
+     */
+    static BlockSizeProfile load(const std::string& path);
+};
+
+/**
+ * @brief Pick the block size of RMQBlockDecomposition by measurement
+ *
+ * The default block size, sqrt(n) + 1, balances the partial-block scans
+ * against the scan over block minima in an operation count model. On real
+ * hardware the balance is off: partial blocks are vectorized scans over
+ * contiguous memory, and a block that starts on a cache line boundary
+ * wastes no line. tune() builds the structure for each candidate, a
+ * multiple of the cache line (16 values), runs a sample of the expected
+ * queries against it, and keeps the fastest. The default size competes as
+ * one more candidate, so the result is never slower than the default.
+ *
+ * Tuning needs queries, which preprocess() does not have, so it is a
+ * separate step whose result goes into the configuration:
+ *
+ * @code
+ * BlockSizeProfile profile = BlockSizeProfile::load("block_profile.txt");
+ * BlockSizeTuning tuning = BlockSizeTuner::tune(data, sample, profile);
+ * profile.save("block_profile.txt");
+ * auto rmq = RMQFactory::create(AlgorithmType::BLOCK_DECOMPOSITION,
+ *                               AlgorithmConfig().withBlockSize(tuning.block_size));
+ * @endcode
+ *
+ * Timings are wall clock and noisy; each candidate is measured in two
+ * rounds and the faster is kept.
+ */
+class BlockSizeTuner {
+public:
+    static constexpr Size CACHE_LINE_VALUES = 64 / sizeof(Value);
+    
+    /**
+     * @brief Candidate block sizes for n elements
+     *
+     * Multiples of CACHE_LINE_VALUES growing by about sqrt(2), from one
+     * cache line up to 8 sqrt(n) (capped at n). For n below one cache line
+     * the only candidate is n.
+     */
+    static std::vector<Size> candidateSizes(Size n);
+    
+    /**
+     * @brief Measure every candidate on sample and return the fastest
+     * @param data Array to tune for
+     * @param sample Representative queries
+     * @param min_ms_per_candidate Time spent querying each candidate per round
+     * @param config Other settings for the block decomposition (block_size is ignored)
+     * @throws InvalidDataException if data or sample is empty
+     * @throws InvalidQueryException or BoundsException if a sample query is invalid
+     */
+    static BlockSizeTuning tune(const std::vector<Value>& data, const std::vector<Query>& sample,
+                                double min_ms_per_candidate = 2.0,
+                                const AlgorithmConfig& config = AlgorithmConfig());
+    
+    /**
+     * @brief Use the block size recorded for this profile, or tune and record it
+     * @throws As tune() when a measurement is needed
+     */
+    static BlockSizeTuning tune(const std::vector<Value>& data, const std::vector<Query>& sample,
+                                BlockSizeProfile& profile, double min_ms_per_candidate = 2.0,
+                                const AlgorithmConfig& config = AlgorithmConfig());
+
+private:
+    static void validate(const std::vector<Value>& data, const std::vector<Query>& sample);
+    static double measure(const std::vector<Value>& data, const std::vector<Query>& sample,
+                          const AlgorithmConfig& config, double min_ms);
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_BLOCK_TUNER_H
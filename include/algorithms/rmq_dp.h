@@ -27,6 +27,8 @@ private:
     static constexpr const char* ALGORITHM_NAME = "Dynamic Programming";
     static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::DYNAMIC_PROGRAMMING;
     static constexpr Size RECOMMENDED_MAX_SIZE = 1000;
+    static constexpr Size PARALLEL_MIN_SIZE = 256;
+    static constexpr Size PARALLEL_MIN_ROWS_PER_WORKER = 64;
     
     /**
      * @brief 2D DP table where dp_table_[i][j] stores minimum in range [i, j]
@@ -48,13 +50,26 @@ private:
      */
     void clearTables();
     
+    /**
+     * @brief Fill rows [row_begin, row_end) of the DP tables
+     * 
+     * The last row of the chunk is a prefix-min scan over the data; every
+     * row above it is derived from the row below as min(A[i], dp[i+1][j]).
+     * Chunks write disjoint rows, so they can be filled concurrently.
+     */
+    void fillRows(Index row_begin, Index row_end);
+    
 protected:
     /**
      * @brief Build the DP table for all ranges
      * 
      * Uses dynamic programming to compute minimum for all possible ranges:
      * - dp[i][i] = A[i] (base case)
-     * - dp[i][j] = min(dp[i][j-1], A[j]) for j > i
+     * - dp[i][j] = min(A[i], dp[i+1][j]) for j > i
+     * 
+     * The table is filled one row at a time so every pass streams through
+     * contiguous memory. With AlgorithmConfig::enable_parallel the rows are
+     * split across hardware threads.
      */
     void performPreprocess() override;
     
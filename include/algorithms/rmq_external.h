@@ -0,0 +1,303 @@
+#ifndef RMQ_ALGORITHMS_RMQ_EXTERNAL_H
+#define RMQ_ALGORITHMS_RMQ_EXTERNAL_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief I/O and cache counters for the external-memory RMQ
+ */
+struct ExternalIOStats {
+    uint64_t queries = 0;       ///< Queries answered
+    uint64_t block_reads = 0;   ///< Blocks read from the file (cache misses)
+    uint64_t bytes_read = 0;    ///< Bytes read from the file by queries
+    uint64_t cache_hits = 0;    ///< Block lookups served from the cache
+    uint64_t cache_misses = 0;  ///< Block lookups that went to the file
+    uint64_t evictions = 0;     ///< Blocks evicted from the cache
+    
+    /**
+     * @brief Fraction of block lookups served from the cache
+     */
+    double hitRate() const {
+        uint64_t lookups = cache_hits + cache_misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(cache_hits) / lookups;
+    }
+};
+
+/**
+ * @brief Out-of-core Range Minimum Query for arrays larger than RAM
+ *
+ * The raw array lives in a file of native-endian Value elements. Only the
+ * per-block minima and a sparse table over them are kept in memory; the
+ * blocks themselves are read on demand (pread on POSIX) through a
+ * fixed-capacity LRU block cache. A query touches the file only for the
+ * partial blocks at its two ends; every complete block in between is
+ * answered from the in-memory sparse table.
+ *
+ * @complexity
+ * - Preprocessing: O(n) time, one sequential pass over the file
+ * - Query: O(b) time, at most two block reads (b = block size)
+ * - Resident Space: O((n/b) log(n/b)) + cache capacity
+ *
+ * @note Not thread-safe: queries update the cache and the I/O counters.
+ */
+class RMQExternalMemory {
+private:
+    static constexpr const char* ALGORITHM_NAME = "External Memory (Block + Sparse Table)";
+
+public:
+    /**
+     * @brief Default block size in elements (16 KiB of Value)
+     */
+    static constexpr Size DEFAULT_BLOCK_ELEMENTS = 4096;
+    
+    /**
+     * @brief Default cache budget in bytes
+     */
+    static constexpr Size DEFAULT_CACHE_BYTES = Size(64) * 1024 * 1024;
+
+private:
+    AlgorithmConfig config_;   ///< Configuration (block_size selects the block size)
+    Size cache_bytes_;         ///< Cache budget in bytes
+    
+    std::string path_;         ///< Path of the backing file
+    int fd_;                   ///< POSIX file descriptor (-1 when closed)
+    std::FILE* file_;          ///< Fallback stream on non-POSIX platforms
+    
+    Size size_;                ///< Number of elements in the file
+    Size block_size_;          ///< Elements per block
+    Size num_blocks_;          ///< Number of blocks
+    
+    /**
+     * @brief Minimum value and index of each block
+     */
+    std::vector<Value> block_min_;
+    std::vector<Index> block_min_index_;
+    
+    /**
+     * @brief Sparse table over block minima, level-major:
+     * sparse_min_[k][b] = position of min block in blocks [b, b + 2^k - 1]
+     */
+    std::vector<std::vector<uint32_t>> sparse_min_;
+    
+    /**
+     * @brief Floor of log2 for block counts
+     */
+    std::vector<uint8_t> log_table_;
+    
+    /**
+     * @brief One cached block
+     */
+    struct CacheEntry {
+        std::vector<Value> values;           ///< Block contents
+        std::list<size_t>::iterator lru_pos; ///< Position in the LRU list
+    };
+    
+    Size cache_capacity_;                                   ///< Capacity in blocks
+    mutable std::list<size_t> lru_;                          ///< Most recent first
+    mutable std::unordered_map<size_t, CacheEntry> cache_;   ///< Block id -> entry
+    mutable ExternalIOStats stats_;                          ///< I/O counters
+    
+    /**
+     * @brief Read one block from the file into out
+     */
+    void readBlock(size_t block, Value* out, Size count) const;
+    
+    /**
+     * @brief Get a block through the LRU cache
+     */
+    const std::vector<Value>& fetchBlock(size_t block) const;
+    
+    /**
+     * @brief Build the in-memory sparse table over block minima
+     */
+    void buildSparseTable();
+    
+    /**
+     * @brief Block holding the minimum of blocks [first, last] (leftmost on ties)
+     */
+    size_t queryBlocks(size_t first, size_t last) const;
+    
+    /**
+     * @brief Scan part of one block, returning (value, index) of the leftmost minimum
+     */
+    std::pair<Value, Index> scanBlock(size_t block, Index left, Index right) const;
+    
+    /**
+     * @brief Minimum of [left, right] as (value, index)
+     */
+    std::pair<Value, Index> findMinimum(Index left, Index right) const;
+    
+    Index getBlockStart(size_t block) const {
+        return block * block_size_;
+    }
+    
+    Index getBlockEnd(size_t block) const {
+        return std::min((block + 1) * block_size_, size_) - 1;
+    }
+    
+    void validateQuery(Index left, Index right) const;
+
+public:
+    /**
+     * @brief Default constructor (default block size and cache budget)
+     */
+    RMQExternalMemory();
+    
+    /**
+     * @brief Constructor with configuration and cache budget
+     * @param config Algorithm configuration (block_size in elements, 0 for default)
+     * @param cache_bytes Maximum bytes of block data kept in memory
+     */
+    explicit RMQExternalMemory(const AlgorithmConfig& config,
+                               Size cache_bytes = DEFAULT_CACHE_BYTES);
+    
+    /**
+     * @brief Destructor - closes the backing file
+     */
+    ~RMQExternalMemory();
+    
+    RMQExternalMemory(const RMQExternalMemory&) = delete;
+    RMQExternalMemory& operator=(const RMQExternalMemory&) = delete;
+    
+    /**
+     * @brief Open a data file and build the in-memory block index
+     * @param path File of native-endian Value elements
+     * @throws InvalidDataException if the file cannot be opened or is empty
+     * @throws AlgorithmException on read errors
+     */
+    void open(const std::string& path);
+    
+    /**
+     * @brief Close the file and release all in-memory structures
+     */
+    void close();
+    
+    /**
+     * @brief Check whether a file is open and indexed
+     */
+    bool isOpen() const {
+        return size_ > 0;
+    }
+    
+    /**
+     * @brief Query the minimum value in a range
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return The minimum value in the range [left, right]
+     * @throws NotPreprocessedException if no file is open
+     * @throws BoundsException if indices are out of bounds
+     * @throws InvalidQueryException if left > right
+     */
+    Value query(Index left, Index right) const;
+    
+    /**
+     * @brief Query with value and leftmost index of the minimum
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Detailed query result including value, index, and timing
+     */
+    QueryResult queryDetailed(Index left, Index right) const;
+    
+    /**
+     * @brief Query without throwing
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Outcome holding the status and, on success, value and index
+     */
+    QueryOutcome tryQuery(Index left, Index right) const noexcept;
+    
+    /**
+     * @brief Get the algorithm name
+     */
+    std::string getName() const {
+        return ALGORITHM_NAME;
+    }
+    
+    /**
+     * @brief Get complexity information
+     */
+    ComplexityInfo getComplexity() const;
+    
+    /**
+     * @brief Number of elements in the open file
+     */
+    Size size() const {
+        return size_;
+    }
+    
+    /**
+     * @brief Resident memory in bytes (block index plus cached blocks)
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * @brief Get I/O and cache counters
+     */
+    ExternalIOStats getIOStats() const {
+        return stats_;
+    }
+    
+    /**
+     * @brief Reset I/O and cache counters
+     */
+    void resetIOStats() {
+        stats_ = ExternalIOStats();
+    }
+    
+    /**
+     * @brief Drop every cached block (counters are kept)
+     */
+    void dropCache();
+    
+    /**
+     * @brief Get current block size in elements
+     */
+    size_t getBlockSize() const {
+        return block_size_;
+    }
+    
+    /**
+     * @brief Get number of blocks
+     */
+    size_t getNumBlocks() const {
+        return num_blocks_;
+    }
+    
+    /**
+     * @brief Get cache capacity in blocks
+     */
+    size_t getCacheCapacity() const {
+        return cache_capacity_;
+    }
+    
+    /**
+     * @brief Get statistics
+     * @return Tuple of (block_size, num_blocks, resident_bytes)
+     */
+    std::tuple<size_t, size_t, size_t> getBlockStats() const;
+    
+    /**
+     * @brief Write an array to a file in the format read by open()
+     * @param path Destination file (truncated)
+     * @param data Values to write
+     * @param append Append to the file instead of truncating it
+     */
+    static void writeDataFile(const std::string& path, const std::vector<Value>& data,
+                              bool append = false);
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_EXTERNAL_H
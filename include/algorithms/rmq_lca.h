@@ -2,6 +2,7 @@
 #define RMQ_ALGORITHMS_RMQ_LCA_H
 
 #include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
 #include <vector>
 #include <stack>
 
@@ -28,21 +29,9 @@ private:
     static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::LCA_BASED;
     
     /**
-     * @brief Node structure for Cartesian tree
+     * @brief Node structure for Cartesian tree (shared with the kernel benchmark)
      */
-    struct CartesianNode {
-        Value value;           ///< Value at this node
-        Index array_index;     ///< Original array index
-        int left_child;        ///< Index of left child (-1 if none)
-        int right_child;       ///< Index of right child (-1 if none)
-        int parent;            ///< Index of parent (-1 if root)
-        int depth;             ///< Depth in the tree
-        
-        CartesianNode() 
-            : value(0), array_index(0), 
-              left_child(-1), right_child(-1), 
-              parent(-1), depth(0) {}
-    };
+    using CartesianNode = kernels::CartesianNode;
     
     /**
      * @brief Cartesian tree nodes
@@ -56,7 +45,7 @@ private:
     
     /**
      * @brief Binary lifting table for LCA
-     * ancestors_[i][j] = 2^j-th ancestor of node i
+     * ancestors_[j][i] = 2^j-th ancestor of node i (stored level by level)
      */
     std::vector<std::vector<int>> ancestors_;
     
@@ -84,11 +73,6 @@ private:
      */
     void buildLCAStructure();
     
-    /**
-     * @brief Compute depth of each node using DFS
-     */
-    void computeDepths(int node, int depth);
-    
     /**
      * @brief Find LCA of two nodes using binary lifting
      * @param u First node index in tree
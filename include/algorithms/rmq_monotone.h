@@ -0,0 +1,214 @@
+#ifndef RMQ_ALGORITHMS_RMQ_MONOTONE_H
+#define RMQ_ALGORITHMS_RMQ_MONOTONE_H
+
+#include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Overall shape of an array, as found by RMQMonotoneRuns::analyze()
+ */
+enum class DataShape {
+    CONSTANT,           ///< All elements equal
+    NON_DECREASING,     ///< One non-decreasing run
+    NON_INCREASING,     ///< One non-increasing run
+    PIECEWISE_MONOTONE, ///< A few long monotone runs
+    GENERAL             ///< Runs too short to pay off
+};
+
+/**
+ * @brief Convert DataShape to string
+ */
+inline std::string dataShapeToString(DataShape shape) {
+    switch (shape) {
+        case DataShape::CONSTANT:
+            return "constant";
+        case DataShape::NON_DECREASING:
+            return "non-decreasing";
+        case DataShape::NON_INCREASING:
+            return "non-increasing";
+        case DataShape::PIECEWISE_MONOTONE:
+            return "piecewise monotone";
+        case DataShape::GENERAL:
+            return "general";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * @brief Result of scanning an array for monotone runs
+ */
+struct ShapeAnalysis {
+    DataShape shape = DataShape::GENERAL;  ///< Classification
+    Size runs = 0;                         ///< Maximal monotone runs (0 for an empty array)
+};
+
+/**
+ * @brief Range minimum over maximal monotone runs of the array
+ *
+ * Preprocessing splits the array greedily into maximal non-decreasing or
+ * non-increasing runs. Inside a run the minimum of a range is at one of
+ * its ends (the left end of a rising run, the right end of a falling
+ * one), so only the run boundaries and one minimum per run are stored,
+ * plus a sparse table of packed (minimum, run) entries over the runs.
+ *
+ * - Sorted, reverse-sorted and constant arrays are one run: O(1) extra
+ *   space and a query is one or two reads.
+ * - A few long runs cost O(k log k) for k runs; a query finds the runs of
+ *   its ends by binary search and reads the run table in between.
+ * - Arbitrary data still works (k is at most about n / 2), but the
+ *   general structures are a better fit; RMQFactory::createForData()
+ *   only picks this algorithm when analyze() does not report GENERAL.
+ *
+ * Ties resolve to the leftmost minimum: inside a falling run the answer
+ * is the start of the stretch equal to the right end, found by binary
+ * search.
+ *
+ * @complexity
+ * - Preprocessing: O(n) scan + O(k log k) for k runs
+ * - Query: O(1) for one run, O(log k) otherwise
+ * - Update: Not supported (requires full rebuild)
+ * - Total Space: O(n + k log k)
+ */
+class RMQMonotoneRuns final : public RMQBase {
+private:
+    static constexpr const char* ALGORITHM_NAME = "Monotone Runs";
+    static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::MONOTONE_RUNS;
+    
+    /**
+     * @brief First index of each run, plus n as a sentinel
+     */
+    std::vector<Index> run_start_;
+    
+    /**
+     * @brief Whether each run is non-increasing (minimum at its right end)
+     */
+    std::vector<bool> run_falling_;
+    
+    /**
+     * @brief Leftmost position of each run's minimum
+     */
+    std::vector<Index> run_min_index_;
+    
+    /**
+     * @brief Sparse table over runs: run_table_[j][r] is the smallest packed
+     * (minimum, run) entry of runs [r, r + 2^j - 1]
+     */
+    std::vector<std::vector<kernels::PackedEntry>> run_table_;
+    
+    DataShape shape_;
+    
+    /**
+     * @brief Last index of the maximal monotone run starting at start
+     * @param falling Set to whether the run is non-increasing
+     */
+    static Index runEnd(const std::vector<Value>& data, Index start, bool& falling);
+    
+    /**
+     * @brief Shape of data with the given number of runs
+     */
+    static DataShape classify(const std::vector<Value>& data, Size runs);
+    
+    size_t runOf(Index index) const;
+    
+    /**
+     * @brief Leftmost minimum of [left, right] within one run
+     */
+    Index runMinimumIndex(size_t run, Index left, Index right) const;
+    
+    /**
+     * @brief Run holding the minimum of runs [first, last] (leftmost on ties)
+     */
+    size_t queryRuns(size_t first, size_t last) const;
+    
+    void buildRunTable();
+    
+    void clearRuns();
+
+protected:
+    /**
+     * @brief Find the runs, their minima and the table over them
+     */
+    void performPreprocess() override;
+    
+    /**
+     * @brief Query from the run ends and the run table
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return The minimum value in range [left, right]
+     */
+    Value performQuery(Index left, Index right) const override;
+    
+    Index findMinimumIndex(Index left, Index right) const override;
+
+public:
+    /**
+     * @brief analyze() reports GENERAL when the average run is shorter than this
+     */
+    static constexpr Size MIN_AVERAGE_RUN = 16;
+    
+    /**
+     * @brief Default constructor
+     */
+    RMQMonotoneRuns();
+    
+    /**
+     * @brief Constructor with configuration
+     * @param config Algorithm configuration
+     */
+    explicit RMQMonotoneRuns(const AlgorithmConfig& config);
+    
+    ~RMQMonotoneRuns() override;
+    
+    std::string getName() const override {
+        return ALGORITHM_NAME;
+    }
+    
+    AlgorithmType getType() const override {
+        return ALGORITHM_TYPE;
+    }
+    
+    ComplexityInfo getComplexity() const override;
+    
+    /**
+     * @brief Check if the algorithm supports dynamic updates
+     * @return false (updates can break runs; rebuild instead)
+     */
+    bool supportsUpdate() const override {
+        return false;
+    }
+    
+    void clear() override;
+    
+    /**
+     * @brief Get memory usage in bytes
+     * @return Approximate memory usage including the run table
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * @brief Shape found by the last preprocess()
+     */
+    DataShape getShape() const {
+        return shape_;
+    }
+    
+    /**
+     * @brief Number of monotone runs
+     */
+    size_t getRunCount() const {
+        return run_falling_.size();
+    }
+    
+    /**
+     * @brief Classify data by its monotone runs (one O(n) pass, no allocation)
+     */
+    static ShapeAnalysis analyze(const std::vector<Value>& data);
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_MONOTONE_H
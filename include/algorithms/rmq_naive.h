@@ -2,6 +2,7 @@
 #define RMQ_ALGORITHMS_RMQ_NAIVE_H
 
 #include "../core/rmq_base.h"
+#include "../core/rmq_compressed.h"
 
 namespace rmq {
 
@@ -17,12 +18,26 @@ namespace rmq {
  * - Query: O(n) time, O(1) space
  * - Update: O(1) time
  * - Total Space: O(n) for storing the array
+ *
+ * With AlgorithmConfig::compress_data the array is held as a
+ * CompressedArray (block_size elements per block, 256 by default). Its
+ * uncompressed block minima let queries skip whole blocks, so a query
+ * decodes at most two partial blocks.
  */
 class RMQNaive final : public RMQBase {
 private:
     static constexpr const char* ALGORITHM_NAME = "Naive Linear Scan";
     static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::NAIVE;
     
+    /**
+     * @brief Compressed copy of the data (compress_data only; data_ is then released)
+     */
+    CompressedArray compressed_;
+    
+    bool isCompressed() const {
+        return !compressed_.empty();
+    }
+    
 protected:
     /**
      * @brief Perform preprocessing (no-op for naive approach)
@@ -48,6 +63,10 @@ protected:
      */
     Index findMinimumIndex(Index left, Index right) const override;
     
+    Value valueAt(Index index) const override;
+    
+    std::vector<Value> copyData() const override;
+    
 public:
     /**
      * @brief Default constructor
@@ -102,7 +121,7 @@ public:
      * @throws BoundsException if index is out of bounds
      * @throws NotPreprocessedException if not preprocessed
      */
-    void update(Index index, Value value);
+    void update(Index index, Value value) override;
     
     /**
      * @brief Batch update multiple elements
@@ -110,7 +129,12 @@ public:
      * @throws BoundsException if any index is out of bounds
      * @throws NotPreprocessedException if not preprocessed
      */
-    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates);
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates) override;
+    
+    /**
+     * @brief Clear the data (and its compressed form)
+     */
+    void clear() override;
     
     /**
      * @brief Get memory usage in bytes
@@ -0,0 +1,195 @@
+#ifndef RMQ_ALGORITHMS_RMQ_SHAPE_INDEX_H
+#define RMQ_ALGORITHMS_RMQ_SHAPE_INDEX_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Range minimum over many small arrays that share argmin tables by shape
+ *
+ * The position of a range minimum depends only on the shape of the array's
+ * Cartesian tree, not on its values, and collections of small arrays tend
+ * to repeat a limited number of shapes. Each array added is reduced to its
+ * Cartesian tree signature (kernels::buildCartesianTree, then the number
+ * of rightmost-path pops before each push, at most 2n bits); arrays with
+ * the same signature share one argmin table, built when the shape is
+ * first seen. An array then costs its values plus a shape id and an
+ * offset.
+ *
+ * The shared table is the stack bitmask of StaticRMQ: bit i of mask[r] is
+ * set if position i is smaller than everything in (i, r], and the minimum
+ * of [l, r] is the lowest set bit at or above l. Ties resolve to the
+ * leftmost minimum, as everywhere else.
+ *
+ * @code
+ * RMQShapeIndex index;
+ * Size id = index.addArray({5, 2, 8, 1});
+ * index.addArray({50, 20, 80, 10});   // same shape, no new table
+ * index.query(id, 0, 2);              // 2
+ * index.getShapeCount();              // 1
+ * @endcode
+ *
+ * @complexity
+ * - Add: O(n) per array, plus O(n) for a new shape
+ * - Query: O(1)
+ * - Space: O(total elements + 8 bytes * distinct shapes * n)
+ */
+class RMQShapeIndex {
+private:
+    static constexpr const char* ALGORITHM_NAME = "Shared Cartesian Tree Shapes";
+
+public:
+    /**
+     * @brief Largest array one mask word can describe
+     */
+    static constexpr Size MAX_ARRAY_SIZE = 64;
+    
+    /**
+     * @brief Cartesian tree signature: for each position, its pops as 0 bits
+     * followed by a 1 bit for its push
+     */
+    struct Signature {
+        uint64_t bits[2] = {0, 0};
+        Size length = 0;
+        
+        bool operator==(const Signature& other) const {
+            return length == other.length && bits[0] == other.bits[0] && bits[1] == other.bits[1];
+        }
+    };
+
+private:
+    struct SignatureHash {
+        size_t operator()(const Signature& signature) const {
+            uint64_t hash = signature.bits[0] * 0x9E3779B97F4A7C15ull;
+            hash ^= (signature.bits[1] + signature.length) * 0xC2B2AE3D27D4EB4Full;
+            return static_cast<size_t>(hash ^ (hash >> 29));
+        }
+    };
+    
+    /**
+     * @brief Values of every array, back to back
+     */
+    std::vector<Value> values_;
+    
+    /**
+     * @brief First value of each array, plus one past the last array
+     */
+    std::vector<uint32_t> offsets_;
+    
+    /**
+     * @brief Shape id of each array
+     */
+    std::vector<uint32_t> shape_of_;
+    
+    /**
+     * @brief Masks of each shape, back to back; shape s starts at mask_offsets_[s]
+     */
+    std::vector<uint64_t> masks_;
+    std::vector<uint32_t> mask_offsets_;
+    
+    std::unordered_map<Signature, uint32_t, SignatureHash> shape_ids_;
+    
+    /**
+     * @brief Scratch space for the Cartesian tree build (reused across arrays)
+     */
+    std::vector<int> stack_;
+    
+    /**
+     * @brief Signature with caller-provided scratch space
+     */
+    static Signature computeSignature(const Value* values, Size count, std::vector<int>& stack);
+    
+    /**
+     * @brief Append the masks of the shape with this signature
+     */
+    void appendMasks(const Signature& signature);
+    
+    void validateQuery(Size array, Index left, Index right) const;
+
+public:
+    RMQShapeIndex();
+    
+    /**
+     * @brief Build the index over a collection of arrays
+     * @throws InvalidDataException if an array is empty or longer than MAX_ARRAY_SIZE
+     */
+    explicit RMQShapeIndex(const std::vector<std::vector<Value>>& arrays);
+    
+    /**
+     * @brief Cartesian tree signature of values[0..count)
+     * @throws InvalidDataException if count is 0 or above MAX_ARRAY_SIZE
+     */
+    static Signature signatureOf(const Value* values, Size count);
+    
+    /**
+     * @brief Add one array, sharing the argmin table of an earlier array of
+     * the same shape
+     * @return Id of the array (arrays are numbered in order of addition)
+     * @throws InvalidDataException if the array is empty or longer than MAX_ARRAY_SIZE
+     */
+    Size addArray(const std::vector<Value>& values);
+    
+    /**
+     * @brief Leftmost position of the minimum of [left, right] in an array
+     * @throws BoundsException if the array id or the range is out of bounds
+     * @throws InvalidQueryException if left > right
+     */
+    Index queryIndex(Size array, Index left, Index right) const;
+    
+    /**
+     * @brief Minimum of [left, right] in an array
+     * @throws BoundsException if the array id or the range is out of bounds
+     * @throws InvalidQueryException if left > right
+     */
+    Value query(Size array, Index left, Index right) const;
+    
+    std::string getName() const {
+        return ALGORITHM_NAME;
+    }
+    
+    /**
+     * @brief Number of arrays added
+     */
+    Size getArrayCount() const {
+        return shape_of_.size();
+    }
+    
+    /**
+     * @brief Number of distinct shapes (shared tables)
+     */
+    Size getShapeCount() const {
+        return mask_offsets_.size();
+    }
+    
+    /**
+     * @brief Length of an array
+     * @throws BoundsException if the array id is out of bounds
+     */
+    Size getArraySize(Size array) const;
+    
+    /**
+     * @brief Shape id of an array; arrays with equal ids share a table
+     * @throws BoundsException if the array id is out of bounds
+     */
+    Size getShapeId(Size array) const;
+    
+    /**
+     * @brief Bytes held: values, per-array ids, shared tables and the shape map
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * @brief Remove every array and shape
+     */
+    void clear();
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_SHAPE_INDEX_H
@@ -2,6 +2,10 @@
 #define RMQ_ALGORITHMS_RMQ_SPARSE_TABLE_H
 
 #include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <cmath>
 
@@ -21,6 +25,21 @@ namespace rmq {
  * - Total Space: O(n log n) for the sparse table
  * 
  * @note This is optimal for static arrays with many queries
+ *
+ * Two options trim the table for workloads of short ranges:
+ * - AlgorithmConfig::lazy_levels: preprocess() builds only level 0; a
+ *   query builds the levels it needs on first use. Construction is
+ *   serialized by a mutex and published per level, so concurrent queries
+ *   are safe and a built level is read without locking.
+ * - AlgorithmConfig::max_levels: at most that many levels are kept. A
+ *   range of 2^max_levels or more elements is split at blocks of
+ *   2^(max_levels - 1): the table answers its two end blocks and
+ *   precomputed block minima cover the rest, so only those queries lose
+ *   O(1).
+ *
+ * AlgorithmConfig::packed_entries stores each entry as one 64-bit
+ * (value, index) key instead of two parallel tables: 8 bytes per entry
+ * instead of 12, and an argmin reads one level instead of two.
  */
 class RMQSparseTable final : public RMQBase {
 private:
@@ -28,14 +47,50 @@ private:
     static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::SPARSE_TABLE;
     
     /**
-     * @brief Sparse table where sparse_table_[i][j] = min in range [i, i + 2^j - 1]
+     * @brief Sparse table where sparse_table_[j][i] = min in range [i, i + 2^j - 1]
+     * 
+     * Stored level by level so each level is one contiguous array.
      */
-    std::vector<std::vector<Value>> sparse_table_;
+    mutable std::vector<std::vector<Value>> sparse_table_;
     
     /**
      * @brief Table storing index of minimum element for each range
      */
-    std::vector<std::vector<Index>> index_table_;
+    mutable std::vector<std::vector<Index>> index_table_;
+    
+    /**
+     * @brief Packed (value, index) keys per level; replaces sparse_table_
+     * and index_table_ when packed_ is set
+     */
+    mutable std::vector<std::vector<kernels::PackedEntry>> packed_table_;
+    
+    /**
+     * @brief Whether levels are stored as packed_table_ (packed_entries)
+     */
+    bool packed_;
+    
+    /**
+     * @brief Whether each level is built (lazy_levels fills these on demand)
+     */
+    std::unique_ptr<std::atomic<bool>[]> level_ready_;
+    
+    /**
+     * @brief Serializes on-demand level construction
+     */
+    mutable std::mutex level_mutex_;
+    
+    /**
+     * @brief Levels queries may use (max_level_ unless max_levels caps it)
+     */
+    size_t level_cap_;
+    
+    /**
+     * @brief Minimum (and its index) of each aligned block of 2^block_shift_
+     * elements; only kept when the cap drops levels
+     */
+    std::vector<Value> block_min_;
+    std::vector<Index> block_min_index_;
+    size_t block_shift_;
     
     /**
      * @brief Precomputed logarithms for O(1) query
@@ -62,14 +117,47 @@ private:
      */
     void clearTables();
     
+    /**
+     * @brief Size level j for its n - 2^j + 1 ranges
+     */
+    void allocateLevel(size_t j) const;
+    
+    /**
+     * @brief Fill level j from level j - 1 and publish it
+     */
+    void buildLevel(size_t j) const;
+    
+    /**
+     * @brief Build levels up to k that are not built yet (thread-safe)
+     */
+    void materializeLevels(size_t k) const;
+    
+    void ensureLevel(size_t k) const {
+        if (!level_ready_[k].load(std::memory_order_acquire)) {
+            materializeLevels(k);
+        }
+    }
+    
+    /**
+     * @brief Minimum blocks for ranges beyond the level cap
+     */
+    void buildBlockMinima();
+    
+    /**
+     * @brief Sparse table answer for a range shorter than 2^level_cap_
+     */
+    Value lookup(Index left, Index right) const;
+    
+    Index lookupIndex(Index left, Index right) const;
+    
 protected:
     /**
      * @brief Build the sparse table using binary lifting
      * 
      * Algorithm:
-     * 1. Base case: sparse_table[i][0] = A[i]
-     * 2. For each power j: sparse_table[i][j] = min(sparse_table[i][j-1], 
-     *                                               sparse_table[i + 2^(j-1)][j-1])
+     * 1. Base case: sparse_table[0][i] = A[i]
+     * 2. For each power j: sparse_table[j][i] = min(sparse_table[j-1][i], 
+     *                                               sparse_table[j-1][i + 2^(j-1)])
      */
     void performPreprocess() override;
     
@@ -78,7 +166,7 @@ protected:
      * 
      * For range [L, R]:
      * 1. Find largest k where 2^k <= R - L + 1
-     * 2. Return min(sparse_table[L][k], sparse_table[R - 2^k + 1][k])
+     * 2. Return min(sparse_table[k][L], sparse_table[k][R - 2^k + 1])
      * 
      * @param left Left boundary (inclusive)
      * @param right Right boundary (inclusive)
@@ -160,9 +248,28 @@ public:
         return max_level_;
     }
     
+    /**
+     * @brief Number of levels built so far (all usable ones unless lazy)
+     */
+    size_t getBuiltLevels() const;
+    
+    /**
+     * @brief Whether entries are packed (value, index) keys
+     */
+    bool isPacked() const {
+        return packed_;
+    }
+    
+    /**
+     * @brief Number of levels queries may use (getLevels() unless capped)
+     */
+    size_t getLevelCap() const {
+        return level_cap_;
+    }
+    
     /**
      * @brief Get total number of entries in sparse table
-     * @return Total entries across all levels
+     * @return Total entries across all built levels
      */
     size_t getTableEntries() const;
     
@@ -0,0 +1,201 @@
+#ifndef RMQ_ALGORITHMS_RMQ_STATIC_H
+#define RMQ_ALGORITHMS_RMQ_STATIC_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace rmq {
+
+namespace static_detail {
+
+/**
+ * @brief Position of the lowest set bit (mask != 0)
+ */
+constexpr unsigned lowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#else
+    unsigned bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+/**
+ * @brief Position of the highest set bit (mask != 0)
+ */
+constexpr unsigned highestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(mask));
+#else
+    unsigned bit = 0;
+    while (mask >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+} // namespace static_detail
+
+/**
+ * @brief Range minimum over a fixed-size array, sized at compile time
+ *
+ * For the many small arrays whose length is known up front (32 or 64
+ * price levels, say). Storage is std::array, so there is no heap
+ * allocation, no virtual dispatch and no runtime sizing; the whole object
+ * can be built in a constant expression from constant data.
+ *
+ * The structure is picked from N:
+ * - N <= 64: one stack bitmask per right end. Bit i of masks[r] is set if
+ *   data[i] is smaller than everything in (i, r]; the minimum of [l, r] is
+ *   the lowest set bit at or above l. N words of 32 or 64 bits.
+ * - N > 64: a sparse table of positions, stored in the narrowest integer
+ *   that holds N. Two lookups per query.
+ *
+ * Both answer a query with a constant number of operations and no loop,
+ * and both return the leftmost minimum on ties. T only needs operator<.
+ *
+ * @code
+ * constexpr StaticRMQ levels(std::array<int, 8>{3, 1, 4, 1, 5, 9, 2, 6});
+ * static_assert(levels.query(4, 7) == 2);
+ * @endcode
+ *
+ * @complexity
+ * - Preprocessing: O(N) (bitmask) or O(N log N) (sparse table)
+ * - Query: O(1), no bounds check (see queryChecked())
+ * - Update: Not supported (construct a new object)
+ */
+template <typename T, Size N>
+class StaticRMQ {
+    static_assert(N >= 1, "StaticRMQ needs at least one element");
+    static_assert(N <= 65536, "StaticRMQ is meant for small arrays; use RMQFactory for large ones");
+
+public:
+    /**
+     * @brief true if queries use stack bitmasks, false for the sparse table
+     */
+    static constexpr bool USES_BITMASK = N <= 64;
+    
+    /**
+     * @brief Levels of the sparse table (floor(log2 N) + 1)
+     */
+    static constexpr Size LEVELS = static_detail::highestBit(N) + 1;
+
+private:
+    using Mask = std::conditional_t<(N <= 32), uint32_t, uint64_t>;
+    using Position = std::conditional_t<(N <= 256), uint8_t, uint16_t>;
+    using Table = std::conditional_t<USES_BITMASK,
+                                     std::array<Mask, N>,
+                                     std::array<std::array<Position, N>, LEVELS>>;
+    
+    std::array<T, N> data_;
+    Table table_;
+    
+    constexpr void buildMasks() {
+        Mask stack = 0;
+        for (Size r = 0; r < N; ++r) {
+            // Pop the larger elements; equal ones stay, so ties resolve leftmost
+            while (stack != 0) {
+                unsigned top = static_detail::highestBit(stack);
+                if (!(data_[r] < data_[top])) {
+                    break;
+                }
+                stack &= ~(Mask(1) << top);
+            }
+            stack |= Mask(1) << r;
+            table_[r] = stack;
+        }
+    }
+    
+    constexpr void buildSparseTable() {
+        for (Size i = 0; i < N; ++i) {
+            table_[0][i] = static_cast<Position>(i);
+        }
+        for (Size j = 1; j < LEVELS; ++j) {
+            Size half = Size(1) << (j - 1);
+            for (Size i = 0; i + 2 * half <= N; ++i) {
+                Position left = table_[j - 1][i];
+                Position right = table_[j - 1][i + half];
+                table_[j][i] = data_[right] < data_[left] ? right : left;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Build the structure over data (usable in constant expressions)
+     */
+    constexpr explicit StaticRMQ(const std::array<T, N>& data) : data_(data), table_() {
+        if constexpr (USES_BITMASK) {
+            buildMasks();
+        } else {
+            buildSparseTable();
+        }
+    }
+    
+    /**
+     * @brief Index of the leftmost minimum of [left, right] (no bounds check)
+     */
+    constexpr Index queryIndex(Index left, Index right) const {
+        if constexpr (USES_BITMASK) {
+            return left + static_detail::lowestBit(table_[right] >> left);
+        } else {
+            Size k = static_detail::highestBit(right - left + 1);
+            Position first = table_[k][left];
+            Position second = table_[k][right - (Size(1) << k) + 1];
+            return data_[second] < data_[first] ? second : first;
+        }
+    }
+    
+    /**
+     * @brief Minimum of [left, right] (no bounds check)
+     */
+    constexpr const T& query(Index left, Index right) const {
+        return data_[queryIndex(left, right)];
+    }
+    
+    /**
+     * @brief Minimum of [left, right], validated like IRMQAlgorithm::query()
+     * @throws InvalidQueryException if left > right
+     * @throws BoundsException if right >= N
+     */
+    const T& queryChecked(Index left, Index right) const {
+        if (left > right) {
+            throw InvalidQueryException(left, right);
+        }
+        if (right >= N) {
+            throw BoundsException(left, right, N);
+        }
+        return query(left, right);
+    }
+    
+    constexpr const T& operator[](Index index) const {
+        return data_[index];
+    }
+    
+    constexpr const std::array<T, N>& data() const {
+        return data_;
+    }
+    
+    static constexpr Size size() {
+        return N;
+    }
+    
+    /**
+     * @brief Bytes held, all inline in the object
+     */
+    static constexpr size_t getMemoryUsage() {
+        return sizeof(StaticRMQ);
+    }
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_STATIC_H
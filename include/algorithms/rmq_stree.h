@@ -0,0 +1,165 @@
+#ifndef RMQ_ALGORITHMS_RMQ_STREE_H
+#define RMQ_ALGORITHMS_RMQ_STREE_H
+
+#include "../core/rmq_base.h"
+#include "../core/rmq_kernels.h"
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Static 16-ary min tree (S-tree) implementation of Range Minimum Query
+ *
+ * Every node holds 16 keys and fills exactly one 64-byte cache line. The
+ * leaves are the array itself (padded with the maximum Value); each key of
+ * an upper level is the minimum of one node of the level below. The layout
+ * is implicit: node j of a level has its children at nodes 16j..16j + 15 of
+ * the level below, so there are no pointers. Levels are stored root first
+ * in one aligned array, keeping the upper levels in a few shared lines.
+ *
+ * A query climbs from the leaves: on each level it takes the partial node
+ * at either end of the range with one masked 16-key min
+ * (kernels::minNode), then moves to the parents of the nodes in between.
+ *
+ * @complexity
+ * - Preprocessing: O(n) time, O(n / 15) extra space
+ * - Query: O(log_16 n) time (two node reads per level), O(1) space
+ * - Update: Not supported (requires full rebuild)
+ * - Total Space: O(n), about 16/15 of the data
+ *
+ * @note The tree keeps its own aligned copy of the data and releases data_
+ * after preprocessing.
+ */
+class RMQSTree final : public RMQBase {
+private:
+    static constexpr const char* ALGORITHM_NAME = "S-Tree (16-ary Min Tree)";
+    static constexpr AlgorithmType ALGORITHM_TYPE = AlgorithmType::S_TREE;
+    
+    /**
+     * @brief One cache line of keys
+     */
+    struct alignas(64) Node {
+        Value keys[kernels::NODE_KEYS];
+    };
+    static_assert(sizeof(Node) == 64, "an S-tree node must fill one cache line");
+    
+    /**
+     * @brief All levels, root level first; level 0 (the leaves) is last
+     */
+    std::vector<Node> nodes_;
+    
+    /**
+     * @brief First node of each level, indexed from the leaves (level 0) up
+     */
+    std::vector<size_t> level_offset_;
+    
+    /**
+     * @brief Keys of a level as one flat array
+     */
+    const Value* level(size_t k) const {
+        return nodes_[level_offset_[k]].keys;
+    }
+    
+    Value* level(size_t k) {
+        return nodes_[level_offset_[k]].keys;
+    }
+    
+    /**
+     * @brief Leftmost position at level 0 below key position of level k holding value
+     */
+    Index descend(size_t k, Index position, Value value) const;
+    
+    void clearTree();
+
+protected:
+    /**
+     * @brief Build the levels bottom-up and release data_
+     */
+    void performPreprocess() override;
+    
+    /**
+     * @brief Query by climbing the tree, two partial nodes per level
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return The minimum value in range [left, right]
+     */
+    Value performQuery(Index left, Index right) const override;
+    
+    /**
+     * @brief Leftmost minimum: the first piece of the climb holding the
+     * minimum, then down through its leftmost matching children
+     */
+    Index findMinimumIndex(Index left, Index right) const override;
+    
+    Value valueAt(Index index) const override;
+    
+    std::vector<Value> copyData() const override;
+
+public:
+    /**
+     * @brief Default constructor
+     */
+    RMQSTree();
+    
+    /**
+     * @brief Constructor with configuration
+     * @param config Algorithm configuration
+     */
+    explicit RMQSTree(const AlgorithmConfig& config);
+    
+    ~RMQSTree() override;
+    
+    std::string getName() const override {
+        return ALGORITHM_NAME;
+    }
+    
+    AlgorithmType getType() const override {
+        return ALGORITHM_TYPE;
+    }
+    
+    ComplexityInfo getComplexity() const override;
+    
+    /**
+     * @brief Check if the algorithm supports dynamic updates
+     * @return false (the tree is static; updates require a rebuild)
+     */
+    bool supportsUpdate() const override {
+        return false;
+    }
+    
+    void clear() override;
+    
+    /**
+     * @brief Get memory usage in bytes
+     * @return Approximate memory usage including all levels
+     */
+    size_t getMemoryUsage() const;
+    
+    /**
+     * @brief Number of levels, leaves included
+     */
+    size_t getLevels() const {
+        return level_offset_.size();
+    }
+    
+    /**
+     * @brief Total number of nodes (cache lines) across all levels
+     */
+    size_t getNodeCount() const {
+        return nodes_.size();
+    }
+    
+    /**
+     * @brief Number of nodes (cache lines) the tree needs for n elements
+     */
+    static size_t nodeCount(size_t n);
+    
+    /**
+     * @brief Number of levels the tree needs for n elements, leaves included
+     */
+    static size_t levelCount(size_t n);
+};
+
+} // namespace rmq
+
+#endif // RMQ_ALGORITHMS_RMQ_STREE_H
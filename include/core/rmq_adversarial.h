@@ -0,0 +1,291 @@
+#ifndef RMQ_CORE_RMQ_ADVERSARIAL_H
+#define RMQ_CORE_RMQ_ADVERSARIAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "rmq_types.h"
+
+namespace rmq {
+
+/**
+ * @brief Inputs and query sets built to hit each algorithm's bad cases
+ *
+ * Uniform random data is the friendliest input for most structures: its
+ * Cartesian tree has depth O(log n), its minima are spread evenly and it
+ * has no runs. The generators here produce the shapes that are not:
+ * sorted data (a Cartesian tree that is a path), long ties, many short
+ * runs, and query sets whose ends fall just inside block boundaries so
+ * every partial block is scanned almost whole.
+ *
+ * The mutation operators let a search (the complexity benchmark's
+ * --adversarial mode) climb from these seeds towards the slowest inputs it
+ * can find for one algorithm. Everything is deterministic for a seed.
+ */
+namespace adversarial {
+
+/**
+ * @brief Structured input shapes
+ */
+enum class InputPattern {
+    RANDOM,           ///< Uniform random values (the usual baseline)
+    SORTED,           ///< Strictly increasing: the Cartesian tree is a right path
+    REVERSE_SORTED,   ///< Strictly decreasing: a left path
+    ORGAN_PIPE,       ///< Increasing then decreasing: two paths of depth n/2
+    SAWTOOTH,         ///< Increasing runs of about sqrt(n), each restarting lower
+    ZIGZAG,           ///< Alternating high and low: n/2 runs of length 2
+    CONSTANT,         ///< One value everywhere: every range is a tie
+    FEW_DISTINCT      ///< Random values from {0, 1, 2, 3}: many ties
+};
+
+inline const char* inputPatternToString(InputPattern pattern) {
+    switch (pattern) {
+        case InputPattern::RANDOM: return "random";
+        case InputPattern::SORTED: return "sorted";
+        case InputPattern::REVERSE_SORTED: return "reverse-sorted";
+        case InputPattern::ORGAN_PIPE: return "organ-pipe";
+        case InputPattern::SAWTOOTH: return "sawtooth";
+        case InputPattern::ZIGZAG: return "zigzag";
+        case InputPattern::CONSTANT: return "constant";
+        case InputPattern::FEW_DISTINCT: return "few-distinct";
+        default: return "unknown";
+    }
+}
+
+inline std::vector<InputPattern> allInputPatterns() {
+    return {InputPattern::RANDOM, InputPattern::SORTED, InputPattern::REVERSE_SORTED,
+            InputPattern::ORGAN_PIPE, InputPattern::SAWTOOTH, InputPattern::ZIGZAG,
+            InputPattern::CONSTANT, InputPattern::FEW_DISTINCT};
+}
+
+/**
+ * @brief Generate n values of the given pattern
+ */
+inline std::vector<Value> generateInput(InputPattern pattern, Size n, uint32_t seed = 42) {
+    std::vector<Value> data(n);
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<Value> random_value(-1000000, 1000000);
+    Size tooth = static_cast<Size>(std::sqrt(static_cast<double>(n))) + 1;
+    
+    for (Size i = 0; i < n; ++i) {
+        Value position = static_cast<Value>(i % 1000000000);
+        switch (pattern) {
+            case InputPattern::RANDOM:
+                data[i] = random_value(gen);
+                break;
+            case InputPattern::SORTED:
+                data[i] = position;
+                break;
+            case InputPattern::REVERSE_SORTED:
+                data[i] = -position;
+                break;
+            case InputPattern::ORGAN_PIPE:
+                data[i] = static_cast<Value>(std::min(i, n - 1 - i) % 1000000000);
+                break;
+            case InputPattern::SAWTOOTH:
+                data[i] = static_cast<Value>(i % tooth) - static_cast<Value>((i / tooth) % 1000000);
+                break;
+            case InputPattern::ZIGZAG:
+                data[i] = (i % 2 == 0 ? 1000000 : -1000000) + static_cast<Value>((i / 2) % 1000);
+                break;
+            case InputPattern::CONSTANT:
+                data[i] = 7;
+                break;
+            case InputPattern::FEW_DISTINCT:
+                data[i] = random_value(gen) & 3;
+                break;
+        }
+    }
+    return data;
+}
+
+/**
+ * @brief Parameters of a query set
+ *
+ * Lengths are drawn from [min_length, max_length]. With period > 1 each
+ * query's ends are then moved within their period so that
+ * left % period == left_offset and right % period == right_offset; with
+ * period = block size, left_offset = 1 and right_offset = period - 2 every
+ * query scans two nearly full partial blocks.
+ */
+struct QueryShape {
+    Size min_length = 1;
+    Size max_length = 0;      ///< 0: the whole array
+    Size period = 0;          ///< 0 or 1: no alignment
+    Size left_offset = 0;
+    Size right_offset = 0;
+    
+    std::string describe() const {
+        std::string text = "length " + std::to_string(min_length) + "-" +
+                           (max_length == 0 ? std::string("n") : std::to_string(max_length));
+        if (period > 1) {
+            text += ", ends at " + std::to_string(left_offset) + "/" + std::to_string(right_offset) +
+                    " mod " + std::to_string(period);
+        }
+        return text;
+    }
+};
+
+/**
+ * @brief Seed query shapes for an array of n elements
+ *
+ * Uniform ranges, the full range, short ranges, and long ranges straddling
+ * sqrt(n) + 1 blocks (the default block decomposition) and cache lines.
+ */
+inline std::vector<QueryShape> structuredQueryShapes(Size n) {
+    Size block = static_cast<Size>(std::sqrt(static_cast<double>(n))) + 1;
+    std::vector<QueryShape> shapes(5);
+    
+    shapes[1].min_length = n;
+    shapes[1].max_length = n;
+    
+    shapes[2].max_length = std::min<Size>(16, n);
+    
+    shapes[3].min_length = n / 2 + 1;
+    shapes[3].period = block;
+    shapes[3].left_offset = 1;
+    shapes[3].right_offset = block - 2;
+    
+    shapes[4].min_length = n / 2 + 1;
+    shapes[4].period = 16;
+    shapes[4].left_offset = 1;
+    shapes[4].right_offset = 14;
+    return shapes;
+}
+
+/**
+ * @brief Generate count valid queries of the given shape over n elements
+ */
+inline std::vector<Query> generateQueries(const QueryShape& shape, Size n, Size count, uint32_t seed = 42) {
+    std::vector<Query> queries;
+    if (n == 0) return queries;
+    queries.reserve(count);
+    
+    std::mt19937 gen(seed);
+    Size max_length = shape.max_length == 0 ? n : std::min(shape.max_length, n);
+    Size min_length = std::max<Size>(1, std::min(shape.min_length, max_length));
+    std::uniform_int_distribution<Size> length_dist(min_length, max_length);
+    
+    for (Size i = 0; i < count; ++i) {
+        Size length = length_dist(gen);
+        Index left = std::uniform_int_distribution<Index>(0, n - length)(gen);
+        Index right = left + length - 1;
+        
+        if (shape.period > 1) {
+            Index aligned_left = left - left % shape.period + shape.left_offset % shape.period;
+            Index aligned_right = right - right % shape.period + shape.right_offset % shape.period;
+            if (aligned_right >= n && aligned_right >= shape.period) {
+                aligned_right -= shape.period;
+            }
+            if (aligned_left <= aligned_right && aligned_right < n) {
+                left = aligned_left;
+                right = aligned_right;
+            }
+        }
+        queries.emplace_back(left, right);
+    }
+    return queries;
+}
+
+/**
+ * @brief Apply one random structural change to data
+ * @return Name of the change
+ */
+inline const char* mutateInput(std::vector<Value>& data, std::mt19937& gen) {
+    Size n = data.size();
+    if (n < 2) return "none";
+    
+    // Segments from half the array down to a few elements
+    Size length = std::max<Size>(2, n >> std::uniform_int_distribution<int>(1, 10)(gen));
+    length = std::min(length, n);
+    Index start = std::uniform_int_distribution<Index>(0, n - length)(gen);
+    auto first = data.begin() + start;
+    auto last = first + length;
+    
+    switch (std::uniform_int_distribution<int>(0, 6)(gen)) {
+        case 0:
+            std::reverse(first, last);
+            return "reverse";
+        case 1:
+            std::sort(first, last);
+            return "sort";
+        case 2:
+            std::sort(first, last, [](Value a, Value b) { return a > b; });
+            return "sort-desc";
+        case 3: {
+            // A strictly increasing run from the segment's minimum deepens the tree
+            Value low = *std::min_element(first, last);
+            Size headroom = static_cast<Size>(static_cast<int64_t>(std::numeric_limits<Value>::max()) - low);
+            for (Size i = 0; i < length; ++i) {
+                first[i] = low + static_cast<Value>(std::min(i, headroom));
+            }
+            return "plant-run";
+        }
+        case 4:
+            std::fill(first, last, *first);
+            return "flatten";
+        case 5: {
+            std::uniform_int_distribution<Index> position(0, n - 1);
+            std::uniform_int_distribution<Value> value(-1000000, 1000000);
+            for (Size i = 0; i < std::max<Size>(1, n / 100); ++i) {
+                data[position(gen)] = value(gen);
+            }
+            return "perturb";
+        }
+        default: {
+            Index target = std::uniform_int_distribution<Index>(0, n - length)(gen);
+            std::copy(first, last, data.begin() + target);
+            return "splice";
+        }
+    }
+}
+
+/**
+ * @brief Apply one random change to a query shape for n elements
+ * @return Name of the change
+ */
+inline const char* mutateShape(QueryShape& shape, Size n, std::mt19937& gen) {
+    Size block = static_cast<Size>(std::sqrt(static_cast<double>(n))) + 1;
+    
+    switch (std::uniform_int_distribution<int>(0, 4)(gen)) {
+        case 0: {
+            const Size periods[] = {0, block, 2 * block, 16, 64, block + 1, block - 1};
+            shape.period = periods[std::uniform_int_distribution<int>(0, 6)(gen)];
+            shape.left_offset = 1;
+            shape.right_offset = shape.period > 2 ? shape.period - 2 : 0;
+            return "period";
+        }
+        case 1:
+            if (shape.period > 1) {
+                shape.left_offset = std::uniform_int_distribution<Size>(0, shape.period - 1)(gen);
+            }
+            return "left-offset";
+        case 2:
+            if (shape.period > 1) {
+                shape.right_offset = std::uniform_int_distribution<Size>(0, shape.period - 1)(gen);
+            }
+            return "right-offset";
+        case 3: {
+            Size max_length = shape.max_length == 0 ? n : shape.max_length;
+            max_length = std::uniform_int_distribution<int>(0, 1)(gen) == 0 ? max_length / 2 : max_length * 2;
+            shape.max_length = std::min(std::max<Size>(1, max_length), n);
+            shape.min_length = std::min(shape.min_length, shape.max_length);
+            return "max-length";
+        }
+        default: {
+            Size max_length = shape.max_length == 0 ? n : shape.max_length;
+            shape.min_length = std::uniform_int_distribution<Size>(1, max_length)(gen);
+            return "min-length";
+        }
+    }
+}
+
+} // namespace adversarial
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_ADVERSARIAL_H
@@ -1,14 +1,22 @@
 #ifndef RMQ_CORE_RMQ_BASE_H
 #define RMQ_CORE_RMQ_BASE_H
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <istream>
+#include <ostream>
+#include <utility>
 #include "rmq_types.h"
 #include "rmq_exception.h"
 
 namespace rmq {
 
+namespace recording {
+class IRecorder;
+}
+
 /**
  * @brief Abstract interface for all RMQ algorithms
  * 
@@ -49,6 +57,38 @@ public:
      */
     virtual QueryResult queryDetailed(Index left, Index right) const = 0;
     
+    /**
+     * @brief Query the minimum value without throwing
+     * 
+     * Reports validation failures as a status code instead of an exception,
+     * and never allocates. The index field of the outcome is not filled.
+     * An attached recorder (see setRecorder()) is called on this path as
+     * well; RecordingWriter neither allocates, locks nor does I/O there.
+     * 
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Outcome holding the status and, on success, the minimum value
+     */
+    virtual QueryOutcome tryQuery(Index left, Index right) const noexcept = 0;
+    
+    /**
+     * @brief Query the minimum value and its index without throwing
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Outcome holding the status and, on success, value and index
+     */
+    virtual QueryOutcome tryQueryDetailed(Index left, Index right) const noexcept = 0;
+    
+    /**
+     * @brief Answer a batch of queries without throwing
+     * @param queries Array of count queries
+     * @param count Number of queries
+     * @param results Caller-owned array of at least count outcomes
+     * @return Number of queries that succeeded
+     */
+    virtual Size tryQueryBatch(const Query* queries, Size count,
+                               QueryOutcome* results) const noexcept = 0;
+    
     /**
      * @brief Get the name of the algorithm
      * @return Human-readable algorithm name
@@ -73,6 +113,25 @@ public:
      */
     virtual bool supportsUpdate() const = 0;
     
+    /**
+     * @brief Update a single element
+     * @param index Index to update
+     * @param value New value
+     * @throws NotSupportedException if supportsUpdate() is false
+     * @throws BoundsException if index is out of bounds
+     * @throws NotPreprocessedException if not preprocessed
+     */
+    virtual void update(Index index, Value value) = 0;
+    
+    /**
+     * @brief Batch update multiple elements
+     * @param updates Vector of pairs (index, new_value)
+     * @throws NotSupportedException if supportsUpdate() is false
+     * @throws BoundsException if any index is out of bounds
+     * @throws NotPreprocessedException if not preprocessed
+     */
+    virtual void batchUpdate(const std::vector<std::pair<Index, Value>>& updates) = 0;
+    
     /**
      * @brief Check if the algorithm has been preprocessed
      * @return true if preprocessed, false otherwise
@@ -94,10 +153,20 @@ public:
  */
 class RMQBase : public IRMQAlgorithm {
 protected:
-    std::vector<Value> data_;           ///< The input data
+    std::vector<Value> data_;           ///< The input data (empty if released, see valueAt())
+    Size size_;                          ///< Number of elements, kept if data_ is released
     bool preprocessed_;                  ///< Whether preprocessing is complete
-    mutable Duration last_query_time_;  ///< Time taken for the last query
+    mutable std::atomic<Duration::rep> last_query_time_;  ///< Time taken for the last query (ms)
     AlgorithmConfig config_;             ///< Algorithm configuration
+    recording::IRecorder* recorder_;     ///< Receives queries and updates (not owned, may be null)
+    
+    /**
+     * @brief Pass an update to the recorder, if one is attached
+     * 
+     * Algorithms that support updates call this once per element, after
+     * validating the index.
+     */
+    void recordUpdate(Index index, Value value) const noexcept;
     
     /**
      * @brief Validate query indices
@@ -108,6 +177,14 @@ protected:
      */
     void validateQuery(Index left, Index right) const;
     
+    /**
+     * @brief Check a query against the current state without throwing
+     * @param left Left boundary
+     * @param right Right boundary
+     * @return QueryStatus::OK if the query can be answered
+     */
+    QueryStatus checkQuery(Index left, Index right) const noexcept;
+    
     /**
      * @brief Validate input data
      * @param data The input data to validate
@@ -134,6 +211,41 @@ protected:
      */
     virtual Value performQuery(Index left, Index right) const = 0;
     
+    /**
+     * @brief Write the algorithm-specific structure of a binary index
+     * 
+     * The default writes nothing; loadStructure() then rebuilds the
+     * structure from data_. Algorithms override the pair to restore
+     * without re-preprocessing.
+     * 
+     * @param out Destination stream
+     */
+    virtual void saveStructure(std::ostream& out) const;
+    
+    /**
+     * @brief Restore the structure written by saveStructure()
+     * @param in Source stream positioned after the array data
+     * @throws InvalidDataException if the stream is truncated or corrupt
+     */
+    virtual void loadStructure(std::istream& in);
+    
+    /**
+     * @brief Value of one element
+     * 
+     * Algorithms that keep the data in another form (e.g. compressed) may
+     * release data_ after preprocessing; they override this and copyData().
+     */
+    virtual Value valueAt(Index index) const {
+        return data_[index];
+    }
+    
+    /**
+     * @brief The whole array, as written by saveIndex()
+     */
+    virtual std::vector<Value> copyData() const {
+        return data_;
+    }
+    
     /**
      * @brief Find the index of the minimum value (optional override)
      * @param left Left boundary
@@ -142,6 +254,14 @@ protected:
      */
     virtual Index findMinimumIndex(Index left, Index right) const;
     
+    /**
+     * @brief Minimum value and its index, as used by the detailed queries
+     * 
+     * Defaults to findMinimumIndex() followed by valueAt(). Algorithms whose
+     * data may change during a query override it so both come from one pass.
+     */
+    virtual std::pair<Value, Index> findMinimum(Index left, Index right) const;
+    
 public:
     /**
      * @brief Default constructor
@@ -181,6 +301,69 @@ public:
      */
     QueryResult queryDetailed(Index left, Index right) const override final;
     
+    /**
+     * @brief Query the minimum value without throwing
+     * 
+     * Unlike query(), this does not record getLastQueryTime().
+     * 
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Outcome holding the status and, on success, the minimum value
+     */
+    QueryOutcome tryQuery(Index left, Index right) const noexcept override final;
+    
+    /**
+     * @brief Query the minimum value and its index without throwing
+     * @param left Left boundary (inclusive)
+     * @param right Right boundary (inclusive)
+     * @return Outcome holding the status and, on success, value and index
+     */
+    QueryOutcome tryQueryDetailed(Index left, Index right) const noexcept override final;
+    
+    /**
+     * @brief Answer a batch of queries without throwing
+     * @param queries Array of count queries
+     * @param count Number of queries
+     * @param results Caller-owned array of at least count outcomes
+     * @return Number of queries that succeeded
+     */
+    Size tryQueryBatch(const Query* queries, Size count,
+                       QueryOutcome* results) const noexcept override final;
+    
+    /**
+     * @brief Update a single element (not supported by default)
+     * @throws NotSupportedException unless overridden
+     */
+    void update(Index index, Value value) override;
+    
+    /**
+     * @brief Batch update multiple elements (not supported by default)
+     * @throws NotSupportedException unless overridden
+     */
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates) override;
+    
+    /**
+     * @brief Write the preprocessed index in the binary index format
+     * 
+     * Format: rmq::serialization header, array size, array data, then the
+     * algorithm-specific structure.
+     * 
+     * @param out Destination stream (opened in binary mode)
+     * @throws NotPreprocessedException if not preprocessed
+     */
+    void saveIndex(std::ostream& out) const;
+    
+    /**
+     * @brief Load an index written by saveIndex() for the same algorithm type
+     * 
+     * Any previous state is discarded; if loading fails the algorithm is
+     * left unpreprocessed.
+     * 
+     * @param in Source stream (opened in binary mode)
+     * @throws InvalidDataException if the stream is corrupt or of another type
+     */
+    void loadIndex(std::istream& in);
+    
     /**
      * @brief Check if the algorithm has been preprocessed
      * @return true if preprocessed, false otherwise
@@ -194,7 +377,7 @@ public:
      * @return Size of the array, 0 if not preprocessed
      */
     Size size() const override final {
-        return data_.size();
+        return size_;
     }
     
     /**
@@ -213,12 +396,30 @@ public:
         config_ = config;
     }
     
+    /**
+     * @brief Attach a recorder for every valid query and update (nullptr detaches)
+     * 
+     * The recorder must outlive the attachment. Attach it before the
+     * algorithm is shared between threads.
+     */
+    void setRecorder(recording::IRecorder* recorder) {
+        recorder_ = recorder;
+    }
+    
+    recording::IRecorder* getRecorder() const {
+        return recorder_;
+    }
+    
     /**
      * @brief Get the last query time
+     * 
+     * Safe while other threads query; it then reports whichever query
+     * finished last.
+     * 
      * @return Duration of the last query
      */
     Duration getLastQueryTime() const {
-        return last_query_time_;
+        return Duration(last_query_time_.load(std::memory_order_relaxed));
     }
     
     /**
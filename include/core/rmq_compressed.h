@@ -0,0 +1,161 @@
+#ifndef RMQ_CORE_RMQ_COMPRESSED_H
+#define RMQ_CORE_RMQ_COMPRESSED_H
+
+#include <cstdint>
+#include <vector>
+#include "rmq_types.h"
+
+namespace rmq {
+
+/**
+ * @brief Block-compressed, updatable array of values
+ *
+ * The array is cut into fixed-size blocks and each block is stored in the
+ * smaller of two encodings:
+ * - FRAME_OF_REFERENCE: value - block minimum, bit-packed at the width of
+ *   the largest difference (narrow ranges and small deltas; a constant
+ *   block stores nothing)
+ * - RUN_LENGTH: (start, value) per run of equal values (constant stretches)
+ *
+ * Each block's minimum and the offset of its leftmost occurrence are kept
+ * uncompressed, so range scans only decode the partial blocks at either
+ * end. Partial scans decode a chunk at a time (see kernels::scanMinPacked)
+ * and never materialise the block.
+ *
+ * Used by RMQNaive and RMQBlockDecomposition when
+ * AlgorithmConfig::compress_data is set.
+ */
+class CompressedArray {
+public:
+    /**
+     * @brief Block encodings
+     */
+    enum class Encoding : uint8_t {
+        FRAME_OF_REFERENCE,
+        RUN_LENGTH
+    };
+    
+    /**
+     * @brief Block size used when none is given
+     */
+    static constexpr Size DEFAULT_BLOCK_SIZE = 256;
+    
+    CompressedArray();
+    
+    /**
+     * @brief Compress data
+     * @param data Values to store
+     * @param block_size Elements per block (below 2^32)
+     * @throws ConfigurationException if block_size is 0 or too large
+     */
+    explicit CompressedArray(const std::vector<Value>& data, Size block_size = DEFAULT_BLOCK_SIZE);
+    
+    Size size() const {
+        return size_;
+    }
+    
+    bool empty() const {
+        return size_ == 0;
+    }
+    
+    Size blockSize() const {
+        return block_size_;
+    }
+    
+    Size numBlocks() const {
+        return blocks_.size();
+    }
+    
+    /**
+     * @brief Value at index (no bounds check)
+     */
+    Value get(Index index) const;
+    
+    /**
+     * @brief Set the value at index and re-encode its block (no bounds check)
+     */
+    void set(Index index, Value value);
+    
+    /**
+     * @brief Minimum of [left, right] (no bounds check)
+     */
+    Value scanMin(Index left, Index right) const;
+    
+    /**
+     * @brief Index of the leftmost minimum of [left, right] (no bounds check)
+     */
+    Index scanMinIndex(Index left, Index right) const;
+    
+    /**
+     * @brief Minimum of a whole block (stored uncompressed)
+     */
+    Value blockMin(size_t block) const {
+        return blocks_[block].min;
+    }
+    
+    /**
+     * @brief Index of the leftmost minimum of a whole block
+     */
+    Index blockMinIndex(size_t block) const {
+        return block * block_size_ + blocks_[block].min_offset;
+    }
+    
+    Encoding blockEncoding(size_t block) const {
+        return blocks_[block].encoding;
+    }
+    
+    /**
+     * @brief Decompress the whole array
+     */
+    std::vector<Value> decode() const;
+    
+    /**
+     * @brief Heap bytes used (block headers and payloads)
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    struct Block {
+        Value min;              ///< Block minimum (uncompressed)
+        uint32_t min_offset;    ///< Offset of its leftmost occurrence
+        Encoding encoding;
+        uint8_t bit_width;      ///< FRAME_OF_REFERENCE only
+        
+        /// FRAME_OF_REFERENCE: packed differences (kernels::packBits layout)
+        /// RUN_LENGTH: two words per run, start offset then value bits
+        std::vector<uint32_t> words;
+    };
+    
+    Size size_;
+    Size block_size_;
+    std::vector<Block> blocks_;
+    
+    Index blockStart(size_t block) const {
+        return block * block_size_;
+    }
+    
+    Size blockLength(size_t block) const;
+    
+    void encodeBlock(size_t block, const Value* values);
+    
+    void decodeBlock(size_t block, Value* out) const;
+    
+    /**
+     * @brief Run holding offset (RUN_LENGTH blocks)
+     */
+    static size_t findRun(const Block& block, Index offset);
+    
+    /**
+     * @brief Minimum of offsets [first, last] of one block
+     */
+    Value blockScanMin(const Block& block, Index first, Index last) const;
+    
+    /**
+     * @brief Offset of the leftmost minimum of offsets [first, last] of one block
+     */
+    Index blockScanMinIndex(const Block& block, Index first, Index last) const;
+};
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_COMPRESSED_H
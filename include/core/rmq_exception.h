@@ -132,6 +132,15 @@ public:
     explicit InvalidDataException(Size size)
         : RMQException(createMessage(size)) {}
     
+    /**
+     * @brief Constructor for data exceeding a configured maximum size
+     * @param size The invalid size
+     * @param max_size The configured maximum
+     */
+    InvalidDataException(Size size, Size max_size)
+        : RMQException("Input data size " + std::to_string(size) + 
+                       " exceeds maximum allowed size " + std::to_string(max_size)) {}
+    
     /**
      * @brief Constructor with custom message
      * @param message Custom error message
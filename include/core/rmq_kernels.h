@@ -0,0 +1,553 @@
+#ifndef RMQ_CORE_RMQ_KERNELS_H
+#define RMQ_CORE_RMQ_KERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "rmq_types.h"
+
+namespace rmq {
+
+/**
+ * @brief Inner loops shared by the algorithms
+ *
+ * Each kernel works on raw arrays with no validation, virtual dispatch or
+ * timing, so the algorithms call them from performQuery/performPreprocess
+ * and benchmarks/benchmark_kernels.cpp can measure exactly the code that
+ * ships. Callers are responsible for bounds.
+ */
+namespace kernels {
+
+/**
+ * @brief Minimum of data[left..right]
+ *
+ * Written as an unconditional min so the compiler can vectorize it.
+ */
+inline Value scanMin(const Value* data, Index left, Index right) {
+    Value min_value = data[left];
+    for (Index i = left + 1; i <= right; ++i) {
+        min_value = std::min(min_value, data[i]);
+    }
+    return min_value;
+}
+
+/**
+ * @brief Index of the leftmost minimum of data[left..right]
+ */
+inline Index scanMinIndex(const Value* data, Index left, Index right) {
+    Value min_value = data[left];
+    Index min_index = left;
+    for (Index i = left + 1; i <= right; ++i) {
+        if (data[i] < min_value) {
+            min_value = data[i];
+            min_index = i;
+        }
+    }
+    return min_index;
+}
+
+/**
+ * @brief Bit-packing layout used by CompressedArray
+ *
+ * Values are packed in chunks of PACKED_CHUNK. Within a chunk, value i
+ * belongs to lane i % PACKED_LANES and each lane packs its 32 values into
+ * its own 32-bit words; word w of lane l is stored at w * PACKED_LANES + l.
+ * A chunk of width-bit values therefore takes width * PACKED_LANES words,
+ * and every lane extracts a value with the same shift, so unpacking runs
+ * across the lanes with plain vector shifts and masks.
+ */
+constexpr Size PACKED_LANES = 8;
+constexpr Size PACKED_CHUNK = 32 * PACKED_LANES;
+
+/**
+ * @brief Number of 32-bit words packBits() writes for count values (whole chunks)
+ */
+inline Size packedWords(Size count, unsigned width) {
+    return (count + PACKED_CHUNK - 1) / PACKED_CHUNK * width * PACKED_LANES;
+}
+
+/**
+ * @brief Position of value index: first word and shift within it
+ */
+inline void packedPosition(Index index, unsigned width, Index& word, unsigned& shift) {
+    Index chunk = index / PACKED_CHUNK;
+    Index lane = index % PACKED_LANES;
+    Index bit = (index % PACKED_CHUNK) / PACKED_LANES * width;
+    word = chunk * width * PACKED_LANES + bit / 32 * PACKED_LANES + lane;
+    shift = static_cast<unsigned>(bit % 32);
+}
+
+/**
+ * @brief Pack count values of width bits (width <= 32)
+ * @param words packedWords(count, width) zeroed words
+ */
+inline void packBits(const uint32_t* values, Size count, unsigned width, uint32_t* words) {
+    if (width == 0) return;
+    
+    for (Index i = 0; i < count; ++i) {
+        Index word;
+        unsigned shift;
+        packedPosition(i, width, word, shift);
+        words[word] |= values[i] << shift;
+        if (shift + width > 32) {
+            words[word + PACKED_LANES] |= values[i] >> (32 - shift);
+        }
+    }
+}
+
+/**
+ * @brief Unpack a single value (random access)
+ */
+inline uint32_t unpackValue(const uint32_t* words, unsigned width, Index index) {
+    if (width == 0) return 0;
+    
+    Index word;
+    unsigned shift;
+    packedPosition(index, width, word, shift);
+    uint64_t value = words[word] >> shift;
+    if (shift + width > 32) {
+        value |= static_cast<uint64_t>(words[word + PACKED_LANES]) << (32 - shift);
+    }
+    return static_cast<uint32_t>(value & ((uint64_t(1) << width) - 1));
+}
+
+/**
+ * @brief Unpack one chunk of Width-bit values
+ *
+ * The outer loop is unrolled so every word offset and shift is a constant;
+ * the inner loop over lanes is what vectorizes.
+ */
+template <unsigned Width>
+inline void unpackChunkFixed(const uint32_t* words, uint32_t* out) {
+    constexpr uint32_t mask = static_cast<uint32_t>((uint64_t(1) << Width) - 1);
+    if constexpr (Width == 0) {
+        // Constant block: nothing is stored
+        std::fill(out, out + PACKED_CHUNK, 0u);
+        return;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 32
+#endif
+    for (unsigned k = 0; k < PACKED_CHUNK / PACKED_LANES; ++k) {
+        const unsigned bit = k * Width;
+        const unsigned shift = bit % 32;
+        const uint32_t* low = words + bit / 32 * PACKED_LANES;
+        uint32_t* target = out + k * PACKED_LANES;
+        
+        if (shift + Width > 32) {
+            const uint32_t* high = low + PACKED_LANES;
+            for (unsigned lane = 0; lane < PACKED_LANES; ++lane) {
+                target[lane] = ((low[lane] >> shift) | ((high[lane] << 1) << (31 - shift))) & mask;
+            }
+        } else {
+            for (unsigned lane = 0; lane < PACKED_LANES; ++lane) {
+                target[lane] = (low[lane] >> shift) & mask;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Minimum of one whole chunk of Width-bit values, without storing them
+ */
+template <unsigned Width>
+inline uint32_t minChunkFixed(const uint32_t* words) {
+    constexpr uint32_t mask = static_cast<uint32_t>((uint64_t(1) << Width) - 1);
+    if constexpr (Width == 0) {
+        return 0;
+    }
+    uint32_t lane_min[PACKED_LANES];
+    for (unsigned lane = 0; lane < PACKED_LANES; ++lane) {
+        lane_min[lane] = mask;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC unroll 32
+#endif
+    for (unsigned k = 0; k < PACKED_CHUNK / PACKED_LANES; ++k) {
+        const unsigned bit = k * Width;
+        const unsigned shift = bit % 32;
+        const uint32_t* low = words + bit / 32 * PACKED_LANES;
+        
+        if (shift + Width > 32) {
+            const uint32_t* high = low + PACKED_LANES;
+            for (unsigned lane = 0; lane < PACKED_LANES; ++lane) {
+                uint32_t value = ((low[lane] >> shift) | ((high[lane] << 1) << (31 - shift))) & mask;
+                lane_min[lane] = std::min(lane_min[lane], value);
+            }
+        } else {
+            for (unsigned lane = 0; lane < PACKED_LANES; ++lane) {
+                lane_min[lane] = std::min(lane_min[lane], (low[lane] >> shift) & mask);
+            }
+        }
+    }
+    
+    uint32_t min_value = lane_min[0];
+    for (unsigned lane = 1; lane < PACKED_LANES; ++lane) {
+        min_value = std::min(min_value, lane_min[lane]);
+    }
+    return min_value;
+}
+
+template <size_t... Widths>
+inline uint32_t minChunkDispatch(unsigned width, const uint32_t* words, std::index_sequence<Widths...>) {
+    using MinChunk = uint32_t (*)(const uint32_t*);
+    static constexpr MinChunk table[] = {&minChunkFixed<static_cast<unsigned>(Widths)>...};
+    return table[width](words);
+}
+
+template <size_t... Widths>
+inline void unpackChunkDispatch(unsigned width, const uint32_t* words, uint32_t* out,
+                                std::index_sequence<Widths...>) {
+    using Unpack = void (*)(const uint32_t*, uint32_t*);
+    static constexpr Unpack table[] = {&unpackChunkFixed<static_cast<unsigned>(Widths)>...};
+    table[width](words, out);
+}
+
+/**
+ * @brief Unpack chunk number chunk of values packed at width bits (width <= 32)
+ * @param out PACKED_CHUNK values
+ */
+inline void unpackChunk(const uint32_t* words, unsigned width, Index chunk, uint32_t* out) {
+    unpackChunkDispatch(width, words + chunk * width * PACKED_LANES, out,
+                        std::make_index_sequence<33>());
+}
+
+/**
+ * @brief Minimum of the whole chunk number chunk (width <= 32)
+ */
+inline uint32_t minChunk(const uint32_t* words, unsigned width, Index chunk) {
+    return minChunkDispatch(width, words + chunk * width * PACKED_LANES, std::make_index_sequence<33>());
+}
+
+/**
+ * @brief Minimum of packed values [first, first + count)
+ *
+ * Whole chunks are reduced while decoding; the partial chunks at either
+ * end are decoded into a stack buffer. Either way the scan reads width/32
+ * of the bytes of an unpacked scan.
+ */
+inline uint32_t scanMinPacked(const uint32_t* words, unsigned width, Index first, Size count) {
+    uint32_t buffer[PACKED_CHUNK];
+    uint32_t min_value = std::numeric_limits<uint32_t>::max();
+    Index last = first + count - 1;
+    
+    for (Index chunk = first / PACKED_CHUNK; chunk <= last / PACKED_CHUNK; ++chunk) {
+        Index begin = chunk * PACKED_CHUNK;
+        if (first <= begin && begin + PACKED_CHUNK - 1 <= last) {
+            min_value = std::min(min_value, minChunk(words, width, chunk));
+            continue;
+        }
+        
+        unpackChunk(words, width, chunk, buffer);
+        Index from = std::max(first, begin) - begin;
+        Index to = std::min(last, begin + PACKED_CHUNK - 1) - begin;
+        for (Index i = from; i <= to; ++i) {
+            min_value = std::min(min_value, buffer[i]);
+        }
+    }
+    return min_value;
+}
+
+/**
+ * @brief Offset (from first) of the leftmost minimum of packed values
+ */
+inline Index scanMinIndexPacked(const uint32_t* words, unsigned width, Index first, Size count) {
+    uint32_t buffer[PACKED_CHUNK];
+    uint32_t min_value = std::numeric_limits<uint32_t>::max();
+    Index min_index = first;
+    Index last = first + count - 1;
+    
+    for (Index chunk = first / PACKED_CHUNK; chunk <= last / PACKED_CHUNK; ++chunk) {
+        unpackChunk(words, width, chunk, buffer);
+        Index begin = chunk * PACKED_CHUNK;
+        Index from = std::max(first, begin) - begin;
+        Index to = std::min(last, begin + PACKED_CHUNK - 1) - begin;
+        for (Index i = from; i <= to; ++i) {
+            if (buffer[i] < min_value) {
+                min_value = buffer[i];
+                min_index = begin + i;
+            }
+        }
+    }
+    return min_index - first;
+}
+
+/**
+ * @brief Build one sparse table level from the level below it
+ *
+ * values[i] = min(prev_values[i], prev_values[i + half]) for i < count,
+ * keeping the left candidate on ties so indices stay leftmost.
+ */
+inline void buildSparseLevel(const Value* prev_values, const Index* prev_indices,
+                             Size count, Size half,
+                             Value* values, Index* indices) {
+    for (Index i = 0; i < count; ++i) {
+        Value left_value = prev_values[i];
+        Value right_value = prev_values[i + half];
+        Index left_index = prev_indices[i];
+        Index right_index = prev_indices[i + half];
+        bool take_right = right_value < left_value;
+        values[i] = take_right ? right_value : left_value;
+        indices[i] = take_right ? right_index : left_index;
+    }
+}
+
+/**
+ * @brief Combine the two overlapping power-of-two ranges of a sparse query
+ * @param level Values of the level with 2^k >= half the range length
+ * @param left Start of the first range
+ * @param right_start Start of the second range (right - 2^k + 1)
+ */
+inline Value sparseLookup(const Value* level, Index left, Index right_start) {
+    return std::min(level[left], level[right_start]);
+}
+
+/**
+ * @brief Index variant of sparseLookup() (leftmost on ties)
+ */
+inline Index sparseLookupIndex(const Value* level, const Index* indices,
+                               Index left, Index right_start) {
+    return level[left] <= level[right_start] ? indices[left] : indices[right_start];
+}
+
+/**
+ * @brief One (value, index) pair in a single 64-bit key
+ *
+ * The value, biased to unsigned by flipping its sign bit, fills the high
+ * half and the index the low half, so keys compare as unsigned integers
+ * by value first and index second: the smallest key is the leftmost
+ * minimum, and a plain min over keys yields the value and its index at
+ * once. Indices must be below PACKED_MAX_SIZE.
+ */
+using PackedEntry = uint64_t;
+
+static_assert(sizeof(Value) == 4, "packed entries hold a 32-bit value");
+
+/**
+ * @brief Arrays up to this size can use packed entries
+ */
+constexpr Size PACKED_MAX_SIZE = Size(1) << 32;
+
+inline PackedEntry packEntry(Value value, Index index) {
+    uint32_t biased = static_cast<uint32_t>(value) ^ 0x80000000u;
+    return (static_cast<PackedEntry>(biased) << 32) | static_cast<uint32_t>(index);
+}
+
+inline Value packedValue(PackedEntry entry) {
+    return static_cast<Value>(static_cast<uint32_t>(entry >> 32) ^ 0x80000000u);
+}
+
+inline Index packedIndex(PackedEntry entry) {
+    return static_cast<Index>(entry & 0xFFFFFFFFu);
+}
+
+/**
+ * @brief Smallest entry of entries[left..right]
+ *
+ * An unconditional unsigned min, so it vectorizes like scanMin().
+ */
+inline PackedEntry scanMinEntry(const PackedEntry* entries, Index left, Index right) {
+    PackedEntry min_entry = entries[left];
+    for (Index i = left + 1; i <= right; ++i) {
+        min_entry = std::min(min_entry, entries[i]);
+    }
+    return min_entry;
+}
+
+/**
+ * @brief Packed variant of buildSparseLevel(): one min per entry, ties
+ * resolved by the index bits
+ */
+inline void buildPackedLevel(const PackedEntry* prev, Size count, Size half, PackedEntry* entries) {
+    for (Index i = 0; i < count; ++i) {
+        entries[i] = std::min(prev[i], prev[i + half]);
+    }
+}
+
+/**
+ * @brief Packed variant of sparseLookup(): value and leftmost index together
+ */
+inline PackedEntry packedLookup(const PackedEntry* level, Index left, Index right_start) {
+    return std::min(level[left], level[right_start]);
+}
+
+/**
+ * @brief Keys per S-tree node: 16 Values fill one 64-byte cache line
+ */
+constexpr Size NODE_KEYS = 16;
+
+/**
+ * @brief Minimum of keys [first, last] of one S-tree node
+ *
+ * Always reads all NODE_KEYS keys and masks the ones outside the range
+ * with 32-bit and/or, so the loop has a fixed trip count, no branches and
+ * lanes as wide as a Value; the compiler turns it into a few vector
+ * compares and mins (pminsd with SSE4.1 or AVX2).
+ */
+inline Value minNode(const Value* node, Index first, Index last) {
+    const int32_t from = static_cast<int32_t>(first);
+    const int32_t to = static_cast<int32_t>(last);
+    Value min_value = std::numeric_limits<Value>::max();
+    for (int32_t i = 0; i < static_cast<int32_t>(NODE_KEYS); ++i) {
+        int32_t inside = -static_cast<int32_t>((i >= from) & (i <= to));
+        Value key = (node[i] & inside) | (std::numeric_limits<Value>::max() & ~inside);
+        min_value = std::min(min_value, key);
+    }
+    return min_value;
+}
+
+/**
+ * @brief Position of the first key equal to value in one S-tree node (NODE_KEYS if none)
+ */
+inline Index findInNode(const Value* node, Index first, Value value) {
+    for (Index i = first; i < NODE_KEYS; ++i) {
+        if (node[i] == value) {
+            return i;
+        }
+    }
+    return NODE_KEYS;
+}
+
+/**
+ * @brief Build one S-tree level: values[j] = minimum of node j of the level below
+ * @param prev Level below, padded to count * NODE_KEYS keys
+ */
+inline void buildNodeLevel(const Value* prev, Size count, Value* values) {
+    for (Index j = 0; j < count; ++j) {
+        values[j] = minNode(prev + j * NODE_KEYS, 0, NODE_KEYS - 1);
+    }
+}
+
+/**
+ * @brief Cartesian tree node of RMQLCABased
+ *
+ * Defined here so benchmarks/benchmark_kernels.cpp builds trees with the
+ * same layout as the library.
+ */
+struct CartesianNode {
+    Value value;           ///< Value at this node
+    Index array_index;     ///< Original array index
+    int left_child;        ///< Index of left child (-1 if none)
+    int right_child;       ///< Index of right child (-1 if none)
+    int parent;            ///< Index of parent (-1 if root)
+    int depth;             ///< Depth in the tree
+    
+    CartesianNode() 
+        : value(0), array_index(0), 
+          left_child(-1), right_child(-1), 
+          parent(-1), depth(0) {}
+};
+
+/**
+ * @brief Link nodes[0..n) into a Cartesian tree with the rightmost-path stack
+ *
+ * Node needs int members parent, left_child and right_child (initialised to
+ * -1) and a value member. Equal values make the later node a right
+ * descendant, so the LCA of a range is its leftmost minimum.
+ *
+ * @param stack Scratch space (reused to avoid allocation)
+ * @return Index of the root (-1 if n == 0)
+ */
+template <typename Node>
+inline int buildCartesianTree(Node* nodes, Size n, std::vector<int>& stack) {
+    stack.clear();
+    
+    for (int i = 0; i < static_cast<int>(n); ++i) {
+        int last_popped = -1;
+        
+        // Pop elements from stack that are greater than current
+        while (!stack.empty() && nodes[stack.back()].value > nodes[i].value) {
+            last_popped = stack.back();
+            stack.pop_back();
+        }
+        
+        // Current node becomes right child of stack top
+        if (!stack.empty()) {
+            nodes[stack.back()].right_child = i;
+            nodes[i].parent = stack.back();
+        }
+        
+        // Last popped becomes left child of current
+        if (last_popped != -1) {
+            nodes[i].left_child = last_popped;
+            nodes[last_popped].parent = i;
+        }
+        
+        stack.push_back(i);
+    }
+    
+    return stack.empty() ? -1 : stack.front();
+}
+
+/**
+ * @brief Set the depth member of every node below root
+ *
+ * Iterative, so degenerate (sorted) inputs whose tree is a single path do
+ * not overflow the call stack.
+ */
+template <typename Node>
+inline void computeDepths(Node* nodes, int root, std::vector<int>& stack) {
+    stack.clear();
+    if (root == -1) return;
+    
+    nodes[root].depth = 0;
+    stack.push_back(root);
+    
+    while (!stack.empty()) {
+        int node = stack.back();
+        stack.pop_back();
+        
+        for (int child : {nodes[node].left_child, nodes[node].right_child}) {
+            if (child != -1) {
+                nodes[child].depth = nodes[node].depth + 1;
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Lowest common ancestor by binary lifting
+ * @param nodes Tree nodes (depth member is used)
+ * @param up Level-major ancestor table: up[j][v] = 2^j-th ancestor of v or -1
+ * @return LCA of u and v
+ */
+template <typename Node>
+inline int liftLCA(const Node* nodes, const std::vector<std::vector<int>>& up, int u, int v) {
+    // Ensure u is at the same or deeper level than v
+    if (nodes[u].depth < nodes[v].depth) {
+        std::swap(u, v);
+    }
+    
+    // Bring u up to the same level as v
+    int depth_diff = nodes[u].depth - nodes[v].depth;
+    for (int j = 0; depth_diff != 0; ++j, depth_diff >>= 1) {
+        if (depth_diff & 1) {
+            u = up[j][u];
+        }
+    }
+    
+    if (u == v) {
+        return u;
+    }
+    
+    // Binary search for the LCA
+    for (int j = static_cast<int>(up.size()) - 1; j >= 0; --j) {
+        const std::vector<int>& level = up[j];
+        if (level[u] != level[v]) {
+            u = level[u];
+            v = level[v];
+        }
+    }
+    
+    // Parent of u (or v) is the LCA
+    return up[0][u];
+}
+
+} // namespace kernels
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_KERNELS_H
@@ -0,0 +1,233 @@
+#ifndef RMQ_CORE_RMQ_RECORDING_H
+#define RMQ_CORE_RMQ_RECORDING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rmq_types.h"
+#include "rmq_exception.h"
+#include "rmq_workload.h"
+
+namespace rmq {
+
+/**
+ * @brief Capture of the queries and updates an algorithm serves, for replay
+ *
+ * A recording holds a reference to a snapshot of the array (a name or
+ * path, plus its size and checksum; not the data) and the stream of
+ * operations with their times. Recordings can be shared where the data
+ * cannot, and replayed against any algorithm by the complexity benchmark
+ * (--replay).
+ *
+ * Attach a recorder to an algorithm with RMQBase::setRecorder(). With none
+ * attached the hook costs one pointer test per query or update.
+ */
+namespace recording {
+
+/**
+ * @brief Receiver of recorded operations
+ *
+ * Implementations must be thread-safe: concurrent algorithms take queries
+ * and updates from several threads. They run on the query path, including
+ * RMQBase::tryQuery(), so they should neither allocate nor lock there.
+ */
+class IRecorder {
+public:
+    virtual ~IRecorder() = default;
+    
+    /**
+     * @brief A valid query over [left, right] is being answered
+     */
+    virtual void recordQuery(Index left, Index right) noexcept = 0;
+    
+    /**
+     * @brief data[index] is being set to value
+     */
+    virtual void recordUpdate(Index index, Value value) noexcept = 0;
+};
+
+/**
+ * @brief Magic bytes at the start of every recording
+ */
+constexpr char RECORDING_MAGIC[8] = {'R', 'M', 'Q', 'T', 'R', 'A', 'C', 'E'};
+
+/**
+ * @brief Current version of the recording format
+ */
+constexpr uint32_t RECORDING_VERSION = 1;
+
+/**
+ * @brief One recorded operation
+ */
+struct RecordedOperation {
+    uint64_t timestamp_ns;         ///< Nanoseconds since recording started
+    WorkloadOperation operation;
+};
+
+/**
+ * @brief A recording read back by readRecording()
+ */
+struct Recording {
+    std::string snapshot;       ///< Reference to the array the operations ran against
+    Size array_size = 0;        ///< Its number of elements
+    uint64_t checksum = 0;      ///< snapshotChecksum() of its values
+    std::vector<RecordedOperation> operations;
+    
+    /**
+     * @brief The operations without their times
+     */
+    std::vector<WorkloadOperation> workload() const;
+    
+    /**
+     * @brief Time between the first and the last operation
+     */
+    uint64_t durationNs() const {
+        return operations.empty() ? 0 : operations.back().timestamp_ns - operations.front().timestamp_ns;
+    }
+};
+
+/**
+ * @brief Checksum identifying a snapshot (64-bit FNV-1a over the values)
+ */
+uint64_t snapshotChecksum(const std::vector<Value>& data);
+
+/**
+ * @brief Read a snapshot in the raw format of RMQExternalMemory::writeDataFile()
+ * @throws InvalidDataException if the file cannot be read or is truncated
+ */
+std::vector<Value> loadSnapshot(const std::string& path);
+
+/**
+ * @brief Read a recording
+ *
+ * A record cut short at the end of the file (the writer was killed in the
+ * middle of a flush) is dropped.
+ *
+ * @throws InvalidDataException if the file cannot be read, is not a
+ *         recording, or holds an operation outside the array
+ */
+Recording readRecording(const std::string& path);
+
+/**
+ * @brief Recorder that writes the compact binary recording format
+ *
+ * File layout (native byte order):
+ * - header: RECORDING_MAGIC, version (u32), sizeof(Value) (u32),
+ *   array size (u64), snapshot checksum (u64), reference length (u32)
+ *   and bytes;
+ * - records until the end of the file: a kind byte (0 query, 1 update),
+ *   then LEB128 varints: time since the previous record in ns, and
+ *   either left and right - left, or the index and the zigzag-encoded
+ *   value.
+ *
+ * A typical record takes 6 to 10 bytes. Recording threads put records in
+ * a preallocated lock-free ring of buffer_records slots (rounded up to a
+ * power of two); the hot path is a clock read and a slot claim, with no
+ * lock, allocation or I/O. A flusher thread drains the ring to the file
+ * every few milliseconds, when half a ring has been filled, on flush() and
+ * in the destructor. If the ring is full, recording threads wait for the
+ * flusher, so size buffer_records for the peak operation rate.
+ *
+ * Times of operations recorded concurrently may be stored out of order by
+ * the time it takes to claim a slot; they are clamped to be non-decreasing.
+ */
+class RecordingWriter final : public IRecorder {
+private:
+    struct PendingRecord {
+        uint64_t timestamp_ns;
+        Index first;           ///< left, or the updated index
+        uint64_t second;       ///< right - left, or the zigzag value
+        uint8_t kind;
+    };
+    
+    /**
+     * @brief Ring slot; sequence tells producers and the flusher whose turn it is
+     */
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        PendingRecord record;
+    };
+    
+    /**
+     * @brief How often the flusher drains the ring without being woken
+     */
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{5};
+    
+    std::FILE* file_;
+    std::chrono::steady_clock::time_point start_;
+    
+    // Ring (bounded multi-producer queue; the flusher is the one consumer)
+    std::unique_ptr<Slot[]> slots_;
+    uint64_t mask_;
+    alignas(64) std::atomic<uint64_t> enqueue_pos_;
+    alignas(64) uint64_t dequeue_pos_;     ///< Guarded by mutex_
+    
+    // Flusher state, guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_;
+    uint64_t last_timestamp_ns_;
+    std::vector<uint8_t> encoded_;         ///< Scratch for writePending()
+    Size dropped_;
+    bool failed_;
+    std::thread flusher_;
+    
+    void append(uint8_t kind, Index first, uint64_t second) noexcept;
+    bool pop(PendingRecord& record) noexcept;
+    bool writePending() noexcept;
+    void flushLoop();
+
+public:
+    /**
+     * @brief Create the recording and write its header
+     * @param path Output file (truncated)
+     * @param snapshot Reference to the array, e.g. the path of a snapshot file
+     * @param data The array as it is when recording starts
+     * @param buffer_records Slots in the ring (>= 1)
+     * @throws InvalidDataException if the file cannot be created
+     * @throws ConfigurationException if buffer_records is 0
+     * @throws std::system_error if the flusher thread cannot be started
+     */
+    RecordingWriter(const std::string& path, const std::string& snapshot,
+                    const std::vector<Value>& data, Size buffer_records = 65536);
+    
+    /**
+     * @brief Destructor - stops the flusher, writes the ring and closes the file
+     */
+    ~RecordingWriter() override;
+    
+    RecordingWriter(const RecordingWriter&) = delete;
+    RecordingWriter& operator=(const RecordingWriter&) = delete;
+    
+    void recordQuery(Index left, Index right) noexcept override;
+    void recordUpdate(Index index, Value value) noexcept override;
+    
+    /**
+     * @brief Write the records in the ring to the file (on the calling thread)
+     * @return false if a write has failed (records since then are lost)
+     */
+    bool flush();
+    
+    /**
+     * @brief Operations received so far, including dropped ones
+     */
+    Size operationCount();
+    
+    /**
+     * @brief Operations lost to a failed write
+     */
+    Size droppedCount();
+};
+
+} // namespace recording
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_RECORDING_H
@@ -0,0 +1,139 @@
+#ifndef RMQ_CORE_RMQ_SERIALIZATION_H
+#define RMQ_CORE_RMQ_SERIALIZATION_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "rmq_types.h"
+#include "rmq_exception.h"
+
+namespace rmq {
+
+/**
+ * @brief Helpers for the binary index format
+ *
+ * All values are written in native byte order; an index file is meant to be
+ * reloaded on the machine (or architecture) that wrote it. Every file starts
+ * with an IndexHeader so a reader can reject foreign or mismatched files.
+ */
+namespace serialization {
+
+/**
+ * @brief Magic bytes at the start of every binary index
+ */
+constexpr char INDEX_MAGIC[8] = {'R', 'M', 'Q', 'I', 'N', 'D', 'E', 'X'};
+
+/**
+ * @brief Current version of the binary index format
+ */
+constexpr uint32_t INDEX_VERSION = 1;
+
+/**
+ * @brief Header written before the array data
+ */
+struct IndexHeader {
+    char magic[8];             ///< INDEX_MAGIC
+    uint32_t version;          ///< INDEX_VERSION
+    uint32_t algorithm_type;   ///< AlgorithmType of the writer
+    uint32_t value_size;       ///< sizeof(Value) of the writer
+    uint32_t index_size;       ///< sizeof(Index) of the writer
+};
+
+/**
+ * @brief Write a trivially copyable value
+ */
+template <typename T>
+inline void writePod(std::ostream& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "writePod requires a trivially copyable type");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Read a trivially copyable value
+ * @throws InvalidDataException if the stream ends early
+ */
+template <typename T>
+inline T readPod(std::istream& in) {
+    static_assert(std::is_trivially_copyable<T>::value, "readPod requires a trivially copyable type");
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw InvalidDataException("Binary index is truncated");
+    }
+    return value;
+}
+
+/**
+ * @brief Write a vector as a 64-bit length followed by its elements
+ */
+template <typename T>
+inline void writeVector(std::ostream& out, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "writeVector requires a trivially copyable type");
+    writePod<uint64_t>(out, values.size());
+    if (!values.empty()) {
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+}
+
+/**
+ * @brief Read a vector written by writeVector()
+ * @param max_size Upper bound on the element count, to reject corrupt lengths
+ * @throws InvalidDataException if the stream is truncated or the length is too large
+ */
+template <typename T>
+inline std::vector<T> readVector(std::istream& in, Size max_size) {
+    static_assert(std::is_trivially_copyable<T>::value, "readVector requires a trivially copyable type");
+    uint64_t count = readPod<uint64_t>(in);
+    if (count > max_size) {
+        throw InvalidDataException("Binary index has an invalid array length");
+    }
+    
+    std::vector<T> values(static_cast<Size>(count));
+    if (count > 0 && !in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T))) {
+        throw InvalidDataException("Binary index is truncated");
+    }
+    return values;
+}
+
+/**
+ * @brief Build the header for an algorithm type
+ */
+inline IndexHeader makeHeader(AlgorithmType type) {
+    IndexHeader header;
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+    header.version = INDEX_VERSION;
+    header.algorithm_type = static_cast<uint32_t>(type);
+    header.value_size = sizeof(Value);
+    header.index_size = sizeof(Index);
+    return header;
+}
+
+/**
+ * @brief Validate a header read from a stream
+ * @throws InvalidDataException if the header does not match the expected type
+ */
+inline void checkHeader(const IndexHeader& header, AlgorithmType expected) {
+    if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0) {
+        throw InvalidDataException("Not a binary RMQ index");
+    }
+    if (header.version != INDEX_VERSION) {
+        throw InvalidDataException("Unsupported binary index version " + std::to_string(header.version));
+    }
+    if (header.value_size != sizeof(Value) || header.index_size != sizeof(Index)) {
+        throw InvalidDataException("Binary index was written with different value or index types");
+    }
+    if (header.algorithm_type != static_cast<uint32_t>(expected)) {
+        throw InvalidDataException("Binary index was written by " +
+                                   algorithmTypeToString(static_cast<AlgorithmType>(header.algorithm_type)) +
+                                   ", expected " + algorithmTypeToString(expected));
+    }
+}
+
+} // namespace serialization
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_SERIALIZATION_H
@@ -0,0 +1,172 @@
+#ifndef RMQ_CORE_RMQ_TRACE_H
+#define RMQ_CORE_RMQ_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Begin/end tracing of build phases and batch queries
+ *
+ * Instrumented code uses RMQ_TRACE_SCOPE, which expands to nothing unless
+ * RMQ_ENABLE_TRACING is defined. When enabled, events go to the tracer
+ * installed with setTracer(); with no tracer installed a scope costs one
+ * atomic load.
+ */
+namespace trace {
+
+/**
+ * @brief Receiver of trace events
+ *
+ * Implementations must be thread-safe: preprocessing may run on several
+ * threads. Event names are string literals and outlive the tracer.
+ */
+class ITracer {
+public:
+    virtual ~ITracer() = default;
+    
+    /**
+     * @brief A phase started on the calling thread
+     * @param name Phase name (string literal)
+     * @param arg Optional numeric argument (e.g. level or batch size), -1 if none
+     */
+    virtual void begin(const char* name, int64_t arg) noexcept = 0;
+    
+    /**
+     * @brief The innermost open phase with this name ended on the calling thread
+     */
+    virtual void end(const char* name) noexcept = 0;
+};
+
+/**
+ * @brief Process-wide tracer slot
+ */
+inline std::atomic<ITracer*>& tracerSlot() noexcept {
+    static std::atomic<ITracer*> slot{nullptr};
+    return slot;
+}
+
+/**
+ * @brief Install a tracer (nullptr disables tracing)
+ *
+ * The tracer must stay alive until it is replaced and every scope that
+ * started with it has ended.
+ */
+inline void setTracer(ITracer* tracer) noexcept {
+    tracerSlot().store(tracer, std::memory_order_release);
+}
+
+/**
+ * @brief Currently installed tracer (nullptr if none)
+ */
+inline ITracer* getTracer() noexcept {
+    return tracerSlot().load(std::memory_order_acquire);
+}
+
+/**
+ * @brief RAII begin/end pair for one phase
+ */
+class Scope {
+private:
+    ITracer* tracer_;
+    const char* name_;
+
+public:
+    explicit Scope(const char* name, int64_t arg = -1) noexcept
+        : tracer_(getTracer()), name_(name) {
+        if (tracer_ != nullptr) {
+            tracer_->begin(name_, arg);
+        }
+    }
+    
+    ~Scope() {
+        if (tracer_ != nullptr) {
+            tracer_->end(name_);
+        }
+    }
+    
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/**
+ * @brief Tracer that writes the Chrome trace event format
+ *
+ * Events are buffered in memory and written as a JSON array by flush() (and
+ * by the destructor). Load the file in chrome://tracing or Perfetto.
+ * Timestamps are microseconds since the writer was created.
+ */
+class ChromeTraceWriter final : public ITracer {
+private:
+    struct Event {
+        const char* name;
+        char phase;        ///< 'B' or 'E'
+        double timestamp;  ///< Microseconds since start_
+        uint64_t thread;
+        int64_t arg;
+    };
+    
+    std::string path_;
+    std::chrono::steady_clock::time_point start_;
+    std::vector<Event> events_;
+    std::mutex mutex_;
+    
+    void record(const char* name, char phase, int64_t arg) noexcept;
+
+public:
+    /**
+     * @brief Constructor
+     * @param path Output file written by flush()
+     */
+    explicit ChromeTraceWriter(const std::string& path);
+    
+    /**
+     * @brief Destructor - flushes buffered events
+     */
+    ~ChromeTraceWriter() override;
+    
+    void begin(const char* name, int64_t arg) noexcept override;
+    void end(const char* name) noexcept override;
+    
+    /**
+     * @brief Write all events recorded so far to the output file
+     * @return true if the file was written
+     */
+    bool flush();
+    
+    /**
+     * @brief Number of events recorded so far
+     */
+    size_t eventCount();
+};
+
+} // namespace trace
+
+} // namespace rmq
+
+#define RMQ_TRACE_CONCAT_INNER(a, b) a##b
+#define RMQ_TRACE_CONCAT(a, b) RMQ_TRACE_CONCAT_INNER(a, b)
+
+#if defined(RMQ_ENABLE_TRACING)
+/**
+ * @brief Trace the enclosing block as phase `name`
+ */
+#define RMQ_TRACE_SCOPE(name) \
+    ::rmq::trace::Scope RMQ_TRACE_CONCAT(rmq_trace_scope_, __LINE__)(name)
+
+/**
+ * @brief Trace the enclosing block as phase `name` with a numeric argument
+ */
+#define RMQ_TRACE_SCOPE_ARG(name, arg) \
+    ::rmq::trace::Scope RMQ_TRACE_CONCAT(rmq_trace_scope_, __LINE__)(name, static_cast<int64_t>(arg))
+#else
+#define RMQ_TRACE_SCOPE(name) ((void)0)
+#define RMQ_TRACE_SCOPE_ARG(name, arg) ((void)0)
+#endif
+
+#endif // RMQ_CORE_RMQ_TRACE_H
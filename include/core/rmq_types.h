@@ -34,7 +34,7 @@ using Duration = std::chrono::duration<double, std::milli>;
 namespace constants {
     
     /**
-     * @brief Maximum supported array size
+     * @brief Default maximum array size (see AlgorithmConfig::max_array_size)
      */
     constexpr Size MAX_ARRAY_SIZE = 1000000;
     
@@ -68,7 +68,9 @@ enum class AlgorithmType {
     DYNAMIC_PROGRAMMING,///< O(1) query, O(n²) preprocessing
     SPARSE_TABLE,       ///< O(1) query, O(n log n) preprocessing
     BLOCK_DECOMPOSITION,///< O(√n) query, O(n) preprocessing
-    LCA_BASED          ///< O(log n) query, O(n) preprocessing
+    LCA_BASED,         ///< O(log n) query, O(n) preprocessing
+    S_TREE,            ///< O(log_16 n) query, O(n) preprocessing
+    MONOTONE_RUNS      ///< O(1) query on monotone data, O(n) preprocessing
 };
 
 /**
@@ -156,6 +158,57 @@ struct QueryResult {
     QueryResult() : minimum_value(0), minimum_index(0), query_time(0) {}
 };
 
+/**
+ * @brief Status codes reported by the non-throwing query API
+ */
+enum class QueryStatus {
+    OK,                ///< Query succeeded
+    NOT_PREPROCESSED,  ///< preprocess() has not been called
+    INVALID_RANGE,     ///< left > right
+    EMPTY_DATA,        ///< The preprocessed array is empty
+    OUT_OF_BOUNDS,     ///< right is outside the array
+    INTERNAL_ERROR     ///< The algorithm failed to produce an answer
+};
+
+/**
+ * @brief Result of a non-throwing query
+ * 
+ * Plays the role of std::expected<Value, QueryStatus>: value and index are
+ * only meaningful when status is QueryStatus::OK. Trivially copyable, so
+ * batches of outcomes can live in caller-owned buffers.
+ */
+struct QueryOutcome {
+    QueryStatus status;   ///< Outcome of the query
+    Value value;          ///< Minimum value (valid only if ok())
+    Index index;          ///< Index of the minimum (INVALID_INDEX unless requested)
+    
+    /**
+     * @brief Default constructor (not preprocessed, no value)
+     */
+    constexpr QueryOutcome() noexcept
+        : status(QueryStatus::NOT_PREPROCESSED), value(0), index(constants::INVALID_INDEX) {}
+    
+    /**
+     * @brief Constructor with all fields
+     */
+    constexpr QueryOutcome(QueryStatus s, Value val, Index idx) noexcept
+        : status(s), value(val), index(idx) {}
+    
+    /**
+     * @brief Check whether the query succeeded
+     */
+    constexpr bool ok() const noexcept {
+        return status == QueryStatus::OK;
+    }
+    
+    /**
+     * @brief Same as ok()
+     */
+    constexpr explicit operator bool() const noexcept {
+        return ok();
+    }
+};
+
 /**
  * @brief Configuration for algorithm behavior
  */
@@ -164,6 +217,12 @@ struct AlgorithmConfig {
     bool enable_parallel = false;       ///< Enable parallel preprocessing
     bool track_statistics = false;      ///< Track detailed statistics
     Size block_size = constants::DEFAULT_BLOCK_SIZE; ///< Block size for block decomposition
+    Size max_array_size = constants::MAX_ARRAY_SIZE; ///< Largest array accepted by preprocess()
+    bool concurrent_updates = false;    ///< Block decomposition: allow updates from many threads
+    bool compress_data = false;         ///< Naive/block decomposition: keep the data block-compressed
+    bool lazy_levels = false;           ///< Sparse table: build each level on first use
+    Size max_levels = 0;                ///< Sparse table: levels kept, longer ranges use block minima (0 = all)
+    bool packed_entries = false;        ///< Sparse table/block decomposition: one 64-bit (value, index) key per entry
     
     /**
      * @brief Default constructor with default values
@@ -201,6 +260,75 @@ struct AlgorithmConfig {
         block_size = size;
         return *this;
     }
+    
+    /**
+     * @brief Builder pattern method for the maximum array size
+     * 
+     * Raise this for large arrays; check RMQFactory::calculateMemoryUsage()
+     * against available memory first.
+     */
+    AlgorithmConfig& withMaxArraySize(Size size) {
+        max_array_size = size;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for concurrent updates
+     * 
+     * RMQFactory then creates RMQConcurrentBlockDecomposition for
+     * BLOCK_DECOMPOSITION.
+     */
+    AlgorithmConfig& withConcurrentUpdates(bool enable) {
+        concurrent_updates = enable;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for compressed data storage
+     * 
+     * RMQNaive and RMQBlockDecomposition then hold the array as a
+     * CompressedArray instead of raw values; other algorithms ignore it.
+     */
+    AlgorithmConfig& withCompressedData(bool enable) {
+        compress_data = enable;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for lazy sparse table levels
+     * 
+     * RMQSparseTable then builds only level 0 in preprocess() and each
+     * higher level the first time a query needs it.
+     */
+    AlgorithmConfig& withLazyLevels(bool enable) {
+        lazy_levels = enable;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for the sparse table level cap
+     * 
+     * RMQSparseTable keeps at most this many levels; ranges of 2^levels or
+     * more elements are answered from the top level plus a scan of block
+     * minima.
+     */
+    AlgorithmConfig& withMaxLevels(Size levels) {
+        max_levels = levels;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for packed (value, index) entries
+     * 
+     * RMQSparseTable and RMQBlockDecomposition store each minimum and its
+     * index as one 64-bit key (kernels::packEntry), so an argmin reads and
+     * compares one word instead of two arrays. Arrays too large for 32-bit
+     * indices keep the parallel arrays.
+     */
+    AlgorithmConfig& withPackedEntries(bool enable) {
+        packed_entries = enable;
+        return *this;
+    }
 };
 
 /**
@@ -218,6 +346,32 @@ inline std::string algorithmTypeToString(AlgorithmType type) {
             return "Block Decomposition";
         case AlgorithmType::LCA_BASED:
             return "LCA-based";
+        case AlgorithmType::S_TREE:
+            return "S-tree";
+        case AlgorithmType::MONOTONE_RUNS:
+            return "Monotone runs";
+        default:
+            return "Unknown";
+    }
+}
+
+/**
+ * @brief Convert QueryStatus to string (no allocation)
+ */
+inline const char* queryStatusToString(QueryStatus status) noexcept {
+    switch (status) {
+        case QueryStatus::OK:
+            return "OK";
+        case QueryStatus::NOT_PREPROCESSED:
+            return "Not preprocessed";
+        case QueryStatus::INVALID_RANGE:
+            return "Invalid range";
+        case QueryStatus::EMPTY_DATA:
+            return "Empty data";
+        case QueryStatus::OUT_OF_BOUNDS:
+            return "Out of bounds";
+        case QueryStatus::INTERNAL_ERROR:
+            return "Internal error";
         default:
             return "Unknown";
     }
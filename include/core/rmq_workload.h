@@ -0,0 +1,170 @@
+#ifndef RMQ_CORE_RMQ_WORKLOAD_H
+#define RMQ_CORE_RMQ_WORKLOAD_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+#include "rmq_types.h"
+
+namespace rmq {
+
+/**
+ * @brief Kind of a workload operation
+ */
+enum class OperationKind {
+    QUERY,   ///< Range minimum query over [left, right]
+    UPDATE   ///< Point update data[left] = value
+};
+
+/**
+ * @brief One operation of a recorded or synthesized workload
+ */
+struct WorkloadOperation {
+    OperationKind kind;
+    Index left;    ///< Query start, or updated index
+    Index right;   ///< Query end (equal to left for updates)
+    Value value;   ///< New value (updates only)
+    
+    static WorkloadOperation query(Index l, Index r) {
+        return {OperationKind::QUERY, l, r, 0};
+    }
+    
+    static WorkloadOperation update(Index index, Value v) {
+        return {OperationKind::UPDATE, index, index, v};
+    }
+};
+
+/**
+ * @brief Summary of a workload: read/write mix and range-length distribution
+ *
+ * Can be built from a trace or accumulated live, and turned back into a
+ * representative trace with synthesizeTrace().
+ */
+struct WorkloadStats {
+    static constexpr size_t LENGTH_BUCKETS = 64;
+    
+    Size queries = 0;
+    Size updates = 0;
+    double total_range_length = 0.0;
+    
+    /// length_histogram[b] counts queries with length in [2^b, 2^(b+1))
+    std::array<Size, LENGTH_BUCKETS> length_histogram{};
+    
+    /**
+     * @brief Bucket of a range length (floor(log2(length)))
+     */
+    static size_t lengthBucket(Size length) {
+        size_t bucket = 0;
+        while (length > 1 && bucket + 1 < LENGTH_BUCKETS) {
+            length >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+    
+    void recordQuery(Index left, Index right) {
+        Size length = right - left + 1;
+        queries++;
+        total_range_length += static_cast<double>(length);
+        length_histogram[lengthBucket(length)]++;
+    }
+    
+    void recordUpdate() {
+        updates++;
+    }
+    
+    void record(const WorkloadOperation& op) {
+        if (op.kind == OperationKind::QUERY) {
+            recordQuery(op.left, op.right);
+        } else {
+            recordUpdate();
+        }
+    }
+    
+    Size operations() const {
+        return queries + updates;
+    }
+    
+    /**
+     * @brief Fraction of operations that are queries (1 if empty)
+     */
+    double readFraction() const {
+        return operations() == 0 ? 1.0 : static_cast<double>(queries) / operations();
+    }
+    
+    double meanRangeLength() const {
+        return queries == 0 ? 0.0 : total_range_length / queries;
+    }
+    
+    void reset() {
+        *this = WorkloadStats();
+    }
+    
+    static WorkloadStats fromTrace(const std::vector<WorkloadOperation>& trace) {
+        WorkloadStats stats;
+        for (const auto& op : trace) {
+            stats.record(op);
+        }
+        return stats;
+    }
+};
+
+/**
+ * @brief Generate a trace with the read/write mix and range lengths of stats
+ * @param stats Workload summary to reproduce
+ * @param array_size Size of the array the trace will run against
+ * @param count Number of operations
+ * @param seed Random seed
+ * @return Operations valid for an array of array_size elements
+ */
+inline std::vector<WorkloadOperation> synthesizeTrace(const WorkloadStats& stats, Size array_size,
+                                                      Size count, uint32_t seed = 42) {
+    std::vector<WorkloadOperation> trace;
+    if (array_size == 0) return trace;
+    trace.reserve(count);
+    
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution is_query(stats.readFraction());
+    std::uniform_int_distribution<Index> position(0, array_size - 1);
+    std::uniform_int_distribution<Value> value(-1000000, 1000000);
+    
+    // Without observed queries, fall back to uniformly random ranges. The
+    // length distribution needs a positive total weight, so it is only
+    // built when there is one.
+    std::vector<double> weights(stats.length_histogram.begin(), stats.length_histogram.end());
+    bool has_lengths = std::any_of(weights.begin(), weights.end(), [](double w) { return w > 0.0; });
+    std::optional<std::discrete_distribution<size_t>> bucket;
+    if (has_lengths) {
+        bucket.emplace(weights.begin(), weights.end());
+    }
+    
+    for (Size i = 0; i < count; ++i) {
+        if (!is_query(gen)) {
+            trace.push_back(WorkloadOperation::update(position(gen), value(gen)));
+            continue;
+        }
+        
+        if (!has_lengths) {
+            Index a = position(gen);
+            Index b = position(gen);
+            trace.push_back(WorkloadOperation::query(std::min(a, b), std::max(a, b)));
+            continue;
+        }
+        
+        size_t b = (*bucket)(gen);
+        Size low = std::min<Size>(Size(1) << b, array_size);
+        Size high = std::min<Size>(b + 1 < 64 ? (Size(1) << (b + 1)) - 1 : array_size, array_size);
+        Size length = std::uniform_int_distribution<Size>(low, std::max(low, high))(gen);
+        Index left = std::uniform_int_distribution<Index>(0, array_size - length)(gen);
+        trace.push_back(WorkloadOperation::query(left, left + length - 1));
+    }
+    
+    return trace;
+}
+
+} // namespace rmq
+
+#endif // RMQ_CORE_RMQ_WORKLOAD_H
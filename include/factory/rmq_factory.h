@@ -3,11 +3,15 @@
 
 #include "../core/rmq_base.h"
 #include "../core/rmq_types.h"
+#include "../core/rmq_workload.h"
+#include <limits>
 #include <memory>
 #include <string>
 
 namespace rmq {
 
+struct ShapeAnalysis;
+
 /**
  * @brief Factory class for creating RMQ algorithm instances
  * 
@@ -55,6 +59,145 @@ public:
         const AlgorithmConfig& config = AlgorithmConfig()
     );
     
+    /**
+     * @brief Create an algorithm suited to the shape of the data
+     * 
+     * One O(n) pass (RMQMonotoneRuns::analyze()) looks for long monotone
+     * runs. Sorted, reverse-sorted, constant and piecewise monotone data
+     * get RMQMonotoneRuns; anything else falls back to
+     * recommendAlgorithm(). The algorithm is returned unpreprocessed.
+     * 
+     * @param data The array the algorithm will be built over
+     * @param expected_queries Expected number of queries (for the fallback)
+     * @param analysis Optional output for the detected shape and run count
+     * @param config Optional configuration
+     * @return Unique pointer to the chosen algorithm
+     */
+    static RMQAlgorithmPtr createForData(
+        const std::vector<Value>& data,
+        size_t expected_queries,
+        ShapeAnalysis* analysis = nullptr,
+        const AlgorithmConfig& config = AlgorithmConfig()
+    );
+    
+    /**
+     * @brief Algorithm and configuration chosen for a memory budget
+     */
+    struct BudgetSelection {
+        AlgorithmType type;            ///< Chosen algorithm
+        AlgorithmConfig config;        ///< Configuration to build it with
+        size_t predicted_memory_bytes; ///< Footprint after preprocess() (see calculateMemoryUsage)
+        std::string reasoning;         ///< Why this candidate was chosen
+    };
+    
+    /**
+     * @brief Choose the fastest-querying algorithm whose footprint fits a budget
+     * 
+     * Candidates are tried from fastest to slowest query: DP (small arrays
+     * only), sparse table, S-tree, LCA, block decomposition with sqrt(n)
+     * blocks, block decomposition with the smallest larger block size that
+     * fits, and finally the naive scan. With requires_updates only block
+     * decomposition and naive are considered.
+     * 
+     * @param array_size Size of the input array
+     * @param memory_budget_bytes Bytes the structure may hold after preprocess()
+     * @param requires_updates Whether updates are required
+     * @param config Base configuration (block_size is overridden when tuned,
+     *        max_array_size is raised to array_size if below it)
+     * @return Chosen algorithm, configuration and predicted footprint
+     * @throws ConfigurationException if not even the data fits in the budget
+     */
+    static BudgetSelection selectForBudget(
+        size_t array_size,
+        size_t memory_budget_bytes,
+        bool requires_updates = false,
+        const AlgorithmConfig& config = AlgorithmConfig()
+    );
+    
+    /**
+     * @brief Create the algorithm chosen by selectForBudget()
+     * @param array_size Size of the input array
+     * @param memory_budget_bytes Bytes the structure may hold after preprocess()
+     * @param selection Optional output for the chosen type, config and footprint
+     * @param requires_updates Whether updates are required
+     * @param config Base configuration
+     * @return Unique pointer to the chosen algorithm
+     * @throws ConfigurationException if not even the data fits in the budget
+     */
+    static RMQAlgorithmPtr createForBudget(
+        size_t array_size,
+        size_t memory_budget_bytes,
+        BudgetSelection* selection = nullptr,
+        bool requires_updates = false,
+        const AlgorithmConfig& config = AlgorithmConfig()
+    );
+    
+    /**
+     * @brief Measured replay of a workload on one candidate algorithm
+     */
+    struct CandidateMeasurement {
+        AlgorithmType type;
+        bool measured;              ///< false if skipped (over budget or too large for DP)
+        double build_ms;            ///< Initial preprocess() on the sample
+        double ops_per_second;      ///< Replay throughput, rebuilds included
+        size_t memory_bytes;        ///< Predicted footprint for the full array
+        Size rebuilds;              ///< Rebuilds forced by updates (static algorithms)
+    };
+    
+    /**
+     * @brief Result of selectForWorkload()
+     */
+    struct WorkloadSelection {
+        AlgorithmType type;                           ///< Measured winner
+        double ops_per_second;                        ///< Winner's replay throughput
+        size_t memory_bytes;                          ///< Winner's predicted footprint
+        std::vector<CandidateMeasurement> candidates; ///< Every candidate, in getAvailableAlgorithms() order
+    };
+    
+    /**
+     * @brief Pick the algorithm that replays a sample workload fastest
+     * 
+     * Every candidate is built on data_sample and replays the trace until
+     * min_replay_ms has elapsed. Algorithms without update support pay for a
+     * rebuild before the first query after each run of updates. Trace
+     * indices beyond the sample are scaled down proportionally.
+     * 
+     * @param data_sample Data the candidates are built on
+     * @param trace Sample operations (e.g. recorded from production)
+     * @param array_size Size of the full array, for memory predictions (0: sample size)
+     * @param memory_budget_bytes Candidates predicted above this are skipped
+     * @param min_replay_ms Minimum measured replay time per candidate
+     * @param config Configuration for every candidate
+     * @return Winner with its throughput and memory, plus all measurements
+     * @throws InvalidDataException if the sample or trace is empty
+     * @throws ConfigurationException if no candidate fits the budget
+     */
+    static WorkloadSelection selectForWorkload(
+        const std::vector<Value>& data_sample,
+        const std::vector<WorkloadOperation>& trace,
+        size_t array_size = 0,
+        size_t memory_budget_bytes = std::numeric_limits<size_t>::max(),
+        double min_replay_ms = 20.0,
+        const AlgorithmConfig& config = AlgorithmConfig()
+    );
+    
+    /**
+     * @brief selectForWorkload() from live statistics instead of a trace
+     * 
+     * Replays a trace synthesized from stats (see synthesizeTrace()).
+     * 
+     * @param trace_length Number of operations to synthesize
+     */
+    static WorkloadSelection selectForWorkload(
+        const std::vector<Value>& data_sample,
+        const WorkloadStats& stats,
+        Size trace_length = 10000,
+        size_t array_size = 0,
+        size_t memory_budget_bytes = std::numeric_limits<size_t>::max(),
+        double min_replay_ms = 20.0,
+        const AlgorithmConfig& config = AlgorithmConfig()
+    );
+    
     /**
      * @brief Get recommended algorithm type based on characteristics
      * @param array_size Size of the input array
@@ -146,6 +289,19 @@ public:
         size_t array_size
     );
     
+    /**
+     * @brief Calculate expected memory usage (bytes) for a given configuration
+     * 
+     * Same as above, but honours config.block_size for block decomposition.
+     * For MONOTONE_RUNS the footprint depends on the data; this is the
+     * bound for the most runs possible (n / 2, rounded up).
+     */
+    static size_t calculateMemoryUsage(
+        AlgorithmType type,
+        size_t array_size,
+        const AlgorithmConfig& config
+    );
+    
 private:
     
     /**
@@ -0,0 +1,212 @@
+#ifndef RMQ_PERSISTENCE_RMQ_DURABLE_H
+#define RMQ_PERSISTENCE_RMQ_DURABLE_H
+
+#include "../core/rmq_base.h"
+#include "rmq_update_log.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief Configuration for DurableRMQ
+ */
+struct DurabilityConfig {
+    std::string directory;           ///< Directory holding checkpoint.bin and updates.log
+    Size group_commit_size = 64;     ///< Updates buffered per log group commit
+    Size checkpoint_interval = 0;    ///< Automatic checkpoint every N updates (0 = manual only)
+    bool sync = true;                ///< fsync log groups and checkpoints
+    
+    /**
+     * @brief Default constructor
+     */
+    DurabilityConfig() = default;
+    
+    /**
+     * @brief Constructor with directory
+     */
+    explicit DurabilityConfig(const std::string& dir) : directory(dir) {}
+    
+    /**
+     * @brief Builder pattern method for group commit size
+     */
+    DurabilityConfig& withGroupCommit(Size records) {
+        group_commit_size = records;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for checkpoint interval
+     */
+    DurabilityConfig& withCheckpointInterval(Size updates) {
+        checkpoint_interval = updates;
+        return *this;
+    }
+    
+    /**
+     * @brief Builder pattern method for fsync
+     */
+    DurabilityConfig& withSync(bool enable) {
+        sync = enable;
+        return *this;
+    }
+};
+
+/**
+ * @brief What recover() did to restore the index
+ */
+struct RecoveryStats {
+    uint64_t checkpoint_sequence = 0;  ///< Last update covered by the checkpoint
+    Size replayed_updates = 0;         ///< Log records applied after the checkpoint
+    Size discarded_bytes = 0;          ///< Torn log tail that was dropped
+    Duration load_time{0};             ///< Time to load the checkpoint
+    Duration replay_time{0};           ///< Time to replay the log tail
+};
+
+/**
+ * @brief Crash-safe wrapper for updatable RMQ algorithms
+ *
+ * Every update is checked against the array, appended to an update log
+ * (with group commit) and only then applied in memory, so the index is
+ * never ahead of the log: an update whose append throws is not applied.
+ * checkpoint() writes the whole index in the binary
+ * index format (RMQBase::saveIndex) and truncates the log, so a restart
+ * loads the latest checkpoint and replays only the log tail instead of
+ * re-preprocessing from scratch.
+ *
+ * Files in the directory:
+ * - checkpoint.bin: sequence (u64) followed by a binary index
+ * - updates.log: UpdateLog records newer than the checkpoint
+ *
+ * An update is durable once the group commit that contains it returns
+ * (commit() forces one).
+ */
+class DurableRMQ {
+private:
+    std::unique_ptr<RMQBase> algorithm_;  ///< Wrapped updatable algorithm
+    DurabilityConfig config_;             ///< Durability settings
+    UpdateLog log_;                       ///< Update log
+    uint64_t checkpoint_sequence_;        ///< Sequence covered by the last checkpoint
+    Size updates_since_checkpoint_;       ///< For automatic checkpoints
+    
+    std::string checkpointPath() const;
+    std::string logPath() const;
+    
+    /**
+     * @brief Take an automatic checkpoint if the interval has elapsed
+     */
+    void maybeCheckpoint();
+    
+    /**
+     * @brief Reject an update the algorithm would reject, before it is logged
+     * @throws NotPreprocessedException or BoundsException
+     */
+    void validateUpdate(Index index) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param algorithm Algorithm to wrap (must support updates)
+     * @param config Durability settings
+     * @throws NotSupportedException if the algorithm does not support updates
+     * @throws ConfigurationException if the directory is empty or cannot be created
+     */
+    DurableRMQ(std::unique_ptr<RMQBase> algorithm, const DurabilityConfig& config);
+    
+    /**
+     * @brief Destructor - commits pending log records
+     */
+    ~DurableRMQ();
+    
+    DurableRMQ(const DurableRMQ&) = delete;
+    DurableRMQ& operator=(const DurableRMQ&) = delete;
+    
+    /**
+     * @brief Preprocess new data and write the initial checkpoint
+     *
+     * Replaces any previous checkpoint and log in the directory.
+     */
+    void create(const std::vector<Value>& data);
+    
+    /**
+     * @brief Restore the index from the directory after a restart
+     * @return What was loaded and replayed
+     * @throws InvalidDataException if there is no valid checkpoint
+     */
+    RecoveryStats recover();
+    
+    /**
+     * @brief Check whether a checkpoint exists in the directory
+     */
+    bool hasCheckpoint() const;
+    
+    /**
+     * @brief Log and apply a single update
+     * @throws BoundsException if index is outside the array (nothing is logged)
+     */
+    void update(Index index, Value value);
+    
+    /**
+     * @brief Log and apply a batch of updates
+     * @throws BoundsException if any index is outside the array (nothing is logged)
+     */
+    void batchUpdate(const std::vector<std::pair<Index, Value>>& updates);
+    
+    /**
+     * @brief Make every logged update durable now
+     */
+    void commit();
+    
+    /**
+     * @brief Write a checkpoint and truncate the log
+     */
+    void checkpoint();
+    
+    /**
+     * @brief Query the minimum value in a range
+     */
+    Value query(Index left, Index right) const {
+        return algorithm_->query(left, right);
+    }
+    
+    /**
+     * @brief Query with detailed result information
+     */
+    QueryResult queryDetailed(Index left, Index right) const {
+        return algorithm_->queryDetailed(left, right);
+    }
+    
+    /**
+     * @brief Access the wrapped algorithm (for read-only use)
+     */
+    const RMQBase& algorithm() const {
+        return *algorithm_;
+    }
+    
+    /**
+     * @brief Sequence number of the latest logged update
+     */
+    uint64_t lastSequence() const {
+        return log_.lastSequence();
+    }
+    
+    /**
+     * @brief Sequence number covered by the latest checkpoint
+     */
+    uint64_t checkpointSequence() const {
+        return checkpoint_sequence_;
+    }
+    
+    /**
+     * @brief Access the update log (for statistics)
+     */
+    const UpdateLog& log() const {
+        return log_;
+    }
+};
+
+} // namespace rmq
+
+#endif // RMQ_PERSISTENCE_RMQ_DURABLE_H
@@ -0,0 +1,183 @@
+#ifndef RMQ_PERSISTENCE_RMQ_UPDATE_LOG_H
+#define RMQ_PERSISTENCE_RMQ_UPDATE_LOG_H
+
+#include "../core/rmq_types.h"
+#include "../core/rmq_exception.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace rmq {
+
+/**
+ * @brief One point update in the update log
+ */
+struct UpdateLogRecord {
+    uint64_t sequence;  ///< Monotonically increasing sequence number (starts at 1)
+    Index index;        ///< Updated position
+    Value value;        ///< New value
+};
+
+/**
+ * @brief Append-only log of point updates with group commit
+ *
+ * Records are buffered in memory and written as one group when commit() is
+ * called or when group_commit_size records are pending. Each committed group
+ * is flushed and fsync'ed, so a record is durable once the commit that
+ * contains it returns.
+ *
+ * On-disk record layout (native byte order, 24 bytes):
+ * sequence (u64) | index (u64) | value (i32) | checksum (u32)
+ *
+ * A torn or corrupt tail (from a crash in the middle of a write) is
+ * detected by the checksum and dropped when the log is opened. A group
+ * whose write or sync fails is cut off the file again, so a retried
+ * commit never leaves a torn or repeated group in the middle of the log.
+ */
+class UpdateLog {
+public:
+    /**
+     * @brief Size of one record on disk
+     */
+    static constexpr Size RECORD_BYTES = 24;
+
+private:
+    std::string path_;                      ///< Log file path
+    std::FILE* file_;                       ///< Open log file (append mode)
+    Size group_commit_size_;                ///< Records per automatic group commit
+    bool sync_;                             ///< fsync after every group
+    uint64_t next_sequence_;                ///< Sequence of the next appended record
+    uint64_t last_committed_;               ///< Highest durable sequence
+    std::vector<UpdateLogRecord> pending_;  ///< Appended but not yet committed
+    uint64_t groups_committed_;             ///< Number of group commits
+    Size committed_bytes_;                  ///< Length of the committed prefix of the file
+    
+    /**
+     * @brief Flush and optionally fsync the log file
+     */
+    void syncFile();
+    
+    /**
+     * @brief Cut the file back to committed_bytes_ after a failed commit
+     *
+     * Closes the log if the file cannot be cut or reopened.
+     */
+    void rollback();
+
+public:
+    /**
+     * @brief Constructor
+     * @param group_commit_size Records buffered before an automatic commit (>= 1)
+     * @param sync Whether each group commit is fsync'ed
+     */
+    explicit UpdateLog(Size group_commit_size = 64, bool sync = true);
+    
+    /**
+     * @brief Destructor - commits pending records and closes the file
+     */
+    ~UpdateLog();
+    
+    UpdateLog(const UpdateLog&) = delete;
+    UpdateLog& operator=(const UpdateLog&) = delete;
+    
+    /**
+     * @brief Open (or create) a log file for appending
+     *
+     * Existing records are scanned to find the last valid sequence number;
+     * a torn tail is truncated away.
+     *
+     * @param path Log file path
+     * @param min_sequence Sequence numbers continue after at least this value
+     * @throws AlgorithmException if the file cannot be opened
+     */
+    void open(const std::string& path, uint64_t min_sequence = 0);
+    
+    /**
+     * @brief Commit pending records and close the file
+     */
+    void close();
+    
+    /**
+     * @brief Check whether the log is open
+     */
+    bool isOpen() const {
+        return file_ != nullptr;
+    }
+    
+    /**
+     * @brief Append an update (committed with the next group)
+     *
+     * If the append triggers a commit that fails, the record is not kept.
+     *
+     * @return Sequence number assigned to the record
+     * @throws AlgorithmException if the log is not open or the commit fails
+     */
+    uint64_t append(Index index, Value value);
+    
+    /**
+     * @brief Write, flush and fsync every pending record as one group
+     *
+     * On failure the file is cut back to the last committed group and the
+     * records stay pending for a retry. If the file cannot be cut back, the
+     * log is closed and refuses appends until open() is called again.
+     *
+     * @throws AlgorithmException if the write or sync fails
+     */
+    void commit();
+    
+    /**
+     * @brief Discard all records on disk (after a checkpoint)
+     *
+     * Sequence numbers keep increasing across truncations.
+     */
+    void truncate();
+    
+    /**
+     * @brief Sequence number of the most recent record (committed or pending)
+     */
+    uint64_t lastSequence() const {
+        return next_sequence_ - 1;
+    }
+    
+    /**
+     * @brief Highest sequence number that is durable on disk
+     */
+    uint64_t lastCommitted() const {
+        return last_committed_;
+    }
+    
+    /**
+     * @brief Number of records waiting for the next group commit
+     */
+    Size pendingCount() const {
+        return pending_.size();
+    }
+    
+    /**
+     * @brief Number of group commits since open()
+     */
+    uint64_t groupsCommitted() const {
+        return groups_committed_;
+    }
+    
+    /**
+     * @brief Read every valid record of a log file
+     * @param path Log file path (a missing file yields no records)
+     * @param after_sequence Only records with a larger sequence are returned
+     * @param valid_bytes If not null, receives the length of the valid prefix
+     * @return Records in log order, stopping at the first torn or corrupt record
+     */
+    static std::vector<UpdateLogRecord> readRecords(const std::string& path,
+                                                    uint64_t after_sequence = 0,
+                                                    Size* valid_bytes = nullptr);
+    
+    /**
+     * @brief Checksum of a record (FNV-1a over its fields)
+     */
+    static uint32_t checksum(const UpdateLogRecord& record);
+};
+
+} // namespace rmq
+
+#endif // RMQ_PERSISTENCE_RMQ_UPDATE_LOG_H
@@ -0,0 +1,336 @@
+#include "../../include/adaptive/rmq_adaptive.h"
+#include "../../include/factory/rmq_factory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace rmq {
+
+AdaptiveRMQ::AdaptiveRMQ(AlgorithmType initial, const AdaptiveConfig& config)
+    : config_(config),
+      current_(RMQFactory::create(initial, config.algorithm_config)),
+      dirty_(false),
+      window_ops_(0),
+      sampled_ns_(0.0),
+      sampled_ops_(0),
+      rebuild_ns_(0.0) {
+    
+    if (config_.window_operations == 0) {
+        throw ConfigurationException("window_operations", "must be positive");
+    }
+    if (config_.switch_margin < 1.0) {
+        throw ConfigurationException("switch_margin", "must be at least 1");
+    }
+}
+
+AdaptiveRMQ::~AdaptiveRMQ() {
+    if (pending_build_.valid()) {
+        pending_build_.wait();
+    }
+}
+
+void AdaptiveRMQ::preprocess(const std::vector<Value>& data) {
+    // A build in flight is over the old data; let it finish and drop it
+    if (pending_build_.valid()) {
+        try {
+            pending_build_.get();
+        } catch (...) {
+        }
+        pending_updates_.clear();
+    }
+    
+    current_->preprocess(data);
+    data_ = data;
+    dirty_ = false;
+    
+    window_.reset();
+    window_ops_ = 0;
+    sampled_ns_ = 0.0;
+    sampled_ops_ = 0;
+    rebuild_ns_ = 0.0;
+}
+
+Value AdaptiveRMQ::query(Index left, Index right) {
+    pollMigration(false);
+    
+    if (dirty_) {
+        // Rebuilds are the main cost of a static algorithm under updates
+        auto start = std::chrono::steady_clock::now();
+        current_->preprocess(data_);
+        rebuild_ns_ += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        dirty_ = false;
+        stats_.rebuilds++;
+    }
+    
+    Value result;
+    if (config_.latency_sample_interval > 0 && window_ops_ % config_.latency_sample_interval == 0) {
+        auto start = std::chrono::steady_clock::now();
+        result = current_->query(left, right);
+        recordLatency(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    } else {
+        result = current_->query(left, right);
+    }
+    
+    window_.recordQuery(left, right);
+    if (++window_ops_ >= config_.window_operations) {
+        endWindow();
+    }
+    return result;
+}
+
+void AdaptiveRMQ::update(Index index, Value value) {
+    batchUpdate({{index, value}});
+}
+
+void AdaptiveRMQ::batchUpdate(const std::vector<std::pair<Index, Value>>& updates) {
+    if (!current_->isPreprocessed()) {
+        throw NotPreprocessedException(current_->getName());
+    }
+    for (const auto& [index, value] : updates) {
+        if (index >= data_.size()) {
+            throw BoundsException(index, data_.size());
+        }
+    }
+    
+    pollMigration(false);
+    
+    bool sample = config_.latency_sample_interval > 0 && window_ops_ % config_.latency_sample_interval == 0;
+    auto start = std::chrono::steady_clock::now();
+    
+    for (const auto& [index, value] : updates) {
+        data_[index] = value;
+    }
+    if (current_->supportsUpdate()) {
+        current_->batchUpdate(updates);
+    } else {
+        // Rebuilt lazily before the next query
+        dirty_ = true;
+    }
+    
+    // The replacement was built from an older snapshot
+    if (pending_build_.valid()) {
+        pending_updates_.insert(pending_updates_.end(), updates.begin(), updates.end());
+    }
+    
+    if (sample && !updates.empty()) {
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        recordLatency(ns / updates.size());
+    }
+    
+    for (size_t i = 0; i < updates.size(); ++i) {
+        window_.recordUpdate();
+        if (++window_ops_ >= config_.window_operations) {
+            endWindow();
+        }
+    }
+}
+
+void AdaptiveRMQ::waitForMigration() {
+    pollMigration(true);
+}
+
+AlgorithmType AdaptiveRMQ::currentType() const {
+    return current_->getType();
+}
+
+void AdaptiveRMQ::recordLatency(double ns) {
+    sampled_ns_ += ns;
+    sampled_ops_++;
+}
+
+double AdaptiveRMQ::nsPerUnit(AlgorithmType type) const {
+    auto it = ns_per_unit_.find(type);
+    if (it == ns_per_unit_.end()) {
+        it = ns_per_unit_.find(currentType());
+    }
+    return it == ns_per_unit_.end() ? 1.0 : it->second;
+}
+
+void AdaptiveRMQ::endWindow() {
+    stats_.windows++;
+    stats_.last_window = window_;
+    stats_.mean_latency_ns = sampled_ops_ > 0 ? sampled_ns_ / sampled_ops_ : 0.0;
+    
+    const Size n = data_.size();
+    AlgorithmType current = currentType();
+    double modelled_cost = n > 0 ? estimateWindowCost(current, window_, n) : 0.0;
+    
+    // Measured cost of the window (sampled latency over all operations,
+    // plus rebuilds) calibrates the current algorithm, averaged with its
+    // previous calibration so one noisy window does not decide alone
+    if (sampled_ops_ > 0 && modelled_cost > 0.0) {
+        double measured = (stats_.mean_latency_ns * window_ops_ + rebuild_ns_) / modelled_cost;
+        auto it = ns_per_unit_.find(current);
+        ns_per_unit_[current] = it == ns_per_unit_.end() ? measured : 0.5 * (it->second + measured);
+    }
+    stats_.ns_per_cost_unit = nsPerUnit(current);
+    double current_cost = modelled_cost * stats_.ns_per_cost_unit;
+    
+    if (!pending_build_.valid() && n > 0) {
+        AlgorithmType best = current;
+        double best_cost = current_cost;
+        for (AlgorithmType type : candidatesFor(n)) {
+            double cost = estimateWindowCost(type, window_, n) * nsPerUnit(type);
+            if (type != current && cost < best_cost) {
+                best = type;
+                best_cost = cost;
+            }
+        }
+        
+        if (best != current) {
+            double saving = current_cost - best_cost;
+            double build_cost = estimateBuildCost(best, n) * nsPerUnit(best);
+            
+            // Switch only on a clear win that repays the build soon
+            if (best_cost * config_.switch_margin < current_cost &&
+                build_cost < saving * config_.payback_windows) {
+                startMigration(best);
+            }
+        }
+    }
+    
+    window_.reset();
+    window_ops_ = 0;
+    sampled_ns_ = 0.0;
+    sampled_ops_ = 0;
+    rebuild_ns_ = 0.0;
+}
+
+void AdaptiveRMQ::startMigration(AlgorithmType type) {
+    pending_updates_.clear();
+    
+    AlgorithmConfig config = config_.algorithm_config;
+    auto build = [type, config](std::vector<Value> snapshot) {
+        RMQAlgorithmPtr replacement = RMQFactory::create(type, config);
+        replacement->preprocess(snapshot);
+        return replacement;
+    };
+    
+    // Deferred builds run inside pollMigration(true), on this thread
+    pending_build_ = std::async(config_.background ? std::launch::async : std::launch::deferred,
+                                build, data_);
+    if (!config_.background) {
+        pollMigration(true);
+    }
+}
+
+void AdaptiveRMQ::pollMigration(bool wait) {
+    if (!pending_build_.valid()) return;
+    if (!wait && pending_build_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    
+    RMQAlgorithmPtr replacement;
+    try {
+        replacement = pending_build_.get();
+    } catch (...) {
+        // Keep serving with the current algorithm
+        stats_.failed_migrations++;
+        pending_updates_.clear();
+        return;
+    }
+    
+    // Catch up with updates made while it was being built
+    bool replacement_dirty = false;
+    if (!pending_updates_.empty()) {
+        if (replacement->supportsUpdate()) {
+            replacement->batchUpdate(pending_updates_);
+        } else {
+            replacement_dirty = true;
+        }
+        pending_updates_.clear();
+    }
+    
+    // The old algorithm is released here, after the swap
+    current_ = std::shared_ptr<IRMQAlgorithm>(std::move(replacement));
+    dirty_ = replacement_dirty;
+    stats_.migrations++;
+    
+    // Samples so far timed the old algorithm; calibrate the new one on its own
+    sampled_ns_ = 0.0;
+    sampled_ops_ = 0;
+    rebuild_ns_ = 0.0;
+}
+
+double AdaptiveRMQ::estimateBuildCost(AlgorithmType type, Size n) {
+    const double size = static_cast<double>(n);
+    const double log_n = std::max(1.0, std::log2(size));
+    
+    switch (type) {
+        case AlgorithmType::NAIVE:
+            return 0.0;
+        case AlgorithmType::DYNAMIC_PROGRAMMING:
+            return size * size;
+        case AlgorithmType::SPARSE_TABLE:
+            return 2.0 * size * log_n;
+        case AlgorithmType::BLOCK_DECOMPOSITION:
+            return size;
+        case AlgorithmType::LCA_BASED:
+            return size * (log_n + 8.0);
+        default:
+            return std::numeric_limits<double>::infinity();
+    }
+}
+
+double AdaptiveRMQ::estimateWindowCost(AlgorithmType type, const WorkloadStats& window, Size n) {
+    const double size = static_cast<double>(n);
+    const double log_n = std::max(1.0, std::log2(size));
+    const double block = std::floor(std::sqrt(size)) + 1.0;
+    const double queries = static_cast<double>(window.queries);
+    const double updates = static_cast<double>(window.updates);
+    const double length = window.meanRangeLength();
+    
+    // Static algorithms rebuild at most once per query that follows updates
+    const double rebuilds = std::min(updates, queries);
+    
+    switch (type) {
+        case AlgorithmType::NAIVE:
+            return queries * length + updates;
+        case AlgorithmType::BLOCK_DECOMPOSITION:
+            // Two partial blocks plus the block minima in between;
+            // an update rescans its block
+            return queries * (std::min(length, 2.0 * block) + length / block) + updates * block;
+        case AlgorithmType::SPARSE_TABLE:
+            return queries * 4.0 + rebuilds * estimateBuildCost(type, n);
+        case AlgorithmType::LCA_BASED:
+            return queries * 6.0 * log_n + rebuilds * estimateBuildCost(type, n);
+        case AlgorithmType::DYNAMIC_PROGRAMMING:
+            return queries * 2.0 + rebuilds * estimateBuildCost(type, n);
+        default:
+            return std::numeric_limits<double>::infinity();
+    }
+}
+
+std::vector<AlgorithmType> AdaptiveRMQ::candidatesFor(Size n) {
+    std::vector<AlgorithmType> candidates = {
+        AlgorithmType::NAIVE,
+        AlgorithmType::BLOCK_DECOMPOSITION,
+        AlgorithmType::SPARSE_TABLE
+    };
+    if (n <= static_cast<Size>(std::numeric_limits<int>::max())) {
+        candidates.push_back(AlgorithmType::LCA_BASED);
+    }
+    // Same small-array cut-off as the factory
+    if (n <= 1000) {
+        candidates.push_back(AlgorithmType::DYNAMIC_PROGRAMMING);
+    }
+    return candidates;
+}
+
+AlgorithmType AdaptiveRMQ::cheapestFor(const WorkloadStats& window, Size n) {
+    std::vector<AlgorithmType> candidates = candidatesFor(n);
+    
+    AlgorithmType best = candidates.front();
+    double best_cost = estimateWindowCost(best, window, n);
+    for (AlgorithmType type : candidates) {
+        double cost = estimateWindowCost(type, window, n);
+        if (cost < best_cost) {
+            best = type;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+} // namespace rmq
@@ -0,0 +1,217 @@
+#include "../../include/adaptive/rmq_overlay.h"
+#include "../../include/factory/rmq_factory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace rmq {
+
+OverlayRMQ::OverlayRMQ(AlgorithmType base, const OverlayConfig& config)
+    : config_(config),
+      base_type_(base),
+      base_(RMQFactory::create(base, config.algorithm_config)),
+      threshold_(0) {
+}
+
+OverlayRMQ::~OverlayRMQ() {
+    if (pending_build_.valid()) {
+        pending_build_.wait();
+    }
+}
+
+void OverlayRMQ::preprocess(const std::vector<Value>& data) {
+    if (data.size() > kernels::PACKED_MAX_SIZE) {
+        throw InvalidDataException("Overlay holds at most 2^32 elements");
+    }
+    
+    // A merge in flight is over the old data; let it finish and drop it
+    if (pending_build_.valid()) {
+        try {
+            pending_build_.get();
+        } catch (...) {
+        }
+        pending_updates_.clear();
+    }
+    
+    base_->preprocess(data);
+    data_ = data;
+    overlay_index_.clear();
+    overlay_entries_.clear();
+    
+    threshold_ = config_.merge_threshold;
+    if (threshold_ == 0) {
+        threshold_ = std::max<Size>(64, static_cast<Size>(std::sqrt(static_cast<double>(data_.size()))));
+    }
+}
+
+void OverlayRMQ::ensurePreprocessed() const {
+    if (!base_->isPreprocessed()) {
+        throw NotPreprocessedException(base_->getName());
+    }
+}
+
+void OverlayRMQ::validateQuery(Index left, Index right) const {
+    ensurePreprocessed();
+    if (left > right) {
+        throw InvalidQueryException(left, right);
+    }
+    if (right >= data_.size()) {
+        throw BoundsException(left, right, data_.size());
+    }
+}
+
+void OverlayRMQ::insertOverlay(Index index, Value value) {
+    auto position = std::lower_bound(overlay_index_.begin(), overlay_index_.end(), index);
+    size_t offset = position - overlay_index_.begin();
+    kernels::PackedEntry entry = kernels::packEntry(value, index);
+    
+    if (position != overlay_index_.end() && *position == index) {
+        overlay_entries_[offset] = entry;
+    } else {
+        overlay_index_.insert(position, index);
+        overlay_entries_.insert(overlay_entries_.begin() + offset, entry);
+    }
+}
+
+bool OverlayRMQ::overwritten(Index index) const {
+    return std::binary_search(overlay_index_.begin(), overlay_index_.end(), index);
+}
+
+kernels::PackedEntry OverlayRMQ::minimumEntry(Index left, Index right) {
+    kernels::PackedEntry best = std::numeric_limits<kernels::PackedEntry>::max();
+    
+    auto first = std::lower_bound(overlay_index_.begin(), overlay_index_.end(), left);
+    auto last = std::upper_bound(first, overlay_index_.end(), right);
+    if (first != last) {
+        best = kernels::scanMinEntry(overlay_entries_.data(), first - overlay_index_.begin(),
+                                     last - overlay_index_.begin() - 1);
+    }
+    
+    // Static minima of ranges not yet ruled out; an overwritten one splits its range
+    ranges_.clear();
+    ranges_.emplace_back(left, right);
+    bool repair = false;
+    while (!ranges_.empty()) {
+        auto [from, to] = ranges_.back();
+        ranges_.pop_back();
+        
+        QueryOutcome outcome = base_->tryQueryDetailed(from, to);
+        if (!outcome.ok()) {
+            throw AlgorithmException(base_->getName(), queryStatusToString(outcome.status));
+        }
+        if (repair) {
+            stats_.repair_probes++;
+        }
+        repair = true;
+        
+        // Unchanged positions in [from, to] are no smaller than this entry
+        kernels::PackedEntry entry = kernels::packEntry(outcome.value, outcome.index);
+        if (entry >= best) {
+            continue;
+        }
+        if (!overwritten(outcome.index)) {
+            best = entry;
+            continue;
+        }
+        
+        if (outcome.index > from) {
+            ranges_.emplace_back(from, outcome.index - 1);
+        }
+        if (outcome.index < to) {
+            ranges_.emplace_back(outcome.index + 1, to);
+        }
+    }
+    return best;
+}
+
+Value OverlayRMQ::query(Index left, Index right) {
+    validateQuery(left, right);
+    pollMerge(false);
+    return kernels::packedValue(minimumEntry(left, right));
+}
+
+Index OverlayRMQ::queryIndex(Index left, Index right) {
+    validateQuery(left, right);
+    pollMerge(false);
+    return kernels::packedIndex(minimumEntry(left, right));
+}
+
+void OverlayRMQ::update(Index index, Value value) {
+    batchUpdate({{index, value}});
+}
+
+void OverlayRMQ::batchUpdate(const std::vector<std::pair<Index, Value>>& updates) {
+    ensurePreprocessed();
+    for (const auto& [index, value] : updates) {
+        if (index >= data_.size()) {
+            throw BoundsException(index, data_.size());
+        }
+    }
+    
+    pollMerge(false);
+    
+    for (const auto& [index, value] : updates) {
+        data_[index] = value;
+        insertOverlay(index, value);
+    }
+    
+    // The merged index is built from an older snapshot
+    if (pending_build_.valid()) {
+        pending_updates_.insert(pending_updates_.end(), updates.begin(), updates.end());
+    } else if (overlay_index_.size() >= threshold_) {
+        startMerge();
+    }
+}
+
+void OverlayRMQ::waitForMerge() {
+    pollMerge(true);
+}
+
+void OverlayRMQ::startMerge() {
+    pending_updates_.clear();
+    
+    AlgorithmType type = base_type_;
+    AlgorithmConfig config = config_.algorithm_config;
+    auto build = [type, config](std::vector<Value> snapshot) {
+        RMQAlgorithmPtr merged = RMQFactory::create(type, config);
+        merged->preprocess(snapshot);
+        return merged;
+    };
+    
+    // Deferred builds run inside pollMerge(true), on this thread
+    pending_build_ = std::async(config_.background ? std::launch::async : std::launch::deferred,
+                                build, data_);
+    if (!config_.background) {
+        pollMerge(true);
+    }
+}
+
+void OverlayRMQ::pollMerge(bool wait) {
+    if (!pending_build_.valid()) return;
+    if (!wait && pending_build_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+    
+    RMQAlgorithmPtr merged;
+    try {
+        merged = pending_build_.get();
+    } catch (...) {
+        // Keep serving from the old index and the full overlay
+        stats_.failed_merges++;
+        pending_updates_.clear();
+        return;
+    }
+    
+    // The overlay restarts with the updates made during the build
+    base_ = std::shared_ptr<IRMQAlgorithm>(std::move(merged));
+    overlay_index_.clear();
+    overlay_entries_.clear();
+    for (const auto& [index, value] : pending_updates_) {
+        insertOverlay(index, value);
+    }
+    pending_updates_.clear();
+    stats_.merges++;
+}
+
+} // namespace rmq
@@ -0,0 +1,82 @@
+#include "../../include/algorithms/rmq_approximate.h"
+#include "../../include/core/rmq_kernels.h"
+#include <algorithm>
+#include <limits>
+
+namespace rmq {
+
+RMQApproximate::RMQApproximate(const std::vector<Value>& data, const ApproximateConfig& config)
+    : size_(data.size()), bucket_width_(0) {
+    if (data.empty()) {
+        throw InvalidDataException(0);
+    }
+    if (config.max_buckets == 0 && config.max_range_error == 0) {
+        throw ConfigurationException("max_buckets", "must be positive unless max_range_error is set");
+    }
+    
+    // A range is widened by at most bucket_width_ - 1 elements at each end
+    if (config.max_range_error != 0) {
+        bucket_width_ = std::min(config.max_range_error + 1, size_);
+    } else {
+        bucket_width_ = (size_ + config.max_buckets - 1) / config.max_buckets;
+    }
+    
+    Size buckets = (size_ + bucket_width_ - 1) / bucket_width_;
+    bucket_min_.resize(buckets);
+    bucket_max_.resize(buckets);
+    for (Size b = 0; b < buckets; ++b) {
+        Index first = b * bucket_width_;
+        Index last = std::min(first + bucket_width_, size_) - 1;
+        bucket_min_[b] = kernels::scanMin(data.data(), first, last);
+        bucket_max_[b] = *std::max_element(data.begin() + first, data.begin() + last + 1);
+    }
+}
+
+ApproximateMinimum RMQApproximate::query(Index left, Index right) const {
+    if (left > right) {
+        throw InvalidQueryException(left, right);
+    }
+    if (right >= size_) {
+        throw BoundsException(left, right, size_);
+    }
+    
+    Size first = left / bucket_width_;
+    Size last = right / bucket_width_;
+    
+    ApproximateMinimum result;
+    result.value = kernels::scanMin(bucket_min_.data(), first, last);
+    result.covered_left = first * bucket_width_;
+    result.covered_right = std::min((last + 1) * bucket_width_, size_) - 1;
+    
+    // Buckets wholly inside the range bound the true minimum by their
+    // minimum, partly covered ones only by their maximum
+    bool left_aligned = left == result.covered_left;
+    bool right_aligned = right == result.covered_right;
+    Size full_first = left_aligned ? first : first + 1;
+    Size full_end = right_aligned ? last + 1 : last;
+    
+    Value upper = std::numeric_limits<Value>::max();
+    if (full_first < full_end) {
+        upper = kernels::scanMin(bucket_min_.data(), full_first, full_end - 1);
+    }
+    if (!left_aligned) {
+        upper = std::min(upper, bucket_max_[first]);
+    }
+    if (!right_aligned) {
+        upper = std::min(upper, bucket_max_[last]);
+    }
+    result.upper_bound = upper;
+    return result;
+}
+
+size_t RMQApproximate::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQApproximate);
+    
+    // Minimum and maximum per bucket; the data is not kept
+    base_memory += bucket_min_.capacity() * sizeof(Value);
+    base_memory += bucket_max_.capacity() * sizeof(Value);
+    
+    return base_memory;
+}
+
+} // namespace rmq
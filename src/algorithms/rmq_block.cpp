@@ -1,4 +1,7 @@
 #include "../../include/algorithms/rmq_block.h"
+#include "../../include/core/rmq_kernels.h"
+#include "../../include/core/rmq_serialization.h"
+#include "../../include/core/rmq_trace.h"
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -23,7 +26,11 @@ size_t RMQBlockDecomposition::calculateBlockSize(size_t n) const {
         return std::min(config_.block_size, n);
     }
     
-    // Default to sqrt(n) for optimal complexity
+    return defaultBlockSize(n);
+}
+
+size_t RMQBlockDecomposition::defaultBlockSize(size_t n) {
+    // sqrt(n) for optimal complexity
     return static_cast<size_t>(std::sqrt(n)) + 1;
 }
 
@@ -32,25 +39,46 @@ void RMQBlockDecomposition::clearBlocks() {
     block_min_.shrink_to_fit();
     block_min_index_.clear();
     block_min_index_.shrink_to_fit();
+    packed_block_min_.clear();
+    packed_block_min_.shrink_to_fit();
+    compressed_ = CompressedArray();
     block_size_ = 0;
     num_blocks_ = 0;
 }
 
-void RMQBlockDecomposition::computeBlockMinimum(size_t block) {
-    Index start = getBlockStart(block);
-    Index end = getBlockEnd(block);
+void RMQBlockDecomposition::compressData() {
+    compressed_ = CompressedArray(data_, block_size_);
+    std::vector<Value>().swap(data_);
     
-    Value min_val = data_[start];
-    Index min_idx = start;
-    
-    for (Index i = start + 1; i <= end; ++i) {
-        if (data_[i] < min_val) {
-            min_val = data_[i];
-            min_idx = i;
-        }
+    // compressed_ keeps its own block minima
+    block_min_.clear();
+    block_min_.shrink_to_fit();
+    block_min_index_.clear();
+    block_min_index_.shrink_to_fit();
+    packed_block_min_.clear();
+    packed_block_min_.shrink_to_fit();
+}
+
+void RMQBlockDecomposition::packBlockMinima() {
+    packed_block_min_.resize(num_blocks_);
+    for (size_t block = 0; block < num_blocks_; ++block) {
+        packed_block_min_[block] = kernels::packEntry(block_min_[block], block_min_index_[block]);
     }
     
-    block_min_[block] = min_val;
+    block_min_.clear();
+    block_min_.shrink_to_fit();
+    block_min_index_.clear();
+    block_min_index_.shrink_to_fit();
+}
+
+void RMQBlockDecomposition::computeBlockMinimum(size_t block) {
+    Index min_idx = kernels::scanMinIndex(data_.data(), getBlockStart(block), getBlockEnd(block));
+    
+    if (isPacked()) {
+        packed_block_min_[block] = kernels::packEntry(data_[min_idx], min_idx);
+        return;
+    }
+    block_min_[block] = data_[min_idx];
     block_min_index_[block] = min_idx;
 }
 
@@ -65,48 +93,45 @@ void RMQBlockDecomposition::performPreprocess() {
     block_size_ = calculateBlockSize(n);
     num_blocks_ = (n + block_size_ - 1) / block_size_;
     
+    if (config_.compress_data) {
+        RMQ_TRACE_SCOPE_ARG("block.compress", num_blocks_);
+        compressData();
+        return;
+    }
+    
     // Allocate block arrays
     try {
-        block_min_.resize(num_blocks_);
-        block_min_index_.resize(num_blocks_);
+        if (config_.packed_entries && n <= kernels::PACKED_MAX_SIZE) {
+            packed_block_min_.resize(num_blocks_);
+        } else {
+            block_min_.resize(num_blocks_);
+            block_min_index_.resize(num_blocks_);
+        }
     } catch (const std::bad_alloc&) {
         clearBlocks();
         throw AllocationException("Failed to allocate block arrays");
     }
     
     // Compute minimum for each block
+    RMQ_TRACE_SCOPE_ARG("block.minimums", num_blocks_);
     for (size_t block = 0; block < num_blocks_; ++block) {
         computeBlockMinimum(block);
     }
 }
 
 Value RMQBlockDecomposition::queryPartialBlock(Index left, Index right) const {
-    Value min_val = data_[left];
-    
-    for (Index i = left + 1; i <= right; ++i) {
-        if (data_[i] < min_val) {
-            min_val = data_[i];
-        }
-    }
-    
-    return min_val;
+    return kernels::scanMin(data_.data(), left, right);
 }
 
 Index RMQBlockDecomposition::findMinIndexPartialBlock(Index left, Index right) const {
-    Value min_val = data_[left];
-    Index min_idx = left;
-    
-    for (Index i = left + 1; i <= right; ++i) {
-        if (data_[i] < min_val) {
-            min_val = data_[i];
-            min_idx = i;
-        }
-    }
-    
-    return min_idx;
+    return kernels::scanMinIndex(data_.data(), left, right);
 }
 
 Value RMQBlockDecomposition::performQuery(Index left, Index right) const {
+    if (isCompressed()) {
+        return compressed_.scanMin(left, right);
+    }
+    
     size_t left_block = getBlockNumber(left);
     size_t right_block = getBlockNumber(right);
     
@@ -121,8 +146,16 @@ Value RMQBlockDecomposition::performQuery(Index left, Index right) const {
         result = std::min(result, queryPartialBlock(left, left_block_end));
         
         // Handle complete middle blocks
-        for (size_t block = left_block + 1; block < right_block; ++block) {
-            result = std::min(result, block_min_[block]);
+        if (isPacked()) {
+            if (left_block + 1 < right_block) {
+                kernels::PackedEntry entry = kernels::scanMinEntry(packed_block_min_.data(),
+                                                                   left_block + 1, right_block - 1);
+                result = std::min(result, kernels::packedValue(entry));
+            }
+        } else {
+            for (size_t block = left_block + 1; block < right_block; ++block) {
+                result = std::min(result, block_min_[block]);
+            }
         }
         
         // Handle partial right block
@@ -134,6 +167,10 @@ Value RMQBlockDecomposition::performQuery(Index left, Index right) const {
 }
 
 Index RMQBlockDecomposition::findMinimumIndex(Index left, Index right) const {
+    if (isCompressed()) {
+        return compressed_.scanMinIndex(left, right);
+    }
+    
     size_t left_block = getBlockNumber(left);
     size_t right_block = getBlockNumber(right);
     
@@ -153,11 +190,22 @@ Index RMQBlockDecomposition::findMinimumIndex(Index left, Index right) const {
         min_idx = partial_idx;
     }
     
-    // Handle complete middle blocks
-    for (size_t block = left_block + 1; block < right_block; ++block) {
-        if (block_min_[block] < min_val) {
-            min_val = block_min_[block];
-            min_idx = block_min_index_[block];
+    // Handle complete middle blocks; the smallest key is the leftmost minimum
+    if (isPacked()) {
+        if (left_block + 1 < right_block) {
+            kernels::PackedEntry entry = kernels::scanMinEntry(packed_block_min_.data(),
+                                                               left_block + 1, right_block - 1);
+            if (kernels::packedValue(entry) < min_val) {
+                min_val = kernels::packedValue(entry);
+                min_idx = kernels::packedIndex(entry);
+            }
+        }
+    } else {
+        for (size_t block = left_block + 1; block < right_block; ++block) {
+            if (block_min_[block] < min_val) {
+                min_val = block_min_[block];
+                min_idx = block_min_index_[block];
+            }
         }
     }
     
@@ -184,8 +232,15 @@ ComplexityInfo RMQBlockDecomposition::getComplexity() const {
 void RMQBlockDecomposition::update(Index index, Value value) {
     ensurePreprocessed();
     
-    if (index >= data_.size()) {
-        throw BoundsException(index, data_.size());
+    if (index >= size_) {
+        throw BoundsException(index, size_);
+    }
+    recordUpdate(index, value);
+    
+    // Re-encoding the block also recomputes its minimum
+    if (isCompressed()) {
+        compressed_.set(index, value);
+        return;
     }
     
     // Update the value in the array
@@ -201,9 +256,17 @@ void RMQBlockDecomposition::batchUpdate(const std::vector<std::pair<Index, Value
     
     // Validate all indices first
     for (const auto& [index, value] : updates) {
-        if (index >= data_.size()) {
-            throw BoundsException(index, data_.size());
+        if (index >= size_) {
+            throw BoundsException(index, size_);
+        }
+    }
+    
+    if (isCompressed()) {
+        for (const auto& [index, value] : updates) {
+            recordUpdate(index, value);
+            compressed_.set(index, value);
         }
+        return;
     }
     
     // Track which blocks need recomputation
@@ -211,6 +274,7 @@ void RMQBlockDecomposition::batchUpdate(const std::vector<std::pair<Index, Value
     
     // Apply all updates
     for (const auto& [index, value] : updates) {
+        recordUpdate(index, value);
         data_[index] = value;
         blocks_to_update[getBlockNumber(index)] = true;
     }
@@ -223,6 +287,80 @@ void RMQBlockDecomposition::batchUpdate(const std::vector<std::pair<Index, Value
     }
 }
 
+void RMQBlockDecomposition::saveStructure(std::ostream& out) const {
+    serialization::writePod<uint64_t>(out, block_size_);
+    
+    if (!isCompressed() && !isPacked()) {
+        serialization::writeVector(out, block_min_);
+        serialization::writeVector(out, block_min_index_);
+        return;
+    }
+    
+    // Same layout as the parallel arrays, so any kind can load the index
+    std::vector<Value> block_min(num_blocks_);
+    std::vector<Index> block_min_index(num_blocks_);
+    for (size_t block = 0; block < num_blocks_; ++block) {
+        if (isPacked()) {
+            block_min[block] = kernels::packedValue(packed_block_min_[block]);
+            block_min_index[block] = kernels::packedIndex(packed_block_min_[block]);
+        } else {
+            block_min[block] = compressed_.blockMin(block);
+            block_min_index[block] = compressed_.blockMinIndex(block);
+        }
+    }
+    serialization::writeVector(out, block_min);
+    serialization::writeVector(out, block_min_index);
+}
+
+void RMQBlockDecomposition::loadStructure(std::istream& in) {
+    clearBlocks();
+    
+    Size n = data_.size();
+    uint64_t block_size = serialization::readPod<uint64_t>(in);
+    if (block_size == 0 || block_size > n) {
+        throw InvalidDataException("Binary index has an invalid block size");
+    }
+    
+    block_size_ = static_cast<size_t>(block_size);
+    num_blocks_ = (n + block_size_ - 1) / block_size_;
+    block_min_ = serialization::readVector<Value>(in, num_blocks_);
+    block_min_index_ = serialization::readVector<Index>(in, num_blocks_);
+    
+    if (block_min_.size() != num_blocks_ || block_min_index_.size() != num_blocks_) {
+        clearBlocks();
+        throw InvalidDataException("Binary index has an inconsistent block count");
+    }
+    
+    // A corrupt minimum index would send queries outside the array, and a
+    // consistent but wrong minimum would answer them wrongly, so each entry
+    // is checked against a scan of its block (the same O(n) as rebuilding)
+    for (size_t block = 0; block < num_blocks_; ++block) {
+        Index index = block_min_index_[block];
+        if (index < getBlockStart(block) || index > getBlockEnd(block) || data_[index] != block_min_[block]) {
+            clearBlocks();
+            throw InvalidDataException("Binary index has a block minimum outside its block");
+        }
+        if (block_min_[block] != kernels::scanMin(data_.data(), getBlockStart(block), getBlockEnd(block))) {
+            clearBlocks();
+            throw InvalidDataException("Binary index has a block minimum that is not the minimum");
+        }
+    }
+    
+    if (config_.compress_data) {
+        compressData();
+    } else if (config_.packed_entries && n <= kernels::PACKED_MAX_SIZE) {
+        packBlockMinima();
+    }
+}
+
+Value RMQBlockDecomposition::valueAt(Index index) const {
+    return isCompressed() ? compressed_.get(index) : data_[index];
+}
+
+std::vector<Value> RMQBlockDecomposition::copyData() const {
+    return isCompressed() ? compressed_.decode() : data_;
+}
+
 void RMQBlockDecomposition::clear() {
     RMQBase::clear();
     clearBlocks();
@@ -241,6 +379,10 @@ size_t RMQBlockDecomposition::getMemoryUsage() const {
         base_memory += block_min_.capacity() * sizeof(Value);
         base_memory += block_min_index_.capacity() * sizeof(Index);
     }
+    base_memory += packed_block_min_.capacity() * sizeof(kernels::PackedEntry);
+    
+    // Compressed data (block minima included)
+    base_memory += compressed_.getMemoryUsage();
     
     return base_memory;
 }
@@ -254,6 +396,11 @@ void RMQBlockDecomposition::rebuildBlocks() {
         throw NotPreprocessedException(getName());
     }
     
+    // Compressed blocks keep their minima current
+    if (isCompressed()) {
+        return;
+    }
+    
     // Recompute all block minimums
     for (size_t block = 0; block < num_blocks_; ++block) {
         computeBlockMinimum(block);
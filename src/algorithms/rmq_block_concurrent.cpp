@@ -0,0 +1,241 @@
+#include "../../include/algorithms/rmq_block_concurrent.h"
+#include "../../include/core/rmq_trace.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace rmq {
+
+static_assert(sizeof(std::atomic<Value>) == sizeof(Value) && alignof(std::atomic<Value>) == alignof(Value),
+              "data_ is accessed as std::atomic<Value>");
+static_assert(std::atomic<Value>::is_always_lock_free, "std::atomic<Value> must be lock-free");
+
+RMQConcurrentBlockDecomposition::RMQConcurrentBlockDecomposition()
+    : RMQBase(), block_size_(0), num_blocks_(0) {
+}
+
+RMQConcurrentBlockDecomposition::RMQConcurrentBlockDecomposition(const AlgorithmConfig& config)
+    : RMQBase(config), block_size_(0), num_blocks_(0) {
+}
+
+RMQConcurrentBlockDecomposition::~RMQConcurrentBlockDecomposition() {
+    clearBlocks();
+}
+
+size_t RMQConcurrentBlockDecomposition::calculateBlockSize(size_t n) const {
+    // Same choice as RMQBlockDecomposition
+    if (config_.block_size != constants::DEFAULT_BLOCK_SIZE) {
+        return std::min(config_.block_size, n);
+    }
+    return static_cast<size_t>(std::sqrt(n)) + 1;
+}
+
+void RMQConcurrentBlockDecomposition::clearBlocks() {
+    block_key_.reset();
+    block_lock_.reset();
+    block_size_ = 0;
+    num_blocks_ = 0;
+}
+
+void RMQConcurrentBlockDecomposition::atomicMin(std::atomic<uint64_t>& target, uint64_t key) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (key < current &&
+           !target.compare_exchange_weak(current, key, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t RMQConcurrentBlockDecomposition::scanKey(size_t block, Index left, Index right) const {
+    const std::atomic<Value>* elements = values();
+    Index start = getBlockStart(block);
+    
+    uint64_t best = EMPTY_KEY;
+    for (Index i = left; i <= right; ++i) {
+        best = std::min(best, encodeKey(elements[i].load(std::memory_order_acquire), i - start));
+    }
+    return best;
+}
+
+uint64_t RMQConcurrentBlockDecomposition::blockKey(size_t block) const {
+    uint64_t key = block_key_[block].load(std::memory_order_acquire);
+    if (key == EMPTY_KEY) {
+        // An increase is rescanning this block; do not wait for it
+        key = scanKey(block, getBlockStart(block), getBlockEnd(block));
+    }
+    return key;
+}
+
+std::pair<size_t, uint64_t> RMQConcurrentBlockDecomposition::rangeKey(Index left, Index right) const {
+    size_t left_block = getBlockNumber(left);
+    size_t right_block = getBlockNumber(right);
+    
+    if (left_block == right_block) {
+        return {left_block, scanKey(left_block, left, right)};
+    }
+    
+    // Blocks are visited left to right and only a strictly smaller key wins,
+    // so ties resolve to the leftmost block (and offset within it)
+    std::pair<size_t, uint64_t> best(left_block, scanKey(left_block, left, getBlockEnd(left_block)));
+    for (size_t block = left_block + 1; block < right_block; ++block) {
+        uint64_t key = blockKey(block);
+        if ((key >> 32) < (best.second >> 32)) {
+            best = {block, key};
+        }
+    }
+    uint64_t right_key = scanKey(right_block, getBlockStart(right_block), right);
+    if ((right_key >> 32) < (best.second >> 32)) {
+        best = {right_block, right_key};
+    }
+    return best;
+}
+
+void RMQConcurrentBlockDecomposition::lockBlock(size_t block) {
+    std::atomic<bool>& lock = block_lock_[block];
+    while (lock.exchange(true, std::memory_order_acquire)) {
+        while (lock.load(std::memory_order_relaxed)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void RMQConcurrentBlockDecomposition::unlockBlock(size_t block) {
+    block_lock_[block].store(false, std::memory_order_release);
+}
+
+void RMQConcurrentBlockDecomposition::repairBlock(size_t block, size_t offset) {
+    // Repairs in a block are serialized so a rescan never reads a value
+    // that another repair is about to replace
+    lockBlock(block);
+    std::atomic<uint64_t>& key = block_key_[block];
+    if (keyOffset(key.load(std::memory_order_seq_cst)) == offset) {
+        // Clear first: decreases landing during the rescan lower the cleared
+        // key and are not overwritten
+        key.exchange(EMPTY_KEY, std::memory_order_seq_cst);
+        atomicMin(key, scanKey(block, getBlockStart(block), getBlockEnd(block)));
+    }
+    unlockBlock(block);
+}
+
+void RMQConcurrentBlockDecomposition::performPreprocess() {
+    Size n = data_.size();
+    if (n == 0) return;
+    
+    clearBlocks();
+    
+    block_size_ = calculateBlockSize(n);
+    if (block_size_ >= 0xFFFFFFFFu) {
+        throw ConfigurationException("block_size", "must be below 2^32 for concurrent updates");
+    }
+    num_blocks_ = (n + block_size_ - 1) / block_size_;
+    
+    try {
+        block_key_.reset(new std::atomic<uint64_t>[num_blocks_]);
+        block_lock_.reset(new std::atomic<bool>[num_blocks_]);
+    } catch (const std::bad_alloc&) {
+        clearBlocks();
+        throw AllocationException("Failed to allocate block arrays");
+    }
+    
+    RMQ_TRACE_SCOPE_ARG("block.minimums", num_blocks_);
+    for (size_t block = 0; block < num_blocks_; ++block) {
+        block_lock_[block].store(false, std::memory_order_relaxed);
+        block_key_[block].store(scanKey(block, getBlockStart(block), getBlockEnd(block)),
+                                std::memory_order_relaxed);
+    }
+}
+
+Value RMQConcurrentBlockDecomposition::performQuery(Index left, Index right) const {
+    return keyValue(rangeKey(left, right).second);
+}
+
+Index RMQConcurrentBlockDecomposition::findMinimumIndex(Index left, Index right) const {
+    auto [block, key] = rangeKey(left, right);
+    return getBlockStart(block) + keyOffset(key);
+}
+
+std::pair<Value, Index> RMQConcurrentBlockDecomposition::findMinimum(Index left, Index right) const {
+    // One key, so the value and index agree even while updates run
+    auto [block, key] = rangeKey(left, right);
+    return {keyValue(key), getBlockStart(block) + keyOffset(key)};
+}
+
+std::vector<Value> RMQConcurrentBlockDecomposition::copyData() const {
+    const std::atomic<Value>* elements = values();
+    std::vector<Value> copy(data_.size());
+    for (Index i = 0; i < copy.size(); ++i) {
+        copy[i] = elements[i].load(std::memory_order_acquire);
+    }
+    return copy;
+}
+
+ComplexityInfo RMQConcurrentBlockDecomposition::getComplexity() const {
+    return ComplexityInfo(
+        "O(n)",      // preprocessing_time
+        "O(√n)",     // preprocessing_space
+        "O(√n)",     // query_time
+        "O(1)",      // query_space
+        "O(n + √n)"  // total_space
+    );
+}
+
+void RMQConcurrentBlockDecomposition::update(Index index, Value value) {
+    ensurePreprocessed();
+    
+    if (index >= data_.size()) {
+        throw BoundsException(index, data_.size());
+    }
+    recordUpdate(index, value);
+    
+    size_t block = getBlockNumber(index);
+    size_t offset = index - getBlockStart(block);
+    std::atomic<Value>& element = values()[index];
+    
+    // Decrease: lower the block key. If another writer replaced the element
+    // before the key was lowered, the key may now hold a value that is gone;
+    // that writer's repair may have missed it, so repair here.
+    if (value <= element.exchange(value, std::memory_order_seq_cst)) {
+        atomicMin(block_key_[block], encodeKey(value, offset));
+        if (element.load(std::memory_order_seq_cst) != value) {
+            repairBlock(block, offset);
+        }
+        return;
+    }
+    
+    // Increase: only a change to the current minimum needs a rescan
+    repairBlock(block, offset);
+}
+
+void RMQConcurrentBlockDecomposition::batchUpdate(const std::vector<std::pair<Index, Value>>& updates) {
+    ensurePreprocessed();
+    
+    // Validate all indices first
+    for (const auto& [index, value] : updates) {
+        if (index >= data_.size()) {
+            throw BoundsException(index, data_.size());
+        }
+    }
+    
+    for (const auto& [index, value] : updates) {
+        update(index, value);
+    }
+}
+
+void RMQConcurrentBlockDecomposition::clear() {
+    RMQBase::clear();
+    clearBlocks();
+}
+
+size_t RMQConcurrentBlockDecomposition::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQConcurrentBlockDecomposition);
+    
+    // Data vector memory
+    if (!data_.empty()) {
+        base_memory += data_.capacity() * sizeof(Value);
+    }
+    
+    // Block keys and locks
+    base_memory += num_blocks_ * (sizeof(std::atomic<uint64_t>) + sizeof(std::atomic<bool>));
+    
+    return base_memory;
+}
+
+} // namespace rmq
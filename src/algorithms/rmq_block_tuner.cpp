@@ -0,0 +1,196 @@
+#include "../../include/algorithms/rmq_block_tuner.h"
+#include "../../include/algorithms/rmq_block.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace rmq {
+
+BlockSizeProfile::Key BlockSizeProfile::keyOf(Size n, const WorkloadStats& workload) {
+    Size mean_length = static_cast<Size>(workload.meanRangeLength());
+    return Key(WorkloadStats::lengthBucket(n), WorkloadStats::lengthBucket(mean_length));
+}
+
+Size BlockSizeProfile::lookup(Size n, const WorkloadStats& workload) const {
+    auto it = block_sizes_.find(keyOf(n, workload));
+    return it == block_sizes_.end() ? 0 : it->second;
+}
+
+void BlockSizeProfile::record(Size n, const WorkloadStats& workload, Size block_size) {
+    block_sizes_[keyOf(n, workload)] = block_size;
+}
+
+void BlockSizeProfile::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw AlgorithmException("Failed to create block profile " + path);
+    }
+    
+    out << HEADER << " " << VERSION << "\n";
+    for (const auto& [key, block_size] : block_sizes_) {
+        out << key.first << " " << key.second << " " << block_size << "\n";
+    }
+    
+    out.flush();
+    if (!out) {
+        throw AlgorithmException("Failed to write block profile " + path);
+    }
+}
+
+BlockSizeProfile BlockSizeProfile::load(const std::string& path) {
+    BlockSizeProfile profile;
+    std::ifstream in(path);
+    if (!in) {
+        return profile;
+    }
+    
+    std::string header;
+    int version = 0;
+    if (!(in >> header >> version) || header != HEADER) {
+        throw InvalidDataException("Not a block profile: " + path);
+    }
+    if (version != VERSION) {
+        throw InvalidDataException("Unsupported block profile version " + std::to_string(version));
+    }
+    
+    size_t n_bucket = 0;
+    size_t length_bucket = 0;
+    Size block_size = 0;
+    while (in >> n_bucket >> length_bucket >> block_size) {
+        if (block_size == 0) {
+            throw InvalidDataException("Block profile " + path + " has a zero block size");
+        }
+        profile.block_sizes_[Key(n_bucket, length_bucket)] = block_size;
+    }
+    if (!in.eof()) {
+        throw InvalidDataException("Block profile " + path + " is malformed");
+    }
+    return profile;
+}
+
+std::vector<Size> BlockSizeTuner::candidateSizes(Size n) {
+    if (n <= CACHE_LINE_VALUES) {
+        return {n};
+    }
+    
+    Size limit = std::min(n, static_cast<Size>(8.0 * std::sqrt(static_cast<double>(n))));
+    limit = std::max(limit, CACHE_LINE_VALUES);
+    
+    // Cache lines per block: 1, 2, 3, 4, 6, 8, 12, 16, ... (about sqrt(2) apart)
+    std::vector<Size> sizes;
+    for (Size lines = 1; lines * CACHE_LINE_VALUES <= limit;) {
+        sizes.push_back(lines * CACHE_LINE_VALUES);
+        Size next = static_cast<Size>(std::lround(static_cast<double>(lines) * std::sqrt(2.0)));
+        lines = std::max(next, lines + 1);
+    }
+    return sizes;
+}
+
+double BlockSizeTuner::measure(const std::vector<Value>& data, const std::vector<Query>& sample,
+                               const AlgorithmConfig& config, double min_ms) {
+    using clock = std::chrono::steady_clock;
+    
+    RMQBlockDecomposition rmq(config);
+    rmq.preprocess(data);
+    
+    // Whole passes over the sample until min_ms has elapsed
+    volatile Value sink = 0;
+    Size queries = 0;
+    auto start = clock::now();
+    double elapsed_ns = 0.0;
+    do {
+        for (const Query& query : sample) {
+            sink = rmq.query(query.left, query.right);
+        }
+        queries += sample.size();
+        elapsed_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+    } while (elapsed_ns < min_ms * 1e6);
+    (void)sink;
+    
+    return elapsed_ns / static_cast<double>(queries);
+}
+
+void BlockSizeTuner::validate(const std::vector<Value>& data, const std::vector<Query>& sample) {
+    if (data.empty()) {
+        throw InvalidDataException(0);
+    }
+    if (sample.empty()) {
+        throw InvalidDataException("Block size tuning needs a query sample");
+    }
+    for (const Query& query : sample) {
+        if (query.left > query.right) {
+            throw InvalidQueryException(query.left, query.right);
+        }
+        if (query.right >= data.size()) {
+            throw BoundsException(query.left, query.right, data.size());
+        }
+    }
+}
+
+BlockSizeTuning BlockSizeTuner::tune(const std::vector<Value>& data, const std::vector<Query>& sample,
+                                     double min_ms_per_candidate, const AlgorithmConfig& config) {
+    validate(data, sample);
+    
+    std::vector<Size> candidates = candidateSizes(data.size());
+    Size default_size = std::min(RMQBlockDecomposition::defaultBlockSize(data.size()), data.size());
+    auto position = std::lower_bound(candidates.begin(), candidates.end(), default_size);
+    if (position == candidates.end() || *position != default_size) {
+        candidates.insert(position, default_size);
+    }
+    
+    BlockSizeTuning tuning;
+    tuning.ns_per_query = std::numeric_limits<double>::infinity();
+    tuning.default_ns_per_query = std::numeric_limits<double>::infinity();
+    for (Size block_size : candidates) {
+        tuning.trials.push_back({block_size, std::numeric_limits<double>::infinity()});
+    }
+    
+    // Two interleaved rounds, keeping each candidate's faster one, so a
+    // burst of noise does not single out one candidate
+    for (int round = 0; round < 2; ++round) {
+        for (BlockSizeTrial& trial : tuning.trials) {
+            AlgorithmConfig candidate_config = config;
+            candidate_config.withBlockSize(trial.block_size);
+            trial.ns_per_query = std::min(trial.ns_per_query,
+                                          measure(data, sample, candidate_config, min_ms_per_candidate));
+        }
+    }
+    
+    for (const BlockSizeTrial& trial : tuning.trials) {
+        if (trial.ns_per_query < tuning.ns_per_query) {
+            tuning.block_size = trial.block_size;
+            tuning.ns_per_query = trial.ns_per_query;
+        }
+        if (trial.block_size == default_size) {
+            tuning.default_ns_per_query = trial.ns_per_query;
+        }
+    }
+    return tuning;
+}
+
+BlockSizeTuning BlockSizeTuner::tune(const std::vector<Value>& data, const std::vector<Query>& sample,
+                                     BlockSizeProfile& profile, double min_ms_per_candidate,
+                                     const AlgorithmConfig& config) {
+    validate(data, sample);
+    
+    WorkloadStats workload;
+    for (const Query& query : sample) {
+        workload.recordQuery(query.left, query.right);
+    }
+    
+    Size recorded = profile.lookup(data.size(), workload);
+    if (recorded != 0) {
+        BlockSizeTuning tuning;
+        tuning.block_size = std::min(recorded, data.size());
+        tuning.from_profile = true;
+        return tuning;
+    }
+    
+    BlockSizeTuning tuning = tune(data, sample, min_ms_per_candidate, config);
+    profile.record(data.size(), workload, tuning.block_size);
+    return tuning;
+}
+
+} // namespace rmq
@@ -1,6 +1,9 @@
 #include "../../include/algorithms/rmq_dp.h"
+#include "../../include/core/rmq_trace.h"
 #include <algorithm>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 namespace rmq {
 
@@ -13,10 +16,10 @@ RMQDynamicProgramming::~RMQDynamicProgramming() {
 }
 
 void RMQDynamicProgramming::validateSizeForDP() const {
-    if (data_.size() > constants::MAX_ARRAY_SIZE) {
+    if (data_.size() > config_.max_array_size) {
         std::ostringstream oss;
         oss << "Array size " << data_.size() 
-            << " exceeds maximum allowed size " << constants::MAX_ARRAY_SIZE;
+            << " exceeds maximum allowed size " << config_.max_array_size;
         throw InvalidDataException(oss.str());
     }
     
@@ -55,6 +58,7 @@ void RMQDynamicProgramming::performPreprocess() {
     
     // Allocate DP tables
     try {
+        RMQ_TRACE_SCOPE("dp.allocate");
         dp_table_.resize(n, std::vector<Value>(n));
         min_index_table_.resize(n, std::vector<Index>(n));
     } catch (const std::bad_alloc&) {
@@ -62,28 +66,102 @@ void RMQDynamicProgramming::performPreprocess() {
         throw AllocationException(n * n * (sizeof(Value) + sizeof(Index)));
     }
     
-    // Fill DP table using dynamic programming
-    // Base case: single elements
-    for (Index i = 0; i < n; ++i) {
-        dp_table_[i][i] = data_[i];
-        min_index_table_[i][i] = i;
+    // Fill the table row by row. Rows are split into contiguous chunks of
+    // roughly equal work (row i holds n - i entries) and each chunk is filled
+    // independently, optionally on its own thread.
+    size_t num_workers = 1;
+    if (config_.enable_parallel && n >= PARALLEL_MIN_SIZE) {
+        num_workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+        num_workers = std::min(num_workers, n / PARALLEL_MIN_ROWS_PER_WORKER);
+        num_workers = std::max<size_t>(1, num_workers);
     }
     
-    // Fill for increasing lengths
-    for (Size length = 2; length <= n; ++length) {
-        for (Index i = 0; i <= n - length; ++i) {
-            Index j = i + length - 1;
-            
-            // Compare the minimum of [i, j-1] with element at j
-            if (dp_table_[i][j - 1] <= data_[j]) {
-                dp_table_[i][j] = dp_table_[i][j - 1];
-                min_index_table_[i][j] = min_index_table_[i][j - 1];
+    if (num_workers == 1) {
+        fillRows(0, n);
+        return;
+    }
+    
+    // Partition the upper triangle into chunks of equal area
+    std::vector<Index> boundaries;
+    boundaries.push_back(0);
+    const double total_work = static_cast<double>(n) * (n + 1) / 2.0;
+    double accumulated = 0.0;
+    for (Index i = 0; i < n && boundaries.size() < num_workers; ++i) {
+        accumulated += static_cast<double>(n - i);
+        if (accumulated >= total_work * boundaries.size() / num_workers) {
+            boundaries.push_back(i + 1);
+        }
+    }
+    boundaries.push_back(n);
+    
+    std::vector<std::thread> workers;
+    workers.reserve(boundaries.size() - 1);
+    size_t w = 0;
+    try {
+        for (; w + 1 < boundaries.size(); ++w) {
+            if (boundaries[w] < boundaries[w + 1]) {
+                workers.emplace_back(&RMQDynamicProgramming::fillRows, this,
+                                     boundaries[w], boundaries[w + 1]);
+            }
+        }
+    } catch (const std::system_error&) {
+        // Out of threads: fill the chunks that did not get one here, then
+        // join the workers that started
+        for (; w + 1 < boundaries.size(); ++w) {
+            fillRows(boundaries[w], boundaries[w + 1]);
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void RMQDynamicProgramming::fillRows(Index row_begin, Index row_end) {
+    Size n = data_.size();
+    if (row_begin >= row_end) return;
+    
+    RMQ_TRACE_SCOPE_ARG("dp.fill_rows", row_end - row_begin);
+    
+    // Last row of the chunk: plain prefix-min scan over data_
+    Index last = row_end - 1;
+    {
+        Value* values = dp_table_[last].data();
+        Index* indices = min_index_table_[last].data();
+        
+        values[last] = data_[last];
+        indices[last] = last;
+        for (Index j = last + 1; j < n; ++j) {
+            // Keep the earlier index on ties (leftmost minimum)
+            if (values[j - 1] <= data_[j]) {
+                values[j] = values[j - 1];
+                indices[j] = indices[j - 1];
             } else {
-                dp_table_[i][j] = data_[j];
-                min_index_table_[i][j] = j;
+                values[j] = data_[j];
+                indices[j] = j;
             }
         }
     }
+    
+    // Remaining rows, bottom-up: min[i][j] = min(A[i], min[i+1][j]).
+    // Each row is an element-wise min against the row below, so the inner
+    // loop has no carried dependency and is vectorized by the compiler.
+    for (Index i = last; i-- > row_begin; ) {
+        const Value head = data_[i];
+        const Value* below_values = dp_table_[i + 1].data();
+        const Index* below_indices = min_index_table_[i + 1].data();
+        Value* values = dp_table_[i].data();
+        Index* indices = min_index_table_[i].data();
+        
+        values[i] = head;
+        indices[i] = i;
+        for (Index j = i + 1; j < n; ++j) {
+            const Value below_value = below_values[j];
+            const Index below_index = below_indices[j];
+            const bool take_head = head <= below_value;
+            values[j] = take_head ? head : below_value;
+            indices[j] = take_head ? i : below_index;
+        }
+    }
 }
 
 Value RMQDynamicProgramming::performQuery(Index left, Index right) const {
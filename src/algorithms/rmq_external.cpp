@@ -0,0 +1,387 @@
+#include "../../include/algorithms/rmq_external.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RMQ_EXTERNAL_USE_PREAD 1
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rmq {
+
+RMQExternalMemory::RMQExternalMemory()
+    : RMQExternalMemory(AlgorithmConfig()) {
+}
+
+RMQExternalMemory::RMQExternalMemory(const AlgorithmConfig& config, Size cache_bytes)
+    : config_(config),
+      cache_bytes_(cache_bytes),
+      fd_(-1),
+      file_(nullptr),
+      size_(0),
+      block_size_(0),
+      num_blocks_(0),
+      cache_capacity_(0) {
+}
+
+RMQExternalMemory::~RMQExternalMemory() {
+    close();
+}
+
+void RMQExternalMemory::close() {
+#ifdef RMQ_EXTERNAL_USE_PREAD
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+    fd_ = -1;
+    file_ = nullptr;
+    path_.clear();
+    
+    size_ = 0;
+    block_size_ = 0;
+    num_blocks_ = 0;
+    block_min_.clear();
+    block_min_.shrink_to_fit();
+    block_min_index_.clear();
+    block_min_index_.shrink_to_fit();
+    sparse_min_.clear();
+    sparse_min_.shrink_to_fit();
+    log_table_.clear();
+    log_table_.shrink_to_fit();
+    
+    dropCache();
+    cache_capacity_ = 0;
+}
+
+void RMQExternalMemory::dropCache() {
+    cache_.clear();
+    lru_.clear();
+}
+
+void RMQExternalMemory::open(const std::string& path) {
+    close();
+    
+    Size file_bytes = 0;
+#ifdef RMQ_EXTERNAL_USE_PREAD
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw InvalidDataException("Cannot open data file " + path);
+    }
+    
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        close();
+        throw InvalidDataException("Cannot stat data file " + path);
+    }
+    file_bytes = static_cast<Size>(st.st_size);
+#else
+    file_ = std::fopen(path.c_str(), "rb");
+    if (file_ == nullptr) {
+        throw InvalidDataException("Cannot open data file " + path);
+    }
+    std::fseek(file_, 0, SEEK_END);
+    file_bytes = static_cast<Size>(std::ftell(file_));
+#endif
+
+    if (file_bytes < sizeof(Value) || file_bytes % sizeof(Value) != 0) {
+        close();
+        throw InvalidDataException("Data file " + path + " is empty or truncated");
+    }
+    
+    path_ = path;
+    size_ = file_bytes / sizeof(Value);
+    block_size_ = config_.block_size != constants::DEFAULT_BLOCK_SIZE
+                      ? std::min(config_.block_size, size_)
+                      : std::min(DEFAULT_BLOCK_ELEMENTS, size_);
+    num_blocks_ = (size_ + block_size_ - 1) / block_size_;
+    
+    if (num_blocks_ > std::numeric_limits<uint32_t>::max()) {
+        close();
+        throw ConfigurationException("block_size", "too many blocks for the block index");
+    }
+    
+    cache_capacity_ = std::max<Size>(1, cache_bytes_ / (block_size_ * sizeof(Value)));
+    
+    // One sequential pass over the file computes every block minimum.
+    // These reads bypass the cache and are not counted in the query stats.
+    try {
+        block_min_.resize(num_blocks_);
+        block_min_index_.resize(num_blocks_);
+        
+        std::vector<Value> buffer(block_size_);
+        for (size_t block = 0; block < num_blocks_; ++block) {
+            Index start = getBlockStart(block);
+            Size count = getBlockEnd(block) - start + 1;
+            readBlock(block, buffer.data(), count);
+            
+            Value min_val = buffer[0];
+            Index min_idx = 0;
+            for (Index i = 1; i < count; ++i) {
+                if (buffer[i] < min_val) {
+                    min_val = buffer[i];
+                    min_idx = i;
+                }
+            }
+            block_min_[block] = min_val;
+            block_min_index_[block] = start + min_idx;
+        }
+        
+        buildSparseTable();
+    } catch (const std::bad_alloc&) {
+        close();
+        throw AllocationException("Failed to allocate external block index");
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+void RMQExternalMemory::readBlock(size_t block, Value* out, Size count) const {
+    Size bytes = count * sizeof(Value);
+    Size offset = getBlockStart(block) * sizeof(Value);
+
+#ifdef RMQ_EXTERNAL_USE_PREAD
+    char* dst = reinterpret_cast<char*>(out);
+    Size done = 0;
+    while (done < bytes) {
+        ssize_t got = ::pread(fd_, dst + done, bytes - done, static_cast<off_t>(offset + done));
+        if (got <= 0) {
+            throw AlgorithmException(getName(), "Failed to read block from " + path_);
+        }
+        done += static_cast<Size>(got);
+    }
+#else
+    if (std::fseek(file_, static_cast<long>(offset), SEEK_SET) != 0 ||
+        std::fread(out, 1, bytes, file_) != bytes) {
+        throw AlgorithmException(getName(), "Failed to read block from " + path_);
+    }
+#endif
+}
+
+const std::vector<Value>& RMQExternalMemory::fetchBlock(size_t block) const {
+    auto it = cache_.find(block);
+    if (it != cache_.end()) {
+        stats_.cache_hits++;
+        lru_.splice(lru_.begin(), lru_, it->second.lru_pos);
+        return it->second.values;
+    }
+    
+    stats_.cache_misses++;
+    
+    // Reuse the least recently used buffer when the cache is full
+    std::vector<Value> values;
+    if (cache_.size() >= cache_capacity_) {
+        size_t victim = lru_.back();
+        lru_.pop_back();
+        auto victim_it = cache_.find(victim);
+        values.swap(victim_it->second.values);
+        cache_.erase(victim_it);
+        stats_.evictions++;
+    }
+    
+    Size count = getBlockEnd(block) - getBlockStart(block) + 1;
+    values.resize(count);
+    readBlock(block, values.data(), count);
+    stats_.block_reads++;
+    stats_.bytes_read += count * sizeof(Value);
+    
+    lru_.push_front(block);
+    CacheEntry& entry = cache_[block];
+    entry.values.swap(values);
+    entry.lru_pos = lru_.begin();
+    return entry.values;
+}
+
+void RMQExternalMemory::buildSparseTable() {
+    log_table_.assign(num_blocks_ + 1, 0);
+    for (size_t i = 2; i <= num_blocks_; ++i) {
+        log_table_[i] = static_cast<uint8_t>(log_table_[i / 2] + 1);
+    }
+    
+    size_t levels = log_table_[num_blocks_] + 1;
+    sparse_min_.assign(levels, std::vector<uint32_t>());
+    
+    sparse_min_[0].resize(num_blocks_);
+    for (size_t b = 0; b < num_blocks_; ++b) {
+        sparse_min_[0][b] = static_cast<uint32_t>(b);
+    }
+    
+    for (size_t k = 1; k < levels; ++k) {
+        size_t half = size_t(1) << (k - 1);
+        size_t count = num_blocks_ - (size_t(1) << k) + 1;
+        const std::vector<uint32_t>& prev = sparse_min_[k - 1];
+        std::vector<uint32_t>& level = sparse_min_[k];
+        level.resize(count);
+        
+        for (size_t b = 0; b < count; ++b) {
+            uint32_t a = prev[b];
+            uint32_t c = prev[b + half];
+            level[b] = block_min_[a] <= block_min_[c] ? a : c;
+        }
+    }
+}
+
+size_t RMQExternalMemory::queryBlocks(size_t first, size_t last) const {
+    size_t k = log_table_[last - first + 1];
+    uint32_t a = sparse_min_[k][first];
+    uint32_t b = sparse_min_[k][last - (size_t(1) << k) + 1];
+    return block_min_[a] <= block_min_[b] ? a : b;
+}
+
+std::pair<Value, Index> RMQExternalMemory::scanBlock(size_t block, Index left, Index right) const {
+    Index start = getBlockStart(block);
+    
+    // A complete block is answered from its stored minimum without I/O
+    if (left == start && right == getBlockEnd(block)) {
+        return {block_min_[block], block_min_index_[block]};
+    }
+    
+    const std::vector<Value>& values = fetchBlock(block);
+    Value min_val = values[left - start];
+    Index min_idx = left;
+    for (Index i = left + 1; i <= right; ++i) {
+        if (values[i - start] < min_val) {
+            min_val = values[i - start];
+            min_idx = i;
+        }
+    }
+    return {min_val, min_idx};
+}
+
+std::pair<Value, Index> RMQExternalMemory::findMinimum(Index left, Index right) const {
+    stats_.queries++;
+    
+    size_t left_block = left / block_size_;
+    size_t right_block = right / block_size_;
+    
+    if (left_block == right_block) {
+        return scanBlock(left_block, left, right);
+    }
+    
+    // Left, middle and right parts in index order; strict < keeps the leftmost
+    std::pair<Value, Index> best = scanBlock(left_block, left, getBlockEnd(left_block));
+    
+    if (left_block + 1 < right_block) {
+        size_t block = queryBlocks(left_block + 1, right_block - 1);
+        if (block_min_[block] < best.first) {
+            best = {block_min_[block], block_min_index_[block]};
+        }
+    }
+    
+    std::pair<Value, Index> tail = scanBlock(right_block, getBlockStart(right_block), right);
+    if (tail.first < best.first) {
+        best = tail;
+    }
+    
+    return best;
+}
+
+void RMQExternalMemory::validateQuery(Index left, Index right) const {
+    if (!isOpen()) {
+        throw NotPreprocessedException(getName());
+    }
+    
+    if (left > right) {
+        throw InvalidQueryException(left, right);
+    }
+    
+    if (right >= size_) {
+        throw BoundsException(left, right, size_);
+    }
+}
+
+Value RMQExternalMemory::query(Index left, Index right) const {
+    validateQuery(left, right);
+    return findMinimum(left, right).first;
+}
+
+QueryResult RMQExternalMemory::queryDetailed(Index left, Index right) const {
+    validateQuery(left, right);
+    
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::pair<Value, Index> result = findMinimum(left, right);
+    auto end_time = std::chrono::high_resolution_clock::now();
+    
+    return QueryResult(result.first, result.second,
+                       std::chrono::duration_cast<Duration>(end_time - start_time));
+}
+
+QueryOutcome RMQExternalMemory::tryQuery(Index left, Index right) const noexcept {
+    if (!isOpen()) {
+        return QueryOutcome(QueryStatus::NOT_PREPROCESSED, 0, constants::INVALID_INDEX);
+    }
+    if (left > right) {
+        return QueryOutcome(QueryStatus::INVALID_RANGE, 0, constants::INVALID_INDEX);
+    }
+    if (right >= size_) {
+        return QueryOutcome(QueryStatus::OUT_OF_BOUNDS, 0, constants::INVALID_INDEX);
+    }
+    
+    try {
+        std::pair<Value, Index> result = findMinimum(left, right);
+        return QueryOutcome(QueryStatus::OK, result.first, result.second);
+    } catch (...) {
+        // Read failures and cache allocation failures
+        return QueryOutcome(QueryStatus::INTERNAL_ERROR, 0, constants::INVALID_INDEX);
+    }
+}
+
+ComplexityInfo RMQExternalMemory::getComplexity() const {
+    return ComplexityInfo(
+        "O(n)",              // preprocessing_time (one sequential scan)
+        "O((n/b) log(n/b))", // preprocessing_space (resident)
+        "O(b)",              // query_time (at most two block reads)
+        "O(1)",              // query_space
+        "O(n) on disk"       // total_space
+    );
+}
+
+size_t RMQExternalMemory::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQExternalMemory);
+    
+    base_memory += block_min_.capacity() * sizeof(Value);
+    base_memory += block_min_index_.capacity() * sizeof(Index);
+    
+    for (const auto& level : sparse_min_) {
+        base_memory += level.capacity() * sizeof(uint32_t);
+    }
+    base_memory += log_table_.capacity() * sizeof(uint8_t);
+    
+    // Cached blocks plus list/map node overhead
+    for (const auto& entry : cache_) {
+        base_memory += entry.second.values.capacity() * sizeof(Value);
+        base_memory += sizeof(CacheEntry) + 2 * sizeof(size_t) + 2 * sizeof(void*);
+    }
+    
+    return base_memory;
+}
+
+std::tuple<size_t, size_t, size_t> RMQExternalMemory::getBlockStats() const {
+    return std::make_tuple(block_size_, num_blocks_, getMemoryUsage());
+}
+
+void RMQExternalMemory::writeDataFile(const std::string& path, const std::vector<Value>& data,
+                                      bool append) {
+    std::FILE* out = std::fopen(path.c_str(), append ? "ab" : "wb");
+    if (out == nullptr) {
+        throw InvalidDataException("Cannot create data file " + path);
+    }
+    
+    size_t written = data.empty() ? 0 : std::fwrite(data.data(), sizeof(Value), data.size(), out);
+    bool failed = written != data.size();
+    failed = (std::fclose(out) != 0) || failed;
+    
+    if (failed) {
+        throw AlgorithmException("Failed to write data file " + path);
+    }
+}
+
+} // namespace rmq
@@ -1,6 +1,7 @@
 #include "../../include/algorithms/rmq_lca.h"
+#include "../../include/core/rmq_kernels.h"
+#include "../../include/core/rmq_trace.h"
 #include <algorithm>
-#include <stack>
 #include <cmath>
 #include <limits>
 
@@ -34,75 +35,35 @@ void RMQLCABased::buildCartesianTree() {
     if (n == 0) return;
     
     // Initialize tree nodes
-    tree_nodes_.resize(n);
-    array_to_tree_.resize(n);
-    
-    for (Index i = 0; i < n; ++i) {
-        tree_nodes_[i].value = data_[i];
-        tree_nodes_[i].array_index = i;
-        tree_nodes_[i].parent = -1;
-        tree_nodes_[i].left_child = -1;
-        tree_nodes_[i].right_child = -1;
-        array_to_tree_[i] = static_cast<int>(i);
+    {
+        RMQ_TRACE_SCOPE("lca.init_nodes");
+        tree_nodes_.resize(n);
+        array_to_tree_.resize(n);
+        
+        for (Index i = 0; i < n; ++i) {
+            tree_nodes_[i].value = data_[i];
+            tree_nodes_[i].array_index = i;
+            tree_nodes_[i].parent = -1;
+            tree_nodes_[i].left_child = -1;
+            tree_nodes_[i].right_child = -1;
+            array_to_tree_[i] = static_cast<int>(i);
+        }
     }
     
     // Build Cartesian tree using stack-based algorithm
     // This maintains the invariant that the stack contains
     // the rightmost path from root to the current position
-    std::stack<int> rightmost_path;
-    
-    for (int i = 0; i < static_cast<int>(n); ++i) {
-        int last_popped = -1;
-        
-        // Pop elements from stack that are greater than current
-        while (!rightmost_path.empty() && 
-               tree_nodes_[rightmost_path.top()].value > tree_nodes_[i].value) {
-            last_popped = rightmost_path.top();
-            rightmost_path.pop();
-        }
-        
-        // Set relationships
-        if (!rightmost_path.empty()) {
-            // Current node becomes right child of stack top
-            tree_nodes_[rightmost_path.top()].right_child = i;
-            tree_nodes_[i].parent = rightmost_path.top();
-        }
-        
-        if (last_popped != -1) {
-            // Last popped becomes left child of current
-            tree_nodes_[i].left_child = last_popped;
-            tree_nodes_[last_popped].parent = i;
-        }
-        
-        rightmost_path.push(i);
+    std::vector<int> stack;
+    stack.reserve(64);
+    {
+        RMQ_TRACE_SCOPE("lca.cartesian_tree");
+        root_index_ = kernels::buildCartesianTree(tree_nodes_.data(), n, stack);
     }
     
-    // Find root (node with no parent)
-    root_index_ = -1;
-    for (int i = 0; i < static_cast<int>(n); ++i) {
-        if (tree_nodes_[i].parent == -1) {
-            root_index_ = i;
-            break;
-        }
-    }
-    
-    // Compute depths
-    if (root_index_ != -1) {
-        computeDepths(root_index_, 0);
-    }
-}
-
-void RMQLCABased::computeDepths(int node, int depth) {
-    if (node == -1) return;
-    
-    tree_nodes_[node].depth = depth;
-    
-    if (tree_nodes_[node].left_child != -1) {
-        computeDepths(tree_nodes_[node].left_child, depth + 1);
-    }
-    
-    if (tree_nodes_[node].right_child != -1) {
-        computeDepths(tree_nodes_[node].right_child, depth + 1);
+    // Compute depths (iteratively: a sorted input gives a path of depth n)
+    {
+        RMQ_TRACE_SCOPE("lca.depths");
+        kernels::computeDepths(tree_nodes_.data(), root_index_, stack);
     }
 }
 
@@ -110,6 +71,8 @@ void RMQLCABased::buildLCAStructure() {
     Size n = tree_nodes_.size();
     if (n == 0 || root_index_ == -1) return;
     
+    RMQ_TRACE_SCOPE("lca.binary_lifting");
+    
     // Calculate maximum log needed for binary lifting
     max_log_ = 0;
     while ((1 << max_log_) < static_cast<int>(n)) {
@@ -118,18 +81,20 @@ void RMQLCABased::buildLCAStructure() {
     max_log_++;
     
     // Initialize ancestors table
-    ancestors_.assign(n, std::vector<int>(max_log_, -1));
+    ancestors_.assign(max_log_, std::vector<int>(n, -1));
     
     // Set immediate parents
     for (size_t i = 0; i < n; ++i) {
-        ancestors_[i][0] = tree_nodes_[i].parent;
+        ancestors_[0][i] = tree_nodes_[i].parent;
     }
     
     // Fill binary lifting table
     for (int j = 1; j < max_log_; ++j) {
+        const std::vector<int>& below = ancestors_[j - 1];
+        std::vector<int>& level = ancestors_[j];
         for (size_t i = 0; i < n; ++i) {
-            if (ancestors_[i][j - 1] != -1) {
-                ancestors_[i][j] = ancestors_[ancestors_[i][j - 1]][j - 1];
+            if (below[i] != -1) {
+                level[i] = below[below[i]];
             }
         }
     }
@@ -140,7 +105,7 @@ int RMQLCABased::getKthAncestor(int node, int k) const {
     
     for (int i = 0; i < max_log_ && node != -1; ++i) {
         if (k & (1 << i)) {
-            node = ancestors_[node][i];
+            node = ancestors_[i][node];
         }
     }
     
@@ -150,35 +115,18 @@ int RMQLCABased::getKthAncestor(int node, int k) const {
 int RMQLCABased::findLCA(int u, int v) const {
     if (u == -1 || v == -1) return -1;
     
-    // Ensure u is at the same or deeper level than v
-    if (tree_nodes_[u].depth < tree_nodes_[v].depth) {
-        std::swap(u, v);
-    }
-    
-    // Bring u up to the same level as v
-    int depth_diff = tree_nodes_[u].depth - tree_nodes_[v].depth;
-    u = getKthAncestor(u, depth_diff);
-    
-    if (u == v) {
-        return u;
-    }
-    
-    // Binary search for LCA
-    for (int i = max_log_ - 1; i >= 0; --i) {
-        if (ancestors_[u][i] != ancestors_[v][i]) {
-            u = ancestors_[u][i];
-            v = ancestors_[v][i];
-        }
-    }
-    
-    // Parent of u (or v) is the LCA
-    return ancestors_[u][0];
+    return kernels::liftLCA(tree_nodes_.data(), ancestors_, u, v);
 }
 
 void RMQLCABased::performPreprocess() {
     Size n = data_.size();
     if (n == 0) return;
     
+    // Tree nodes are addressed with int
+    if (n > static_cast<Size>(std::numeric_limits<int>::max())) {
+        throw InvalidDataException(n, static_cast<Size>(std::numeric_limits<int>::max()));
+    }
+    
     // Clear any existing tree
     clearTree();
     
@@ -188,7 +136,7 @@ void RMQLCABased::performPreprocess() {
         
         // Build LCA structure
         buildLCAStructure();
-        
+    
     } catch (const std::bad_alloc&) {
         clearTree();
         throw AllocationException("Failed to allocate memory for Cartesian tree");
@@ -0,0 +1,244 @@
+#include "../../include/algorithms/rmq_monotone.h"
+#include "../../include/core/rmq_trace.h"
+#include <algorithm>
+
+namespace rmq {
+
+RMQMonotoneRuns::RMQMonotoneRuns() : RMQBase(), shape_(DataShape::GENERAL) {
+}
+
+RMQMonotoneRuns::RMQMonotoneRuns(const AlgorithmConfig& config)
+    : RMQBase(config), shape_(DataShape::GENERAL) {
+}
+
+RMQMonotoneRuns::~RMQMonotoneRuns() {
+    clearRuns();
+}
+
+Index RMQMonotoneRuns::runEnd(const std::vector<Value>& data, Index start, bool& falling) {
+    Size n = data.size();
+    Index end = start;
+    
+    // Equal elements fit either direction; the first change decides it
+    while (end + 1 < n && data[end + 1] == data[end]) {
+        end++;
+    }
+    falling = end + 1 < n && data[end + 1] < data[end];
+    
+    if (falling) {
+        while (end + 1 < n && data[end + 1] <= data[end]) {
+            end++;
+        }
+    } else {
+        while (end + 1 < n && data[end + 1] >= data[end]) {
+            end++;
+        }
+    }
+    return end;
+}
+
+DataShape RMQMonotoneRuns::classify(const std::vector<Value>& data, Size runs) {
+    if (runs == 1) {
+        if (data.front() == data.back()) {
+            return DataShape::CONSTANT;
+        }
+        return data.front() < data.back() ? DataShape::NON_DECREASING : DataShape::NON_INCREASING;
+    }
+    return runs * MIN_AVERAGE_RUN <= data.size() ? DataShape::PIECEWISE_MONOTONE : DataShape::GENERAL;
+}
+
+ShapeAnalysis RMQMonotoneRuns::analyze(const std::vector<Value>& data) {
+    ShapeAnalysis analysis;
+    if (data.empty()) {
+        return analysis;
+    }
+    
+    bool falling = false;
+    for (Index start = 0; start < data.size(); start = runEnd(data, start, falling) + 1) {
+        analysis.runs++;
+    }
+    analysis.shape = classify(data, analysis.runs);
+    return analysis;
+}
+
+void RMQMonotoneRuns::clearRuns() {
+    run_start_.clear();
+    run_start_.shrink_to_fit();
+    run_falling_.clear();
+    run_falling_.shrink_to_fit();
+    run_min_index_.clear();
+    run_min_index_.shrink_to_fit();
+    run_table_.clear();
+    run_table_.shrink_to_fit();
+    shape_ = DataShape::GENERAL;
+}
+
+void RMQMonotoneRuns::performPreprocess() {
+    Size n = data_.size();
+    if (n == 0) return;
+    
+    clearRuns();
+    ShapeAnalysis analysis = analyze(data_);
+    if (analysis.runs > kernels::PACKED_MAX_SIZE) {
+        throw InvalidDataException("Too many monotone runs for packed run entries");
+    }
+    
+    try {
+        RMQ_TRACE_SCOPE_ARG("monotone.runs", analysis.runs);
+        run_start_.reserve(analysis.runs + 1);
+        run_falling_.reserve(analysis.runs);
+        run_min_index_.reserve(analysis.runs);
+        for (Index start = 0; start < n;) {
+            bool falling = false;
+            Index end = runEnd(data_, start, falling);
+            
+            // A falling run's minimum is the start of its last equal stretch
+            Index min_index = start;
+            if (falling) {
+                min_index = end;
+                while (min_index > start && data_[min_index - 1] == data_[end]) {
+                    min_index--;
+                }
+            }
+            
+            run_start_.push_back(start);
+            run_falling_.push_back(falling);
+            run_min_index_.push_back(min_index);
+            start = end + 1;
+        }
+        run_start_.push_back(n);
+        buildRunTable();
+    } catch (const std::bad_alloc&) {
+        clearRuns();
+        throw AllocationException("Failed to allocate monotone runs");
+    }
+    
+    shape_ = analysis.shape;
+}
+
+void RMQMonotoneRuns::buildRunTable() {
+    size_t runs = run_falling_.size();
+    if (runs < 3) {
+        return;  // Queries never span a whole run
+    }
+    
+    RMQ_TRACE_SCOPE_ARG("monotone.table", runs);
+    size_t levels = 1;
+    while ((size_t(1) << levels) <= runs) {
+        levels++;
+    }
+    
+    run_table_.resize(levels);
+    run_table_[0].resize(runs);
+    for (size_t run = 0; run < runs; ++run) {
+        run_table_[0][run] = kernels::packEntry(data_[run_min_index_[run]], run);
+    }
+    for (size_t j = 1; j < levels; ++j) {
+        size_t count = runs - (size_t(1) << j) + 1;
+        run_table_[j].resize(count);
+        kernels::buildPackedLevel(run_table_[j - 1].data(), count, size_t(1) << (j - 1),
+                                  run_table_[j].data());
+    }
+}
+
+size_t RMQMonotoneRuns::runOf(Index index) const {
+    if (run_falling_.size() == 1) {
+        return 0;
+    }
+    return std::upper_bound(run_start_.begin(), run_start_.end(), index) - run_start_.begin() - 1;
+}
+
+Index RMQMonotoneRuns::runMinimumIndex(size_t run, Index left, Index right) const {
+    if (!run_falling_[run]) {
+        return left;
+    }
+    
+    // Leftmost element of [left, right] equal to the right end
+    Value target = data_[right];
+    return std::partition_point(data_.begin() + left, data_.begin() + right,
+                                [target](Value value) { return value > target; }) - data_.begin();
+}
+
+size_t RMQMonotoneRuns::queryRuns(size_t first, size_t last) const {
+    size_t k = 0;
+    while ((size_t(2) << k) <= last - first + 1) {
+        k++;
+    }
+    kernels::PackedEntry entry = kernels::packedLookup(run_table_[k].data(), first,
+                                                       last - (size_t(1) << k) + 1);
+    return kernels::packedIndex(entry);
+}
+
+Value RMQMonotoneRuns::performQuery(Index left, Index right) const {
+    size_t first = runOf(left);
+    size_t last = runOf(right);
+    
+    if (first == last) {
+        return run_falling_[first] ? data_[right] : data_[left];
+    }
+    
+    // Each end run answers from one of its ends, whole runs from the table
+    Value result = run_falling_[first] ? data_[run_start_[first + 1] - 1] : data_[left];
+    result = std::min(result, run_falling_[last] ? data_[right] : data_[run_start_[last]]);
+    if (first + 1 < last) {
+        result = std::min(result, data_[run_min_index_[queryRuns(first + 1, last - 1)]]);
+    }
+    return result;
+}
+
+Index RMQMonotoneRuns::findMinimumIndex(Index left, Index right) const {
+    size_t first = runOf(left);
+    size_t last = runOf(right);
+    
+    if (first == last) {
+        return runMinimumIndex(first, left, right);
+    }
+    
+    // Left to right; only a strictly smaller value moves the answer
+    Index min_index = runMinimumIndex(first, left, run_start_[first + 1] - 1);
+    if (first + 1 < last) {
+        Index middle = run_min_index_[queryRuns(first + 1, last - 1)];
+        if (data_[middle] < data_[min_index]) {
+            min_index = middle;
+        }
+    }
+    Index right_index = runMinimumIndex(last, run_start_[last], right);
+    return data_[right_index] < data_[min_index] ? right_index : min_index;
+}
+
+ComplexityInfo RMQMonotoneRuns::getComplexity() const {
+    return ComplexityInfo(
+        "O(n)",          // preprocessing_time
+        "O(k log k)",    // preprocessing_space (k monotone runs)
+        "O(log k)",      // query_time (O(1) for a single run)
+        "O(1)",          // query_space
+        "O(n + k log k)" // total_space
+    );
+}
+
+void RMQMonotoneRuns::clear() {
+    RMQBase::clear();
+    clearRuns();
+}
+
+size_t RMQMonotoneRuns::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQMonotoneRuns);
+    
+    // Data vector memory
+    base_memory += data_.capacity() * sizeof(Value);
+    
+    // Run boundaries, directions and minima
+    base_memory += run_start_.capacity() * sizeof(Index);
+    base_memory += (run_falling_.capacity() + 7) / 8;
+    base_memory += run_min_index_.capacity() * sizeof(Index);
+    
+    // Table over runs
+    for (const auto& level : run_table_) {
+        base_memory += level.capacity() * sizeof(kernels::PackedEntry);
+    }
+    base_memory += run_table_.capacity() * sizeof(std::vector<kernels::PackedEntry>);
+    
+    return base_memory;
+}
+
+} // namespace rmq
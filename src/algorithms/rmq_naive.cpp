@@ -1,4 +1,5 @@
 #include "../../include/algorithms/rmq_naive.h"
+#include "../../include/core/rmq_kernels.h"
 #include <algorithm>
 #include <limits>
 
@@ -9,34 +10,40 @@ RMQNaive::RMQNaive(const AlgorithmConfig& config) : RMQBase(config) {
 
 void RMQNaive::performPreprocess() {
     // No preprocessing required for naive approach
-    // The data is already stored in the base class
+    // The data is already stored in the base class, unless compressed
+    compressed_ = CompressedArray();
+    
+    if (config_.compress_data) {
+        Size block_size = config_.block_size != constants::DEFAULT_BLOCK_SIZE
+                              ? config_.block_size
+                              : CompressedArray::DEFAULT_BLOCK_SIZE;
+        compressed_ = CompressedArray(data_, block_size);
+        std::vector<Value>().swap(data_);
+    }
 }
 
 Value RMQNaive::performQuery(Index left, Index right) const {
-    // Simple linear scan to find minimum
-    Value min_value = data_[left];
-    
-    for (Index i = left + 1; i <= right; ++i) {
-        if (data_[i] < min_value) {
-            min_value = data_[i];
-        }
+    if (isCompressed()) {
+        return compressed_.scanMin(left, right);
     }
     
-    return min_value;
+    // Simple linear scan to find minimum
+    return kernels::scanMin(data_.data(), left, right);
 }
 
 Index RMQNaive::findMinimumIndex(Index left, Index right) const {
-    Value min_value = data_[left];
-    Index min_index = left;
-    
-    for (Index i = left + 1; i <= right; ++i) {
-        if (data_[i] < min_value) {
-            min_value = data_[i];
-            min_index = i;
-        }
+    if (isCompressed()) {
+        return compressed_.scanMinIndex(left, right);
     }
-    
-    return min_index;
+    return kernels::scanMinIndex(data_.data(), left, right);
+}
+
+Value RMQNaive::valueAt(Index index) const {
+    return isCompressed() ? compressed_.get(index) : data_[index];
+}
+
+std::vector<Value> RMQNaive::copyData() const {
+    return isCompressed() ? compressed_.decode() : data_;
 }
 
 ComplexityInfo RMQNaive::getComplexity() const {
@@ -52,11 +59,16 @@ ComplexityInfo RMQNaive::getComplexity() const {
 void RMQNaive::update(Index index, Value value) {
     ensurePreprocessed();
     
-    if (index >= data_.size()) {
-        throw BoundsException(index, data_.size());
+    if (index >= size_) {
+        throw BoundsException(index, size_);
     }
+    recordUpdate(index, value);
     
-    data_[index] = value;
+    if (isCompressed()) {
+        compressed_.set(index, value);
+    } else {
+        data_[index] = value;
+    }
 }
 
 void RMQNaive::batchUpdate(const std::vector<std::pair<Index, Value>>& updates) {
@@ -64,17 +76,27 @@ void RMQNaive::batchUpdate(const std::vector<std::pair<Index, Value>>& updates)
     
     // Validate all indices first
     for (const auto& [index, value] : updates) {
-        if (index >= data_.size()) {
-            throw BoundsException(index, data_.size());
+        if (index >= size_) {
+            throw BoundsException(index, size_);
         }
     }
     
     // Apply all updates
     for (const auto& [index, value] : updates) {
-        data_[index] = value;
+        recordUpdate(index, value);
+        if (isCompressed()) {
+            compressed_.set(index, value);
+        } else {
+            data_[index] = value;
+        }
     }
 }
 
+void RMQNaive::clear() {
+    RMQBase::clear();
+    compressed_ = CompressedArray();
+}
+
 size_t RMQNaive::getMemoryUsage() const {
     // Base memory: vector overhead + data
     size_t base_memory = sizeof(RMQNaive);
@@ -87,6 +109,9 @@ size_t RMQNaive::getMemoryUsage() const {
     // Vector overhead (approximate)
     base_memory += sizeof(std::vector<Value>);
     
+    // Compressed blocks
+    base_memory += compressed_.getMemoryUsage();
+    
     return base_memory;
 }
 
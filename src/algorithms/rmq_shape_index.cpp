@@ -0,0 +1,187 @@
+#include "../../include/algorithms/rmq_shape_index.h"
+#include "../../include/algorithms/rmq_static.h"
+#include "../../include/core/rmq_kernels.h"
+#include <limits>
+
+namespace rmq {
+
+namespace {
+
+/**
+ * @brief Cartesian tree node as kernels::buildCartesianTree expects it
+ */
+struct ShapeNode {
+    Value value;
+    int parent;
+    int left_child;
+    int right_child;
+};
+
+} // namespace
+
+RMQShapeIndex::RMQShapeIndex() : offsets_(1, 0) {
+}
+
+RMQShapeIndex::RMQShapeIndex(const std::vector<std::vector<Value>>& arrays) : RMQShapeIndex() {
+    Size total = 0;
+    for (const auto& values : arrays) {
+        total += values.size();
+    }
+    values_.reserve(total);
+    offsets_.reserve(arrays.size() + 1);
+    shape_of_.reserve(arrays.size());
+    
+    for (const auto& values : arrays) {
+        addArray(values);
+    }
+}
+
+RMQShapeIndex::Signature RMQShapeIndex::signatureOf(const Value* values, Size count) {
+    std::vector<int> stack;
+    return computeSignature(values, count, stack);
+}
+
+RMQShapeIndex::Signature RMQShapeIndex::computeSignature(const Value* values, Size count,
+                                                         std::vector<int>& stack) {
+    if (count == 0 || count > MAX_ARRAY_SIZE) {
+        throw InvalidDataException("Shape index arrays must hold 1 to " +
+                                   std::to_string(MAX_ARRAY_SIZE) + " elements, got " +
+                                   std::to_string(count));
+    }
+    
+    ShapeNode nodes[MAX_ARRAY_SIZE];
+    for (Size i = 0; i < count; ++i) {
+        nodes[i] = {values[i], -1, -1, -1};
+    }
+    kernels::buildCartesianTree(nodes, count, stack);
+    
+    // Pushing i pops the right spine of its left subtree; right children
+    // come later in the array, so one backward pass measures every spine
+    int spine[MAX_ARRAY_SIZE];
+    for (Size i = count; i-- > 0;) {
+        int right = nodes[i].right_child;
+        spine[i] = 1 + (right >= 0 ? spine[right] : 0);
+    }
+    
+    Signature signature;
+    signature.length = count;
+    Size bit = 0;
+    for (Size i = 0; i < count; ++i) {
+        int left = nodes[i].left_child;
+        bit += left >= 0 ? spine[left] : 0;
+        signature.bits[bit / 64] |= uint64_t(1) << (bit % 64);
+        bit++;
+    }
+    return signature;
+}
+
+void RMQShapeIndex::appendMasks(const Signature& signature) {
+    // Replay the pops and pushes on a stack of positions held as a bitmask
+    uint64_t stack = 0;
+    Index position = 0;
+    for (Size bit = 0; position < signature.length; ++bit) {
+        if ((signature.bits[bit / 64] >> (bit % 64)) & 1) {
+            stack |= uint64_t(1) << position;
+            masks_.push_back(stack);
+            position++;
+        } else {
+            stack &= ~(uint64_t(1) << static_detail::highestBit(stack));
+        }
+    }
+}
+
+Size RMQShapeIndex::addArray(const std::vector<Value>& values) {
+    Signature signature = computeSignature(values.data(), values.size(), stack_);
+    if (values_.size() + values.size() > std::numeric_limits<uint32_t>::max()) {
+        throw InvalidDataException("Shape index holds at most 2^32 - 1 elements");
+    }
+    
+    auto found = shape_ids_.find(signature);
+    uint32_t shape;
+    if (found != shape_ids_.end()) {
+        shape = found->second;
+    } else {
+        shape = static_cast<uint32_t>(mask_offsets_.size());
+        mask_offsets_.push_back(static_cast<uint32_t>(masks_.size()));
+        appendMasks(signature);
+        shape_ids_.emplace(signature, shape);
+    }
+    
+    values_.insert(values_.end(), values.begin(), values.end());
+    offsets_.push_back(static_cast<uint32_t>(values_.size()));
+    shape_of_.push_back(shape);
+    return shape_of_.size() - 1;
+}
+
+void RMQShapeIndex::validateQuery(Size array, Index left, Index right) const {
+    if (array >= shape_of_.size()) {
+        throw BoundsException(array, shape_of_.size());
+    }
+    
+    if (left > right) {
+        throw InvalidQueryException(left, right);
+    }
+    
+    Size size = offsets_[array + 1] - offsets_[array];
+    if (right >= size) {
+        throw BoundsException(left, right, size);
+    }
+}
+
+Index RMQShapeIndex::queryIndex(Size array, Index left, Index right) const {
+    validateQuery(array, left, right);
+    
+    // Bit right is always set, so the shifted mask is never zero
+    uint64_t mask = masks_[mask_offsets_[shape_of_[array]] + right];
+    return left + static_detail::lowestBit(mask >> left);
+}
+
+Value RMQShapeIndex::query(Size array, Index left, Index right) const {
+    return values_[offsets_[array] + queryIndex(array, left, right)];
+}
+
+Size RMQShapeIndex::getArraySize(Size array) const {
+    if (array >= shape_of_.size()) {
+        throw BoundsException(array, shape_of_.size());
+    }
+    return offsets_[array + 1] - offsets_[array];
+}
+
+Size RMQShapeIndex::getShapeId(Size array) const {
+    if (array >= shape_of_.size()) {
+        throw BoundsException(array, shape_of_.size());
+    }
+    return shape_of_[array];
+}
+
+size_t RMQShapeIndex::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQShapeIndex);
+    
+    // Per array: values, offset and shape id
+    base_memory += values_.capacity() * sizeof(Value);
+    base_memory += offsets_.capacity() * sizeof(uint32_t);
+    base_memory += shape_of_.capacity() * sizeof(uint32_t);
+    
+    // Per shape: masks and an approximate hash map node
+    base_memory += masks_.capacity() * sizeof(uint64_t);
+    base_memory += mask_offsets_.capacity() * sizeof(uint32_t);
+    base_memory += shape_ids_.size() * (sizeof(Signature) + sizeof(uint32_t) + 2 * sizeof(void*));
+    base_memory += shape_ids_.bucket_count() * sizeof(void*);
+    
+    return base_memory;
+}
+
+void RMQShapeIndex::clear() {
+    values_.clear();
+    values_.shrink_to_fit();
+    offsets_.assign(1, 0);
+    shape_of_.clear();
+    shape_of_.shrink_to_fit();
+    masks_.clear();
+    masks_.shrink_to_fit();
+    mask_offsets_.clear();
+    mask_offsets_.shrink_to_fit();
+    shape_ids_.clear();
+}
+
+} // namespace rmq
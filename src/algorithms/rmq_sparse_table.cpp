@@ -1,14 +1,17 @@
 #include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../include/core/rmq_kernels.h"
+#include "../../include/core/rmq_trace.h"
 #include <algorithm>
 #include <tuple>
 
 namespace rmq {
 
-RMQSparseTable::RMQSparseTable() : RMQBase(), max_level_(0) {
+RMQSparseTable::RMQSparseTable()
+    : RMQBase(), packed_(false), level_cap_(0), block_shift_(0), max_level_(0) {
 }
 
 RMQSparseTable::RMQSparseTable(const AlgorithmConfig& config) 
-    : RMQBase(config), max_level_(0) {
+    : RMQBase(config), packed_(false), level_cap_(0), block_shift_(0), max_level_(0) {
 }
 
 RMQSparseTable::~RMQSparseTable() {
@@ -40,9 +43,84 @@ void RMQSparseTable::clearTables() {
     sparse_table_.shrink_to_fit();
     index_table_.clear();
     index_table_.shrink_to_fit();
+    packed_table_.clear();
+    packed_table_.shrink_to_fit();
     log_table_.clear();
     log_table_.shrink_to_fit();
+    level_ready_.reset();
+    block_min_.clear();
+    block_min_.shrink_to_fit();
+    block_min_index_.clear();
+    block_min_index_.shrink_to_fit();
     max_level_ = 0;
+    level_cap_ = 0;
+    block_shift_ = 0;
+    packed_ = false;
+}
+
+void RMQSparseTable::allocateLevel(size_t j) const {
+    // Level j only holds the n - 2^j + 1 ranges that fit in the array
+    size_t count = log_table_.size() - (size_t(1) << j);
+    if (packed_) {
+        packed_table_[j].resize(count);
+    } else {
+        sparse_table_[j].resize(count);
+        index_table_[j].resize(count);
+    }
+}
+
+void RMQSparseTable::buildLevel(size_t j) const {
+    RMQ_TRACE_SCOPE_ARG("sparse.level", j);
+    
+    allocateLevel(j);
+    
+    // Combine two halves of length 2^(j-1) from the previous level
+    size_t count = log_table_.size() - (size_t(1) << j);
+    if (packed_) {
+        kernels::buildPackedLevel(packed_table_[j - 1].data(), count, size_t(1) << (j - 1),
+                                  packed_table_[j].data());
+    } else {
+        kernels::buildSparseLevel(sparse_table_[j - 1].data(), index_table_[j - 1].data(),
+                                  count, size_t(1) << (j - 1),
+                                  sparse_table_[j].data(), index_table_[j].data());
+    }
+    level_ready_[j].store(true, std::memory_order_release);
+}
+
+void RMQSparseTable::materializeLevels(size_t k) const {
+    std::lock_guard<std::mutex> lock(level_mutex_);
+    
+    for (size_t j = 1; j <= k; ++j) {
+        if (level_ready_[j].load(std::memory_order_relaxed)) {
+            continue;
+        }
+        try {
+            buildLevel(j);
+        } catch (const std::bad_alloc&) {
+            sparse_table_[j].clear();
+            sparse_table_[j].shrink_to_fit();
+            index_table_[j].clear();
+            index_table_[j].shrink_to_fit();
+            packed_table_[j].clear();
+            packed_table_[j].shrink_to_fit();
+            throw AllocationException("Failed to allocate sparse table level " + std::to_string(j));
+        }
+    }
+}
+
+void RMQSparseTable::buildBlockMinima() {
+    RMQ_TRACE_SCOPE("sparse.block_minima");
+    Size n = data_.size();
+    size_t block = size_t(1) << block_shift_;
+    size_t num_blocks = (n + block - 1) / block;
+    
+    block_min_.resize(num_blocks);
+    block_min_index_.resize(num_blocks);
+    for (size_t b = 0; b < num_blocks; ++b) {
+        Index last = std::min(n, (b + 1) * block) - 1;
+        block_min_index_[b] = kernels::scanMinIndex(data_.data(), b * block, last);
+        block_min_[b] = data_[block_min_index_[b]];
+    }
 }
 
 void RMQSparseTable::performPreprocess() {
@@ -54,18 +132,31 @@ void RMQSparseTable::performPreprocess() {
     
     // Compute maximum level needed
     max_level_ = computeLog2(n) + 1;
+    level_cap_ = config_.max_levels != 0 ? std::min(config_.max_levels, max_level_) : max_level_;
+    packed_ = config_.packed_entries && n <= kernels::PACKED_MAX_SIZE;
     
     // Precompute logarithms for O(1) query
     precomputeLogTable(n);
     
-    // Allocate sparse tables
+    // Allocate sparse tables level by level; level j only holds the
+    // n - 2^j + 1 ranges that fit in the array. Lazy levels are
+    // allocated when they are built.
     try {
-        sparse_table_.resize(n);
-        index_table_.resize(n);
+        RMQ_TRACE_SCOPE("sparse.allocate");
+        if (packed_) {
+            packed_table_.resize(level_cap_);
+        } else {
+            sparse_table_.resize(level_cap_);
+            index_table_.resize(level_cap_);
+        }
+        level_ready_ = std::make_unique<std::atomic<bool>[]>(level_cap_);
         
-        for (Index i = 0; i < n; ++i) {
-            sparse_table_[i].resize(max_level_);
-            index_table_[i].resize(max_level_);
+        size_t allocated = config_.lazy_levels ? 1 : level_cap_;
+        for (size_t j = 0; j < allocated; ++j) {
+            allocateLevel(j);
+        }
+        for (size_t j = 0; j < level_cap_; ++j) {
+            level_ready_[j].store(false, std::memory_order_relaxed);
         }
     } catch (const std::bad_alloc&) {
         clearTables();
@@ -73,66 +164,95 @@ void RMQSparseTable::performPreprocess() {
     }
     
     // Initialize base case (ranges of length 1)
-    for (Index i = 0; i < n; ++i) {
-        sparse_table_[i][0] = data_[i];
-        index_table_[i][0] = i;
+    {
+        RMQ_TRACE_SCOPE_ARG("sparse.level", 0);
+        if (packed_) {
+            for (Index i = 0; i < n; ++i) {
+                packed_table_[0][i] = kernels::packEntry(data_[i], i);
+            }
+        } else {
+            for (Index i = 0; i < n; ++i) {
+                sparse_table_[0][i] = data_[i];
+                index_table_[0][i] = i;
+            }
+        }
+        level_ready_[0].store(true, std::memory_order_release);
     }
     
-    // Build sparse table using binary lifting
-    for (size_t j = 1; j < max_level_; ++j) {
-        // Range length is 2^j
-        size_t range_len = size_t(1) << j;
-        
-        // For all starting positions where range fits
-        for (Index i = 0; i + range_len <= n; ++i) {
-            // Combine two halves of length 2^(j-1)
-            size_t half_len = size_t(1) << (j - 1);
-            Index mid = i + half_len;
-            
-            if (sparse_table_[i][j - 1] <= sparse_table_[mid][j - 1]) {
-                sparse_table_[i][j] = sparse_table_[i][j - 1];
-                index_table_[i][j] = index_table_[i][j - 1];
-            } else {
-                sparse_table_[i][j] = sparse_table_[mid][j - 1];
-                index_table_[i][j] = index_table_[mid][j - 1];
-            }
+    // Build sparse table using binary lifting, unless queries build it
+    if (!config_.lazy_levels) {
+        for (size_t j = 1; j < level_cap_; ++j) {
+            buildLevel(j);
         }
     }
+    
+    // Ranges the capped table cannot cover scan blocks of the top level's width
+    if (level_cap_ < max_level_) {
+        block_shift_ = level_cap_ - 1;
+        buildBlockMinima();
+    }
 }
 
-Value RMQSparseTable::performQuery(Index left, Index right) const {
-    // Compute range length
-    size_t length = right - left + 1;
-    
+Value RMQSparseTable::lookup(Index left, Index right) const {
     // Find largest power of 2 that fits in the range
-    int k = log_table_[length];
+    int k = log_table_[right - left + 1];
+    ensureLevel(k);
     
     // Cover the range with two overlapping power-of-2 ranges
     size_t power = size_t(1) << k;
+    if (packed_) {
+        return kernels::packedValue(kernels::packedLookup(packed_table_[k].data(), left, right - power + 1));
+    }
+    return kernels::sparseLookup(sparse_table_[k].data(), left, right - power + 1);
+}
+
+Index RMQSparseTable::lookupIndex(Index left, Index right) const {
+    int k = log_table_[right - left + 1];
+    ensureLevel(k);
     
-    // Return minimum of the two overlapping ranges
-    return std::min(
-        sparse_table_[left][k],
-        sparse_table_[right - power + 1][k]
-    );
+    size_t power = size_t(1) << k;
+    if (packed_) {
+        return kernels::packedIndex(kernels::packedLookup(packed_table_[k].data(), left, right - power + 1));
+    }
+    return kernels::sparseLookupIndex(sparse_table_[k].data(), index_table_[k].data(),
+                                      left, right - power + 1);
+}
+
+Value RMQSparseTable::performQuery(Index left, Index right) const {
+    if (static_cast<size_t>(log_table_[right - left + 1]) < level_cap_) {
+        return lookup(left, right);
+    }
+    
+    // Beyond the cap: the end blocks fit the table, the blocks in between
+    // come from the block minima
+    size_t first_block = left >> block_shift_;
+    size_t last_block = right >> block_shift_;
+    Value result = lookup(left, ((first_block + 1) << block_shift_) - 1);
+    if (first_block + 1 < last_block) {
+        result = std::min(result, kernels::scanMin(block_min_.data(), first_block + 1, last_block - 1));
+    }
+    return std::min(result, lookup(last_block << block_shift_, right));
 }
 
 Index RMQSparseTable::findMinimumIndex(Index left, Index right) const {
-    // Compute range length
-    size_t length = right - left + 1;
+    if (static_cast<size_t>(log_table_[right - left + 1]) < level_cap_) {
+        return lookupIndex(left, right);
+    }
     
-    // Find largest power of 2 that fits in the range
-    int k = log_table_[length];
+    // Left to right; only a strictly smaller value moves the answer
+    size_t first_block = left >> block_shift_;
+    size_t last_block = right >> block_shift_;
+    Index min_index = lookupIndex(left, ((first_block + 1) << block_shift_) - 1);
     
-    // Cover the range with two overlapping power-of-2 ranges
-    size_t power = size_t(1) << k;
-    
-    // Return index corresponding to minimum value
-    if (sparse_table_[left][k] <= sparse_table_[right - power + 1][k]) {
-        return index_table_[left][k];
-    } else {
-        return index_table_[right - power + 1][k];
+    if (first_block + 1 < last_block) {
+        size_t middle = kernels::scanMinIndex(block_min_.data(), first_block + 1, last_block - 1);
+        if (block_min_[middle] < data_[min_index]) {
+            min_index = block_min_index_[middle];
+        }
     }
+    
+    Index right_index = lookupIndex(last_block << block_shift_, right);
+    return data_[right_index] < data_[min_index] ? right_index : min_index;
 }
 
 ComplexityInfo RMQSparseTable::getComplexity() const {
@@ -158,44 +278,69 @@ size_t RMQSparseTable::getMemoryUsage() const {
         base_memory += data_.capacity() * sizeof(Value);
     }
     
-    // Sparse table memory
+    // Sparse table memory (lazy levels may be growing)
+    std::lock_guard<std::mutex> lock(level_mutex_);
     if (!sparse_table_.empty()) {
-        for (const auto& row : sparse_table_) {
-            base_memory += row.capacity() * sizeof(Value);
+        for (const auto& level : sparse_table_) {
+            base_memory += level.capacity() * sizeof(Value);
         }
         base_memory += sparse_table_.capacity() * sizeof(std::vector<Value>);
     }
     
     // Index table memory
     if (!index_table_.empty()) {
-        for (const auto& row : index_table_) {
-            base_memory += row.capacity() * sizeof(Index);
+        for (const auto& level : index_table_) {
+            base_memory += level.capacity() * sizeof(Index);
         }
         base_memory += index_table_.capacity() * sizeof(std::vector<Index>);
     }
     
+    // Packed table memory
+    if (!packed_table_.empty()) {
+        for (const auto& level : packed_table_) {
+            base_memory += level.capacity() * sizeof(kernels::PackedEntry);
+        }
+        base_memory += packed_table_.capacity() * sizeof(std::vector<kernels::PackedEntry>);
+    }
+    
     // Log table memory
     if (!log_table_.empty()) {
         base_memory += log_table_.capacity() * sizeof(int);
     }
     
+    // Level flags and block minima (capped tables only)
+    base_memory += level_cap_ * sizeof(std::atomic<bool>);
+    base_memory += block_min_.capacity() * sizeof(Value);
+    base_memory += block_min_index_.capacity() * sizeof(Index);
+    
     return base_memory;
 }
 
-size_t RMQSparseTable::getTableEntries() const {
-    if (sparse_table_.empty()) {
-        return 0;
+size_t RMQSparseTable::getBuiltLevels() const {
+    size_t built = 0;
+    for (size_t j = 0; j < level_cap_; ++j) {
+        if (level_ready_[j].load(std::memory_order_acquire)) {
+            built++;
+        }
     }
+    return built;
+}
+
+size_t RMQSparseTable::getTableEntries() const {
+    std::lock_guard<std::mutex> lock(level_mutex_);
     
     size_t total = 0;
-    for (const auto& row : sparse_table_) {
-        total += row.size();
+    for (const auto& level : sparse_table_) {
+        total += level.size();
+    }
+    for (const auto& level : packed_table_) {
+        total += level.size();
     }
     return total;
 }
 
 bool RMQSparseTable::verifyTable() const {
-    if (!preprocessed_ || sparse_table_.empty()) {
+    if (!preprocessed_ || (sparse_table_.empty() && packed_table_.empty())) {
         return false;
     }
     
@@ -203,13 +348,18 @@ bool RMQSparseTable::verifyTable() const {
     
     // Verify base case
     for (Index i = 0; i < n; ++i) {
-        if (sparse_table_[i][0] != data_[i]) {
+        bool matches = packed_ ? packed_table_[0][i] == kernels::packEntry(data_[i], i)
+                               : sparse_table_[0][i] == data_[i];
+        if (!matches) {
             return false;
         }
     }
     
-    // Verify each level
-    for (size_t j = 1; j < max_level_; ++j) {
+    // Verify each level built so far
+    for (size_t j = 1; j < level_cap_; ++j) {
+        if (!level_ready_[j].load(std::memory_order_acquire)) {
+            break;
+        }
         size_t range_len = size_t(1) << j;
         
         for (Index i = 0; i + range_len <= n; ++i) {
@@ -217,12 +367,19 @@ bool RMQSparseTable::verifyTable() const {
             size_t half_len = size_t(1) << (j - 1);
             Index mid = i + half_len;
             
+            if (packed_) {
+                if (packed_table_[j][i] != std::min(packed_table_[j - 1][i], packed_table_[j - 1][mid])) {
+                    return false;
+                }
+                continue;
+            }
+            
             Value expected = std::min(
-                sparse_table_[i][j - 1],
-                sparse_table_[mid][j - 1]
+                sparse_table_[j - 1][i],
+                sparse_table_[j - 1][mid]
             );
             
-            if (sparse_table_[i][j] != expected) {
+            if (sparse_table_[j][i] != expected) {
                 return false;
             }
         }
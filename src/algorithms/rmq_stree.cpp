@@ -0,0 +1,225 @@
+#include "../../include/algorithms/rmq_stree.h"
+#include "../../include/core/rmq_trace.h"
+#include <algorithm>
+#include <limits>
+
+namespace rmq {
+
+using kernels::NODE_KEYS;
+
+RMQSTree::RMQSTree() : RMQBase() {
+}
+
+RMQSTree::RMQSTree(const AlgorithmConfig& config) : RMQBase(config) {
+}
+
+RMQSTree::~RMQSTree() {
+    clearTree();
+}
+
+size_t RMQSTree::nodeCount(size_t n) {
+    size_t total = 0;
+    size_t entries = n;
+    do {
+        entries = (entries + NODE_KEYS - 1) / NODE_KEYS;
+        total += entries;
+    } while (entries > 1);
+    return total;
+}
+
+size_t RMQSTree::levelCount(size_t n) {
+    size_t levels = 0;
+    size_t entries = n;
+    do {
+        entries = (entries + NODE_KEYS - 1) / NODE_KEYS;
+        levels++;
+    } while (entries > 1);
+    return levels;
+}
+
+void RMQSTree::clearTree() {
+    nodes_.clear();
+    nodes_.shrink_to_fit();
+    level_offset_.clear();
+    level_offset_.shrink_to_fit();
+}
+
+void RMQSTree::performPreprocess() {
+    Size n = data_.size();
+    if (n == 0) return;
+    
+    clearTree();
+    
+    // Nodes per level, from the leaves up to the single root node
+    std::vector<size_t> level_nodes;
+    size_t entries = n;
+    do {
+        entries = (entries + NODE_KEYS - 1) / NODE_KEYS;
+        level_nodes.push_back(entries);
+    } while (entries > 1);
+    
+    try {
+        RMQ_TRACE_SCOPE("stree.allocate");
+        nodes_.resize(nodeCount(n));
+        level_offset_.resize(level_nodes.size());
+    } catch (const std::bad_alloc&) {
+        clearTree();
+        throw AllocationException("Failed to allocate S-tree");
+    }
+    
+    // Root level first: each level starts after all the levels above it
+    size_t offset = 0;
+    for (size_t k = level_nodes.size(); k-- > 0;) {
+        level_offset_[k] = offset;
+        offset += level_nodes[k];
+    }
+    
+    // Pad the last node of every level so it never wins a minimum
+    for (size_t k = 0; k < level_nodes.size(); ++k) {
+        Node& last = nodes_[level_offset_[k] + level_nodes[k] - 1];
+        std::fill(last.keys, last.keys + NODE_KEYS, std::numeric_limits<Value>::max());
+    }
+    
+    {
+        RMQ_TRACE_SCOPE_ARG("stree.level", 0);
+        std::copy(data_.begin(), data_.end(), level(0));
+    }
+    
+    for (size_t k = 1; k < level_nodes.size(); ++k) {
+        RMQ_TRACE_SCOPE_ARG("stree.level", k);
+        kernels::buildNodeLevel(level(k - 1), level_nodes[k - 1], level(k));
+    }
+    
+    // The leaves hold the data now
+    std::vector<Value>().swap(data_);
+}
+
+Value RMQSTree::performQuery(Index left, Index right) const {
+    Value result = std::numeric_limits<Value>::max();
+    
+    for (size_t k = 0;; ++k) {
+        const Value* keys = level(k);
+        Index left_node = left / NODE_KEYS;
+        Index right_node = right / NODE_KEYS;
+        
+        if (left_node == right_node) {
+            return std::min(result, kernels::minNode(keys + left_node * NODE_KEYS,
+                                                     left % NODE_KEYS, right % NODE_KEYS));
+        }
+        
+        result = std::min(result, kernels::minNode(keys + left_node * NODE_KEYS,
+                                                   left % NODE_KEYS, NODE_KEYS - 1));
+        result = std::min(result, kernels::minNode(keys + right_node * NODE_KEYS,
+                                                   0, right % NODE_KEYS));
+        
+        // The nodes strictly between are covered by keys of the next level
+        if (left_node + 1 == right_node) {
+            return result;
+        }
+        left = left_node + 1;
+        right = right_node - 1;
+    }
+}
+
+Index RMQSTree::findMinimumIndex(Index left, Index right) const {
+    // Pieces on the left side are visited left to right, pieces on the right
+    // side right to left, and every left piece precedes every right piece;
+    // so the left side keeps its first minimum and the right side its last
+    bool left_found = false;
+    Value left_value = 0;
+    size_t left_level = 0;
+    Index left_position = 0;
+    
+    bool right_found = false;
+    Value right_value = 0;
+    size_t right_level = 0;
+    Index right_position = 0;
+    
+    for (size_t k = 0;; ++k) {
+        const Value* keys = level(k);
+        Index left_node = left / NODE_KEYS;
+        Index right_node = right / NODE_KEYS;
+        Index left_first = left % NODE_KEYS;
+        Index left_last = left_node == right_node ? right % NODE_KEYS : NODE_KEYS - 1;
+        
+        const Value* node = keys + left_node * NODE_KEYS;
+        Value value = kernels::minNode(node, left_first, left_last);
+        if (!left_found || value < left_value) {
+            left_found = true;
+            left_value = value;
+            left_level = k;
+            left_position = left_node * NODE_KEYS + kernels::findInNode(node, left_first, value);
+        }
+        
+        if (left_node == right_node) {
+            break;
+        }
+        
+        node = keys + right_node * NODE_KEYS;
+        value = kernels::minNode(node, 0, right % NODE_KEYS);
+        if (!right_found || value <= right_value) {
+            right_found = true;
+            right_value = value;
+            right_level = k;
+            right_position = right_node * NODE_KEYS + kernels::findInNode(node, 0, value);
+        }
+        
+        if (left_node + 1 == right_node) {
+            break;
+        }
+        left = left_node + 1;
+        right = right_node - 1;
+    }
+    
+    if (right_found && right_value < left_value) {
+        return descend(right_level, right_position, right_value);
+    }
+    return descend(left_level, left_position, left_value);
+}
+
+Index RMQSTree::descend(size_t k, Index position, Value value) const {
+    while (k > 0) {
+        --k;
+        const Value* node = level(k) + position * NODE_KEYS;
+        position = position * NODE_KEYS + kernels::findInNode(node, 0, value);
+    }
+    return position;
+}
+
+Value RMQSTree::valueAt(Index index) const {
+    return level(0)[index];
+}
+
+std::vector<Value> RMQSTree::copyData() const {
+    return std::vector<Value>(level(0), level(0) + size_);
+}
+
+ComplexityInfo RMQSTree::getComplexity() const {
+    return ComplexityInfo(
+        "O(n)",          // preprocessing_time
+        "O(n)",          // preprocessing_space
+        "O(log_16 n)",   // query_time
+        "O(1)",          // query_space
+        "O(n)"           // total_space
+    );
+}
+
+void RMQSTree::clear() {
+    RMQBase::clear();
+    clearTree();
+}
+
+size_t RMQSTree::getMemoryUsage() const {
+    size_t base_memory = sizeof(RMQSTree);
+    
+    // Data vector memory (released after preprocessing)
+    base_memory += data_.capacity() * sizeof(Value);
+    
+    // Levels, leaves included
+    base_memory += nodes_.capacity() * sizeof(Node);
+    base_memory += level_offset_.capacity() * sizeof(size_t);
+    
+    return base_memory;
+}
+
+} // namespace rmq
@@ -1,18 +1,45 @@
 #include "../../include/core/rmq_base.h"
+#include "../../include/core/rmq_recording.h"
+#include "../../include/core/rmq_serialization.h"
+#include "../../include/core/rmq_trace.h"
 #include <algorithm>
 
 namespace rmq {
 
 RMQBase::RMQBase() 
-    : preprocessed_(false), 
+    : size_(0),
+      preprocessed_(false), 
       last_query_time_(0),
-      config_() {
+      config_(),
+      recorder_(nullptr) {
 }
 
 RMQBase::RMQBase(const AlgorithmConfig& config) 
-    : preprocessed_(false), 
+    : size_(0),
+      preprocessed_(false), 
       last_query_time_(0),
-      config_(config) {
+      config_(config),
+      recorder_(nullptr) {
+}
+
+QueryStatus RMQBase::checkQuery(Index left, Index right) const noexcept {
+    if (!preprocessed_) {
+        return QueryStatus::NOT_PREPROCESSED;
+    }
+    
+    if (left > right) {
+        return QueryStatus::INVALID_RANGE;
+    }
+    
+    if (size_ == 0) {
+        return QueryStatus::EMPTY_DATA;
+    }
+    
+    if (right >= size_) {
+        return QueryStatus::OUT_OF_BOUNDS;
+    }
+    
+    return QueryStatus::OK;
 }
 
 void RMQBase::validateQuery(Index left, Index right) const {
@@ -20,12 +47,12 @@ void RMQBase::validateQuery(Index left, Index right) const {
         throw InvalidQueryException(left, right);
     }
     
-    if (data_.empty()) {
+    if (size_ == 0) {
         throw InvalidDataException("Cannot query empty data");
     }
     
-    if (right >= data_.size()) {
-        throw BoundsException(left, right, data_.size());
+    if (right >= size_) {
+        throw BoundsException(left, right, size_);
     }
 }
 
@@ -34,8 +61,14 @@ void RMQBase::validateData(const std::vector<Value>& data) const {
         throw InvalidDataException();
     }
     
-    if (data.size() > constants::MAX_ARRAY_SIZE) {
-        throw InvalidDataException(data.size());
+    if (data.size() > config_.max_array_size) {
+        throw InvalidDataException(data.size(), config_.max_array_size);
+    }
+}
+
+void RMQBase::recordUpdate(Index index, Value value) const noexcept {
+    if (recorder_ != nullptr) {
+        recorder_->recordUpdate(index, value);
     }
 }
 
@@ -46,9 +79,11 @@ void RMQBase::ensurePreprocessed() const {
 }
 
 void RMQBase::preprocess(const std::vector<Value>& data) {
+    RMQ_TRACE_SCOPE_ARG("preprocess", data.size());
     validateData(data);
     
     data_ = data;
+    size_ = data_.size();
     preprocessed_ = false;
     
     try {
@@ -69,13 +104,17 @@ void RMQBase::preprocess(const std::vector<Value>& data) {
 Value RMQBase::query(Index left, Index right) const {
     ensurePreprocessed();
     validateQuery(left, right);
+    if (recorder_ != nullptr) {
+        recorder_->recordQuery(left, right);
+    }
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
     Value result = performQuery(left, right);
     
     auto end_time = std::chrono::high_resolution_clock::now();
-    last_query_time_ = std::chrono::duration_cast<Duration>(end_time - start_time);
+    last_query_time_.store(std::chrono::duration_cast<Duration>(end_time - start_time).count(),
+                           std::memory_order_relaxed);
     
     return result;
 }
@@ -83,25 +122,129 @@ Value RMQBase::query(Index left, Index right) const {
 QueryResult RMQBase::queryDetailed(Index left, Index right) const {
     ensurePreprocessed();
     validateQuery(left, right);
+    if (recorder_ != nullptr) {
+        recorder_->recordQuery(left, right);
+    }
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    Value min_value = performQuery(left, right);
-    Index min_index = findMinimumIndex(left, right);
+    auto [min_value, min_index] = findMinimum(left, right);
     
     auto end_time = std::chrono::high_resolution_clock::now();
     Duration query_time = std::chrono::duration_cast<Duration>(end_time - start_time);
     
-    last_query_time_ = query_time;
+    last_query_time_.store(query_time.count(), std::memory_order_relaxed);
     
     return QueryResult(min_value, min_index, query_time);
 }
 
+QueryOutcome RMQBase::tryQuery(Index left, Index right) const noexcept {
+    QueryStatus status = checkQuery(left, right);
+    if (status != QueryStatus::OK) {
+        return QueryOutcome(status, 0, constants::INVALID_INDEX);
+    }
+    if (recorder_ != nullptr) {
+        recorder_->recordQuery(left, right);
+    }
+    
+    try {
+        return QueryOutcome(QueryStatus::OK, performQuery(left, right), constants::INVALID_INDEX);
+    } catch (...) {
+        return QueryOutcome(QueryStatus::INTERNAL_ERROR, 0, constants::INVALID_INDEX);
+    }
+}
+
+QueryOutcome RMQBase::tryQueryDetailed(Index left, Index right) const noexcept {
+    QueryStatus status = checkQuery(left, right);
+    if (status != QueryStatus::OK) {
+        return QueryOutcome(status, 0, constants::INVALID_INDEX);
+    }
+    if (recorder_ != nullptr) {
+        recorder_->recordQuery(left, right);
+    }
+    
+    try {
+        auto [min_value, min_index] = findMinimum(left, right);
+        return QueryOutcome(QueryStatus::OK, min_value, min_index);
+    } catch (...) {
+        return QueryOutcome(QueryStatus::INTERNAL_ERROR, 0, constants::INVALID_INDEX);
+    }
+}
+
+Size RMQBase::tryQueryBatch(const Query* queries, Size count,
+                            QueryOutcome* results) const noexcept {
+    RMQ_TRACE_SCOPE_ARG("query_batch", count);
+    Size succeeded = 0;
+    
+    for (Size i = 0; i < count; ++i) {
+        results[i] = tryQuery(queries[i].left, queries[i].right);
+        if (results[i].ok()) {
+            ++succeeded;
+        }
+    }
+    
+    return succeeded;
+}
+
+void RMQBase::update(Index /*index*/, Value /*value*/) {
+    throw NotSupportedException("update", getName());
+}
+
+void RMQBase::batchUpdate(const std::vector<std::pair<Index, Value>>& /*updates*/) {
+    throw NotSupportedException("batchUpdate", getName());
+}
+
+void RMQBase::saveStructure(std::ostream& /*out*/) const {
+    // Nothing stored: loadStructure() rebuilds from data_
+}
+
+void RMQBase::loadStructure(std::istream& /*in*/) {
+    performPreprocess();
+}
+
+void RMQBase::saveIndex(std::ostream& out) const {
+    ensurePreprocessed();
+    
+    serialization::writePod(out, serialization::makeHeader(getType()));
+    if (data_.size() == size_) {
+        serialization::writeVector(out, data_);
+    } else {
+        serialization::writeVector(out, copyData());
+    }
+    saveStructure(out);
+    
+    if (!out) {
+        throw AlgorithmException(getName(), "Failed to write binary index");
+    }
+}
+
+void RMQBase::loadIndex(std::istream& in) {
+    clear();
+    
+    try {
+        serialization::checkHeader(serialization::readPod<serialization::IndexHeader>(in), getType());
+        
+        std::vector<Value> data = serialization::readVector<Value>(in, config_.max_array_size);
+        validateData(data);
+        data_ = std::move(data);
+        size_ = data_.size();
+        
+        loadStructure(in);
+        preprocessed_ = true;
+    } catch (const std::bad_alloc&) {
+        clear();
+        throw AllocationException("Failed to allocate memory while loading index");
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
 Index RMQBase::findMinimumIndex(Index left, Index right) const {
     Value min_value = performQuery(left, right);
     
     for (Index i = left; i <= right; ++i) {
-        if (data_[i] == min_value) {
+        if (valueAt(i) == min_value) {
             return i;
         }
     }
@@ -109,10 +252,16 @@ Index RMQBase::findMinimumIndex(Index left, Index right) const {
     return left;
 }
 
+std::pair<Value, Index> RMQBase::findMinimum(Index left, Index right) const {
+    Index min_index = findMinimumIndex(left, right);
+    return {valueAt(min_index), min_index};
+}
+
 void RMQBase::clear() {
     data_.clear();
+    size_ = 0;
     preprocessed_ = false;
-    last_query_time_ = Duration(0);
+    last_query_time_.store(0, std::memory_order_relaxed);
 }
 
 } // namespace rmq
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "../../include/core/rmq_compressed.h"
+#include "../../include/core/rmq_exception.h"
+#include "../../include/core/rmq_kernels.h"
+#include <algorithm>
+#include <limits>
+
+namespace rmq {
+
+namespace {
+
+// RUN_LENGTH blocks store run r as words[2r] = start offset, words[2r + 1] = value
+
+size_t runCount(const std::vector<uint32_t>& words) {
+    return words.size() / 2;
+}
+
+Index runStart(const std::vector<uint32_t>& words, size_t run) {
+    return words[2 * run];
+}
+
+Value runValue(const std::vector<uint32_t>& words, size_t run) {
+    return static_cast<Value>(words[2 * run + 1]);
+}
+
+unsigned bitWidth(uint32_t value) {
+    unsigned width = 0;
+    while (value != 0) {
+        value >>= 1;
+        width++;
+    }
+    return width;
+}
+
+} // namespace
+
+CompressedArray::CompressedArray() : size_(0), block_size_(DEFAULT_BLOCK_SIZE) {
+}
+
+CompressedArray::CompressedArray(const std::vector<Value>& data, Size block_size)
+    : size_(data.size()), block_size_(block_size) {
+    
+    if (block_size_ == 0 || block_size_ > std::numeric_limits<uint32_t>::max()) {
+        throw ConfigurationException("block_size", "must be between 1 and 2^32 - 1 for compressed storage");
+    }
+    
+    blocks_.resize((size_ + block_size_ - 1) / block_size_);
+    for (size_t block = 0; block < blocks_.size(); ++block) {
+        encodeBlock(block, data.data() + blockStart(block));
+    }
+}
+
+Size CompressedArray::blockLength(size_t block) const {
+    return std::min(block_size_, size_ - blockStart(block));
+}
+
+void CompressedArray::encodeBlock(size_t block, const Value* values) {
+    Block& target = blocks_[block];
+    Size count = blockLength(block);
+    
+    Index min_offset = kernels::scanMinIndex(values, 0, count - 1);
+    Value min_value = values[min_offset];
+    
+    // Differences from the minimum always fit in 32 bits
+    std::vector<uint32_t> deltas(count);
+    uint32_t max_delta = 0;
+    Size runs = 1;
+    for (Index i = 0; i < count; ++i) {
+        deltas[i] = static_cast<uint32_t>(values[i]) - static_cast<uint32_t>(min_value);
+        max_delta = std::max(max_delta, deltas[i]);
+        if (i > 0 && values[i] != values[i - 1]) {
+            runs++;
+        }
+    }
+    unsigned width = bitWidth(max_delta);
+    
+    target.min = min_value;
+    target.min_offset = static_cast<uint32_t>(min_offset);
+    target.words.clear();
+    
+    if (2 * runs < kernels::packedWords(count, width)) {
+        target.encoding = Encoding::RUN_LENGTH;
+        target.bit_width = 0;
+        target.words.reserve(2 * runs);
+        for (Index i = 0; i < count; ++i) {
+            if (i == 0 || values[i] != values[i - 1]) {
+                target.words.push_back(static_cast<uint32_t>(i));
+                target.words.push_back(static_cast<uint32_t>(values[i]));
+            }
+        }
+    } else {
+        target.encoding = Encoding::FRAME_OF_REFERENCE;
+        target.bit_width = static_cast<uint8_t>(width);
+        target.words.assign(kernels::packedWords(count, width), 0);
+        kernels::packBits(deltas.data(), count, width, target.words.data());
+    }
+    target.words.shrink_to_fit();
+}
+
+size_t CompressedArray::findRun(const Block& block, Index offset) {
+    // Last run starting at or before offset (the first run starts at 0)
+    size_t low = 0;
+    size_t high = runCount(block.words);
+    while (high - low > 1) {
+        size_t mid = low + (high - low) / 2;
+        if (runStart(block.words, mid) <= offset) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+Value CompressedArray::get(Index index) const {
+    const Block& block = blocks_[index / block_size_];
+    Index offset = index % block_size_;
+    
+    if (block.encoding == Encoding::RUN_LENGTH) {
+        return runValue(block.words, findRun(block, offset));
+    }
+    
+    uint32_t delta = kernels::unpackValue(block.words.data(), block.bit_width, offset);
+    return static_cast<Value>(static_cast<uint32_t>(block.min) + delta);
+}
+
+void CompressedArray::set(Index index, Value value) {
+    size_t block = index / block_size_;
+    std::vector<Value> values(blockLength(block));
+    decodeBlock(block, values.data());
+    values[index - blockStart(block)] = value;
+    encodeBlock(block, values.data());
+}
+
+void CompressedArray::decodeBlock(size_t block, Value* out) const {
+    const Block& source = blocks_[block];
+    Size count = blockLength(block);
+    
+    if (source.encoding == Encoding::RUN_LENGTH) {
+        size_t runs = runCount(source.words);
+        for (size_t run = 0; run < runs; ++run) {
+            Index end = run + 1 < runs ? runStart(source.words, run + 1) : count;
+            std::fill(out + runStart(source.words, run), out + end, runValue(source.words, run));
+        }
+        return;
+    }
+    
+    uint32_t deltas[kernels::PACKED_CHUNK];
+    for (Index start = 0; start < count; start += kernels::PACKED_CHUNK) {
+        kernels::unpackChunk(source.words.data(), source.bit_width, start / kernels::PACKED_CHUNK, deltas);
+        Size length = std::min(kernels::PACKED_CHUNK, count - start);
+        for (Index i = 0; i < length; ++i) {
+            out[start + i] = static_cast<Value>(static_cast<uint32_t>(source.min) + deltas[i]);
+        }
+    }
+}
+
+Value CompressedArray::blockScanMin(const Block& block, Index first, Index last) const {
+    if (first <= block.min_offset && block.min_offset <= last) {
+        return block.min;
+    }
+    
+    if (block.encoding == Encoding::RUN_LENGTH) {
+        Value min_value = std::numeric_limits<Value>::max();
+        size_t runs = runCount(block.words);
+        for (size_t run = findRun(block, first); run < runs && runStart(block.words, run) <= last; ++run) {
+            min_value = std::min(min_value, runValue(block.words, run));
+        }
+        return min_value;
+    }
+    
+    uint32_t delta = kernels::scanMinPacked(block.words.data(), block.bit_width, first, last - first + 1);
+    return static_cast<Value>(static_cast<uint32_t>(block.min) + delta);
+}
+
+Index CompressedArray::blockScanMinIndex(const Block& block, Index first, Index last) const {
+    // The stored offset is the leftmost minimum of the whole block
+    if (first <= block.min_offset && block.min_offset <= last) {
+        return block.min_offset;
+    }
+    
+    if (block.encoding == Encoding::RUN_LENGTH) {
+        size_t runs = runCount(block.words);
+        size_t run = findRun(block, first);
+        Value min_value = runValue(block.words, run);
+        Index min_offset = first;
+        for (++run; run < runs && runStart(block.words, run) <= last; ++run) {
+            if (runValue(block.words, run) < min_value) {
+                min_value = runValue(block.words, run);
+                min_offset = runStart(block.words, run);
+            }
+        }
+        return min_offset;
+    }
+    
+    return first + kernels::scanMinIndexPacked(block.words.data(), block.bit_width, first, last - first + 1);
+}
+
+Value CompressedArray::scanMin(Index left, Index right) const {
+    size_t left_block = left / block_size_;
+    size_t right_block = right / block_size_;
+    
+    if (left_block == right_block) {
+        return blockScanMin(blocks_[left_block], left % block_size_, right % block_size_);
+    }
+    
+    Value result = blockScanMin(blocks_[left_block], left % block_size_, block_size_ - 1);
+    for (size_t block = left_block + 1; block < right_block; ++block) {
+        result = std::min(result, blocks_[block].min);
+    }
+    return std::min(result, blockScanMin(blocks_[right_block], 0, right % block_size_));
+}
+
+Index CompressedArray::scanMinIndex(Index left, Index right) const {
+    size_t left_block = left / block_size_;
+    size_t right_block = right / block_size_;
+    
+    if (left_block == right_block) {
+        return blockStart(left_block) +
+               blockScanMinIndex(blocks_[left_block], left % block_size_, right % block_size_);
+    }
+    
+    // Only a strictly smaller value moves the answer right
+    Index min_index = blockStart(left_block) +
+                      blockScanMinIndex(blocks_[left_block], left % block_size_, block_size_ - 1);
+    Value min_value = get(min_index);
+    for (size_t block = left_block + 1; block < right_block; ++block) {
+        if (blocks_[block].min < min_value) {
+            min_value = blocks_[block].min;
+            min_index = blockMinIndex(block);
+        }
+    }
+    
+    Index right_index = blockStart(right_block) +
+                        blockScanMinIndex(blocks_[right_block], 0, right % block_size_);
+    return get(right_index) < min_value ? right_index : min_index;
+}
+
+std::vector<Value> CompressedArray::decode() const {
+    std::vector<Value> data(size_);
+    for (size_t block = 0; block < blocks_.size(); ++block) {
+        decodeBlock(block, data.data() + blockStart(block));
+    }
+    return data;
+}
+
+size_t CompressedArray::getMemoryUsage() const {
+    size_t memory = blocks_.capacity() * sizeof(Block);
+    for (const Block& block : blocks_) {
+        memory += block.words.capacity() * sizeof(uint32_t);
+    }
+    return memory;
+}
+
+} // namespace rmq
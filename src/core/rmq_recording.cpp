@@ -0,0 +1,359 @@
+#include "../../include/core/rmq_recording.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace rmq {
+
+namespace recording {
+
+namespace {
+
+constexpr uint8_t KIND_QUERY = 0;
+constexpr uint8_t KIND_UPDATE = 1;
+
+/**
+ * @brief Longest encoded record: a kind byte and three 10-byte varints
+ */
+constexpr Size MAX_RECORD_BYTES = 31;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Decode a varint at pos; false if the buffer ends inside it
+ */
+bool getVarint(const std::vector<uint8_t>& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        uint8_t byte = in[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    throw InvalidDataException("Recording holds an overlong varint");
+}
+
+uint64_t zigzag(Value value) {
+    int64_t wide = value;
+    return (static_cast<uint64_t>(wide) << 1) ^ static_cast<uint64_t>(wide >> 63);
+}
+
+int64_t unzigzag(uint64_t encoded) {
+    return static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+}
+
+template <typename T>
+void putPod(std::vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T getPod(const std::vector<uint8_t>& in, size_t& pos) {
+    if (in.size() - pos < sizeof(T)) {
+        throw InvalidDataException("Recording header is truncated");
+    }
+    T value;
+    std::memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+std::vector<WorkloadOperation> Recording::workload() const {
+    std::vector<WorkloadOperation> ops;
+    ops.reserve(operations.size());
+    for (const auto& recorded : operations) {
+        ops.push_back(recorded.operation);
+    }
+    return ops;
+}
+
+uint64_t snapshotChecksum(const std::vector<Value>& data) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    for (size_t i = 0; i < data.size() * sizeof(Value); ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::vector<Value> loadSnapshot(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw InvalidDataException("Cannot open snapshot " + path);
+    }
+    
+    Size bytes = static_cast<Size>(in.tellg());
+    if (bytes % sizeof(Value) != 0) {
+        throw InvalidDataException("Snapshot " + path + " is truncated");
+    }
+    
+    std::vector<Value> data(bytes / sizeof(Value));
+    in.seekg(0);
+    if (bytes > 0 && !in.read(reinterpret_cast<char*>(data.data()), bytes)) {
+        throw InvalidDataException("Cannot read snapshot " + path);
+    }
+    return data;
+}
+
+Recording readRecording(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw InvalidDataException("Cannot open recording " + path);
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    
+    size_t pos = 0;
+    if (bytes.size() < sizeof(RECORDING_MAGIC) ||
+        std::memcmp(bytes.data(), RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) {
+        throw InvalidDataException("Not an RMQ recording: " + path);
+    }
+    pos += sizeof(RECORDING_MAGIC);
+    
+    uint32_t version = getPod<uint32_t>(bytes, pos);
+    if (version != RECORDING_VERSION) {
+        throw InvalidDataException("Unsupported recording version " + std::to_string(version));
+    }
+    if (getPod<uint32_t>(bytes, pos) != sizeof(Value)) {
+        throw InvalidDataException("Recording was written with a different value type");
+    }
+    
+    Recording recording;
+    recording.array_size = static_cast<Size>(getPod<uint64_t>(bytes, pos));
+    recording.checksum = getPod<uint64_t>(bytes, pos);
+    uint32_t reference_length = getPod<uint32_t>(bytes, pos);
+    if (bytes.size() - pos < reference_length) {
+        throw InvalidDataException("Recording header is truncated");
+    }
+    recording.snapshot.assign(reinterpret_cast<const char*>(bytes.data() + pos), reference_length);
+    pos += reference_length;
+    
+    uint64_t timestamp = 0;
+    while (pos < bytes.size()) {
+        uint8_t kind = bytes[pos++];
+        if (kind != KIND_QUERY && kind != KIND_UPDATE) {
+            throw InvalidDataException("Recording holds an unknown record kind");
+        }
+        
+        uint64_t delta = 0;
+        uint64_t first = 0;
+        uint64_t second = 0;
+        if (!getVarint(bytes, pos, delta) || !getVarint(bytes, pos, first) ||
+            !getVarint(bytes, pos, second)) {
+            break;  // Torn tail
+        }
+        timestamp += delta;
+        
+        WorkloadOperation op;
+        if (kind == KIND_QUERY) {
+            if (first >= recording.array_size || second >= recording.array_size - first) {
+                throw InvalidDataException("Recorded query is outside the array");
+            }
+            op = WorkloadOperation::query(first, first + second);
+        } else {
+            int64_t value = unzigzag(second);
+            if (first >= recording.array_size || value < std::numeric_limits<Value>::min() ||
+                value > std::numeric_limits<Value>::max()) {
+                throw InvalidDataException("Recorded update is outside the array or value range");
+            }
+            op = WorkloadOperation::update(first, static_cast<Value>(value));
+        }
+        recording.operations.push_back({timestamp, op});
+    }
+    return recording;
+}
+
+RecordingWriter::RecordingWriter(const std::string& path, const std::string& snapshot,
+                                 const std::vector<Value>& data, Size buffer_records)
+    : file_(nullptr),
+      start_(std::chrono::steady_clock::now()),
+      mask_(0),
+      enqueue_pos_(0),
+      dequeue_pos_(0),
+      stopping_(false),
+      last_timestamp_ns_(0),
+      dropped_(0),
+      failed_(false) {
+    if (buffer_records == 0) {
+        throw ConfigurationException("buffer_records", "must be at least 1");
+    }
+    
+    std::vector<uint8_t> header;
+    header.insert(header.end(), RECORDING_MAGIC, RECORDING_MAGIC + sizeof(RECORDING_MAGIC));
+    putPod<uint32_t>(header, RECORDING_VERSION);
+    putPod<uint32_t>(header, sizeof(Value));
+    putPod<uint64_t>(header, data.size());
+    putPod<uint64_t>(header, snapshotChecksum(data));
+    putPod<uint32_t>(header, static_cast<uint32_t>(snapshot.size()));
+    header.insert(header.end(), snapshot.begin(), snapshot.end());
+    
+    // Slot i starts free for the producer claiming position i
+    uint64_t capacity = 1;
+    while (capacity < buffer_records) {
+        capacity <<= 1;
+    }
+    mask_ = capacity - 1;
+    slots_.reset(new Slot[capacity]);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    encoded_.reserve(capacity * MAX_RECORD_BYTES);
+    
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw InvalidDataException("Cannot create recording " + path);
+    }
+    if (std::fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw InvalidDataException("Cannot write recording " + path);
+    }
+    
+    try {
+        flusher_ = std::thread(&RecordingWriter::flushLoop, this);
+    } catch (...) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw;
+    }
+}
+
+RecordingWriter::~RecordingWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    flusher_.join();
+    
+    flush();
+    if (file_ != nullptr) {
+        std::fclose(file_);
+    }
+}
+
+void RecordingWriter::append(uint8_t kind, Index first, uint64_t second) noexcept {
+    uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+    
+    // Claim the slot at enqueue_pos_ once the flusher has freed it
+    uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[pos & mask_];
+        int64_t lag = static_cast<int64_t>(slot->sequence.load(std::memory_order_acquire) - pos);
+        if (lag == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (lag < 0) {
+            // Ring full: wake the flusher and wait for it
+            wake_.notify_one();
+            std::this_thread::yield();
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    
+    slot->record = {timestamp, first, second, kind};
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    
+    // Drain early once half a ring is waiting
+    if (((pos + 1) & (mask_ >> 1)) == 0) {
+        wake_.notify_one();
+    }
+}
+
+bool RecordingWriter::pop(PendingRecord& record) noexcept {
+    Slot& slot = slots_[dequeue_pos_ & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+        return false;  // Empty, or the producer is still writing the slot
+    }
+    record = slot.record;
+    slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+    dequeue_pos_++;
+    return true;
+}
+
+bool RecordingWriter::writePending() noexcept {
+    // At most one ring per write keeps encoded_ within its reservation
+    Size batch;
+    do {
+        batch = 0;
+        encoded_.clear();
+        PendingRecord record;
+        while (batch <= mask_ && pop(record)) {
+            batch++;
+            if (failed_) {
+                continue;
+            }
+            // Concurrent producers may publish slightly out of time order
+            uint64_t timestamp = std::max(record.timestamp_ns, last_timestamp_ns_);
+            encoded_.push_back(record.kind);
+            putVarint(encoded_, timestamp - last_timestamp_ns_);
+            putVarint(encoded_, record.first);
+            putVarint(encoded_, record.second);
+            last_timestamp_ns_ = timestamp;
+        }
+        
+        if (!failed_ && !encoded_.empty() &&
+            (std::fwrite(encoded_.data(), 1, encoded_.size(), file_) != encoded_.size() ||
+             std::fflush(file_) != 0)) {
+            failed_ = true;
+        }
+        if (failed_) {
+            dropped_ += batch;
+        }
+    } while (batch > mask_);
+    return !failed_;
+}
+
+void RecordingWriter::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        wake_.wait_for(lock, FLUSH_INTERVAL);
+        writePending();
+    }
+}
+
+void RecordingWriter::recordQuery(Index left, Index right) noexcept {
+    append(KIND_QUERY, left, right - left);
+}
+
+void RecordingWriter::recordUpdate(Index index, Value value) noexcept {
+    append(KIND_UPDATE, index, zigzag(value));
+}
+
+bool RecordingWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writePending();
+}
+
+Size RecordingWriter::operationCount() {
+    return static_cast<Size>(enqueue_pos_.load(std::memory_order_acquire));
+}
+
+Size RecordingWriter::droppedCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+} // namespace recording
+
+} // namespace rmq
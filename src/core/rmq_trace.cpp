@@ -0,0 +1,81 @@
+#include "../../include/core/rmq_trace.h"
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <thread>
+
+namespace rmq {
+
+namespace trace {
+
+ChromeTraceWriter::ChromeTraceWriter(const std::string& path)
+    : path_(path), start_(std::chrono::steady_clock::now()) {
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() {
+    flush();
+}
+
+void ChromeTraceWriter::record(const char* name, char phase, int64_t arg) noexcept {
+    double timestamp = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start_).count();
+    uint64_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back({name, phase, timestamp, thread, arg});
+    } catch (...) {
+        // Tracing must never fail the traced code; drop the event
+    }
+}
+
+void ChromeTraceWriter::begin(const char* name, int64_t arg) noexcept {
+    record(name, 'B', arg);
+}
+
+void ChromeTraceWriter::end(const char* name) noexcept {
+    record(name, 'E', -1);
+}
+
+bool ChromeTraceWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::ofstream out(path_);
+    if (!out) {
+        return false;
+    }
+    
+    // Chrome wants small thread ids; number threads in order of appearance
+    std::vector<uint64_t> threads;
+    auto threadId = [&threads](uint64_t thread) {
+        for (size_t i = 0; i < threads.size(); ++i) {
+            if (threads[i] == thread) return i + 1;
+        }
+        threads.push_back(thread);
+        return threads.size();
+    };
+    
+    out << "{\"traceEvents\": [" << std::endl;
+    out << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < events_.size(); ++i) {
+        const Event& event = events_[i];
+        out << "  {\"name\": \"" << event.name << "\", \"cat\": \"rmq\", \"ph\": \"" << event.phase
+            << "\", \"ts\": " << event.timestamp << ", \"pid\": 1, \"tid\": " << threadId(event.thread);
+        if (event.arg >= 0) {
+            out << ", \"args\": {\"value\": " << event.arg << "}";
+        }
+        out << "}" << (i + 1 < events_.size() ? "," : "") << std::endl;
+    }
+    out << "], \"displayTimeUnit\": \"ms\"}" << std::endl;
+    
+    return static_cast<bool>(out);
+}
+
+size_t ChromeTraceWriter::eventCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+} // namespace trace
+
+} // namespace rmq
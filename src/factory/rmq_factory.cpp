@@ -3,13 +3,61 @@
 #include "../../include/algorithms/rmq_dp.h"
 #include "../../include/algorithms/rmq_sparse_table.h"
 #include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_block_concurrent.h"
 #include "../../include/algorithms/rmq_lca.h"
+#include "../../include/algorithms/rmq_stree.h"
+#include "../../include/algorithms/rmq_monotone.h"
+#include <algorithm>
+#include <chrono>
 #include <stdexcept>
 #include <cmath>
+#include <limits>
 #include <sstream>
 
 namespace rmq {
 
+namespace {
+
+/**
+ * @brief Replay a trace once, returning a checksum of the query results
+ * 
+ * Static algorithms apply updates to data and rebuild lazily, before the
+ * next query.
+ */
+long long replayTrace(IRMQAlgorithm& algorithm, std::vector<Value>& data,
+                      const std::vector<WorkloadOperation>& trace, Size& rebuilds) {
+    long long checksum = 0;
+    bool in_place = algorithm.supportsUpdate();
+    bool dirty = false;
+    
+    for (const auto& op : trace) {
+        if (op.kind == OperationKind::UPDATE) {
+            if (in_place) {
+                algorithm.update(op.left, op.value);
+            } else {
+                data[op.left] = op.value;
+                dirty = true;
+            }
+            continue;
+        }
+        
+        if (dirty) {
+            algorithm.preprocess(data);
+            rebuilds++;
+            dirty = false;
+        }
+        checksum += algorithm.query(op.left, op.right);
+    }
+    
+    if (dirty) {
+        algorithm.preprocess(data);
+        rebuilds++;
+    }
+    return checksum;
+}
+
+} // namespace
+
 RMQAlgorithmPtr RMQFactory::create(
     AlgorithmType type,
     const AlgorithmConfig& config) {
@@ -25,11 +73,20 @@ RMQAlgorithmPtr RMQFactory::create(
             return std::make_unique<RMQSparseTable>(config);
             
         case AlgorithmType::BLOCK_DECOMPOSITION:
+            if (config.concurrent_updates) {
+                return std::make_unique<RMQConcurrentBlockDecomposition>(config);
+            }
             return std::make_unique<RMQBlockDecomposition>(config);
             
         case AlgorithmType::LCA_BASED:
             return std::make_unique<RMQLCABased>(config);
             
+        case AlgorithmType::S_TREE:
+            return std::make_unique<RMQSTree>(config);
+            
+        case AlgorithmType::MONOTONE_RUNS:
+            return std::make_unique<RMQMonotoneRuns>(config);
+            
         default:
             throw std::invalid_argument("Unknown algorithm type");
     }
@@ -86,6 +143,209 @@ RMQAlgorithmPtr RMQFactory::createOptimal(
     return create(recommended, config);
 }
 
+RMQAlgorithmPtr RMQFactory::createForData(
+    const std::vector<Value>& data,
+    size_t expected_queries,
+    ShapeAnalysis* analysis,
+    const AlgorithmConfig& config) {
+    
+    ShapeAnalysis shape = RMQMonotoneRuns::analyze(data);
+    if (analysis) {
+        *analysis = shape;
+    }
+    
+    if (shape.shape != DataShape::GENERAL) {
+        return create(AlgorithmType::MONOTONE_RUNS, config);
+    }
+    return create(recommendAlgorithm(data.size(), expected_queries, false), config);
+}
+
+RMQFactory::BudgetSelection RMQFactory::selectForBudget(
+    size_t array_size,
+    size_t memory_budget_bytes,
+    bool requires_updates,
+    const AlgorithmConfig& config) {
+    
+    const size_t n = array_size;
+    const size_t data_bytes = n * sizeof(Value);
+    if (data_bytes > memory_budget_bytes) {
+        throw ConfigurationException("memory_budget",
+            std::to_string(memory_budget_bytes) + " bytes cannot hold the data itself (" +
+            std::to_string(data_bytes) + " bytes)");
+    }
+    
+    // Budgets are for large arrays; lift the default size limit to fit this one
+    AlgorithmConfig base_config = config;
+    base_config.max_array_size = std::max(config.max_array_size, n);
+    
+    BudgetSelection selection;
+    selection.config = base_config;
+    
+    auto fits = [&](AlgorithmType type) {
+        return calculateMemoryUsage(type, n, selection.config) <= memory_budget_bytes;
+    };
+    auto choose = [&](AlgorithmType type, const std::string& reasoning) {
+        selection.type = type;
+        selection.predicted_memory_bytes = calculateMemoryUsage(type, n, selection.config);
+        selection.reasoning = reasoning;
+        return selection;
+    };
+    
+    if (!requires_updates) {
+        // Static algorithms from fastest to slowest query. DP only pays off
+        // on small arrays (same cut-off as getBenchmarkRecommendation); the
+        // LCA tree links nodes with int.
+        struct Candidate {
+            AlgorithmType type;
+            bool eligible;
+            const char* reasoning;
+        };
+        const Candidate candidates[] = {
+            {AlgorithmType::DYNAMIC_PROGRAMMING, n <= 1000, "O(1) query; full table fits the budget"},
+            {AlgorithmType::SPARSE_TABLE, true, "O(1) query; sparse table fits the budget"},
+            {AlgorithmType::S_TREE, true, "O(log_16 n) query; sparse table exceeds the budget"},
+            {AlgorithmType::LCA_BASED, n <= static_cast<size_t>(std::numeric_limits<int>::max()),
+             "O(log n) query; S-tree exceeds the budget"}
+        };
+        for (const Candidate& candidate : candidates) {
+            if (candidate.eligible && fits(candidate.type)) {
+                return choose(candidate.type, candidate.reasoning);
+            }
+        }
+    }
+    
+    // Block decomposition with sqrt(n) blocks is its fastest configuration
+    selection.config.block_size = constants::DEFAULT_BLOCK_SIZE;
+    if (fits(AlgorithmType::BLOCK_DECOMPOSITION)) {
+        return choose(AlgorithmType::BLOCK_DECOMPOSITION, "O(sqrt n) query with sqrt(n) blocks");
+    }
+    
+    // Fewer, larger blocks: the smallest block size whose summary fits
+    const size_t entry_bytes = sizeof(Value) + sizeof(Index);
+    size_t max_blocks = (memory_budget_bytes - data_bytes) / entry_bytes;
+    if (max_blocks >= 2) {
+        selection.config.block_size = (n + max_blocks - 1) / max_blocks;
+        return choose(AlgorithmType::BLOCK_DECOMPOSITION,
+                      "Block size " + std::to_string(selection.config.block_size) +
+                      " trades query time for a smaller block summary");
+    }
+    
+    selection.config = base_config;
+    return choose(AlgorithmType::NAIVE, "Only the data fits the budget");
+}
+
+RMQAlgorithmPtr RMQFactory::createForBudget(
+    size_t array_size,
+    size_t memory_budget_bytes,
+    BudgetSelection* selection,
+    bool requires_updates,
+    const AlgorithmConfig& config) {
+    
+    BudgetSelection chosen = selectForBudget(array_size, memory_budget_bytes, requires_updates, config);
+    if (selection != nullptr) {
+        *selection = chosen;
+    }
+    return create(chosen.type, chosen.config);
+}
+
+RMQFactory::WorkloadSelection RMQFactory::selectForWorkload(
+    const std::vector<Value>& data_sample,
+    const std::vector<WorkloadOperation>& trace,
+    size_t array_size,
+    size_t memory_budget_bytes,
+    double min_replay_ms,
+    const AlgorithmConfig& config) {
+    
+    using clock = std::chrono::steady_clock;
+    
+    const Size n = data_sample.size();
+    if (n == 0) {
+        throw InvalidDataException("Workload selection needs a non-empty data sample");
+    }
+    if (trace.empty()) {
+        throw InvalidDataException("Workload selection needs a non-empty trace");
+    }
+    if (array_size == 0) {
+        array_size = n;
+    }
+    
+    // Fit the trace to the sample, keeping ranges proportional
+    Index max_index = 0;
+    for (const auto& op : trace) {
+        max_index = std::max(max_index, op.right);
+    }
+    std::vector<WorkloadOperation> scaled = trace;
+    if (max_index >= n) {
+        const double scale = static_cast<double>(n) / (static_cast<double>(max_index) + 1.0);
+        for (auto& op : scaled) {
+            op.left = std::min<Index>(static_cast<Index>(op.left * scale), n - 1);
+            op.right = std::min<Index>(static_cast<Index>(op.right * scale), n - 1);
+        }
+    }
+    
+    WorkloadSelection selection;
+    selection.ops_per_second = -1.0;
+    
+    for (AlgorithmType type : getAvailableAlgorithms()) {
+        CandidateMeasurement candidate{type, false, 0.0, 0.0, calculateMemoryUsage(type, array_size, config), 0};
+        
+        // DP is quadratic in the full array, whatever the sample size
+        bool too_large = type == AlgorithmType::DYNAMIC_PROGRAMMING && array_size > 1000;
+        if (too_large || candidate.memory_bytes > memory_budget_bytes) {
+            selection.candidates.push_back(candidate);
+            continue;
+        }
+        
+        std::vector<Value> data = data_sample;
+        auto algorithm = create(type, config);
+        
+        auto start = clock::now();
+        algorithm->preprocess(data);
+        candidate.build_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        
+        // Replay until the minimum time has elapsed
+        Size operations = 0;
+        volatile long long sink = 0;
+        double elapsed_ms = 0.0;
+        start = clock::now();
+        do {
+            sink = sink + replayTrace(*algorithm, data, scaled, candidate.rebuilds);
+            operations += scaled.size();
+            elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        } while (elapsed_ms < min_replay_ms);
+        
+        candidate.measured = true;
+        candidate.ops_per_second = operations / (std::max(elapsed_ms, 1e-6) / 1000.0);
+        selection.candidates.push_back(candidate);
+        
+        if (candidate.ops_per_second > selection.ops_per_second) {
+            selection.type = type;
+            selection.ops_per_second = candidate.ops_per_second;
+            selection.memory_bytes = candidate.memory_bytes;
+        }
+    }
+    
+    if (selection.ops_per_second < 0.0) {
+        throw ConfigurationException("memory_budget",
+            "no algorithm fits " + std::to_string(memory_budget_bytes) + " bytes");
+    }
+    
+    return selection;
+}
+
+RMQFactory::WorkloadSelection RMQFactory::selectForWorkload(
+    const std::vector<Value>& data_sample,
+    const WorkloadStats& stats,
+    Size trace_length,
+    size_t array_size,
+    size_t memory_budget_bytes,
+    double min_replay_ms,
+    const AlgorithmConfig& config) {
+    
+    return selectForWorkload(data_sample, synthesizeTrace(stats, data_sample.size(), trace_length),
+                             array_size, memory_budget_bytes, min_replay_ms, config);
+}
+
 AlgorithmType RMQFactory::recommendAlgorithm(
     size_t array_size,
     size_t expected_queries,
@@ -130,7 +390,9 @@ std::vector<AlgorithmType> RMQFactory::getAvailableAlgorithms() {
         AlgorithmType::DYNAMIC_PROGRAMMING,
         AlgorithmType::SPARSE_TABLE,
         AlgorithmType::BLOCK_DECOMPOSITION,
-        AlgorithmType::LCA_BASED
+        AlgorithmType::LCA_BASED,
+        AlgorithmType::S_TREE,
+        AlgorithmType::MONOTONE_RUNS
     };
 }
 
@@ -151,6 +413,12 @@ std::string RMQFactory::getAlgorithmDescription(AlgorithmType type) {
         case AlgorithmType::LCA_BASED:
             return "LCA-based - O(log n) query, O(n) preprocessing";
             
+        case AlgorithmType::S_TREE:
+            return "S-tree - O(log_16 n) query, O(n) preprocessing, n/15 extra space";
+            
+        case AlgorithmType::MONOTONE_RUNS:
+            return "Monotone runs - O(1) query on sorted data, O(log k) on k runs, O(n) preprocessing";
+            
         default:
             return "Unknown algorithm";
     }
@@ -169,7 +437,8 @@ bool RMQFactory::supportsFeature(AlgorithmType type, const std::string& feature)
     
     if (feature == "O(n) space") {
         return type == AlgorithmType::NAIVE || 
-               type == AlgorithmType::BLOCK_DECOMPOSITION;
+               type == AlgorithmType::BLOCK_DECOMPOSITION ||
+               type == AlgorithmType::S_TREE;
     }
     
     if (feature == "O(1) preprocessing") {
@@ -263,6 +532,12 @@ double RMQFactory::calculatePreprocessingTime(AlgorithmType type, size_t array_s
         case AlgorithmType::BLOCK_DECOMPOSITION:
             return CONSTANT_FACTOR * array_size;  // O(n)
             
+        case AlgorithmType::S_TREE:
+            return CONSTANT_FACTOR * array_size;  // O(n)
+            
+        case AlgorithmType::MONOTONE_RUNS:
+            return CONSTANT_FACTOR * array_size;  // O(n) for few runs
+            
         default:
             return 0;
     }
@@ -288,31 +563,119 @@ double RMQFactory::calculateQueryTime(AlgorithmType type, size_t array_size) {
         case AlgorithmType::LCA_BASED:
             return CONSTANT_FACTOR * std::log2(array_size);  // O(log n)
             
+        case AlgorithmType::S_TREE:
+            return CONSTANT_FACTOR * std::log2(array_size) / 4.0;  // O(log_16 n)
+            
+        case AlgorithmType::MONOTONE_RUNS:
+            return CONSTANT_FACTOR * std::log2(array_size);  // O(log k), k <= n / 2
+            
         default:
             return 0;
     }
 }
 
 size_t RMQFactory::calculateMemoryUsage(AlgorithmType type, size_t array_size) {
-    // Estimates in bytes
-    const size_t element_size = sizeof(Value);
+    return calculateMemoryUsage(type, array_size, AlgorithmConfig());
+}
+
+size_t RMQFactory::calculateMemoryUsage(AlgorithmType type, size_t array_size,
+                                        const AlgorithmConfig& config) {
+    // Bytes held after preprocess(), following each algorithm's layout
+    // (including its copy of the data, excluding the object itself)
+    const size_t n = array_size;
+    const size_t data_bytes = n * sizeof(Value);
+    if (n == 0) {
+        return 0;
+    }
+    
+    // Number of power-of-two levels: floor(log2(n)) + 1
+    size_t levels = 0;
+    while (levels < 63 && (size_t(1) << levels) <= n) {
+        levels++;
+    }
     
     switch (type) {
         case AlgorithmType::NAIVE:
-            return array_size * element_size;  // O(n)
+            return data_bytes;  // O(n)
             
         case AlgorithmType::DYNAMIC_PROGRAMMING:
-            return array_size * array_size * element_size * 2;  // O(n²)
+            // Two n x n tables of rows
+            return data_bytes + n * (n * (sizeof(Value) + sizeof(Index)) +
+                                     sizeof(std::vector<Value>) + sizeof(std::vector<Index>));  // O(n²)
             
-        case AlgorithmType::SPARSE_TABLE:
-            return array_size * static_cast<size_t>(std::log2(array_size) + 1) * element_size * 2;  // O(n log n)
+        case AlgorithmType::SPARSE_TABLE: {
+            // Level j holds n - 2^j + 1 (value, index) entries, plus the log
+            // table; lazy levels are counted as if every query had built them
+            size_t kept = config.max_levels != 0 ? std::min(config.max_levels, levels) : levels;
+            bool packed = config.packed_entries && n <= kernels::PACKED_MAX_SIZE;
+            size_t entries = 0;
+            for (size_t j = 0; j < kept; ++j) {
+                entries += n - (size_t(1) << j) + 1;
+            }
             
-        case AlgorithmType::BLOCK_DECOMPOSITION:
-            return array_size * element_size + 
-                   static_cast<size_t>(std::sqrt(array_size)) * element_size * 2;  // O(n + √n)
+            // A level cap adds one (value, index) minimum per block of 2^(kept - 1)
+            size_t blocks = 0;
+            if (kept < levels) {
+                size_t block = size_t(1) << (kept - 1);
+                blocks = (n + block - 1) / block;
+            }
+            size_t table_bytes = packed
+                ? entries * sizeof(kernels::PackedEntry) + kept * sizeof(std::vector<kernels::PackedEntry>)
+                : entries * (sizeof(Value) + sizeof(Index)) +
+                  kept * (sizeof(std::vector<Value>) + sizeof(std::vector<Index>));
+            return data_bytes + table_bytes + blocks * (sizeof(Value) + sizeof(Index)) +
+                   kept * sizeof(std::atomic<bool>) + (n + 1) * sizeof(int);  // O(n log n)
+        }
             
-        case AlgorithmType::LCA_BASED:
-            return array_size * static_cast<size_t>(std::log2(array_size) + 1) * element_size * 2;  // O(n log n)
+        case AlgorithmType::BLOCK_DECOMPOSITION: {
+            // Mirrors RMQBlockDecomposition::calculateBlockSize()
+            size_t block_size = config.block_size != constants::DEFAULT_BLOCK_SIZE
+                ? std::min(config.block_size, n)
+                : static_cast<size_t>(std::sqrt(n)) + 1;
+            size_t num_blocks = (n + block_size - 1) / block_size;
+            if (config.concurrent_updates) {
+                // One packed 64-bit key and one lock flag per block
+                return data_bytes + num_blocks * (sizeof(uint64_t) + sizeof(bool));
+            }
+            if (config.packed_entries && n <= kernels::PACKED_MAX_SIZE) {
+                return data_bytes + num_blocks * sizeof(kernels::PackedEntry);  // O(n + √n)
+            }
+            return data_bytes + num_blocks * (sizeof(Value) + sizeof(Index));  // O(n + √n)
+        }
+            
+        case AlgorithmType::LCA_BASED: {
+            // Tree node (value, array index, three links, depth) padded to
+            // Index alignment, the ancestor table and the array-to-tree map
+            size_t node_bytes = sizeof(Value) + sizeof(Index) + 4 * sizeof(int);
+            node_bytes = (node_bytes + alignof(Index) - 1) / alignof(Index) * alignof(Index);
+            size_t ancestor_levels = levels + ((size_t(1) << (levels - 1)) < n ? 1 : 0);
+            return data_bytes + n * node_bytes + ancestor_levels * n * sizeof(int) +
+                   ancestor_levels * sizeof(std::vector<int>) + n * sizeof(int);  // O(n log n)
+        }
+            
+        case AlgorithmType::S_TREE: {
+            // One 64-byte node per 16 keys on every level (the leaves hold
+            // the data), plus one offset per level
+            return RMQSTree::nodeCount(n) * 64 + RMQSTree::levelCount(n) * sizeof(size_t);  // O(n + n/15)
+        }
+            
+        case AlgorithmType::MONOTONE_RUNS: {
+            // Worst case of k = ceil(n / 2) runs: start, direction and
+            // minimum of each run, and a packed table over runs (3 or more)
+            size_t runs = (n + 1) / 2;
+            size_t run_bytes = (runs + 1) * sizeof(Index) + (runs + 63) / 64 * sizeof(uint64_t) +
+                               runs * sizeof(Index);
+            size_t run_levels = 0;
+            size_t entries = 0;
+            if (runs >= 3) {
+                while ((size_t(1) << run_levels) <= runs) {
+                    entries += runs - (size_t(1) << run_levels) + 1;
+                    run_levels++;
+                }
+            }
+            return data_bytes + run_bytes + entries * sizeof(kernels::PackedEntry) +
+                   run_levels * sizeof(std::vector<kernels::PackedEntry>);  // O(n + k log k)
+        }
             
         default:
             return 0;
@@ -0,0 +1,238 @@
+#include "../../include/persistence/rmq_durable.h"
+#include "../../include/core/rmq_serialization.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace rmq {
+
+namespace {
+
+/**
+ * @brief Write a buffer to a file and force it to disk
+ */
+void writeFileDurably(const std::string& path, const std::string& contents, bool sync) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr) {
+        throw AlgorithmException("Failed to create checkpoint " + path);
+    }
+    
+    bool failed = std::fwrite(contents.data(), 1, contents.size(), out) != contents.size();
+    failed = std::fflush(out) != 0 || failed;
+    if (sync && !failed) {
+#if defined(_WIN32)
+        failed = _commit(_fileno(out)) != 0;
+#else
+        failed = fsync(fileno(out)) != 0;
+#endif
+    }
+    failed = std::fclose(out) != 0 || failed;
+    
+    if (failed) {
+        throw AlgorithmException("Failed to write checkpoint " + path);
+    }
+}
+
+/**
+ * @brief Force a directory's entries (e.g. a rename into it) to disk
+ *
+ * Windows has no directory fsync; NTFS journals the rename itself.
+ */
+void syncDirectory(const std::string& directory) {
+#if !defined(_WIN32)
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw AlgorithmException("Failed to open checkpoint directory " + directory);
+    }
+    bool failed = fsync(fd) != 0;
+    failed = ::close(fd) != 0 || failed;
+    if (failed) {
+        throw AlgorithmException("Failed to sync checkpoint directory " + directory);
+    }
+#else
+    (void)directory;
+#endif
+}
+
+} // namespace
+
+DurableRMQ::DurableRMQ(std::unique_ptr<RMQBase> algorithm, const DurabilityConfig& config)
+    : algorithm_(std::move(algorithm)),
+      config_(config),
+      log_(config.group_commit_size, config.sync),
+      checkpoint_sequence_(0),
+      updates_since_checkpoint_(0) {
+    
+    if (!algorithm_) {
+        throw ConfigurationException("algorithm", "must not be null");
+    }
+    if (!algorithm_->supportsUpdate()) {
+        throw NotSupportedException("durable updates", algorithm_->getName());
+    }
+    if (config_.directory.empty()) {
+        throw ConfigurationException("directory", "must not be empty");
+    }
+    
+    std::error_code ec;
+    std::filesystem::create_directories(config_.directory, ec);
+    if (ec) {
+        throw ConfigurationException("directory", "cannot create " + config_.directory);
+    }
+}
+
+DurableRMQ::~DurableRMQ() = default;
+
+std::string DurableRMQ::checkpointPath() const {
+    return (std::filesystem::path(config_.directory) / "checkpoint.bin").string();
+}
+
+std::string DurableRMQ::logPath() const {
+    return (std::filesystem::path(config_.directory) / "updates.log").string();
+}
+
+bool DurableRMQ::hasCheckpoint() const {
+    std::error_code ec;
+    return std::filesystem::exists(checkpointPath(), ec);
+}
+
+void DurableRMQ::create(const std::vector<Value>& data) {
+    algorithm_->preprocess(data);
+    
+    // Start a fresh log; sequence numbers restart at 1
+    log_.close();
+    std::error_code ec;
+    std::filesystem::remove(logPath(), ec);
+    log_.open(logPath());
+    
+    checkpoint();
+}
+
+void DurableRMQ::checkpoint() {
+    log_.commit();
+    uint64_t sequence = log_.lastCommitted();
+    
+    std::ostringstream buffer(std::ios::binary);
+    serialization::writePod<uint64_t>(buffer, sequence);
+    algorithm_->saveIndex(buffer);
+    
+    // Write to a temporary file and rename over the old checkpoint, so a
+    // crash leaves either the old or the new checkpoint intact
+    std::string final_path = checkpointPath();
+    std::string temp_path = final_path + ".tmp";
+    writeFileDurably(temp_path, buffer.str(), config_.sync);
+    
+    std::error_code ec;
+    std::filesystem::rename(temp_path, final_path, ec);
+    if (ec) {
+        throw AlgorithmException("Failed to install checkpoint " + final_path);
+    }
+    
+    // The rename must be on disk before the log loses the records it covers
+    if (config_.sync) {
+        syncDirectory(config_.directory);
+    }
+    
+    // Records up to sequence are now covered by the checkpoint. A crash
+    // before the truncation is harmless: replay skips covered sequences.
+    log_.truncate();
+    checkpoint_sequence_ = sequence;
+    updates_since_checkpoint_ = 0;
+}
+
+RecoveryStats DurableRMQ::recover() {
+    RecoveryStats stats;
+    
+    std::ifstream in(checkpointPath(), std::ios::binary);
+    if (!in) {
+        throw InvalidDataException("No checkpoint in " + config_.directory);
+    }
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    uint64_t sequence = serialization::readPod<uint64_t>(in);
+    algorithm_->loadIndex(in);
+    auto loaded = std::chrono::high_resolution_clock::now();
+    
+    // Replay the committed log tail newer than the checkpoint
+    Size valid_bytes = 0;
+    std::vector<UpdateLogRecord> records = UpdateLog::readRecords(logPath(), sequence, &valid_bytes);
+    
+    std::vector<std::pair<Index, Value>> updates;
+    updates.reserve(records.size());
+    for (const auto& record : records) {
+        updates.emplace_back(record.index, record.value);
+    }
+    if (!updates.empty()) {
+        algorithm_->batchUpdate(updates);
+    }
+    auto replayed = std::chrono::high_resolution_clock::now();
+    
+    std::error_code ec;
+    Size log_bytes = 0;
+    if (std::filesystem::exists(logPath(), ec)) {
+        log_bytes = static_cast<Size>(std::filesystem::file_size(logPath(), ec));
+    }
+    
+    // Reopening truncates the torn tail and continues the sequence
+    log_.open(logPath(), sequence);
+    
+    checkpoint_sequence_ = sequence;
+    updates_since_checkpoint_ = records.size();
+    
+    stats.checkpoint_sequence = sequence;
+    stats.replayed_updates = records.size();
+    stats.discarded_bytes = log_bytes > valid_bytes ? log_bytes - valid_bytes : 0;
+    stats.load_time = std::chrono::duration_cast<Duration>(loaded - start);
+    stats.replay_time = std::chrono::duration_cast<Duration>(replayed - loaded);
+    return stats;
+}
+
+void DurableRMQ::maybeCheckpoint() {
+    if (config_.checkpoint_interval > 0 && updates_since_checkpoint_ >= config_.checkpoint_interval) {
+        checkpoint();
+    }
+}
+
+void DurableRMQ::validateUpdate(Index index) const {
+    if (!algorithm_->isPreprocessed()) {
+        throw NotPreprocessedException(algorithm_->getName());
+    }
+    if (index >= algorithm_->size()) {
+        throw BoundsException(index, algorithm_->size());
+    }
+}
+
+void DurableRMQ::update(Index index, Value value) {
+    // Check first so invalid updates never reach the log
+    validateUpdate(index);
+    log_.append(index, value);
+    algorithm_->update(index, value);
+    updates_since_checkpoint_++;
+    maybeCheckpoint();
+}
+
+void DurableRMQ::batchUpdate(const std::vector<std::pair<Index, Value>>& updates) {
+    for (const auto& [index, value] : updates) {
+        validateUpdate(index);
+    }
+    for (const auto& [index, value] : updates) {
+        log_.append(index, value);
+    }
+    algorithm_->batchUpdate(updates);
+    updates_since_checkpoint_ += updates.size();
+    maybeCheckpoint();
+}
+
+void DurableRMQ::commit() {
+    log_.commit();
+}
+
+} // namespace rmq
@@ -0,0 +1,251 @@
+#include "../../include/persistence/rmq_update_log.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace rmq {
+
+namespace {
+
+/**
+ * @brief Encode a record into its 24-byte on-disk form
+ */
+void encodeRecord(const UpdateLogRecord& record, unsigned char* out) {
+    uint64_t index = record.index;
+    int32_t value = record.value;
+    uint32_t sum = UpdateLog::checksum(record);
+    
+    std::memcpy(out, &record.sequence, 8);
+    std::memcpy(out + 8, &index, 8);
+    std::memcpy(out + 16, &value, 4);
+    std::memcpy(out + 20, &sum, 4);
+}
+
+} // namespace
+
+UpdateLog::UpdateLog(Size group_commit_size, bool sync)
+    : file_(nullptr),
+      group_commit_size_(std::max<Size>(1, group_commit_size)),
+      sync_(sync),
+      next_sequence_(1),
+      last_committed_(0),
+      groups_committed_(0),
+      committed_bytes_(0) {
+}
+
+UpdateLog::~UpdateLog() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; pending records are lost
+    }
+}
+
+uint32_t UpdateLog::checksum(const UpdateLogRecord& record) {
+    unsigned char bytes[20];
+    uint64_t index = record.index;
+    int32_t value = record.value;
+    std::memcpy(bytes, &record.sequence, 8);
+    std::memcpy(bytes + 8, &index, 8);
+    std::memcpy(bytes + 16, &value, 4);
+    
+    uint32_t hash = 2166136261u;
+    for (unsigned char byte : bytes) {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::vector<UpdateLogRecord> UpdateLog::readRecords(const std::string& path,
+                                                    uint64_t after_sequence,
+                                                    Size* valid_bytes) {
+    std::vector<UpdateLogRecord> records;
+    Size valid = 0;
+    
+    std::ifstream in(path, std::ios::binary);
+    unsigned char buffer[RECORD_BYTES];
+    uint64_t previous = 0;
+    
+    while (in && in.read(reinterpret_cast<char*>(buffer), RECORD_BYTES)) {
+        UpdateLogRecord record;
+        uint64_t index = 0;
+        int32_t value = 0;
+        uint32_t stored_sum = 0;
+        std::memcpy(&record.sequence, buffer, 8);
+        std::memcpy(&index, buffer + 8, 8);
+        std::memcpy(&value, buffer + 16, 4);
+        std::memcpy(&stored_sum, buffer + 20, 4);
+        record.index = static_cast<Index>(index);
+        record.value = value;
+        
+        // Stop at the first torn or corrupt record
+        if (stored_sum != checksum(record) || record.sequence <= previous) {
+            break;
+        }
+        
+        previous = record.sequence;
+        valid += RECORD_BYTES;
+        if (record.sequence > after_sequence) {
+            records.push_back(record);
+        }
+    }
+    
+    if (valid_bytes != nullptr) {
+        *valid_bytes = valid;
+    }
+    return records;
+}
+
+void UpdateLog::open(const std::string& path, uint64_t min_sequence) {
+    close();
+    
+    // Find the last valid record and cut off anything after it
+    Size valid_bytes = 0;
+    std::vector<UpdateLogRecord> existing = readRecords(path, 0, &valid_bytes);
+    
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec) && std::filesystem::file_size(path, ec) != valid_bytes) {
+        std::filesystem::resize_file(path, valid_bytes, ec);
+        if (ec) {
+            throw AlgorithmException("Failed to truncate torn update log " + path);
+        }
+    }
+    
+    file_ = std::fopen(path.c_str(), "ab");
+    if (file_ == nullptr) {
+        throw AlgorithmException("Failed to open update log " + path);
+    }
+    
+    path_ = path;
+    uint64_t last = existing.empty() ? 0 : existing.back().sequence;
+    last = std::max(last, min_sequence);
+    next_sequence_ = last + 1;
+    last_committed_ = last;
+    pending_.clear();
+    groups_committed_ = 0;
+    committed_bytes_ = valid_bytes;
+}
+
+void UpdateLog::close() {
+    if (file_ == nullptr) {
+        return;
+    }
+    
+    commit();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+uint64_t UpdateLog::append(Index index, Value value) {
+    if (file_ == nullptr) {
+        throw AlgorithmException("Update log is not open");
+    }
+    
+    UpdateLogRecord record;
+    record.sequence = next_sequence_++;
+    record.index = index;
+    record.value = value;
+    pending_.push_back(record);
+    
+    if (pending_.size() >= group_commit_size_) {
+        try {
+            commit();
+        } catch (...) {
+            // The caller sees this append fail, so it must not be retried later
+            pending_.pop_back();
+            next_sequence_--;
+            throw;
+        }
+    }
+    
+    return record.sequence;
+}
+
+void UpdateLog::commit() {
+    if (file_ == nullptr || pending_.empty()) {
+        return;
+    }
+    
+    // The whole group goes out in a single write followed by one fsync
+    std::vector<unsigned char> buffer(pending_.size() * RECORD_BYTES);
+    for (size_t i = 0; i < pending_.size(); ++i) {
+        encodeRecord(pending_[i], buffer.data() + i * RECORD_BYTES);
+    }
+    
+    try {
+        if (std::fwrite(buffer.data(), 1, buffer.size(), file_) != buffer.size()) {
+            throw AlgorithmException("Failed to write update log " + path_);
+        }
+        syncFile();
+    } catch (...) {
+        rollback();
+        throw;
+    }
+    
+    committed_bytes_ += buffer.size();
+    last_committed_ = pending_.back().sequence;
+    pending_.clear();
+    groups_committed_++;
+}
+
+void UpdateLog::truncate() {
+    if (file_ == nullptr) {
+        return;
+    }
+    
+    pending_.clear();
+    std::fclose(file_);
+    
+    file_ = std::fopen(path_.c_str(), "wb");
+    if (file_ == nullptr) {
+        throw AlgorithmException("Failed to truncate update log " + path_);
+    }
+    syncFile();
+    
+    std::fclose(file_);
+    file_ = std::fopen(path_.c_str(), "ab");
+    if (file_ == nullptr) {
+        throw AlgorithmException("Failed to reopen update log " + path_);
+    }
+    last_committed_ = next_sequence_ - 1;
+    committed_bytes_ = 0;
+}
+
+void UpdateLog::rollback() {
+    // Close first so nothing stdio still buffers lands after the cut
+    std::fclose(file_);
+    file_ = nullptr;
+    
+    std::error_code ec;
+    std::filesystem::resize_file(path_, committed_bytes_, ec);
+    if (!ec) {
+        file_ = std::fopen(path_.c_str(), "ab");
+    }
+}
+
+void UpdateLog::syncFile() {
+    if (std::fflush(file_) != 0) {
+        throw AlgorithmException("Failed to flush update log " + path_);
+    }
+    
+    if (sync_) {
+#if defined(_WIN32)
+        int result = _commit(_fileno(file_));
+#else
+        int result = fsync(fileno(file_));
+#endif
+        if (result != 0) {
+            throw AlgorithmException("Failed to sync update log " + path_);
+        }
+    }
+}
+
+} // namespace rmq
@@ -0,0 +1,263 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include "../../include/adaptive/rmq_adaptive.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_concurrent.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+#include "../../src/factory/rmq_factory.cpp"
+#include "../../src/adaptive/rmq_adaptive.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQAdaptiveTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        return data;
+    }
+    
+    /**
+     * @brief Run a workload phase, checking every answer against a plain scan
+     */
+    void runPhase(AdaptiveRMQ& rmq, std::vector<Value>& reference, size_t operations,
+                  size_t length, double update_fraction, std::mt19937& gen) {
+        const size_t n = reference.size();
+        std::uniform_real_distribution<> coin(0.0, 1.0);
+        std::uniform_int_distribution<size_t> position(0, n - length);
+        std::uniform_int_distribution<Value> value(-1000, 1000);
+        
+        for (size_t i = 0; i < operations; ++i) {
+            size_t left = position(gen);
+            if (coin(gen) < update_fraction) {
+                Value v = value(gen);
+                rmq.update(left, v);
+                reference[left] = v;
+            } else {
+                size_t right = left + length - 1;
+                assert(rmq.query(left, right) ==
+                       *std::min_element(reference.begin() + left, reference.begin() + right + 1));
+            }
+        }
+    }
+
+public:
+    void testCostModel() {
+        const Size n = 100000;
+        
+        WorkloadStats scans;
+        for (int i = 0; i < 1000; ++i) scans.recordQuery(0, n - 1);
+        assert(AdaptiveRMQ::cheapestFor(scans, n) == AlgorithmType::SPARSE_TABLE);
+        
+        WorkloadStats writes;
+        for (int i = 0; i < 500; ++i) writes.recordQuery(10, 25);
+        for (int i = 0; i < 500; ++i) writes.recordUpdate();
+        AlgorithmType best = AdaptiveRMQ::cheapestFor(writes, n);
+        assert(best == AlgorithmType::NAIVE || best == AlgorithmType::BLOCK_DECOMPOSITION);
+        
+        // Mid-length ranges with some updates favour blocks
+        WorkloadStats mixed;
+        for (int i = 0; i < 900; ++i) mixed.recordQuery(0, 20000);
+        for (int i = 0; i < 100; ++i) mixed.recordUpdate();
+        assert(AdaptiveRMQ::cheapestFor(mixed, n) == AlgorithmType::BLOCK_DECOMPOSITION);
+        
+        assert(AdaptiveRMQ::estimateBuildCost(AlgorithmType::NAIVE, n) == 0.0);
+        assert(AdaptiveRMQ::estimateBuildCost(AlgorithmType::SPARSE_TABLE, n) >
+               AdaptiveRMQ::estimateBuildCost(AlgorithmType::BLOCK_DECOMPOSITION, n));
+    }
+    
+    void testMigratesToScans() {
+        std::vector<Value> data = generateRandomData(20000, 1);
+        AdaptiveRMQ rmq(AlgorithmType::NAIVE, AdaptiveConfig().withWindow(512).withBackground(false));
+        rmq.preprocess(data);
+        assert(rmq.currentType() == AlgorithmType::NAIVE);
+        
+        std::mt19937 gen(2);
+        runPhase(rmq, data, 2048, 15000, 0.0, gen);
+        assert(rmq.currentType() == AlgorithmType::SPARSE_TABLE);
+        assert(rmq.stats().migrations == 1);
+        assert(rmq.stats().windows == 4);
+        assert(rmq.stats().last_window.queries == 512);
+        assert(rmq.stats().mean_latency_ns > 0.0);
+        assert(rmq.stats().ns_per_cost_unit > 0.0);
+        
+        // A stable workload does not trigger further switches
+        runPhase(rmq, data, 2048, 15000, 0.0, gen);
+        assert(rmq.stats().migrations == 1);
+    }
+    
+    void testMigratesOnUpdates() {
+        std::vector<Value> data = generateRandomData(20000, 3);
+        AdaptiveRMQ rmq(AlgorithmType::SPARSE_TABLE, AdaptiveConfig().withWindow(256).withBackground(false));
+        rmq.preprocess(data);
+        
+        std::mt19937 gen(4);
+        runPhase(rmq, data, 1024, 16, 0.5, gen);
+        assert(rmq.stats().migrations >= 1);
+        assert(rmq.stats().rebuilds > 0);
+        assert(rmq.stats().last_window.updates > 0);
+        
+        AlgorithmType type = rmq.currentType();
+        assert(type == AlgorithmType::NAIVE || type == AlgorithmType::BLOCK_DECOMPOSITION);
+        
+        // Once updatable, updates no longer force rebuilds
+        Size rebuilds = rmq.stats().rebuilds;
+        runPhase(rmq, data, 512, 16, 0.5, gen);
+        assert(rmq.stats().rebuilds == rebuilds);
+    }
+    
+    void testBackgroundMigrationCatchesUp() {
+        std::vector<Value> data = generateRandomData(50000, 5);
+        AdaptiveRMQ rmq(AlgorithmType::NAIVE, AdaptiveConfig().withWindow(256));
+        rmq.preprocess(data);
+        
+        // Long scans start a build; keep writing while it runs
+        std::mt19937 gen(6);
+        runPhase(rmq, data, 256, 40000, 0.0, gen);
+        assert(rmq.migrationInProgress() || rmq.stats().migrations == 1);
+        runPhase(rmq, data, 200, 40000, 0.5, gen);
+        
+        rmq.waitForMigration();
+        assert(!rmq.migrationInProgress());
+        assert(rmq.stats().migrations == 1);
+        assert(rmq.currentType() == AlgorithmType::SPARSE_TABLE);
+        
+        // Updates made during the build are visible after the swap
+        runPhase(rmq, data, 200, 100, 0.0, gen);
+        for (size_t left = 0; left < data.size(); left += 997) {
+            assert(rmq.query(left, left) == data[left]);
+        }
+    }
+    
+    void testDriftingWorkload() {
+        std::vector<Value> data = generateRandomData(20000, 7);
+        AdaptiveRMQ rmq(AlgorithmType::BLOCK_DECOMPOSITION, AdaptiveConfig().withWindow(512));
+        rmq.preprocess(data);
+        
+        // Update-heavy morning, long-scan afternoon, answers stay correct throughout
+        std::mt19937 gen(8);
+        runPhase(rmq, data, 2048, 32, 0.6, gen);
+        rmq.waitForMigration();
+        runPhase(rmq, data, 4096, 18000, 0.0, gen);
+        rmq.waitForMigration();
+        runPhase(rmq, data, 1024, 18000, 0.0, gen);
+        assert(rmq.currentType() == AlgorithmType::SPARSE_TABLE);
+        assert(rmq.stats().failed_migrations == 0);
+    }
+    
+    void testErrors() {
+        AdaptiveRMQ rmq;
+        
+        bool exception_thrown = false;
+        try {
+            rmq.update(0, 1);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        rmq.preprocess(generateRandomData(100, 9));
+        exception_thrown = false;
+        try {
+            rmq.update(100, 1);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            AdaptiveRMQ invalid(AlgorithmType::NAIVE, AdaptiveConfig().withSwitchMargin(0.5));
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Cost Model", [this]() { testCostModel(); });
+        runner.runTest("Migrates To Scans", [this]() { testMigratesToScans(); });
+        runner.runTest("Migrates On Updates", [this]() { testMigratesOnUpdates(); });
+        runner.runTest("Background Migration Catches Up", [this]() { testBackgroundMigrationCatchesUp(); });
+        runner.runTest("Drifting Workload", [this]() { testDriftingWorkload(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Adaptive Wrapper Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQAdaptiveTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <set>
+#include <string>
+#include "../../include/core/rmq_adversarial.h"
+#include "../../include/factory/rmq_factory.h"
+#include "../../include/algorithms/rmq_naive.h"
+#include "../../include/algorithms/rmq_dp.h"
+#include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_lca.h"
+#include "../../include/algorithms/rmq_stree.h"
+#include "../../include/algorithms/rmq_monotone.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_concurrent.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+#include "../../src/factory/rmq_factory.cpp"
+
+using namespace rmq;
+using namespace rmq::adversarial;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class AdversarialTest {
+private:
+    /**
+     * @brief Check every algorithm against a scan on one input and query set
+     */
+    void checkAllAlgorithms(const std::vector<Value>& data, const std::vector<Query>& queries,
+                            const std::string& label) {
+        for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+            auto rmq = RMQFactory::create(type);
+            rmq->preprocess(data);
+            for (const Query& query : queries) {
+                auto first = data.begin() + query.left;
+                auto last = data.begin() + query.right + 1;
+                auto expected = std::min_element(first, last);
+                
+                QueryOutcome outcome = rmq->tryQueryDetailed(query.left, query.right);
+                if (!outcome.ok() || outcome.value != *expected ||
+                    outcome.index != static_cast<Index>(expected - data.begin())) {
+                    throw std::runtime_error(algorithmTypeToString(type) + " wrong on " + label +
+                                             " [" + std::to_string(query.left) + ", " +
+                                             std::to_string(query.right) + "]");
+                }
+                assert(rmq->query(query.left, query.right) == *expected);
+            }
+        }
+    }
+
+public:
+    void testInputPatterns() {
+        const Size n = 1000;
+        
+        auto sorted = generateInput(InputPattern::SORTED, n);
+        assert(std::is_sorted(sorted.begin(), sorted.end()));
+        assert(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+        
+        auto reverse = generateInput(InputPattern::REVERSE_SORTED, n);
+        assert(std::is_sorted(reverse.rbegin(), reverse.rend()));
+        
+        auto pipe = generateInput(InputPattern::ORGAN_PIPE, n);
+        assert(std::max_element(pipe.begin(), pipe.end()) - pipe.begin() >= static_cast<long>(n / 2) - 1);
+        
+        auto zigzag = generateInput(InputPattern::ZIGZAG, n);
+        for (Size i = 0; i + 1 < n; ++i) {
+            assert((zigzag[i] > zigzag[i + 1]) == (i % 2 == 0));
+        }
+        
+        auto constant = generateInput(InputPattern::CONSTANT, n);
+        assert(std::set<Value>(constant.begin(), constant.end()).size() == 1);
+        
+        auto few = generateInput(InputPattern::FEW_DISTINCT, n);
+        assert(std::set<Value>(few.begin(), few.end()).size() <= 4);
+        
+        // Deterministic for a seed
+        for (InputPattern pattern : allInputPatterns()) {
+            assert(generateInput(pattern, n, 5).size() == n);
+            assert(generateInput(pattern, n, 5) == generateInput(pattern, n, 5));
+        }
+        assert(generateInput(InputPattern::RANDOM, n, 5) != generateInput(InputPattern::RANDOM, n, 6));
+    }
+    
+    void testQueryShapes() {
+        const Size n = 10000;
+        auto shapes = structuredQueryShapes(n);
+        assert(shapes.size() == 5);
+        
+        for (const QueryShape& shape : shapes) {
+            auto queries = generateQueries(shape, n, 500, 3);
+            assert(queries.size() == 500);
+            for (const Query& query : queries) {
+                assert(query.left <= query.right && query.right < n);
+            }
+        }
+        
+        // Full range
+        for (const Query& query : generateQueries(shapes[1], n, 10)) {
+            assert(query.left == 0 && query.right == n - 1);
+        }
+        
+        // Ends just inside sqrt(n) + 1 blocks
+        Size block = shapes[3].period;
+        assert(block == 101);
+        for (const Query& query : generateQueries(shapes[3], n, 200)) {
+            assert(query.left % block == 1 || query.right % block != block - 2);
+            if (query.left % block == 1) {
+                assert(query.right % block == block - 2);
+                assert(query.right - query.left + 1 >= n / 2 + 1 - 2 * block);
+            }
+        }
+        
+        // Degenerate arrays still give valid queries
+        for (const QueryShape& shape : structuredQueryShapes(1)) {
+            for (const Query& query : generateQueries(shape, 1, 10)) {
+                assert(query.left == 0 && query.right == 0);
+            }
+        }
+    }
+    
+    void testMutations() {
+        std::mt19937 gen(9);
+        auto data = generateInput(InputPattern::RANDOM, 3000);
+        std::set<std::string> names;
+        for (int i = 0; i < 300; ++i) {
+            names.insert(mutateInput(data, gen));
+            assert(data.size() == 3000);
+        }
+        assert(names.size() == 7);
+        
+        QueryShape shape;
+        for (int i = 0; i < 300; ++i) {
+            mutateShape(shape, 3000, gen);
+            assert(shape.min_length >= 1);
+            assert(shape.max_length == 0 || shape.min_length <= shape.max_length);
+            assert(shape.period <= 2 * 3000);
+            for (const Query& query : generateQueries(shape, 3000, 20, i)) {
+                assert(query.left <= query.right && query.right < 3000);
+            }
+        }
+        
+        // Values near the type limits do not overflow
+        std::vector<Value> extreme(100, std::numeric_limits<Value>::max() - 3);
+        for (int i = 0; i < 100; ++i) {
+            mutateInput(extreme, gen);
+        }
+    }
+    
+    void testCorpusAllAlgorithms() {
+        // Small enough for the O(n^2) dynamic programming table
+        const Size n = 600;
+        for (InputPattern pattern : allInputPatterns()) {
+            auto data = generateInput(pattern, n, 17);
+            for (const QueryShape& shape : structuredQueryShapes(n)) {
+                checkAllAlgorithms(data, generateQueries(shape, n, 60, 18),
+                                   std::string(inputPatternToString(pattern)) + ", " + shape.describe());
+            }
+        }
+    }
+    
+    void testMutatedCorpusAllAlgorithms() {
+        const Size n = 500;
+        std::mt19937 gen(21);
+        for (InputPattern pattern : allInputPatterns()) {
+            auto data = generateInput(pattern, n, 22);
+            QueryShape shape;
+            for (int step = 0; step < 8; ++step) {
+                mutateInput(data, gen);
+                mutateShape(shape, n, gen);
+            }
+            checkAllAlgorithms(data, generateQueries(shape, n, 80, 23),
+                               std::string("mutated ") + inputPatternToString(pattern));
+        }
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Input Patterns", [this]() { testInputPatterns(); });
+        runner.runTest("Query Shapes", [this]() { testQueryShapes(); });
+        runner.runTest("Mutations", [this]() { testMutations(); });
+        runner.runTest("Corpus All Algorithms", [this]() { testCorpusAllAlgorithms(); });
+        runner.runTest("Mutated Corpus All Algorithms", [this]() { testMutatedCorpusAllAlgorithms(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Adversarial Input Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    AdversarialTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
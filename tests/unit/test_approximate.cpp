@@ -0,0 +1,267 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include "../../include/algorithms/rmq_approximate.h"
+#include "../../src/algorithms/rmq_approximate.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQApproximateTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, Value low, Value high, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> dis(low, high);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    /**
+     * @brief Slowly varying series with a little noise, like a monitored metric
+     */
+    std::vector<Value> generateSmoothSeries(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> noise(-2, 2);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<Value>(1000.0 * std::sin(i / 200000.0)) + noise(gen);
+        }
+        return data;
+    }
+    
+    Value naiveMin(const std::vector<Value>& data, size_t left, size_t right) {
+        return *std::min_element(data.begin() + left, data.begin() + right + 1);
+    }
+    
+    /**
+     * @brief Check every guarantee of one answer
+     */
+    void verifyQuery(const RMQApproximate& rmq, const std::vector<Value>& data, size_t left, size_t right) {
+        ApproximateMinimum result = rmq.query(left, right);
+        Value exact = naiveMin(data, left, right);
+        
+        assert(result.value <= exact && exact <= result.upper_bound);
+        assert(result.valueError() >= 0);
+        assert(result.covered_left <= left && right <= result.covered_right);
+        assert(left - result.covered_left < rmq.getBucketWidth());
+        assert(result.covered_right - right < rmq.getBucketWidth());
+        assert(result.value == naiveMin(data, result.covered_left, result.covered_right));
+    }
+    
+    void verifyRandomQueries(const RMQApproximate& rmq, const std::vector<Value>& data, int queries, int seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < queries; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            verifyQuery(rmq, data, left, right);
+        }
+    }
+
+public:
+    void testBasicFunctionality() {
+        std::vector<Value> data = {5, 2, 8, 1, 9, 3, 7, 4};
+        RMQApproximate rmq(data, ApproximateConfig().withMaxBuckets(4));
+        assert(rmq.getBucketWidth() == 2);
+        assert(rmq.getBucketCount() == 4);
+        assert(rmq.size() == 8);
+        
+        // [1, 4] widens to [0, 5]; buckets {8, 1} lie inside
+        ApproximateMinimum result = rmq.query(1, 4);
+        assert(result.value == 1);
+        assert(result.covered_left == 0 && result.covered_right == 5);
+        assert(result.upper_bound == 1);
+        assert(result.exact());
+        
+        // [4, 4] sits in bucket {9, 3}: between its minimum and maximum
+        result = rmq.query(4, 4);
+        assert(result.value == 3);
+        assert(result.upper_bound == 9);
+        assert(result.valueError() == 6);
+        assert(!result.exact());
+    }
+    
+    void testBoundsHold() {
+        std::vector<std::vector<Value>> inputs = {
+            generateRandomData(10000, -1000, 1000, 1),
+            generateRandomData(10000, 0, 3, 2),
+            generateSmoothSeries(10000, 3),
+            std::vector<Value>(10000, 7),
+            generateRandomData(997, -50, 50, 4)
+        };
+        for (const auto& data : inputs) {
+            for (Size buckets : {Size(1), Size(7), Size(100), Size(5000), Size(20000)}) {
+                RMQApproximate rmq(data, ApproximateConfig().withMaxBuckets(buckets));
+                assert(rmq.getBucketCount() <= buckets);
+                verifyRandomQueries(rmq, data, 300, static_cast<int>(buckets));
+                verifyQuery(rmq, data, 0, data.size() - 1);
+                verifyQuery(rmq, data, data.size() - 1, data.size() - 1);
+            }
+        }
+    }
+    
+    void testAlignedRangesExact() {
+        std::vector<Value> data = generateRandomData(4096, -1000, 1000, 5);
+        RMQApproximate rmq(data, ApproximateConfig().withMaxBuckets(64));
+        Size width = rmq.getBucketWidth();
+        assert(width == 64);
+        
+        for (Size first = 0; first < 64; first += 5) {
+            for (Size last = first; last < 64; last += 7) {
+                ApproximateMinimum result = rmq.query(first * width, (last + 1) * width - 1);
+                assert(result.exact());
+                assert(result.value == naiveMin(data, first * width, (last + 1) * width - 1));
+            }
+        }
+        
+        // Smooth series stay close even when not aligned
+        std::vector<Value> series = generateSmoothSeries(1000000, 6);
+        RMQApproximate smooth(series, ApproximateConfig().withMaxBuckets(1024));
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<size_t> dis(0, series.size() - 1);
+        for (int q = 0; q < 200; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(smooth.query(left, right).valueError() <= 16);
+        }
+    }
+    
+    void testMaxRangeError() {
+        std::vector<Value> data = generateRandomData(10000, -1000, 1000, 8);
+        RMQApproximate rmq(data, ApproximateConfig().withMaxRangeError(9));
+        assert(rmq.getBucketWidth() == 10);
+        assert(rmq.getBucketCount() == 1000);
+        verifyRandomQueries(rmq, data, 1000, 9);
+        
+        // A range error past the end leaves a single bucket
+        RMQApproximate coarse(data, ApproximateConfig().withMaxRangeError(100000));
+        assert(coarse.getBucketCount() == 1);
+        verifyRandomQueries(coarse, data, 100, 10);
+    }
+    
+    void testMemoryIndependentOfSize() {
+        std::vector<Value> small = generateSmoothSeries(25600, 11);
+        std::vector<Value> large = generateSmoothSeries(2048000, 12);
+        ApproximateConfig config = ApproximateConfig().withMaxBuckets(256);
+        
+        RMQApproximate a(small, config);
+        RMQApproximate b(large, config);
+        assert(a.getMemoryUsage() == b.getMemoryUsage());
+        assert(b.getMemoryUsage() <= sizeof(RMQApproximate) + 256 * 2 * sizeof(Value));
+        verifyRandomQueries(b, large, 50, 13);
+    }
+    
+    void testErrors() {
+        bool exception_thrown = false;
+        try {
+            RMQApproximate rmq(std::vector<Value>{});
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            RMQApproximate rmq(std::vector<Value>{1, 2, 3}, ApproximateConfig().withMaxBuckets(0));
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        RMQApproximate rmq(generateRandomData(100, 0, 10, 14));
+        
+        exception_thrown = false;
+        try {
+            rmq.query(0, 100);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.query(5, 4);
+        } catch (const InvalidQueryException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Bounds Hold", [this]() { testBoundsHold(); });
+        runner.runTest("Aligned Ranges Exact", [this]() { testAlignedRangesExact(); });
+        runner.runTest("Max Range Error", [this]() { testMaxRangeError(); });
+        runner.runTest("Memory Independent Of Size", [this]() { testMemoryIndependentOfSize(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Approximate Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQApproximateTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
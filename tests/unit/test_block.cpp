@@ -8,9 +8,11 @@
 #include <algorithm>
 #include <tuple>
 #include <cmath>
+#include <sstream>
 #include "../../include/algorithms/rmq_block.h"
 #include "../../include/algorithms/rmq_naive.h"
 #include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
 #include "../../src/algorithms/rmq_block.cpp"
 #include "../../src/algorithms/rmq_naive.cpp"
 
@@ -322,6 +324,58 @@ public:
         assert(duration.count() < 100);  // Less than 100ms for 1000 updates
     }
     
+    void testPackedEntries() {
+        std::mt19937 gen(93);
+        std::uniform_int_distribution<> dis(-10, 10);  // Plenty of ties
+        std::vector<Value> data(2000);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        
+        RMQBlockDecomposition packed(AlgorithmConfig().withPackedEntries(true).withBlockSize(16));
+        packed.preprocess(data);
+        RMQBlockDecomposition unpacked(AlgorithmConfig().withBlockSize(16));
+        unpacked.preprocess(data);
+        assert(packed.getMemoryUsage() < unpacked.getMemoryUsage());
+        
+        RMQNaive naive;
+        naive.preprocess(data);
+        auto check = [&](const RMQBlockDecomposition& rmq) {
+            for (int i = 0; i < 2000; ++i) {
+                Index left = gen() % data.size();
+                Index right = left + gen() % (data.size() - left);
+                QueryOutcome outcome = rmq.tryQueryDetailed(left, right);
+                assert(outcome.value == naive.query(left, right));
+                assert(outcome.index == naive.tryQueryDetailed(left, right).index);
+            }
+        };
+        check(packed);
+        
+        // Updates rewrite the packed key of their block
+        for (int i = 0; i < 200; ++i) {
+            Index index = gen() % data.size();
+            Value value = dis(gen);
+            packed.update(index, value);
+            naive.update(index, value);
+        }
+        check(packed);
+        
+        // The index file is the same as the unpacked one
+        std::stringstream packed_file;
+        std::stringstream unpacked_file;
+        packed.saveIndex(packed_file);
+        for (Index i = 0; i < data.size(); ++i) {
+            unpacked.update(i, naive.query(i, i));
+        }
+        unpacked.saveIndex(unpacked_file);
+        assert(packed_file.str() == unpacked_file.str());
+        
+        RMQBlockDecomposition loaded(AlgorithmConfig().withPackedEntries(true));
+        loaded.loadIndex(packed_file);
+        check(loaded);
+        assert(loaded.getMemoryUsage() < unpacked.getMemoryUsage());
+    }
+    
     void runAllTests(TestRunner& runner) {
         runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
         runner.runTest("Single Element", [this]() { testSingleElement(); });
@@ -339,6 +393,7 @@ public:
         runner.runTest("Block Stats", [this]() { testBlockStats(); });
         runner.runTest("Clear Function", [this]() { testClearFunction(); });
         runner.runTest("Update Performance", [this]() { testUpdatePerformance(); });
+        runner.runTest("Packed Entries", [this]() { testPackedEntries(); });
     }
 };
 
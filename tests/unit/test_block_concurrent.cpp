@@ -0,0 +1,411 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "../../include/algorithms/rmq_block_concurrent.h"
+#include "../../include/factory/rmq_factory.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_concurrent.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+#include "../../src/factory/rmq_factory.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQConcurrentBlockTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        return data;
+    }
+    
+    Value naiveMin(const std::vector<Value>& data, size_t left, size_t right) {
+        return *std::min_element(data.begin() + left, data.begin() + right + 1);
+    }
+    
+    Index naiveMinIndex(const std::vector<Value>& data, size_t left, size_t right) {
+        return std::min_element(data.begin() + left, data.begin() + right + 1) - data.begin();
+    }
+    
+    void verifyAllRanges(const RMQConcurrentBlockDecomposition& rmq, const std::vector<Value>& data, int seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < 2000; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq.query(left, right) == naiveMin(data, left, right));
+            assert(rmq.queryDetailed(left, right).minimum_index == naiveMinIndex(data, left, right));
+        }
+    }
+
+public:
+    void testBasicQueries() {
+        std::vector<Value> data = generateRandomData(1000, 1);
+        RMQConcurrentBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        assert(rmq.getBlockSize() == static_cast<size_t>(std::sqrt(1000)) + 1);
+        assert(rmq.getType() == AlgorithmType::BLOCK_DECOMPOSITION);
+        verifyAllRanges(rmq, data, 2);
+    }
+    
+    void testLeftmostTies() {
+        std::vector<Value> data(100, 5);
+        data[30] = 1;
+        data[70] = 1;
+        RMQConcurrentBlockDecomposition rmq(AlgorithmConfig().withBlockSize(10));
+        rmq.preprocess(data);
+        
+        assert(rmq.queryDetailed(0, 99).minimum_index == 30);
+        assert(rmq.queryDetailed(31, 99).minimum_index == 70);
+        assert(rmq.queryDetailed(0, 9).minimum_index == 0);
+        
+        // Negative and extreme values keep their order in the packed keys
+        data = {0, std::numeric_limits<Value>::max(), -1, std::numeric_limits<Value>::min(), 7};
+        rmq.preprocess(data);
+        assert(rmq.query(0, 4) == std::numeric_limits<Value>::min());
+        assert(rmq.query(0, 2) == -1);
+        assert(rmq.query(1, 1) == std::numeric_limits<Value>::max());
+    }
+    
+    void testSequentialUpdates() {
+        std::vector<Value> data = generateRandomData(2000, 3);
+        RMQConcurrentBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        std::mt19937 gen(4);
+        std::uniform_int_distribution<size_t> position(0, data.size() - 1);
+        std::uniform_int_distribution<Value> value(-1500, 1500);
+        for (int i = 0; i < 5000; ++i) {
+            size_t index = position(gen);
+            Value v = value(gen);
+            rmq.update(index, v);
+            data[index] = v;
+        }
+        verifyAllRanges(rmq, data, 5);
+        
+        // Raising every block minimum forces the rescan path
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] < 0) {
+                rmq.update(i, -data[i]);
+                data[i] = -data[i];
+            }
+        }
+        verifyAllRanges(rmq, data, 6);
+    }
+    
+    void testConcurrentWriters() {
+        const size_t n = 20000;
+        const int num_writers = 4;
+        std::vector<Value> data = generateRandomData(n, 7);
+        RMQConcurrentBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        // Writer t owns the indices congruent to t, so every block sees
+        // concurrent decreases and increases from all writers
+        std::vector<std::thread> writers;
+        for (int t = 0; t < num_writers; ++t) {
+            writers.emplace_back([&rmq, n, t, num_writers]() {
+                std::mt19937 gen(100 + t);
+                std::uniform_int_distribution<Value> value(-2000, 2000);
+                for (int round = 0; round < 5; ++round) {
+                    for (size_t i = t; i < n; i += num_writers) {
+                        rmq.update(i, value(gen));
+                    }
+                }
+            });
+        }
+        
+        // Readers run alongside; every answer must be a valid value
+        std::atomic<bool> done(false);
+        std::atomic<size_t> reads(0);
+        std::thread reader([&]() {
+            std::mt19937 gen(9);
+            std::uniform_int_distribution<size_t> dis(0, n - 1);
+            do {
+                size_t left = dis(gen);
+                size_t right = dis(gen);
+                if (left > right) std::swap(left, right);
+                Value v = rmq.query(left, right);
+                assert(v >= -2000 && v <= 2000);
+                reads++;
+            } while (!done.load());
+        });
+        
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        assert(reads.load() > 0);
+        
+        // Once quiescent, the structure matches the final data exactly
+        std::vector<Value> current(n);
+        for (size_t i = 0; i < n; ++i) {
+            current[i] = rmq.query(i, i);
+        }
+        verifyAllRanges(rmq, current, 10);
+    }
+    
+    void testSameIndexWriters() {
+        const size_t n = 64;
+        const int num_writers = 4;
+        std::vector<Value> data = generateRandomData(n, 15);
+        RMQConcurrentBlockDecomposition rmq(AlgorithmConfig().withBlockSize(16));
+        rmq.preprocess(data);
+        
+        // All writers hit the same few indices of every block, mixing
+        // decreases and increases on one element
+        std::vector<std::thread> writers;
+        for (int t = 0; t < num_writers; ++t) {
+            writers.emplace_back([&rmq, n, t]() {
+                std::mt19937 gen(200 + t);
+                std::uniform_int_distribution<Value> value(-2000, 2000);
+                std::uniform_int_distribution<size_t> slot(0, 1);
+                for (int round = 0; round < 200000; ++round) {
+                    size_t block = round % (n / 16);
+                    rmq.update(block * 16 + slot(gen), value(gen));
+                }
+            });
+        }
+        
+        // Detailed answers take value and index from one key
+        std::atomic<bool> done(false);
+        std::thread reader([&]() {
+            std::mt19937 gen(16);
+            std::uniform_int_distribution<size_t> dis(0, n - 1);
+            do {
+                size_t left = dis(gen);
+                size_t right = dis(gen);
+                if (left > right) std::swap(left, right);
+                QueryOutcome outcome = rmq.tryQueryDetailed(left, right);
+                assert(outcome.ok());
+                assert(outcome.index >= left && outcome.index <= right);
+                assert(outcome.value >= -2000 && outcome.value <= 2000);
+            } while (!done.load());
+        });
+        
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        
+        // Every block key matches the final elements
+        std::vector<Value> current(n);
+        for (size_t i = 0; i < n; ++i) {
+            current[i] = rmq.query(i, i);
+        }
+        for (size_t block = 0; block < n / 16; ++block) {
+            size_t left = block * 16;
+            size_t right = left + 15;
+            QueryResult result = rmq.queryDetailed(left, right);
+            assert(result.minimum_value == naiveMin(current, left, right));
+            assert(result.minimum_index == naiveMinIndex(current, left, right));
+        }
+        verifyAllRanges(rmq, current, 17);
+    }
+    
+    void testConcurrentReaders() {
+        const size_t n = 5000;
+        const int num_readers = 4;
+        std::vector<Value> data = generateRandomData(n, 18);
+        RMQConcurrentBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        // Readers use the timed entry points, which share getLastQueryTime()
+        std::atomic<bool> done(false);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < num_readers; ++t) {
+            readers.emplace_back([&rmq, &done, n, t]() {
+                std::mt19937 gen(300 + t);
+                std::uniform_int_distribution<size_t> dis(0, n - 1);
+                for (int q = 0; q < 2000 || !done.load(); ++q) {
+                    size_t left = dis(gen);
+                    size_t right = dis(gen);
+                    if (left > right) std::swap(left, right);
+                    Value v = rmq.query(left, right);
+                    QueryResult result = rmq.queryDetailed(left, right);
+                    assert(v >= -3000 && v <= 1000);
+                    assert(result.minimum_index >= left && result.minimum_index <= right);
+                    assert(rmq.getLastQueryTime().count() >= 0.0);
+                }
+            });
+        }
+        
+        std::thread writer([&rmq, n]() {
+            std::mt19937 gen(19);
+            std::uniform_int_distribution<size_t> index(0, n - 1);
+            std::uniform_int_distribution<Value> value(-3000, 1000);
+            for (int i = 0; i < 20000; ++i) {
+                rmq.update(index(gen), value(gen));
+            }
+        });
+        writer.join();
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        
+        std::vector<Value> current(n);
+        for (size_t i = 0; i < n; ++i) {
+            current[i] = rmq.query(i, i);
+        }
+        verifyAllRanges(rmq, current, 20);
+    }
+    
+    void testConcurrentDecreasesMonotone() {
+        const size_t n = 10000;
+        std::vector<Value> data = generateRandomData(n, 11);
+        RMQConcurrentBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        // Values only decrease, so a concurrent query can never exceed the
+        // initial minimum of its range
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 3; ++t) {
+            writers.emplace_back([&rmq, &data, n, t]() {
+                for (size_t i = t; i < n; i += 3) {
+                    rmq.update(i, data[i] - 1 - static_cast<Value>(i % 7));
+                }
+            });
+        }
+        
+        std::mt19937 gen(12);
+        std::uniform_int_distribution<size_t> dis(0, n - 1);
+        for (int q = 0; q < 3000; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq.query(left, right) <= naiveMin(data, left, right));
+        }
+        
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        for (size_t i = 0; i < n; ++i) {
+            data[i] -= 1 + static_cast<Value>(i % 7);
+        }
+        verifyAllRanges(rmq, data, 13);
+    }
+    
+    void testFactoryAndErrors() {
+        auto rmq = RMQFactory::create(AlgorithmType::BLOCK_DECOMPOSITION,
+                                      AlgorithmConfig().withConcurrentUpdates(true));
+        assert(dynamic_cast<RMQConcurrentBlockDecomposition*>(rmq.get()) != nullptr);
+        
+        bool exception_thrown = false;
+        try {
+            rmq->update(0, 1);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        std::vector<Value> data = generateRandomData(100, 14);
+        rmq->preprocess(data);
+        exception_thrown = false;
+        try {
+            rmq->batchUpdate({{5, -5000}, {100, 1}});
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(rmq->query(0, 99) == naiveMin(data, 0, 99));
+        
+        // Memory prediction follows the concurrent layout
+        auto& concurrent = dynamic_cast<RMQConcurrentBlockDecomposition&>(*rmq);
+        assert(concurrent.getMemoryUsage() - sizeof(RMQConcurrentBlockDecomposition) ==
+               RMQFactory::calculateMemoryUsage(AlgorithmType::BLOCK_DECOMPOSITION, 100,
+                                                AlgorithmConfig().withConcurrentUpdates(true)));
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Queries", [this]() { testBasicQueries(); });
+        runner.runTest("Leftmost Ties", [this]() { testLeftmostTies(); });
+        runner.runTest("Sequential Updates", [this]() { testSequentialUpdates(); });
+        runner.runTest("Concurrent Writers", [this]() { testConcurrentWriters(); });
+        runner.runTest("Same Index Writers", [this]() { testSameIndexWriters(); });
+        runner.runTest("Concurrent Readers", [this]() { testConcurrentReaders(); });
+        runner.runTest("Concurrent Decreases Monotone", [this]() { testConcurrentDecreasesMonotone(); });
+        runner.runTest("Factory And Errors", [this]() { testFactoryAndErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Concurrent Block Decomposition Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQConcurrentBlockTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
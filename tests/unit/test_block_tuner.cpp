@@ -0,0 +1,286 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "../../include/algorithms/rmq_block_tuner.h"
+#include "../../include/algorithms/rmq_block.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_tuner.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class BlockSizeTunerTest {
+private:
+    const std::string profile_path_ = "test_block_profile.txt";
+    
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000000, 1000000);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    std::vector<Query> generateQueries(size_t size, size_t count, size_t max_length, int seed) {
+        std::vector<Query> queries;
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> length_dis(1, max_length);
+        for (size_t i = 0; i < count; ++i) {
+            size_t length = length_dis(gen);
+            std::uniform_int_distribution<size_t> left_dis(0, size - length);
+            size_t left = left_dis(gen);
+            queries.emplace_back(left, left + length - 1);
+        }
+        return queries;
+    }
+
+public:
+    ~BlockSizeTunerTest() {
+        std::remove(profile_path_.c_str());
+    }
+    
+    void testCandidateSizes() {
+        // Multiples of a cache line, increasing, capped at 8 sqrt(n)
+        std::vector<Size> sizes = BlockSizeTuner::candidateSizes(1000000);
+        assert(!sizes.empty());
+        assert(sizes.front() == BlockSizeTuner::CACHE_LINE_VALUES);
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            assert(sizes[i] % BlockSizeTuner::CACHE_LINE_VALUES == 0);
+            assert(sizes[i] <= 8000);
+            if (i > 0) {
+                assert(sizes[i] > sizes[i - 1]);
+            }
+        }
+        assert(sizes.back() * 3 / 2 > 8000);
+        
+        // Arrays up to a cache line have a single candidate
+        assert(BlockSizeTuner::candidateSizes(5) == std::vector<Size>{5});
+        
+        // Never beyond the array
+        for (Size block_size : BlockSizeTuner::candidateSizes(40)) {
+            assert(block_size <= 40);
+        }
+    }
+    
+    void testTunePicksMeasuredBest() {
+        auto data = generateRandomData(50000, 42);
+        auto sample = generateQueries(data.size(), 500, 5000, 43);
+        
+        BlockSizeTuning tuning = BlockSizeTuner::tune(data, sample, 0.2);
+        assert(!tuning.from_profile);
+        assert(tuning.default_ns_per_query > 0.0);
+        
+        // The default size competes with the cache-line candidates
+        std::vector<Size> candidates = BlockSizeTuner::candidateSizes(data.size());
+        Size default_size = RMQBlockDecomposition::defaultBlockSize(data.size());
+        assert(std::find(candidates.begin(), candidates.end(), default_size) == candidates.end());
+        assert(tuning.trials.size() == candidates.size() + 1);
+        assert(std::any_of(tuning.trials.begin(), tuning.trials.end(),
+                           [&](const BlockSizeTrial& trial) { return trial.block_size == default_size; }));
+        assert(tuning.ns_per_query <= tuning.default_ns_per_query);
+        
+        // The choice is the fastest trial
+        for (const BlockSizeTrial& trial : tuning.trials) {
+            assert(trial.ns_per_query > 0.0);
+            assert(tuning.ns_per_query <= trial.ns_per_query);
+        }
+        auto chosen = std::find_if(tuning.trials.begin(), tuning.trials.end(),
+                                   [&](const BlockSizeTrial& trial) { return trial.block_size == tuning.block_size; });
+        assert(chosen != tuning.trials.end());
+        assert(chosen->ns_per_query == tuning.ns_per_query);
+        
+        // The tuned structure answers like any other
+        RMQBlockDecomposition rmq(AlgorithmConfig().withBlockSize(tuning.block_size));
+        rmq.preprocess(data);
+        assert(rmq.getBlockSize() == tuning.block_size);
+        for (const Query& query : generateQueries(data.size(), 200, data.size(), 44)) {
+            Value expected = *std::min_element(data.begin() + query.left, data.begin() + query.right + 1);
+            assert(rmq.query(query.left, query.right) == expected);
+        }
+    }
+    
+    void testProfileRoundTrip() {
+        WorkloadStats short_queries;
+        short_queries.recordQuery(0, 99);
+        WorkloadStats long_queries;
+        long_queries.recordQuery(0, 99999);
+        
+        BlockSizeProfile profile;
+        profile.record(1000000, short_queries, 64);
+        profile.record(1000000, long_queries, 2048);
+        assert(profile.size() == 2);
+        
+        // Same power-of-two buckets share an entry
+        WorkloadStats similar;
+        similar.recordQuery(10, 119);
+        assert(profile.lookup(900000, similar) == 64);
+        assert(profile.lookup(1000, short_queries) == 0);
+        
+        profile.save(profile_path_);
+        BlockSizeProfile loaded = BlockSizeProfile::load(profile_path_);
+        assert(loaded.size() == 2);
+        assert(loaded.lookup(1000000, short_queries) == 64);
+        assert(loaded.lookup(1000000, long_queries) == 2048);
+        
+        // A missing file is an empty profile
+        std::remove(profile_path_.c_str());
+        assert(BlockSizeProfile::load(profile_path_).size() == 0);
+    }
+    
+    void testTuneWithProfile() {
+        auto data = generateRandomData(20000, 7);
+        auto sample = generateQueries(data.size(), 300, 2000, 8);
+        
+        BlockSizeProfile profile;
+        BlockSizeTuning first = BlockSizeTuner::tune(data, sample, profile, 0.1);
+        assert(!first.from_profile);
+        assert(profile.size() == 1);
+        
+        // The same profile is not measured again
+        BlockSizeTuning second = BlockSizeTuner::tune(data, sample, profile, 0.1);
+        assert(second.from_profile);
+        assert(second.block_size == first.block_size);
+        assert(second.trials.empty());
+        
+        // A different workload on the same array is
+        auto long_sample = generateQueries(data.size(), 300, data.size(), 9);
+        BlockSizeTuning third = BlockSizeTuner::tune(data, long_sample, profile, 0.1);
+        assert(!third.from_profile);
+        assert(profile.size() == 2);
+    }
+    
+    void testErrors() {
+        std::vector<Value> data = {5, 3, 8, 1};
+        bool exception_thrown = false;
+        
+        // Empty sample
+        try {
+            BlockSizeTuner::tune(data, {}, 0.1);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Empty data
+        exception_thrown = false;
+        try {
+            BlockSizeTuner::tune({}, {Query(0, 0)}, 0.1);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Sample query out of range
+        exception_thrown = false;
+        try {
+            BlockSizeTuner::tune(data, {Query(1, 4)}, 0.1);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Malformed profile
+        {
+            std::ofstream out(profile_path_);
+            out << "rmq-block-profile 1\n3 4 garbage\n";
+        }
+        exception_thrown = false;
+        try {
+            BlockSizeProfile::load(profile_path_);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Not a profile at all
+        {
+            std::ofstream out(profile_path_);
+            out << "something else\n";
+        }
+        exception_thrown = false;
+        try {
+            BlockSizeProfile::load(profile_path_);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Candidate Sizes", [this]() { testCandidateSizes(); });
+        runner.runTest("Tune Picks Measured Best", [this]() { testTunePicksMeasuredBest(); });
+        runner.runTest("Profile Round Trip", [this]() { testProfileRoundTrip(); });
+        runner.runTest("Tune With Profile", [this]() { testTuneWithProfile(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Block Size Tuner Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    BlockSizeTunerTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
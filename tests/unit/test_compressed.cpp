@@ -0,0 +1,338 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include "../../include/core/rmq_compressed.h"
+#include "../../include/algorithms/rmq_naive.h"
+#include "../../include/algorithms/rmq_block.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class CompressedStorageTest {
+private:
+    /**
+     * @brief Values in [low, high], with constant runs of up to max_run
+     */
+    std::vector<Value> generateData(size_t size, Value low, Value high, size_t max_run, int seed) {
+        std::vector<Value> data;
+        data.reserve(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> value(low, high);
+        std::uniform_int_distribution<size_t> run(1, max_run);
+        
+        while (data.size() < size) {
+            Value v = value(gen);
+            for (size_t i = run(gen); i > 0 && data.size() < size; --i) {
+                data.push_back(v);
+            }
+        }
+        return data;
+    }
+    
+    Value naiveMin(const std::vector<Value>& data, size_t left, size_t right) {
+        return *std::min_element(data.begin() + left, data.begin() + right + 1);
+    }
+    
+    Index naiveMinIndex(const std::vector<Value>& data, size_t left, size_t right) {
+        return std::min_element(data.begin() + left, data.begin() + right + 1) - data.begin();
+    }
+    
+    void verifyArray(const CompressedArray& array, const std::vector<Value>& data, int seed) {
+        assert(array.size() == data.size());
+        assert(array.decode() == data);
+        for (size_t i = 0; i < data.size(); ++i) {
+            assert(array.get(i) == data[i]);
+        }
+        
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < 500; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(array.scanMin(left, right) == naiveMin(data, left, right));
+            assert(array.scanMinIndex(left, right) == naiveMinIndex(data, left, right));
+        }
+    }
+    
+    void verifyAlgorithm(const RMQBase& rmq, const std::vector<Value>& data, int seed) {
+        assert(rmq.size() == data.size());
+        
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < 500; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq.query(left, right) == naiveMin(data, left, right));
+            assert(rmq.queryDetailed(left, right).minimum_index == naiveMinIndex(data, left, right));
+            
+            QueryOutcome outcome = rmq.tryQueryDetailed(left, right);
+            assert(outcome.ok());
+            assert(outcome.value == naiveMin(data, left, right));
+        }
+    }
+
+public:
+    void testEncodingSelection() {
+        // Long constant stretches are run-length encoded
+        std::vector<Value> runs = generateData(4096, -50, 50, 200, 1);
+        CompressedArray run_array(runs, 256);
+        assert(run_array.blockEncoding(0) == CompressedArray::Encoding::RUN_LENGTH);
+        verifyArray(run_array, runs, 2);
+        
+        // A narrow range without runs is bit-packed
+        std::vector<Value> narrow = generateData(4096, 1000, 1255, 1, 3);
+        CompressedArray narrow_array(narrow, 256);
+        assert(narrow_array.blockEncoding(0) == CompressedArray::Encoding::FRAME_OF_REFERENCE);
+        verifyArray(narrow_array, narrow, 4);
+        
+        // 8-bit differences: about a quarter of the raw size
+        assert(narrow_array.getMemoryUsage() * 3 < narrow.size() * sizeof(Value));
+        assert(run_array.getMemoryUsage() * 4 < runs.size() * sizeof(Value));
+    }
+    
+    void testScansAcrossWidths() {
+        const Value min = std::numeric_limits<Value>::min();
+        const Value max = std::numeric_limits<Value>::max();
+        
+        // Widths 0 (constant), small, odd, and the full 32 bits
+        std::vector<std::pair<Value, Value>> ranges = {
+            {7, 7}, {0, 1}, {-3, 3}, {0, 100}, {-70000, 70000}, {min, max}
+        };
+        int seed = 10;
+        for (const auto& [low, high] : ranges) {
+            for (size_t block_size : {size_t(1), size_t(7), size_t(256), size_t(1000)}) {
+                std::vector<Value> data = generateData(3001, low, high, 3, seed++);
+                verifyArray(CompressedArray(data, block_size), data, seed++);
+            }
+        }
+        
+        // Extreme values at block edges
+        std::vector<Value> edges(600, 0);
+        edges[0] = max;
+        edges[255] = min;
+        edges[256] = min;
+        edges[599] = min;
+        verifyArray(CompressedArray(edges, 256), edges, 99);
+    }
+    
+    void testSetReencodes() {
+        // Two runs per block
+        std::vector<Value> data(1000);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = i % 256 < 128 ? 5 : 6;
+        }
+        CompressedArray array(data, 256);
+        assert(array.blockEncoding(1) == CompressedArray::Encoding::RUN_LENGTH);
+        
+        // Scattered values turn a run-length block into a packed one
+        std::mt19937 gen(20);
+        std::uniform_int_distribution<Value> value(-1000, 1000);
+        for (size_t i = 256; i < 512; ++i) {
+            data[i] = value(gen);
+            array.set(i, data[i]);
+        }
+        assert(array.blockEncoding(1) == CompressedArray::Encoding::FRAME_OF_REFERENCE);
+        assert(array.blockMin(1) == naiveMin(data, 256, 511));
+        assert(array.blockMinIndex(1) == naiveMinIndex(data, 256, 511));
+        
+        // Raising the minimum moves the stored block minimum
+        Index old_min = array.blockMinIndex(1);
+        data[old_min] = 5000;
+        array.set(old_min, 5000);
+        assert(array.blockMin(1) == naiveMin(data, 256, 511));
+        
+        // And back to runs
+        for (size_t i = 256; i < 512; ++i) {
+            data[i] = i < 384 ? 3 : 4;
+            array.set(i, data[i]);
+        }
+        assert(array.blockEncoding(1) == CompressedArray::Encoding::RUN_LENGTH);
+        verifyArray(array, data, 21);
+    }
+    
+    void testCompressedNaive() {
+        std::vector<Value> data = generateData(20000, 0, 255, 4, 30);
+        RMQNaive plain;
+        RMQNaive compressed(AlgorithmConfig().withCompressedData(true));
+        plain.preprocess(data);
+        compressed.preprocess(data);
+        
+        verifyAlgorithm(compressed, data, 31);
+        assert(compressed.getMemoryUsage() * 2 < plain.getMemoryUsage());
+        
+        std::mt19937 gen(32);
+        std::uniform_int_distribution<size_t> index(0, data.size() - 1);
+        std::uniform_int_distribution<Value> value(-100, 400);
+        for (int u = 0; u < 300; ++u) {
+            size_t i = index(gen);
+            data[i] = value(gen);
+            compressed.update(i, data[i]);
+        }
+        compressed.batchUpdate({{0, -1}, {19999, -2}});
+        data[0] = -1;
+        data[19999] = -2;
+        verifyAlgorithm(compressed, data, 33);
+    }
+    
+    void testCompressedBlock() {
+        std::vector<Value> data = generateData(50000, -20, 20, 50, 40);
+        
+        for (size_t block_size : {constants::DEFAULT_BLOCK_SIZE, size_t(64), size_t(5000)}) {
+            RMQBlockDecomposition plain(AlgorithmConfig().withBlockSize(block_size));
+            RMQBlockDecomposition compressed(AlgorithmConfig().withBlockSize(block_size).withCompressedData(true));
+            plain.preprocess(data);
+            compressed.preprocess(data);
+            
+            assert(compressed.getBlockSize() == plain.getBlockSize());
+            verifyAlgorithm(compressed, data, 41);
+            assert(compressed.getMemoryUsage() * 2 < plain.getMemoryUsage());
+        }
+        
+        RMQBlockDecomposition compressed(AlgorithmConfig().withCompressedData(true));
+        compressed.preprocess(data);
+        std::vector<std::pair<Index, Value>> updates;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<size_t> index(0, data.size() - 1);
+        std::uniform_int_distribution<Value> value(-500, 500);
+        for (int u = 0; u < 200; ++u) {
+            updates.emplace_back(index(gen), value(gen));
+        }
+        compressed.batchUpdate(updates);
+        for (const auto& [i, v] : updates) {
+            data[i] = v;
+        }
+        compressed.update(7, -10000);
+        data[7] = -10000;
+        compressed.rebuildBlocks();
+        verifyAlgorithm(compressed, data, 43);
+        
+        // The binary index is the same with or without compression
+        std::stringstream stream;
+        compressed.saveIndex(stream);
+        RMQBlockDecomposition loaded;
+        loaded.loadIndex(stream);
+        verifyAlgorithm(loaded, data, 44);
+        
+        std::stringstream plain_stream;
+        loaded.saveIndex(plain_stream);
+        RMQBlockDecomposition reloaded(AlgorithmConfig().withCompressedData(true));
+        reloaded.loadIndex(plain_stream);
+        verifyAlgorithm(reloaded, data, 45);
+        assert(reloaded.getMemoryUsage() * 2 < loaded.getMemoryUsage());
+    }
+    
+    void testErrors() {
+        bool exception_thrown = false;
+        try {
+            CompressedArray array(std::vector<Value>(10, 1), 0);
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        RMQBlockDecomposition rmq(AlgorithmConfig().withCompressedData(true));
+        rmq.preprocess(std::vector<Value>(100, 1));
+        
+        exception_thrown = false;
+        try {
+            rmq.update(100, 0);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.query(0, 100);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        assert(rmq.tryQuery(0, 100).status == QueryStatus::OUT_OF_BOUNDS);
+        
+        rmq.clear();
+        assert(rmq.size() == 0);
+        assert(!rmq.isPreprocessed());
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Encoding Selection", [this]() { testEncodingSelection(); });
+        runner.runTest("Scans Across Widths", [this]() { testScansAcrossWidths(); });
+        runner.runTest("Set Re-encodes", [this]() { testSetReencodes(); });
+        runner.runTest("Compressed Naive", [this]() { testCompressedNaive(); });
+        runner.runTest("Compressed Block Decomposition", [this]() { testCompressedBlock(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Compressed Storage Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    CompressedStorageTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -279,6 +279,40 @@ public:
         assert(configured_rmq.getConfig().track_statistics == true);
     }
     
+    void testParallelPreprocessing() {
+        // Large enough to be split across several worker threads
+        const size_t size = 700;
+        std::vector<Value> data(size);
+        
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<> dis(-50, 50);  // Narrow range forces ties
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        
+        AlgorithmConfig config;
+        config.withParallel(true);
+        RMQDynamicProgramming parallel_rmq(config);
+        parallel_rmq.preprocess(data);
+        
+        // Every range must match a brute force scan, including the leftmost index
+        for (Index i = 0; i < size; i += 3) {
+            Value expected = data[i];
+            Index expected_index = i;
+            for (Index j = i; j < size; ++j) {
+                if (data[j] < expected) {
+                    expected = data[j];
+                    expected_index = j;
+                }
+                
+                QueryResult result = parallel_rmq.queryDetailed(i, j);
+                assert(result.minimum_value == expected);
+                assert(result.minimum_index == expected_index);
+            }
+        }
+    }
+    
     void testDestructorCleansUp() {
         // Test that destructor properly cleans up
         {
@@ -308,6 +342,7 @@ public:
         runner.runTest("Invalid Query Range", [this]() { testInvalidQueryRange(); });
         runner.runTest("O(1) Query Time", [this]() { testO1QueryTime(); });
         runner.runTest("Configuration", [this]() { testConfiguration(); });
+        runner.runTest("Parallel Preprocessing", [this]() { testParallelPreprocessing(); });
         runner.runTest("Destructor Cleans Up", [this]() { testDestructorCleansUp(); });
     }
 };
@@ -0,0 +1,481 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/resource.h>
+#endif
+#include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_naive.h"
+#include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../include/persistence/rmq_durable.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/persistence/rmq_update_log.cpp"
+#include "../../src/persistence/rmq_durable.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQDurableTest {
+private:
+    const std::string directory_ = "test_durable_dir";
+    
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        
+        return data;
+    }
+    
+    std::unique_ptr<RMQBase> makeBlock() {
+        AlgorithmConfig config;
+        config.withBlockSize(16);
+        return std::make_unique<RMQBlockDecomposition>(config);
+    }
+    
+    DurabilityConfig makeConfig() {
+        // fsync is irrelevant for correctness here and slows the tests down
+        return DurabilityConfig(directory_).withSync(false);
+    }
+    
+    void verifyAgainst(const DurableRMQ& rmq, const std::vector<Value>& reference) {
+        for (size_t left = 0; left < reference.size(); left += 7) {
+            for (size_t right = left; right < reference.size(); right += 13) {
+                Value expected = *std::min_element(reference.begin() + left, reference.begin() + right + 1);
+                assert(rmq.query(left, right) == expected);
+            }
+        }
+    }
+    
+    void resetDirectory() {
+        std::filesystem::remove_all(directory_);
+    }
+
+public:
+    ~RMQDurableTest() {
+        resetDirectory();
+    }
+    
+    void testCreateAndRecover() {
+        resetDirectory();
+        std::vector<Value> reference = generateRandomData(300, 1);
+        
+        {
+            DurableRMQ rmq(makeBlock(), makeConfig());
+            rmq.create(reference);
+            
+            std::mt19937 gen(2);
+            std::uniform_int_distribution<size_t> index_dist(0, reference.size() - 1);
+            std::uniform_int_distribution<> value_dist(-2000, 2000);
+            for (int i = 0; i < 50; ++i) {
+                size_t index = index_dist(gen);
+                Value value = value_dist(gen);
+                rmq.update(index, value);
+                reference[index] = value;
+            }
+            rmq.commit();
+            assert(rmq.lastSequence() == 50);
+        }
+        
+        DurableRMQ restored(makeBlock(), makeConfig());
+        assert(restored.hasCheckpoint());
+        RecoveryStats stats = restored.recover();
+        
+        assert(stats.checkpoint_sequence == 0);
+        assert(stats.replayed_updates == 50);
+        assert(stats.discarded_bytes == 0);
+        verifyAgainst(restored, reference);
+        
+        // New updates continue the sequence
+        restored.update(0, -5000);
+        assert(restored.lastSequence() == 51);
+        assert(restored.query(0, 299) == -5000);
+    }
+    
+    void testGroupCommit() {
+        resetDirectory();
+        DurableRMQ rmq(makeBlock(), makeConfig().withGroupCommit(4));
+        rmq.create(generateRandomData(100, 3));
+        
+        for (int i = 0; i < 10; ++i) {
+            rmq.update(i, i);
+        }
+        
+        assert(rmq.log().groupsCommitted() == 2);
+        assert(rmq.log().pendingCount() == 2);
+        assert(rmq.log().lastCommitted() == 8);
+        
+        rmq.commit();
+        assert(rmq.log().pendingCount() == 0);
+        assert(rmq.log().lastCommitted() == 10);
+        assert(UpdateLog::readRecords(directory_ + "/updates.log").size() == 10);
+    }
+    
+    void testTornTailDiscarded() {
+        resetDirectory();
+        std::vector<Value> reference = generateRandomData(200, 4);
+        
+        {
+            DurableRMQ rmq(makeBlock(), makeConfig());
+            rmq.create(reference);
+            rmq.update(10, -3000);
+            rmq.update(150, -3001);
+            reference[10] = -3000;
+            reference[150] = -3001;
+            rmq.commit();
+        }
+        
+        // Simulate a crash in the middle of writing the next record
+        {
+            std::ofstream log(directory_ + "/updates.log", std::ios::binary | std::ios::app);
+            const char garbage[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+            log.write(garbage, sizeof(garbage));
+        }
+        
+        DurableRMQ restored(makeBlock(), makeConfig());
+        RecoveryStats stats = restored.recover();
+        
+        assert(stats.replayed_updates == 2);
+        assert(stats.discarded_bytes == 10);
+        assert(std::filesystem::file_size(directory_ + "/updates.log") == 2 * UpdateLog::RECORD_BYTES);
+        verifyAgainst(restored, reference);
+    }
+    
+    void testFailedCommitRolledBack() {
+#if !defined(_WIN32)
+        resetDirectory();
+        std::filesystem::create_directories(directory_);
+        std::string path = directory_ + "/updates.log";
+        
+        UpdateLog log(100, false);
+        log.open(path);
+        log.append(1, 10);
+        log.append(2, 20);
+        log.commit();
+        
+        // A file size limit lets only part of the next group reach the disk
+        struct rlimit saved;
+        getrlimit(RLIMIT_FSIZE, &saved);
+        struct rlimit limited = saved;
+        limited.rlim_cur = 2 * UpdateLog::RECORD_BYTES + 10;
+        void (*saved_handler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &limited);
+        
+        log.append(3, 30);
+        log.append(4, 40);
+        bool exception_thrown = false;
+        try {
+            log.commit();
+        } catch (const AlgorithmException&) {
+            exception_thrown = true;
+        }
+        
+        setrlimit(RLIMIT_FSIZE, &saved);
+        std::signal(SIGXFSZ, saved_handler);
+        assert(exception_thrown);
+        
+        // The torn group is cut off and stays pending
+        assert(log.isOpen());
+        assert(log.pendingCount() == 2);
+        assert(log.lastCommitted() == 2);
+        assert(std::filesystem::file_size(path) == 2 * UpdateLog::RECORD_BYTES);
+        
+        // The retry and every later group are recovered
+        log.commit();
+        log.append(5, 50);
+        log.commit();
+        std::vector<UpdateLogRecord> records = UpdateLog::readRecords(path);
+        assert(records.size() == 5);
+        for (size_t i = 0; i < records.size(); ++i) {
+            assert(records[i].sequence == i + 1);
+            assert(records[i].value == static_cast<Value>(10 * (i + 1)));
+        }
+#endif
+    }
+    
+    void testCheckpointReplaysOnlyTail() {
+        resetDirectory();
+        std::vector<Value> reference = generateRandomData(500, 5);
+        
+        {
+            DurableRMQ rmq(makeBlock(), makeConfig());
+            rmq.create(reference);
+            for (int i = 0; i < 20; ++i) {
+                rmq.update(i * 3, -i);
+                reference[i * 3] = -i;
+            }
+            rmq.checkpoint();
+            assert(rmq.checkpointSequence() == 20);
+            assert(UpdateLog::readRecords(directory_ + "/updates.log").empty());
+            
+            for (int i = 0; i < 5; ++i) {
+                rmq.update(400 + i, -100 - i);
+                reference[400 + i] = -100 - i;
+            }
+            rmq.commit();
+        }
+        
+        DurableRMQ restored(makeBlock(), makeConfig());
+        RecoveryStats stats = restored.recover();
+        
+        assert(stats.checkpoint_sequence == 20);
+        assert(stats.replayed_updates == 5);
+        assert(restored.lastSequence() == 25);
+        verifyAgainst(restored, reference);
+    }
+    
+    void testAutomaticCheckpoint() {
+        resetDirectory();
+        DurableRMQ rmq(makeBlock(), makeConfig().withCheckpointInterval(8));
+        rmq.create(generateRandomData(100, 6));
+        
+        for (int i = 0; i < 20; ++i) {
+            rmq.update(i, -i);
+        }
+        
+        assert(rmq.checkpointSequence() == 16);
+        assert(rmq.log().lastSequence() == 20);
+    }
+    
+    void testBinaryIndexRoundTrip() {
+        std::vector<Value> data = generateRandomData(1000, 7);
+        AlgorithmConfig config;
+        config.withBlockSize(32);
+        
+        RMQBlockDecomposition original(config);
+        original.preprocess(data);
+        original.update(500, -9999);
+        
+        std::stringstream buffer(std::ios::in | std::ios::out | std::ios::binary);
+        original.saveIndex(buffer);
+        
+        RMQBlockDecomposition loaded;
+        loaded.loadIndex(buffer);
+        assert(loaded.isPreprocessed());
+        assert(loaded.size() == data.size());
+        assert(loaded.getBlockSize() == 32);
+        
+        std::mt19937 gen(8);
+        std::uniform_int_distribution<size_t> index_dist(0, data.size() - 1);
+        for (int i = 0; i < 300; ++i) {
+            size_t left = index_dist(gen);
+            size_t right = index_dist(gen);
+            if (left > right) std::swap(left, right);
+            assert(loaded.queryDetailed(left, right).minimum_index ==
+                   original.queryDetailed(left, right).minimum_index);
+        }
+        
+        // An index written by another algorithm is rejected
+        buffer.clear();
+        buffer.seekg(0);
+        RMQNaive naive;
+        bool exception_thrown = false;
+        try {
+            naive.loadIndex(buffer);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(!naive.isPreprocessed());
+        
+        // Truncated input is rejected
+        std::string bytes = buffer.str();
+        std::stringstream truncated(bytes.substr(0, bytes.size() / 2), std::ios::in | std::ios::binary);
+        exception_thrown = false;
+        try {
+            loaded.loadIndex(truncated);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(!loaded.isPreprocessed());
+        
+        // The last bytes are the minimum index of the last block (992..999);
+        // one outside the block or not at the block minimum is rejected
+        Index last_min = original.queryDetailed(992, 999).minimum_index;
+        for (Index corrupt : {Index(0), last_min == 999 ? Index(998) : Index(999)}) {
+            std::string edited = bytes;
+            std::memcpy(&edited[edited.size() - sizeof(Index)], &corrupt, sizeof(Index));
+            std::stringstream corrupted(edited, std::ios::in | std::ios::binary);
+            exception_thrown = false;
+            try {
+                loaded.loadIndex(corrupted);
+            } catch (const InvalidDataException&) {
+                exception_thrown = true;
+            }
+            assert(exception_thrown);
+            assert(!loaded.isPreprocessed());
+        }
+        
+        // So is a consistent entry (index and value agree) that is not the minimum
+        {
+            Index other = last_min == 999 ? Index(998) : Index(999);
+            Value other_value = data[other];
+            std::string edited = bytes;
+            size_t indices_start = edited.size() - 32 * sizeof(Index);
+            std::memcpy(&edited[edited.size() - sizeof(Index)], &other, sizeof(Index));
+            std::memcpy(&edited[indices_start - sizeof(uint64_t) - sizeof(Value)], &other_value, sizeof(Value));
+            std::stringstream corrupted(edited, std::ios::in | std::ios::binary);
+            exception_thrown = false;
+            try {
+                loaded.loadIndex(corrupted);
+            } catch (const InvalidDataException&) {
+                exception_thrown = true;
+            }
+            assert(exception_thrown);
+            assert(!loaded.isPreprocessed());
+        }
+    }
+    
+    void testInvalidUpdateNotLogged() {
+        resetDirectory();
+        // With sync on, create() also fsyncs the checkpoint and its directory
+        DurableRMQ rmq(makeBlock(), makeConfig().withGroupCommit(1).withSync(true));
+        std::vector<Value> data = generateRandomData(100, 9);
+        rmq.create(data);
+        rmq.update(5, -1);
+        
+        bool exception_thrown = false;
+        try {
+            rmq.update(100, -2);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.batchUpdate({{6, -3}, {1000, -4}});
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Neither the bad update nor the valid half of the bad batch was logged or applied
+        rmq.commit();
+        assert(rmq.lastSequence() == 1);
+        assert(UpdateLog::readRecords(directory_ + "/updates.log").size() == 1);
+        assert(rmq.query(6, 6) == data[6]);
+    }
+    
+    void testStaticAlgorithmRejected() {
+        resetDirectory();
+        
+        bool exception_thrown = false;
+        try {
+            DurableRMQ rmq(std::make_unique<RMQSparseTable>(), makeConfig());
+        } catch (const NotSupportedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        RMQSparseTable sparse;
+        sparse.preprocess({3, 1, 2});
+        exception_thrown = false;
+        try {
+            sparse.update(0, 0);
+        } catch (const NotSupportedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        DurableRMQ rmq(makeBlock(), makeConfig());
+        exception_thrown = false;
+        try {
+            rmq.recover();
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Create And Recover", [this]() { testCreateAndRecover(); });
+        runner.runTest("Group Commit", [this]() { testGroupCommit(); });
+        runner.runTest("Torn Tail Discarded", [this]() { testTornTailDiscarded(); });
+        runner.runTest("Checkpoint Replays Only Tail", [this]() { testCheckpointReplaysOnlyTail(); });
+        runner.runTest("Automatic Checkpoint", [this]() { testAutomaticCheckpoint(); });
+        runner.runTest("Binary Index Round Trip", [this]() { testBinaryIndexRoundTrip(); });
+        runner.runTest("Static Algorithm Rejected", [this]() { testStaticAlgorithmRejected(); });
+        runner.runTest("Invalid Update Not Logged", [this]() { testInvalidUpdateNotLogged(); });
+        runner.runTest("Failed Commit Rolled Back", [this]() { testFailedCommitRolledBack(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Durable Update Log Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQDurableTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <chrono>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include "../../include/algorithms/rmq_external.h"
+#include "../../src/algorithms/rmq_external.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+    
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQExternalTest {
+private:
+    const std::string data_path_ = "test_external_data.bin";
+    
+    std::vector<Value> writeRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        
+        RMQExternalMemory::writeDataFile(data_path_, data);
+        return data;
+    }
+    
+public:
+    ~RMQExternalTest() {
+        std::remove(data_path_.c_str());
+    }
+    
+    void testBasicFunctionality() {
+        std::vector<Value> data = {3, 1, 4, 1, 5, 9, 2, 6};
+        RMQExternalMemory::writeDataFile(data_path_, data);
+        
+        AlgorithmConfig config;
+        config.withBlockSize(3);
+        RMQExternalMemory rmq(config);
+        rmq.open(data_path_);
+        
+        assert(rmq.size() == 8);
+        assert(rmq.getNumBlocks() == 3);
+        assert(rmq.query(0, 2) == 1);  // min(3, 1, 4) = 1
+        assert(rmq.query(2, 4) == 1);  // min(4, 1, 5) = 1
+        assert(rmq.query(4, 7) == 2);  // min(5, 9, 2, 6) = 2
+        assert(rmq.query(0, 7) == 1);  // min of all = 1
+    }
+    
+    void testCompareWithBruteForce() {
+        const size_t size = 5000;
+        std::vector<Value> data = writeRandomData(size, 11);
+        
+        AlgorithmConfig config;
+        config.withBlockSize(64);
+        RMQExternalMemory rmq(config, 4 * 64 * sizeof(Value));  // Four cached blocks
+        rmq.open(data_path_);
+        
+        std::mt19937 gen(3);
+        std::uniform_int_distribution<size_t> index_dist(0, size - 1);
+        
+        for (int i = 0; i < 500; ++i) {
+            size_t left = index_dist(gen);
+            size_t right = index_dist(gen);
+            if (left > right) std::swap(left, right);
+            
+            Value expected = data[left];
+            Index expected_index = left;
+            for (size_t j = left + 1; j <= right; ++j) {
+                if (data[j] < expected) {
+                    expected = data[j];
+                    expected_index = j;
+                }
+            }
+            
+            QueryResult result = rmq.queryDetailed(left, right);
+            assert(result.minimum_value == expected);
+            assert(result.minimum_index == expected_index);
+        }
+    }
+    
+    void testOnlyPartialBlocksTouchDisk() {
+        writeRandomData(1000, 5);
+        
+        AlgorithmConfig config;
+        config.withBlockSize(100);
+        RMQExternalMemory rmq(config);
+        rmq.open(data_path_);
+        
+        // Block-aligned range: answered entirely from the in-memory index
+        rmq.query(100, 799);
+        assert(rmq.getIOStats().block_reads == 0);
+        
+        // Two partial blocks at the ends
+        rmq.query(150, 649);
+        assert(rmq.getIOStats().block_reads == 2);
+        assert(rmq.getIOStats().cache_misses == 2);
+        
+        // Same blocks again: served from the cache
+        rmq.query(120, 699);
+        ExternalIOStats stats = rmq.getIOStats();
+        assert(stats.block_reads == 2);
+        assert(stats.cache_hits == 1);  // Block 1 hit, block 6 is complete
+        assert(stats.queries == 3);
+    }
+    
+    void testLRUEviction() {
+        writeRandomData(1000, 9);
+        
+        AlgorithmConfig config;
+        config.withBlockSize(100);
+        RMQExternalMemory rmq(config, 2 * 100 * sizeof(Value));  // Two cached blocks
+        rmq.open(data_path_);
+        assert(rmq.getCacheCapacity() == 2);
+        
+        rmq.query(10, 20);   // Block 0
+        rmq.query(110, 120); // Block 1
+        rmq.query(15, 25);   // Block 0 again (hit, now most recent)
+        rmq.query(210, 220); // Block 2 evicts block 1
+        rmq.query(30, 40);   // Block 0 still cached
+        
+        ExternalIOStats stats = rmq.getIOStats();
+        assert(stats.block_reads == 3);
+        assert(stats.cache_hits == 2);
+        assert(stats.evictions == 1);
+        
+        rmq.query(150, 160); // Block 1 was evicted
+        assert(rmq.getIOStats().block_reads == 4);
+    }
+    
+    void testExceptions() {
+        RMQExternalMemory rmq;
+        
+        bool exception_thrown = false;
+        try {
+            rmq.query(0, 0);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.open("missing_external_data.bin");
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        writeRandomData(10, 1);
+        rmq.open(data_path_);
+        
+        exception_thrown = false;
+        try {
+            rmq.query(2, 10);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        assert(rmq.tryQuery(5, 4).status == QueryStatus::INVALID_RANGE);
+        assert(rmq.tryQuery(0, 9).ok());
+    }
+    
+    void testResidentMemory() {
+        writeRandomData(100000, 2);
+        
+        RMQExternalMemory rmq(AlgorithmConfig(), 4 * RMQExternalMemory::DEFAULT_BLOCK_ELEMENTS * sizeof(Value));
+        rmq.open(data_path_);
+        
+        std::mt19937 gen(8);
+        std::uniform_int_distribution<size_t> index_dist(0, 99999);
+        for (int i = 0; i < 200; ++i) {
+            size_t left = index_dist(gen);
+            size_t right = index_dist(gen);
+            if (left > right) std::swap(left, right);
+            rmq.query(left, right);
+        }
+        
+        // Resident memory stays bounded by the cache budget plus the block index
+        assert(rmq.getMemoryUsage() < 100000 * sizeof(Value) / 4);
+        
+        rmq.close();
+        assert(!rmq.isOpen());
+        assert(rmq.getNumBlocks() == 0);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Compare With Brute Force", [this]() { testCompareWithBruteForce(); });
+        runner.runTest("Only Partial Blocks Touch Disk", [this]() { testOnlyPartialBlocksTouchDisk(); });
+        runner.runTest("LRU Eviction", [this]() { testLRUEviction(); });
+        runner.runTest("Exceptions", [this]() { testExceptions(); });
+        runner.runTest("Resident Memory", [this]() { testResidentMemory(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ External Memory Implementation Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQExternalTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
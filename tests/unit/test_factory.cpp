@@ -0,0 +1,480 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include "../../include/factory/rmq_factory.h"
+#include "../../include/algorithms/rmq_naive.h"
+#include "../../include/algorithms/rmq_dp.h"
+#include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_lca.h"
+#include "../../include/algorithms/rmq_stree.h"
+#include "../../include/algorithms/rmq_monotone.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_concurrent.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+#include "../../src/factory/rmq_factory.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQFactoryTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        return data;
+    }
+    
+    /**
+     * @brief Bytes held by a preprocessed algorithm, excluding the object itself
+     */
+    static size_t structureBytes(const IRMQAlgorithm& algorithm) {
+        if (auto* naive = dynamic_cast<const RMQNaive*>(&algorithm)) {
+            return naive->getMemoryUsage() - sizeof(RMQNaive);
+        }
+        if (auto* dp = dynamic_cast<const RMQDynamicProgramming*>(&algorithm)) {
+            return dp->getMemoryUsage() - sizeof(RMQDynamicProgramming);
+        }
+        if (auto* sparse = dynamic_cast<const RMQSparseTable*>(&algorithm)) {
+            return sparse->getMemoryUsage() - sizeof(RMQSparseTable);
+        }
+        if (auto* block = dynamic_cast<const RMQBlockDecomposition*>(&algorithm)) {
+            return block->getMemoryUsage() - sizeof(RMQBlockDecomposition);
+        }
+        if (auto* lca = dynamic_cast<const RMQLCABased*>(&algorithm)) {
+            return lca->getMemoryUsage() - sizeof(RMQLCABased);
+        }
+        if (auto* stree = dynamic_cast<const RMQSTree*>(&algorithm)) {
+            return stree->getMemoryUsage() - sizeof(RMQSTree);
+        }
+        if (auto* runs = dynamic_cast<const RMQMonotoneRuns*>(&algorithm)) {
+            return runs->getMemoryUsage() - sizeof(RMQMonotoneRuns);
+        }
+        return 0;
+    }
+    
+    /**
+     * @brief Build the selection for a budget and check it fits and answers correctly
+     */
+    RMQFactory::BudgetSelection buildWithinBudget(const std::vector<Value>& data, size_t budget,
+                                                  bool requires_updates = false) {
+        RMQFactory::BudgetSelection selection;
+        auto rmq = RMQFactory::createForBudget(data.size(), budget, &selection, requires_updates);
+        rmq->preprocess(data);
+        
+        assert(rmq->getType() == selection.type);
+        assert(selection.predicted_memory_bytes <= budget);
+        assert(predictionMatches(structureBytes(*rmq), selection.predicted_memory_bytes));
+        
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < 200; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq->query(left, right) ==
+                   *std::min_element(data.begin() + left, data.begin() + right + 1));
+        }
+        return selection;
+    }
+
+public:
+    /**
+     * @brief Prediction matches the measured footprint up to fixed bookkeeping
+     */
+    static bool predictionMatches(size_t actual, size_t predicted) {
+        return actual >= predicted && actual - predicted <= 64;
+    }
+    
+    void testMemoryPredictionsAccurate() {
+        std::vector<Value> data = generateRandomData(5000, 1);
+        
+        for (AlgorithmType type : RMQFactory::getAvailableAlgorithms()) {
+            if (type == AlgorithmType::DYNAMIC_PROGRAMMING) continue;
+            auto rmq = RMQFactory::create(type);
+            rmq->preprocess(data);
+            if (type == AlgorithmType::MONOTONE_RUNS) {
+                // Data-dependent: the prediction is the bound for the most runs
+                assert(structureBytes(*rmq) <= RMQFactory::calculateMemoryUsage(type, data.size()));
+                continue;
+            }
+            assert(predictionMatches(structureBytes(*rmq), RMQFactory::calculateMemoryUsage(type, data.size())));
+        }
+        
+        // Alternating data has the most runs, and reaches that bound
+        std::vector<Value> zigzag(data.size());
+        for (size_t i = 0; i < zigzag.size(); ++i) {
+            zigzag[i] = static_cast<Value>(i % 2);
+        }
+        auto runs = RMQFactory::create(AlgorithmType::MONOTONE_RUNS);
+        runs->preprocess(zigzag);
+        assert(predictionMatches(structureBytes(*runs),
+               RMQFactory::calculateMemoryUsage(AlgorithmType::MONOTONE_RUNS, zigzag.size())));
+        
+        // A configured block size changes the prediction accordingly
+        AlgorithmConfig config;
+        config.withBlockSize(500);
+        auto block = RMQFactory::create(AlgorithmType::BLOCK_DECOMPOSITION, config);
+        block->preprocess(data);
+        assert(predictionMatches(structureBytes(*block),
+               RMQFactory::calculateMemoryUsage(AlgorithmType::BLOCK_DECOMPOSITION, data.size(), config)));
+        
+        // So do packed entries and a sparse table level cap
+        AlgorithmConfig packed;
+        packed.withPackedEntries(true);
+        AlgorithmConfig capped;
+        capped.withMaxLevels(6).withPackedEntries(true);
+        for (const AlgorithmConfig& variant : {packed, capped}) {
+            for (AlgorithmType type : {AlgorithmType::SPARSE_TABLE, AlgorithmType::BLOCK_DECOMPOSITION}) {
+                auto rmq = RMQFactory::create(type, variant);
+                rmq->preprocess(data);
+                assert(predictionMatches(structureBytes(*rmq),
+                       RMQFactory::calculateMemoryUsage(type, data.size(), variant)));
+            }
+        }
+        assert(RMQFactory::calculateMemoryUsage(AlgorithmType::SPARSE_TABLE, data.size(), packed) <
+               RMQFactory::calculateMemoryUsage(AlgorithmType::SPARSE_TABLE, data.size()));
+    }
+    
+    void testCreateForData() {
+        std::vector<Value> sorted(5000);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = static_cast<Value>(i / 2);
+        }
+        std::vector<Value> piecewise(sorted);
+        std::reverse(piecewise.begin() + 2000, piecewise.begin() + 3500);
+        std::vector<Value> random = generateRandomData(5000, 5);
+        
+        ShapeAnalysis analysis;
+        auto rmq = RMQFactory::createForData(sorted, 10000, &analysis);
+        assert(rmq->getType() == AlgorithmType::MONOTONE_RUNS);
+        assert(analysis.shape == DataShape::NON_DECREASING);
+        
+        rmq = RMQFactory::createForData(piecewise, 10000, &analysis);
+        assert(rmq->getType() == AlgorithmType::MONOTONE_RUNS);
+        assert(analysis.shape == DataShape::PIECEWISE_MONOTONE);
+        rmq->preprocess(piecewise);
+        assert(rmq->query(1000, 4000) == *std::min_element(piecewise.begin() + 1000, piecewise.begin() + 4001));
+        
+        // Arbitrary data goes to the general structures
+        rmq = RMQFactory::createForData(random, 10000, &analysis);
+        assert(analysis.shape == DataShape::GENERAL);
+        assert(rmq->getType() == RMQFactory::recommendAlgorithm(random.size(), 10000));
+    }
+    
+    void testAmpleBudgetPicksFastest() {
+        std::vector<Value> small = generateRandomData(200, 2);
+        assert(buildWithinBudget(small, 1 << 30).type == AlgorithmType::DYNAMIC_PROGRAMMING);
+        
+        std::vector<Value> large = generateRandomData(20000, 3);
+        assert(buildWithinBudget(large, 1 << 30).type == AlgorithmType::SPARSE_TABLE);
+    }
+    
+    void testDegradesWithBudget() {
+        std::vector<Value> data = generateRandomData(20000, 4);
+        const size_t n = data.size();
+        
+        size_t sparse = RMQFactory::calculateMemoryUsage(AlgorithmType::SPARSE_TABLE, n);
+        size_t stree = RMQFactory::calculateMemoryUsage(AlgorithmType::S_TREE, n);
+        size_t lca = RMQFactory::calculateMemoryUsage(AlgorithmType::LCA_BASED, n);
+        size_t block = RMQFactory::calculateMemoryUsage(AlgorithmType::BLOCK_DECOMPOSITION, n);
+        size_t data_bytes = n * sizeof(Value);
+        assert(block < stree && stree < lca && lca < sparse);
+        
+        assert(buildWithinBudget(data, sparse).type == AlgorithmType::SPARSE_TABLE);
+        assert(buildWithinBudget(data, sparse - 1).type == AlgorithmType::S_TREE);
+        assert(buildWithinBudget(data, stree).type == AlgorithmType::S_TREE);
+        assert(buildWithinBudget(data, stree - 1).type == AlgorithmType::BLOCK_DECOMPOSITION);
+        
+        // Below the sqrt(n) summary, blocks grow to fit
+        auto tuned = buildWithinBudget(data, block - 1);
+        assert(tuned.type == AlgorithmType::BLOCK_DECOMPOSITION);
+        assert(tuned.config.block_size > static_cast<size_t>(std::sqrt(n)) + 1);
+        
+        auto tight = buildWithinBudget(data, data_bytes + 10 * (sizeof(Value) + sizeof(Index)));
+        assert(tight.type == AlgorithmType::BLOCK_DECOMPOSITION);
+        assert(tight.config.block_size == n / 10);
+        
+        assert(buildWithinBudget(data, data_bytes).type == AlgorithmType::NAIVE);
+    }
+    
+    void testRequiresUpdates() {
+        std::vector<Value> data = generateRandomData(20000, 5);
+        auto selection = buildWithinBudget(data, 1 << 30, true);
+        assert(selection.type == AlgorithmType::BLOCK_DECOMPOSITION);
+        assert(RMQFactory::supportsFeature(selection.type, "update"));
+        
+        assert(buildWithinBudget(data, data.size() * sizeof(Value), true).type == AlgorithmType::NAIVE);
+    }
+    
+    void testBudgetAboveDefaultMaxSize() {
+        // Larger than constants::MAX_ARRAY_SIZE, which the selection must lift
+        std::vector<Value> data = generateRandomData(constants::MAX_ARRAY_SIZE + 100000, 6);
+        const size_t n = data.size();
+        
+        size_t stree = RMQFactory::calculateMemoryUsage(AlgorithmType::S_TREE, n);
+        auto selection = buildWithinBudget(data, stree);
+        assert(selection.type == AlgorithmType::S_TREE);
+        assert(selection.config.max_array_size >= n);
+        
+        auto updatable = buildWithinBudget(data, size_t(1) << 30, true);
+        assert(updatable.type == AlgorithmType::BLOCK_DECOMPOSITION);
+        
+        // A higher limit in the base configuration is kept
+        AlgorithmConfig config;
+        config.withMaxArraySize(4 * n);
+        assert(RMQFactory::selectForBudget(n, stree, false, config).config.max_array_size == 4 * n);
+    }
+    
+    void testBudgetTooSmall() {
+        bool exception_thrown = false;
+        try {
+            RMQFactory::createForBudget(1000, 1000 * sizeof(Value) - 1);
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    /**
+     * @brief Queries of a fixed length at random positions, with a share of updates
+     */
+    std::vector<WorkloadOperation> makeTrace(size_t n, size_t count, size_t length,
+                                             double update_fraction, int seed) {
+        std::vector<WorkloadOperation> trace;
+        std::mt19937 gen(seed);
+        std::uniform_real_distribution<> coin(0.0, 1.0);
+        std::uniform_int_distribution<size_t> position(0, n - length);
+        std::uniform_int_distribution<Value> value(-1000, 1000);
+        
+        for (size_t i = 0; i < count; ++i) {
+            size_t left = position(gen);
+            if (coin(gen) < update_fraction) {
+                trace.push_back(WorkloadOperation::update(left, value(gen)));
+            } else {
+                trace.push_back(WorkloadOperation::query(left, left + length - 1));
+            }
+        }
+        return trace;
+    }
+    
+    void testWorkloadStats() {
+        std::vector<WorkloadOperation> trace = {
+            WorkloadOperation::query(0, 0),
+            WorkloadOperation::query(10, 13),
+            WorkloadOperation::query(0, 999),
+            WorkloadOperation::update(5, 42)
+        };
+        
+        WorkloadStats stats = WorkloadStats::fromTrace(trace);
+        assert(stats.queries == 3);
+        assert(stats.updates == 1);
+        assert(stats.readFraction() == 0.75);
+        assert(stats.meanRangeLength() == (1.0 + 4.0 + 1000.0) / 3.0);
+        assert(stats.length_histogram[0] == 1);
+        assert(stats.length_histogram[2] == 1);
+        assert(stats.length_histogram[9] == 1);
+        
+        // A synthesized trace keeps the mix and the length buckets
+        WorkloadStats long_ranges = WorkloadStats::fromTrace(makeTrace(5000, 2000, 3000, 0.25, 1));
+        std::vector<WorkloadOperation> synthesized = synthesizeTrace(long_ranges, 5000, 4000);
+        assert(synthesized.size() == 4000);
+        
+        WorkloadStats replayed = WorkloadStats::fromTrace(synthesized);
+        assert(std::abs(replayed.readFraction() - long_ranges.readFraction()) < 0.05);
+        for (const auto& op : synthesized) {
+            assert(op.left <= op.right && op.right < 5000);
+            if (op.kind == OperationKind::QUERY) {
+                assert(WorkloadStats::lengthBucket(op.right - op.left + 1) == 11);
+            }
+        }
+        
+        // Without observed queries there are no lengths to sample from
+        WorkloadStats updates_only = WorkloadStats::fromTrace(makeTrace(100, 50, 10, 1.0, 2));
+        assert(updates_only.queries == 0);
+        for (const auto& op : synthesizeTrace(updates_only, 100, 200)) {
+            assert(op.kind == OperationKind::UPDATE && op.left < 100);
+        }
+        for (const auto& op : synthesizeTrace(WorkloadStats(), 100, 200)) {
+            assert(op.kind == OperationKind::QUERY && op.left <= op.right && op.right < 100);
+        }
+    }
+    
+    void testLongScansPickConstantQuery() {
+        std::vector<Value> data = generateRandomData(20000, 6);
+        auto trace = makeTrace(data.size(), 2000, 15000, 0.0, 2);
+        
+        auto selection = RMQFactory::selectForWorkload(data, trace, 0,
+                                                       std::numeric_limits<size_t>::max(), 5.0);
+        assert(selection.type == AlgorithmType::SPARSE_TABLE);
+        assert(selection.ops_per_second > 0);
+        assert(selection.memory_bytes == RMQFactory::calculateMemoryUsage(AlgorithmType::SPARSE_TABLE, data.size()));
+        assert(selection.candidates.size() == RMQFactory::getAvailableAlgorithms().size());
+        
+        // DP is skipped above its size cut-off
+        for (const auto& candidate : selection.candidates) {
+            assert(candidate.measured == (candidate.type != AlgorithmType::DYNAMIC_PROGRAMMING));
+            assert(candidate.rebuilds == 0);
+        }
+    }
+    
+    void testUpdateHeavyPicksUpdatable() {
+        std::vector<Value> data = generateRandomData(20000, 7);
+        auto trace = makeTrace(data.size(), 400, 16, 0.5, 3);
+        
+        auto selection = RMQFactory::selectForWorkload(data, trace, 0,
+                                                       std::numeric_limits<size_t>::max(), 5.0);
+        assert(RMQFactory::supportsFeature(selection.type, "update"));
+        
+        for (const auto& candidate : selection.candidates) {
+            if (candidate.type == AlgorithmType::SPARSE_TABLE) {
+                assert(candidate.rebuilds > 0);
+            }
+        }
+    }
+    
+    void testWorkloadRespectsBudget() {
+        std::vector<Value> data = generateRandomData(5000, 8);
+        auto trace = makeTrace(data.size(), 1000, 4000, 0.0, 4);
+        
+        // Memory is predicted for the full array, not the sample
+        const size_t full_size = 1000000;
+        size_t budget = RMQFactory::calculateMemoryUsage(AlgorithmType::SPARSE_TABLE, full_size) - 1;
+        auto selection = RMQFactory::selectForWorkload(data, trace, full_size, budget, 2.0);
+        
+        assert(selection.type != AlgorithmType::SPARSE_TABLE);
+        assert(selection.memory_bytes <= budget);
+        for (const auto& candidate : selection.candidates) {
+            if (candidate.type == AlgorithmType::SPARSE_TABLE) {
+                assert(!candidate.measured);
+            }
+        }
+        
+        bool exception_thrown = false;
+        try {
+            RMQFactory::selectForWorkload(data, trace, full_size, 1000, 2.0);
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void testSelectionFromStats() {
+        std::vector<Value> data = generateRandomData(20000, 9);
+        
+        // A trace recorded on the full array is scaled to the sample
+        WorkloadStats stats;
+        for (const auto& op : makeTrace(200000, 1000, 150000, 0.0, 5)) {
+            stats.record(op);
+        }
+        auto selection = RMQFactory::selectForWorkload(data, stats, 2000, 200000,
+                                                       std::numeric_limits<size_t>::max(), 5.0);
+        assert(selection.type != AlgorithmType::NAIVE);
+        assert(selection.memory_bytes == RMQFactory::calculateMemoryUsage(selection.type, 200000));
+        
+        auto scaled = RMQFactory::selectForWorkload(data, makeTrace(200000, 1000, 150000, 0.0, 5), 0,
+                                                    std::numeric_limits<size_t>::max(), 5.0);
+        assert(scaled.type != AlgorithmType::NAIVE);
+        
+        bool exception_thrown = false;
+        try {
+            RMQFactory::selectForWorkload(data, std::vector<WorkloadOperation>());
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Memory Predictions Accurate", [this]() { testMemoryPredictionsAccurate(); });
+        runner.runTest("Create For Data", [this]() { testCreateForData(); });
+        runner.runTest("Ample Budget Picks Fastest", [this]() { testAmpleBudgetPicksFastest(); });
+        runner.runTest("Degrades With Budget", [this]() { testDegradesWithBudget(); });
+        runner.runTest("Requires Updates", [this]() { testRequiresUpdates(); });
+        runner.runTest("Budget Above Default Max Size", [this]() { testBudgetAboveDefaultMaxSize(); });
+        runner.runTest("Budget Too Small", [this]() { testBudgetTooSmall(); });
+        runner.runTest("Workload Stats", [this]() { testWorkloadStats(); });
+        runner.runTest("Long Scans Pick Constant Query", [this]() { testLongScansPickConstantQuery(); });
+        runner.runTest("Update Heavy Picks Updatable", [this]() { testUpdateHeavyPicksUpdatable(); });
+        runner.runTest("Workload Respects Budget", [this]() { testWorkloadRespectsBudget(); });
+        runner.runTest("Selection From Stats", [this]() { testSelectionFromStats(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Factory Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQFactoryTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
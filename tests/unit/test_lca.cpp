@@ -10,6 +10,7 @@
 #include "../../include/algorithms/rmq_lca.h"
 #include "../../include/algorithms/rmq_naive.h"
 #include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
 #include "../../src/algorithms/rmq_lca.cpp"
 #include "../../src/algorithms/rmq_naive.cpp"
 
@@ -0,0 +1,288 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include "../../include/algorithms/rmq_monotone.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQMonotoneRunsTest {
+private:
+    /**
+     * @brief Runs of random length and direction, with repeated values
+     */
+    std::vector<Value> generatePiecewise(size_t size, size_t min_run, size_t max_run, int seed) {
+        std::vector<Value> data;
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> run_length(min_run, max_run);
+        std::uniform_int_distribution<Value> step(0, 3);
+        std::uniform_int_distribution<Value> jump(-1000, 1000);
+        Value value = 0;
+        bool falling = false;
+        while (data.size() < size) {
+            size_t length = std::min(run_length(gen), size - data.size());
+            value += jump(gen);
+            for (size_t i = 0; i < length; ++i) {
+                value += falling ? -step(gen) : step(gen);
+                data.push_back(value);
+            }
+            falling = !falling;
+        }
+        return data;
+    }
+    
+    std::vector<Value> generateRandomData(size_t size, Value low, Value high, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> dis(low, high);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    Value naiveMin(const std::vector<Value>& data, size_t left, size_t right) {
+        return *std::min_element(data.begin() + left, data.begin() + right + 1);
+    }
+    
+    Index naiveMinIndex(const std::vector<Value>& data, size_t left, size_t right) {
+        return std::min_element(data.begin() + left, data.begin() + right + 1) - data.begin();
+    }
+    
+    void verifyAllQueries(const RMQMonotoneRuns& rmq, const std::vector<Value>& data) {
+        for (size_t left = 0; left < data.size(); ++left) {
+            for (size_t right = left; right < data.size(); ++right) {
+                assert(rmq.query(left, right) == naiveMin(data, left, right));
+                assert(rmq.queryDetailed(left, right).minimum_index == naiveMinIndex(data, left, right));
+            }
+        }
+    }
+    
+    void verifyRandomQueries(const RMQMonotoneRuns& rmq, const std::vector<Value>& data, int queries, int seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < queries; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq.query(left, right) == naiveMin(data, left, right));
+            assert(rmq.queryDetailed(left, right).minimum_index == naiveMinIndex(data, left, right));
+        }
+    }
+
+public:
+    void testBasicFunctionality() {
+        RMQMonotoneRuns rmq;
+        std::vector<Value> data = {1, 3, 5, 7, 6, 4, 2, 8, 9};
+        rmq.preprocess(data);
+        
+        assert(rmq.getRunCount() == 3);
+        assert(rmq.query(0, 8) == 1);
+        assert(rmq.query(2, 5) == 4);
+        assert(rmq.query(4, 7) == 2);
+        assert(rmq.query(3, 3) == 7);
+        assert(rmq.getName() == "Monotone Runs");
+        assert(rmq.getType() == AlgorithmType::MONOTONE_RUNS);
+        assert(!rmq.supportsUpdate());
+        verifyAllQueries(rmq, data);
+    }
+    
+    void testShapeDetection() {
+        std::vector<Value> sorted(1000);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = static_cast<Value>(i / 3);
+        }
+        std::vector<Value> reversed(sorted.rbegin(), sorted.rend());
+        std::vector<Value> constant(1000, 42);
+        std::vector<Value> piecewise = generatePiecewise(1000, 50, 100, 1);
+        std::vector<Value> random = generateRandomData(1000, 0, 1000, 2);
+        
+        assert(RMQMonotoneRuns::analyze(sorted).shape == DataShape::NON_DECREASING);
+        assert(RMQMonotoneRuns::analyze(reversed).shape == DataShape::NON_INCREASING);
+        assert(RMQMonotoneRuns::analyze(constant).shape == DataShape::CONSTANT);
+        assert(RMQMonotoneRuns::analyze(piecewise).shape == DataShape::PIECEWISE_MONOTONE);
+        assert(RMQMonotoneRuns::analyze(random).shape == DataShape::GENERAL);
+        assert(RMQMonotoneRuns::analyze({}).runs == 0);
+        assert(RMQMonotoneRuns::analyze({5}).shape == DataShape::CONSTANT);
+        
+        // Leading and trailing equal stretches join the run
+        ShapeAnalysis plateau = RMQMonotoneRuns::analyze({4, 4, 3, 2, 2, 1, 1});
+        assert(plateau.shape == DataShape::NON_INCREASING);
+        assert(plateau.runs == 1);
+        
+        RMQMonotoneRuns rmq;
+        rmq.preprocess(piecewise);
+        assert(rmq.getShape() == DataShape::PIECEWISE_MONOTONE);
+        assert(rmq.getRunCount() == RMQMonotoneRuns::analyze(piecewise).runs);
+        assert(dataShapeToString(rmq.getShape()) == "piecewise monotone");
+    }
+    
+    void testMatchesNaive() {
+        // Every shape, including arbitrary data and ties
+        std::vector<std::vector<Value>> inputs = {
+            {7},
+            {2, 2, 2, 2},
+            {1, 2, 2, 3, 3, 3, 4},
+            {4, 3, 3, 2, 2, 2, 1},
+            {1, 0, 1, 0, 1, 0, 1},
+            {5, 5, 1, 1, 5, 5, 1, 1},
+            generatePiecewise(300, 1, 8, 3),
+            generatePiecewise(300, 20, 40, 4),
+            generateRandomData(300, 0, 5, 5),
+            generateRandomData(300, -1000, 1000, 6)
+        };
+        for (const auto& data : inputs) {
+            RMQMonotoneRuns rmq;
+            rmq.preprocess(data);
+            verifyAllQueries(rmq, data);
+        }
+        
+        std::vector<Value> large = generatePiecewise(200000, 100, 5000, 7);
+        RMQMonotoneRuns rmq;
+        rmq.preprocess(large);
+        verifyRandomQueries(rmq, large, 5000, 8);
+    }
+    
+    void testFallingRunTies() {
+        // The minimum of a falling run is the start of its last equal stretch
+        RMQMonotoneRuns rmq;
+        std::vector<Value> data = {9, 5, 5, 5, 3, 3, 3, 8, 3, 3};
+        rmq.preprocess(data);
+        
+        assert(rmq.queryDetailed(0, 6).minimum_index == 4);
+        assert(rmq.queryDetailed(1, 3).minimum_index == 1);
+        assert(rmq.queryDetailed(5, 9).minimum_index == 5);
+        assert(rmq.queryDetailed(0, 9).minimum_index == 4);
+        assert(rmq.queryDetailed(7, 9).minimum_index == 8);
+        verifyAllQueries(rmq, data);
+    }
+    
+    void testMemoryUsage() {
+        std::vector<Value> sorted(100000);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            sorted[i] = static_cast<Value>(i);
+        }
+        
+        // One run: the data plus a few words
+        RMQMonotoneRuns rmq;
+        rmq.preprocess(sorted);
+        size_t data_bytes = sorted.size() * sizeof(Value);
+        assert(rmq.getRunCount() == 1);
+        assert(rmq.getMemoryUsage() - sizeof(RMQMonotoneRuns) - data_bytes <= 64);
+        
+        // Few runs: a small table over them
+        std::vector<Value> piecewise = generatePiecewise(100000, 1000, 2000, 9);
+        rmq.preprocess(piecewise);
+        assert(rmq.getMemoryUsage() - sizeof(RMQMonotoneRuns) - data_bytes < data_bytes / 10);
+        
+        // Only the data vector's capacity survives clear()
+        rmq.clear();
+        assert(rmq.getMemoryUsage() <= sizeof(RMQMonotoneRuns) + data_bytes);
+        assert(rmq.getRunCount() == 0);
+        assert(!rmq.isPreprocessed());
+    }
+    
+    void testErrors() {
+        RMQMonotoneRuns rmq;
+        
+        bool exception_thrown = false;
+        try {
+            rmq.query(0, 0);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        rmq.preprocess(generatePiecewise(100, 10, 20, 10));
+        
+        exception_thrown = false;
+        try {
+            rmq.query(0, 100);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.update(0, 1);
+        } catch (const NotSupportedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Shape Detection", [this]() { testShapeDetection(); });
+        runner.runTest("Matches Naive", [this]() { testMatchesNaive(); });
+        runner.runTest("Falling Run Ties", [this]() { testFallingRunTies(); });
+        runner.runTest("Memory Usage", [this]() { testMemoryUsage(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Monotone Runs Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQMonotoneRunsTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include "../../include/algorithms/rmq_naive.h"
 #include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
 #include "../../src/algorithms/rmq_naive.cpp"
 
 using namespace rmq;
@@ -188,6 +189,44 @@ public:
         assert(exception_thrown);
     }
     
+    void testNoThrowQuery() {
+        RMQNaive fresh_rmq;
+        assert(fresh_rmq.tryQuery(0, 0).status == QueryStatus::NOT_PREPROCESSED);
+        
+        std::vector<Value> data = {7, 2, 5, 2, 9, 1, 3};
+        rmq_->preprocess(data);
+        
+        QueryOutcome outcome = rmq_->tryQuery(0, 3);
+        assert(outcome.ok());
+        assert(outcome.value == 2);
+        
+        outcome = rmq_->tryQueryDetailed(1, 4);
+        assert(outcome.ok());
+        assert(outcome.value == 2);
+        assert(outcome.index == 1);
+        
+        assert(rmq_->tryQuery(3, 2).status == QueryStatus::INVALID_RANGE);
+        assert(rmq_->tryQuery(2, 7).status == QueryStatus::OUT_OF_BOUNDS);
+        assert(!rmq_->tryQueryDetailed(2, 100));
+    }
+    
+    void testNoThrowBatchQuery() {
+        std::vector<Value> data = {3, 1, 4, 1, 5, 9, 2, 6};
+        rmq_->preprocess(data);
+        
+        std::vector<Query> queries = {{0, 2}, {5, 3}, {4, 7}, {6, 8}, {0, 7}};
+        std::vector<QueryOutcome> results(queries.size());
+        
+        Size succeeded = rmq_->tryQueryBatch(queries.data(), queries.size(), results.data());
+        
+        assert(succeeded == 3);
+        assert(results[0].ok() && results[0].value == 1);
+        assert(results[1].status == QueryStatus::INVALID_RANGE);
+        assert(results[2].ok() && results[2].value == 2);
+        assert(results[3].status == QueryStatus::OUT_OF_BOUNDS);
+        assert(results[4].ok() && results[4].value == 1);
+    }
+    
     void testUpdate() {
         std::vector<Value> data = {3, 1, 4, 1, 5};
         rmq_->preprocess(data);
@@ -282,6 +321,38 @@ public:
         assert(configured_rmq.getConfig().track_statistics == true);
     }
     
+    void testMaxArraySize() {
+        // Default limit rejects arrays above MAX_ARRAY_SIZE
+        std::vector<Value> large_data(constants::MAX_ARRAY_SIZE + 1, 7);
+        large_data.back() = 3;
+        bool exception_thrown = false;
+        try {
+            rmq_->preprocess(large_data);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // A raised limit accepts them
+        AlgorithmConfig config;
+        config.withMaxArraySize(2 * constants::MAX_ARRAY_SIZE);
+        RMQNaive large_rmq(config);
+        large_rmq.preprocess(large_data);
+        assert(large_rmq.query(0, large_data.size() - 1) == 3);
+        
+        // A lowered limit rejects small arrays
+        AlgorithmConfig small_config;
+        small_config.withMaxArraySize(4);
+        RMQNaive small_rmq(small_config);
+        exception_thrown = false;
+        try {
+            small_rmq.preprocess({5, 4, 3, 2, 1});
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
     void runAllTests(TestRunner& runner) {
         runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
         runner.runTest("Single Element", [this]() { testSingleElement(); });
@@ -294,12 +365,15 @@ public:
         runner.runTest("Not Preprocessed Exception", [this]() { testNotPreprocessedException(); });
         runner.runTest("Invalid Query Range", [this]() { testInvalidQueryRange(); });
         runner.runTest("Out of Bounds Query", [this]() { testOutOfBoundsQuery(); });
+        runner.runTest("No-Throw Query", [this]() { testNoThrowQuery(); });
+        runner.runTest("No-Throw Batch Query", [this]() { testNoThrowBatchQuery(); });
         runner.runTest("Update Single Element", [this]() { testUpdate(); });
         runner.runTest("Batch Update", [this]() { testBatchUpdate(); });
         runner.runTest("Complexity Info", [this]() { testComplexityInfo(); });
         runner.runTest("Memory Usage", [this]() { testMemoryUsage(); });
         runner.runTest("Large Dataset", [this]() { testLargeDataset(); });
         runner.runTest("Configuration", [this]() { testConfiguration(); });
+        runner.runTest("Max Array Size", [this]() { testMaxArraySize(); });
     }
 };
 
@@ -0,0 +1,316 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include "../../include/adaptive/rmq_overlay.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_block_concurrent.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_monotone.cpp"
+#include "../../src/factory/rmq_factory.cpp"
+#include "../../src/adaptive/rmq_overlay.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQOverlayTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, Value low, Value high, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> dis(low, high);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    Index naiveMinIndex(const std::vector<Value>& data, size_t left, size_t right) {
+        return std::min_element(data.begin() + left, data.begin() + right + 1) - data.begin();
+    }
+    
+    /**
+     * @brief Mixed updates and queries, checking value and index against a plain scan
+     */
+    void runPhase(OverlayRMQ& rmq, std::vector<Value>& reference, size_t operations,
+                  double update_fraction, Value low, Value high, std::mt19937& gen) {
+        const size_t n = reference.size();
+        std::uniform_real_distribution<> coin(0.0, 1.0);
+        std::uniform_int_distribution<size_t> position(0, n - 1);
+        std::uniform_int_distribution<Value> value(low, high);
+        
+        for (size_t i = 0; i < operations; ++i) {
+            size_t left = position(gen);
+            if (coin(gen) < update_fraction) {
+                Value v = value(gen);
+                rmq.update(left, v);
+                reference[left] = v;
+            } else {
+                size_t right = position(gen);
+                if (left > right) std::swap(left, right);
+                Index expected = naiveMinIndex(reference, left, right);
+                assert(rmq.query(left, right) == reference[expected]);
+                assert(rmq.queryIndex(left, right) == expected);
+            }
+        }
+    }
+
+public:
+    void testBasicFunctionality() {
+        OverlayRMQ rmq(AlgorithmType::SPARSE_TABLE, OverlayConfig().withMergeThreshold(100));
+        std::vector<Value> data = {5, 2, 8, 1, 9, 3, 7};
+        rmq.preprocess(data);
+        assert(rmq.baseType() == AlgorithmType::SPARSE_TABLE);
+        assert(rmq.size() == 7);
+        assert(rmq.query(0, 6) == 1);
+        
+        // Decrease: the overlay entry wins
+        rmq.update(4, 0);
+        assert(rmq.query(0, 6) == 0);
+        assert(rmq.queryIndex(0, 6) == 4);
+        assert(rmq.query(0, 3) == 1);
+        
+        // Increase the static minimum: the next smallest is found around it
+        rmq.update(3, 10);
+        assert(rmq.query(0, 3) == 2);
+        assert(rmq.queryIndex(0, 3) == 1);
+        assert(rmq.query(3, 3) == 10);
+        assert(rmq.query(5, 6) == 3);
+        assert(rmq.overlaySize() == 2);
+        assert(rmq.stats().merges == 0);
+    }
+    
+    void testIncreasesRepaired() {
+        // Sorted data: raising the front moves every prefix minimum right
+        std::vector<Value> data(1000);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<Value>(i);
+        }
+        OverlayRMQ rmq(AlgorithmType::SPARSE_TABLE, OverlayConfig().withMergeThreshold(1000));
+        rmq.preprocess(data);
+        
+        for (size_t i = 0; i < 10; ++i) {
+            rmq.update(i, 5000);
+        }
+        assert(rmq.query(0, 999) == 10);
+        assert(rmq.queryIndex(0, 999) == 10);
+        assert(rmq.query(0, 9) == 5000);
+        assert(rmq.queryIndex(0, 9) == 0);
+        assert(rmq.stats().repair_probes > 0);
+        
+        // Decreases never need a second static query
+        Size probes = rmq.stats().repair_probes;
+        rmq.update(500, -1);
+        assert(rmq.query(20, 999) == -1);
+        assert(rmq.stats().repair_probes == probes);
+        
+        // Ties resolve to the leftmost position
+        rmq.update(300, -1);
+        assert(rmq.queryIndex(0, 999) == 300);
+        rmq.update(200, 20);
+        assert(rmq.queryIndex(20, 250) == 20);
+    }
+    
+    void testMatchesScan() {
+        std::vector<AlgorithmType> bases = {
+            AlgorithmType::SPARSE_TABLE,
+            AlgorithmType::LCA_BASED,
+            AlgorithmType::DYNAMIC_PROGRAMMING,
+            AlgorithmType::S_TREE,
+            AlgorithmType::BLOCK_DECOMPOSITION
+        };
+        int seed = 1;
+        for (AlgorithmType base : bases) {
+            std::vector<Value> data = generateRandomData(500, 0, 20, seed);
+            OverlayRMQ rmq(base, OverlayConfig().withMergeThreshold(40).withBackground(false));
+            rmq.preprocess(data);
+            
+            std::mt19937 gen(seed++);
+            runPhase(rmq, data, 3000, 0.3, 0, 25, gen);
+            assert(rmq.stats().merges > 0);
+            assert(rmq.overlaySize() < 40);
+        }
+    }
+    
+    void testSynchronousMerge() {
+        std::vector<Value> data = generateRandomData(10000, -1000, 1000, 2);
+        OverlayRMQ rmq(AlgorithmType::SPARSE_TABLE, OverlayConfig().withBackground(false));
+        rmq.preprocess(data);
+        assert(rmq.mergeThreshold() == 100);
+        
+        std::vector<std::pair<Index, Value>> updates;
+        for (Index i = 0; i < 99; ++i) {
+            updates.emplace_back(i * 100, -2000);
+            data[i * 100] = -2000;
+        }
+        rmq.batchUpdate(updates);
+        assert(rmq.overlaySize() == 99);
+        
+        // Rewriting a position does not grow the overlay
+        rmq.update(0, -3000);
+        data[0] = -3000;
+        assert(rmq.overlaySize() == 99);
+        assert(rmq.stats().merges == 0);
+        
+        rmq.update(1, -3000);
+        data[1] = -3000;
+        assert(rmq.stats().merges == 1);
+        assert(rmq.overlaySize() == 0);
+        assert(!rmq.mergeInProgress());
+        
+        std::mt19937 gen(3);
+        runPhase(rmq, data, 500, 0.0, 0, 0, gen);
+    }
+    
+    void testBackgroundMergeCatchesUp() {
+        std::vector<Value> data = generateRandomData(200000, -1000, 1000, 4);
+        OverlayRMQ rmq(AlgorithmType::SPARSE_TABLE, OverlayConfig().withMergeThreshold(64));
+        rmq.preprocess(data);
+        
+        // Reach the threshold, then keep writing while the merge is built
+        std::mt19937 gen(5);
+        for (Index i = 0; i < 64; ++i) {
+            rmq.update(i * 3000, 2000);
+            data[i * 3000] = 2000;
+        }
+        assert(rmq.mergeInProgress() || rmq.stats().merges == 1);
+        runPhase(rmq, data, 400, 0.1, -1500, 1500, gen);
+        
+        rmq.waitForMerge();
+        assert(!rmq.mergeInProgress());
+        assert(rmq.stats().merges >= 1);
+        assert(rmq.stats().failed_merges == 0);
+        
+        // Updates made during the build are visible after the swap
+        runPhase(rmq, data, 400, 0.0, 0, 0, gen);
+        for (size_t i = 0; i < data.size(); i += 997) {
+            assert(rmq.query(i, i) == data[i]);
+        }
+    }
+    
+    void testErrors() {
+        OverlayRMQ rmq;
+        
+        bool exception_thrown = false;
+        try {
+            rmq.query(0, 0);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.update(0, 1);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        rmq.preprocess(generateRandomData(100, 0, 10, 6));
+        
+        exception_thrown = false;
+        try {
+            rmq.query(0, 100);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.query(5, 4);
+        } catch (const InvalidQueryException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Nothing applied when one index is out of range
+        exception_thrown = false;
+        try {
+            rmq.batchUpdate({{0, -1}, {100, -1}});
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(rmq.overlaySize() == 0);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Increases Repaired", [this]() { testIncreasesRepaired(); });
+        runner.runTest("Matches Scan", [this]() { testMatchesScan(); });
+        runner.runTest("Synchronous Merge", [this]() { testSynchronousMerge(); });
+        runner.runTest("Background Merge Catches Up", [this]() { testBackgroundMergeCatchesUp(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Update Overlay Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQOverlayTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
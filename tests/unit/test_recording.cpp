@@ -0,0 +1,404 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_naive.h"
+#include "../../include/core/rmq_recording.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/core/rmq_recording.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_naive.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+/**
+ * @brief Recorder that keeps operations in memory
+ */
+class MemoryRecorder : public recording::IRecorder {
+public:
+    std::vector<WorkloadOperation> operations;
+    std::mutex mutex;
+    
+    void recordQuery(Index left, Index right) noexcept override {
+        std::lock_guard<std::mutex> lock(mutex);
+        operations.push_back(WorkloadOperation::query(left, right));
+    }
+    
+    void recordUpdate(Index index, Value value) noexcept override {
+        std::lock_guard<std::mutex> lock(mutex);
+        operations.push_back(WorkloadOperation::update(index, value));
+    }
+};
+
+class RecordingTest {
+private:
+    const std::string recording_path_ = "test_recording.bin";
+    const std::string snapshot_path_ = "test_recording_snapshot.bin";
+    
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000000, 1000000);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    void writeSnapshot(const std::vector<Value>& data) {
+        std::ofstream out(snapshot_path_, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(Value));
+    }
+    
+    static bool sameOperation(const WorkloadOperation& a, const WorkloadOperation& b) {
+        if (a.kind != b.kind || a.left != b.left) return false;
+        return a.kind == OperationKind::QUERY ? a.right == b.right : a.value == b.value;
+    }
+
+public:
+    ~RecordingTest() {
+        std::remove(recording_path_.c_str());
+        std::remove(snapshot_path_.c_str());
+    }
+    
+    void testRoundTrip() {
+        auto data = generateRandomData(1000, 42);
+        std::vector<WorkloadOperation> expected = {
+            WorkloadOperation::query(0, 999),
+            WorkloadOperation::update(17, -2147483647 - 1),
+            WorkloadOperation::query(500, 500),
+            WorkloadOperation::update(999, 2147483647),
+            WorkloadOperation::query(3, 40)
+        };
+        
+        {
+            // A buffer of 2 makes the writer flush in the middle
+            recording::RecordingWriter writer(recording_path_, "snapshots/orders.bin", data, 2);
+            for (const auto& op : expected) {
+                if (op.kind == OperationKind::QUERY) {
+                    writer.recordQuery(op.left, op.right);
+                } else {
+                    writer.recordUpdate(op.left, op.value);
+                }
+            }
+            assert(writer.operationCount() == expected.size());
+            assert(writer.droppedCount() == 0);
+        }
+        
+        recording::Recording trace = recording::readRecording(recording_path_);
+        assert(trace.snapshot == "snapshots/orders.bin");
+        assert(trace.array_size == data.size());
+        assert(trace.checksum == recording::snapshotChecksum(data));
+        assert(trace.operations.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(sameOperation(trace.operations[i].operation, expected[i]));
+            if (i > 0) {
+                assert(trace.operations[i].timestamp_ns >= trace.operations[i - 1].timestamp_ns);
+            }
+        }
+        
+        // The checksum tells arrays apart
+        auto other = data;
+        other[500]++;
+        assert(recording::snapshotChecksum(other) != trace.checksum);
+    }
+    
+    void testHookOnQueryAndUpdate() {
+        auto data = generateRandomData(256, 7);
+        RMQBlockDecomposition rmq;
+        rmq.preprocess(data);
+        
+        MemoryRecorder recorder;
+        rmq.setRecorder(&recorder);
+        assert(rmq.getRecorder() == &recorder);
+        
+        rmq.query(10, 20);
+        rmq.queryDetailed(0, 255);
+        rmq.tryQuery(5, 6);
+        rmq.tryQueryDetailed(7, 8);
+        rmq.update(3, -5);
+        rmq.batchUpdate({{4, 1}, {200, 2}});
+        
+        // Invalid queries are not recorded
+        rmq.tryQuery(9, 300);
+        bool exception_thrown = false;
+        try {
+            rmq.query(20, 10);
+        } catch (const InvalidQueryException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        std::vector<WorkloadOperation> expected = {
+            WorkloadOperation::query(10, 20),
+            WorkloadOperation::query(0, 255),
+            WorkloadOperation::query(5, 6),
+            WorkloadOperation::query(7, 8),
+            WorkloadOperation::update(3, -5),
+            WorkloadOperation::update(4, 1),
+            WorkloadOperation::update(200, 2)
+        };
+        assert(recorder.operations.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(sameOperation(recorder.operations[i], expected[i]));
+        }
+        
+        // Detached: nothing more is recorded
+        rmq.setRecorder(nullptr);
+        rmq.query(0, 1);
+        rmq.update(0, 1);
+        assert(recorder.operations.size() == expected.size());
+    }
+    
+    void testReplayReproducesAnswers() {
+        auto data = generateRandomData(5000, 11);
+        writeSnapshot(data);
+        
+        // Record a mixed workload served by the naive algorithm
+        std::vector<Value> answers;
+        {
+            RMQNaive rmq;
+            rmq.preprocess(data);
+            recording::RecordingWriter writer(recording_path_, snapshot_path_, data);
+            rmq.setRecorder(&writer);
+            
+            std::mt19937 gen(12);
+            std::uniform_int_distribution<Index> position(0, data.size() - 1);
+            for (int i = 0; i < 2000; ++i) {
+                Index a = position(gen);
+                Index b = position(gen);
+                if (i % 5 == 4) {
+                    rmq.update(a, static_cast<Value>(b) - 2500);
+                } else {
+                    answers.push_back(rmq.query(std::min(a, b), std::max(a, b)));
+                }
+            }
+        }
+        
+        // Replay against another algorithm from the referenced snapshot
+        recording::Recording trace = recording::readRecording(recording_path_);
+        auto snapshot = recording::loadSnapshot(trace.snapshot);
+        assert(snapshot == data);
+        assert(recording::snapshotChecksum(snapshot) == trace.checksum);
+        
+        RMQBlockDecomposition replay;
+        replay.preprocess(snapshot);
+        size_t next_answer = 0;
+        for (const auto& recorded : trace.operations) {
+            const WorkloadOperation& op = recorded.operation;
+            if (op.kind == OperationKind::QUERY) {
+                assert(replay.query(op.left, op.right) == answers[next_answer++]);
+            } else {
+                replay.update(op.left, op.value);
+            }
+        }
+        assert(next_answer == answers.size());
+        
+        WorkloadStats stats = WorkloadStats::fromTrace(trace.workload());
+        assert(stats.queries == 1600);
+        assert(stats.updates == 400);
+    }
+    
+    void testCompactFormat() {
+        auto data = generateRandomData(100000, 3);
+        const size_t operations = 10000;
+        {
+            recording::RecordingWriter writer(recording_path_, "snapshot", data);
+            std::mt19937 gen(4);
+            std::uniform_int_distribution<Index> position(0, data.size() - 1024);
+            std::uniform_int_distribution<Index> length(0, 1023);
+            for (size_t i = 0; i < operations; ++i) {
+                Index left = position(gen);
+                writer.recordQuery(left, left + length(gen));
+            }
+        }
+        
+        // A fixed-width record would take 24 bytes
+        std::ifstream in(recording_path_, std::ios::binary | std::ios::ate);
+        size_t bytes = static_cast<size_t>(in.tellg());
+        assert(bytes < operations * 12);
+        assert(recording::readRecording(recording_path_).operations.size() == operations);
+    }
+    
+    void testConcurrentRecording() {
+        auto data = generateRandomData(1000, 5);
+        const int threads = 4;
+        const int per_thread = 5000;
+        {
+            recording::RecordingWriter writer(recording_path_, "snapshot", data, 64);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&writer, t]() {
+                    for (int i = 0; i < per_thread; ++i) {
+                        if (i % 10 == 0) {
+                            writer.recordUpdate(t, i);
+                        } else {
+                            writer.recordQuery(t, t + i % 100);
+                        }
+                    }
+                });
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+            assert(writer.operationCount() == static_cast<Size>(threads * per_thread));
+        }
+        
+        recording::Recording trace = recording::readRecording(recording_path_);
+        assert(trace.operations.size() == static_cast<size_t>(threads * per_thread));
+        for (size_t i = 1; i < trace.operations.size(); ++i) {
+            assert(trace.operations[i].timestamp_ns >= trace.operations[i - 1].timestamp_ns);
+        }
+    }
+    
+    void testTornTailAndErrors() {
+        auto data = generateRandomData(100, 6);
+        {
+            recording::RecordingWriter writer(recording_path_, "snapshot", data);
+            writer.recordQuery(1, 50);
+            writer.recordQuery(2, 60);
+        }
+        
+        // A record cut short is dropped
+        std::ifstream in(recording_path_, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        {
+            std::ofstream out(recording_path_, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), bytes.size() - 1);
+        }
+        assert(recording::readRecording(recording_path_).operations.size() == 1);
+        
+        bool exception_thrown = false;
+        
+        // Not a recording
+        {
+            std::ofstream out(recording_path_, std::ios::binary | std::ios::trunc);
+            out << "not a recording at all";
+        }
+        try {
+            recording::readRecording(recording_path_);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // An operation outside the recorded array
+        {
+            recording::RecordingWriter writer(recording_path_, "snapshot", data);
+            writer.recordQuery(10, 100);
+        }
+        exception_thrown = false;
+        try {
+            recording::readRecording(recording_path_);
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Missing recording and snapshot
+        exception_thrown = false;
+        try {
+            recording::readRecording("no_such_recording.bin");
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            recording::loadSnapshot("no_such_snapshot.bin");
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // Zero buffer
+        exception_thrown = false;
+        try {
+            recording::RecordingWriter writer(recording_path_, "snapshot", data, 0);
+        } catch (const ConfigurationException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Round Trip", [this]() { testRoundTrip(); });
+        runner.runTest("Hook On Query And Update", [this]() { testHookOnQueryAndUpdate(); });
+        runner.runTest("Replay Reproduces Answers", [this]() { testReplayReproducesAnswers(); });
+        runner.runTest("Compact Format", [this]() { testCompactFormat(); });
+        runner.runTest("Concurrent Recording", [this]() { testConcurrentRecording(); });
+        runner.runTest("Torn Tail And Errors", [this]() { testTornTailAndErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Recording Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RecordingTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -0,0 +1,258 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include "../../include/algorithms/rmq_shape_index.h"
+#include "../../src/algorithms/rmq_shape_index.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQShapeIndexTest {
+private:
+    std::mt19937 gen_{94};
+    
+    std::vector<Value> generateArray(Size n, Value low, Value high) {
+        std::vector<Value> values(n);
+        std::uniform_int_distribution<Value> dis(low, high);
+        for (auto& value : values) {
+            value = dis(gen_);
+        }
+        return values;
+    }
+    
+    /**
+     * @brief Check every range of one array against a linear scan
+     */
+    void verifyAllRanges(const RMQShapeIndex& index, Size array, const std::vector<Value>& values) {
+        for (Index left = 0; left < values.size(); ++left) {
+            Index expected = left;
+            for (Index right = left; right < values.size(); ++right) {
+                if (values[right] < values[expected]) {
+                    expected = right;
+                }
+                assert(index.queryIndex(array, left, right) == expected);
+                assert(index.query(array, left, right) == values[expected]);
+            }
+        }
+    }
+
+public:
+    void testBasicFunctionality() {
+        RMQShapeIndex index;
+        Size first = index.addArray({5, 2, 8, 1});
+        Size second = index.addArray({3, 9, 4});
+        
+        assert(first == 0 && second == 1);
+        assert(index.getArrayCount() == 2);
+        assert(index.getArraySize(0) == 4);
+        assert(index.getArraySize(1) == 3);
+        assert(index.query(0, 0, 2) == 2);
+        assert(index.query(0, 0, 3) == 1);
+        assert(index.queryIndex(1, 1, 2) == 2);
+        assert(index.query(1, 0, 2) == 3);
+    }
+    
+    void testSharedShapes() {
+        RMQShapeIndex index;
+        index.addArray({5, 2, 8, 1});
+        index.addArray({50, 20, 80, 10});    // Scaled
+        index.addArray({-1, -4, 0, -9});     // Shifted, same order
+        index.addArray({5, 2, 1, 8});        // Different shape
+        index.addArray({5, 2, 8});           // Different length
+        
+        assert(index.getShapeCount() == 3);
+        assert(index.getShapeId(0) == index.getShapeId(1));
+        assert(index.getShapeId(0) == index.getShapeId(2));
+        assert(index.getShapeId(0) != index.getShapeId(3));
+        assert(index.getShapeId(0) != index.getShapeId(4));
+        
+        // Shared tables, own values
+        assert(index.query(1, 1, 2) == 20);
+        assert(index.query(2, 0, 3) == -9);
+        
+        // Equal values keep the leftmost, so ties are part of the shape
+        auto tied = RMQShapeIndex::signatureOf(std::vector<Value>{1, 1}.data(), 2);
+        auto rising = RMQShapeIndex::signatureOf(std::vector<Value>{1, 2}.data(), 2);
+        auto falling = RMQShapeIndex::signatureOf(std::vector<Value>{2, 1}.data(), 2);
+        assert(tied == rising);
+        assert(!(tied == falling));
+    }
+    
+    void testMatchesScan() {
+        RMQShapeIndex index;
+        std::vector<std::vector<Value>> arrays;
+        for (Size n : {1, 2, 3, 7, 31, 32, 33, 63, 64}) {
+            arrays.push_back(generateArray(n, -1000, 1000));
+            arrays.push_back(generateArray(n, 0, 3));   // Plenty of ties
+            arrays.push_back(std::vector<Value>(n, 7));
+        }
+        for (const auto& values : arrays) {
+            index.addArray(values);
+        }
+        for (Size array = 0; array < arrays.size(); ++array) {
+            verifyAllRanges(index, array, arrays[array]);
+        }
+    }
+    
+    void testManySmallArrays() {
+        // 20000 arrays of 8 elements drawn from a few patterns
+        std::vector<std::vector<Value>> patterns;
+        for (int p = 0; p < 10; ++p) {
+            patterns.push_back(generateArray(8, 0, 100));
+        }
+        
+        std::vector<std::vector<Value>> arrays;
+        std::uniform_int_distribution<int> pick(0, 9);
+        std::uniform_int_distribution<Value> offset(-500, 500);
+        for (int i = 0; i < 20000; ++i) {
+            std::vector<Value> values = patterns[pick(gen_)];
+            Value shift = offset(gen_);
+            for (auto& value : values) {
+                value = value * 3 + shift;   // Same order, other values
+            }
+            arrays.push_back(values);
+        }
+        
+        RMQShapeIndex index(arrays);
+        assert(index.getArrayCount() == arrays.size());
+        assert(index.getShapeCount() <= patterns.size());
+        for (Size array = 0; array < arrays.size(); array += 997) {
+            verifyAllRanges(index, array, arrays[array]);
+        }
+        
+        // Values plus 8 bytes per array, the shared tables are negligible
+        size_t per_array = index.getMemoryUsage() / arrays.size();
+        assert(per_array <= 8 * sizeof(Value) + 8 + 4);
+    }
+    
+    void testClear() {
+        RMQShapeIndex index({{1, 2, 3}, {3, 2, 1}});
+        assert(index.getArrayCount() == 2);
+        
+        index.clear();
+        assert(index.getArrayCount() == 0);
+        assert(index.getShapeCount() == 0);
+        
+        Size id = index.addArray({4, 5});
+        assert(id == 0);
+        assert(index.query(0, 0, 1) == 4);
+    }
+    
+    void testErrors() {
+        RMQShapeIndex index;
+        index.addArray({1, 2, 3});
+        
+        bool exception_thrown = false;
+        try {
+            index.addArray({});
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            index.addArray(std::vector<Value>(RMQShapeIndex::MAX_ARRAY_SIZE + 1, 0));
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        assert(index.getArrayCount() == 1);
+        
+        exception_thrown = false;
+        try {
+            index.query(1, 0, 0);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            index.query(0, 0, 3);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            index.query(0, 2, 1);
+        } catch (const InvalidQueryException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Shared Shapes", [this]() { testSharedShapes(); });
+        runner.runTest("Matches Scan", [this]() { testMatchesScan(); });
+        runner.runTest("Many Small Arrays", [this]() { testManySmallArrays(); });
+        runner.runTest("Clear", [this]() { testClear(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Shape Index Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQShapeIndexTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
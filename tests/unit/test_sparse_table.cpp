@@ -7,9 +7,12 @@
 #include <functional>
 #include <algorithm>
 #include <tuple>
+#include <thread>
+#include <limits>
 #include "../../include/algorithms/rmq_sparse_table.h"
 #include "../../include/algorithms/rmq_naive.h"
 #include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
 #include "../../src/algorithms/rmq_sparse_table.cpp"
 #include "../../src/algorithms/rmq_naive.cpp"
 
@@ -298,6 +301,171 @@ public:
         assert(rmq_->query(0, 50) == 50);  // Value at index 50 is 50
     }
     
+    void testLazyLevels() {
+        std::vector<Value> data(1000);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<Value>((i * 7919) % 1000);
+        }
+        
+        RMQSparseTable eager;
+        eager.preprocess(data);
+        
+        RMQSparseTable lazy(AlgorithmConfig().withLazyLevels(true));
+        lazy.preprocess(data);
+        assert(lazy.getLevels() == eager.getLevels());
+        assert(lazy.getBuiltLevels() == 1);
+        assert(lazy.getTableEntries() == data.size());
+        assert(lazy.getMemoryUsage() < eager.getMemoryUsage());
+        
+        // A range of 5 needs level 2, so levels 1 and 2 get built
+        assert(lazy.query(10, 14) == eager.query(10, 14));
+        assert(lazy.getBuiltLevels() == 3);
+        assert(lazy.verifyTable());
+        
+        // Short ranges never build the top levels
+        for (Index left = 0; left + 8 <= data.size(); ++left) {
+            assert(lazy.query(left, left + 7) == eager.query(left, left + 7));
+        }
+        assert(lazy.getBuiltLevels() == 4);
+        
+        assert(lazy.query(0, 999) == eager.query(0, 999));
+        assert(lazy.getBuiltLevels() == eager.getBuiltLevels());
+        assert(lazy.getTableEntries() == eager.getTableEntries());
+        assert(lazy.verifyTable());
+    }
+    
+    void testLevelCap() {
+        std::mt19937 gen(92);
+        std::uniform_int_distribution<> dis(0, 50);  // Plenty of ties
+        std::vector<Value> data(777);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        
+        RMQNaive naive;
+        naive.preprocess(data);
+        
+        for (Size cap = 1; cap <= 11; ++cap) {
+            RMQSparseTable capped(AlgorithmConfig().withMaxLevels(cap).withLazyLevels(cap % 2 == 0));
+            capped.preprocess(data);
+            assert(capped.getLevels() == 10);
+            assert(capped.getLevelCap() == std::min<Size>(cap, 10));
+            
+            for (int i = 0; i < 2000; ++i) {
+                Index left = gen() % data.size();
+                Index right = left + gen() % (data.size() - left);
+                QueryOutcome outcome = capped.tryQueryDetailed(left, right);
+                assert(outcome.ok());
+                assert(outcome.value == naive.query(left, right));
+                assert(outcome.index == naive.tryQueryDetailed(left, right).index);
+            }
+            
+            // Block edges, where the middle has no whole block
+            Size block = Size(1) << (capped.getLevelCap() - 1);
+            if (2 * block <= data.size()) {
+                assert(capped.query(0, 2 * block - 1) == naive.query(0, 2 * block - 1));
+                assert(capped.query(block, data.size() - 1) == naive.query(block, data.size() - 1));
+            }
+        }
+        
+        // Fewer levels, less memory
+        RMQSparseTable full;
+        full.preprocess(data);
+        RMQSparseTable capped(AlgorithmConfig().withMaxLevels(4));
+        capped.preprocess(data);
+        assert(capped.getTableEntries() < full.getTableEntries());
+        assert(capped.getMemoryUsage() < full.getMemoryUsage());
+        assert(capped.verifyTable());
+    }
+    
+    void testConcurrentLazyQueries() {
+        std::vector<Value> data(1 << 14);
+        std::mt19937 gen(7);
+        for (auto& value : data) {
+            value = static_cast<Value>(gen() % 100000);
+        }
+        
+        RMQNaive naive;
+        naive.preprocess(data);
+        RMQSparseTable lazy(AlgorithmConfig().withLazyLevels(true));
+        lazy.preprocess(data);
+        
+        // Every thread asks for every level at once
+        std::vector<std::thread> threads;
+        std::vector<int> mismatches(4, 0);
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                std::mt19937 local(t);
+                for (int i = 0; i < 2000; ++i) {
+                    Size length = Size(1) << (local() % 15);
+                    Index left = local() % (data.size() - length + 1);
+                    Index right = left + length - 1;
+                    if (lazy.tryQuery(left, right).value != naive.tryQuery(left, right).value) {
+                        mismatches[t]++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        for (int count : mismatches) {
+            assert(count == 0);
+        }
+        assert(lazy.verifyTable());
+    }
+    
+    void testPackedEntries() {
+        std::mt19937 gen(93);
+        std::uniform_int_distribution<> dis(-20, 20);  // Plenty of ties
+        std::vector<Value> data(1500);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        data[3] = std::numeric_limits<Value>::min();
+        data[1400] = std::numeric_limits<Value>::max();
+        
+        RMQNaive naive;
+        naive.preprocess(data);
+        RMQSparseTable unpacked;
+        unpacked.preprocess(data);
+        
+        for (bool lazy : {false, true}) {
+            RMQSparseTable packed(AlgorithmConfig().withPackedEntries(true).withLazyLevels(lazy));
+            packed.preprocess(data);
+            assert(packed.isPacked());
+            
+            for (int i = 0; i < 3000; ++i) {
+                Index left = gen() % data.size();
+                Index right = left + gen() % (data.size() - left);
+                QueryOutcome outcome = packed.tryQueryDetailed(left, right);
+                assert(outcome.value == naive.query(left, right));
+                assert(outcome.index == naive.tryQueryDetailed(left, right).index);
+            }
+            assert(packed.query(0, data.size() - 1) == std::numeric_limits<Value>::min());
+            assert(packed.query(1400, 1400) == std::numeric_limits<Value>::max());
+            assert(packed.verifyTable());
+            
+            // 8 bytes per entry instead of 12
+            assert(packed.getTableEntries() <= unpacked.getTableEntries());
+            assert(packed.getMemoryUsage() < unpacked.getMemoryUsage());
+        }
+        
+        // Packed levels with a cap fall back to block minima as usual
+        RMQSparseTable capped(AlgorithmConfig().withPackedEntries(true).withMaxLevels(3));
+        capped.preprocess(data);
+        for (int i = 0; i < 1000; ++i) {
+            Index left = gen() % data.size();
+            Index right = left + gen() % (data.size() - left);
+            assert(capped.tryQueryDetailed(left, right).index == naive.tryQueryDetailed(left, right).index);
+        }
+        
+        capped.clear();
+        assert(capped.getTableEntries() == 0);
+        assert(!capped.isPacked());
+    }
+    
     void runAllTests(TestRunner& runner) {
         runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
         runner.runTest("Single Element", [this]() { testSingleElement(); });
@@ -313,6 +481,10 @@ public:
         runner.runTest("No Update Support", [this]() { testNoUpdateSupport(); });
         runner.runTest("Clear Function", [this]() { testClearFunction(); });
         runner.runTest("Edge Cases", [this]() { testEdgeCases(); });
+        runner.runTest("Lazy Levels", [this]() { testLazyLevels(); });
+        runner.runTest("Level Cap", [this]() { testLevelCap(); });
+        runner.runTest("Concurrent Lazy Queries", [this]() { testConcurrentLazyQueries(); });
+        runner.runTest("Packed Entries", [this]() { testPackedEntries(); });
     }
 };
 
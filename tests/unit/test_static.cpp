@@ -0,0 +1,201 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <type_traits>
+#include "../../include/algorithms/rmq_static.h"
+
+using namespace rmq;
+
+// Built and queried entirely at compile time
+constexpr StaticRMQ<int, 8> COMPILE_TIME_RMQ(std::array<int, 8>{3, 1, 4, 1, 5, 9, 2, 6});
+static_assert(COMPILE_TIME_RMQ.query(0, 2) == 1, "constant query");
+static_assert(COMPILE_TIME_RMQ.query(4, 7) == 2, "constant query");
+static_assert(COMPILE_TIME_RMQ.queryIndex(0, 7) == 1, "leftmost of tied minima");
+
+constexpr std::array<int, 100> descending() {
+    std::array<int, 100> values{};
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = 100 - static_cast<int>(i);
+    }
+    return values;
+}
+constexpr StaticRMQ<int, 100> COMPILE_TIME_SPARSE(descending());
+static_assert(!decltype(COMPILE_TIME_SPARSE)::USES_BITMASK, "sparse table above 64 elements");
+static_assert(COMPILE_TIME_SPARSE.query(10, 57) == 43, "constant query");
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class StaticRMQTest {
+private:
+    std::mt19937 gen_{42};
+    
+    template <typename T, Size N>
+    std::array<T, N> generateArray(T low, T high) {
+        std::array<T, N> values{};
+        std::uniform_int_distribution<long long> dis(low, high);
+        for (auto& value : values) {
+            value = static_cast<T>(dis(gen_));
+        }
+        return values;
+    }
+    
+    /**
+     * @brief Check every range of a StaticRMQ against a linear scan
+     */
+    template <typename T, Size N>
+    void verifyAllRanges(const std::array<T, N>& values) {
+        StaticRMQ<T, N> rmq(values);
+        for (Index left = 0; left < N; ++left) {
+            Index expected = left;
+            for (Index right = left; right < N; ++right) {
+                if (values[right] < values[expected]) {
+                    expected = right;
+                }
+                assert(rmq.queryIndex(left, right) == expected);
+                assert(rmq.query(left, right) == values[expected]);
+            }
+        }
+    }
+
+public:
+    void testCompileTime() {
+        // The static_asserts above already ran; the objects are usable at runtime too
+        assert(COMPILE_TIME_RMQ.query(2, 3) == 1);
+        assert(COMPILE_TIME_SPARSE.queryIndex(0, 99) == 99);
+        assert((StaticRMQ<int, 8>::size() == 8));
+    }
+    
+    void testBitmaskSizes() {
+        // Every range, with few distinct values so ties are common
+        verifyAllRanges<int, 1>(generateArray<int, 1>(0, 3));
+        verifyAllRanges<int, 7>(generateArray<int, 7>(0, 3));
+        verifyAllRanges<int, 32>(generateArray<int, 32>(0, 3));
+        verifyAllRanges<int, 33>(generateArray<int, 33>(0, 3));
+        verifyAllRanges<int, 64>(generateArray<int, 64>(0, 3));
+        verifyAllRanges<int, 64>(generateArray<int, 64>(-1000000, 1000000));
+        
+        static_assert(StaticRMQ<int, 64>::USES_BITMASK, "bitmask up to 64 elements");
+    }
+    
+    void testSparseTableSizes() {
+        verifyAllRanges<int, 65>(generateArray<int, 65>(0, 3));
+        verifyAllRanges<int, 256>(generateArray<int, 256>(0, 3));
+        verifyAllRanges<int, 257>(generateArray<int, 257>(-50, 50));
+        verifyAllRanges<int, 1000>(generateArray<int, 1000>(-1000000, 1000000));
+    }
+    
+    void testOtherTypes() {
+        verifyAllRanges<double, 40>(generateArray<double, 40>(-10, 10));
+        verifyAllRanges<long long, 100>(generateArray<long long, 100>(std::numeric_limits<int>::min(),
+                                                                      std::numeric_limits<int>::max()));
+        
+        std::array<Value, 4> extremes = {std::numeric_limits<Value>::max(), 0,
+                                         std::numeric_limits<Value>::min(), std::numeric_limits<Value>::min()};
+        StaticRMQ<Value, 4> rmq(extremes);
+        assert(rmq.query(0, 1) == 0);
+        assert(rmq.queryIndex(0, 3) == 2);
+    }
+    
+    void testNoHeap() {
+        // All storage is inline: tiny tables for small N
+        static_assert(std::is_trivially_copyable<StaticRMQ<int, 64>>::value, "plain value type");
+        static_assert(sizeof(StaticRMQ<int, 32>) == 32 * sizeof(int) + 32 * sizeof(uint32_t), "one 32-bit mask per element");
+        static_assert(sizeof(StaticRMQ<int, 64>) == 64 * sizeof(int) + 64 * sizeof(uint64_t), "one 64-bit mask per element");
+        static_assert(sizeof(StaticRMQ<int, 256>) == 256 * sizeof(int) + 9 * 256, "one byte per sparse entry");
+        assert((StaticRMQ<int, 64>::getMemoryUsage() == sizeof(StaticRMQ<int, 64>)));
+    }
+    
+    void testCheckedQuery() {
+        StaticRMQ<int, 16> rmq(generateArray<int, 16>(0, 100));
+        assert(rmq.queryChecked(3, 9) == rmq.query(3, 9));
+        
+        bool exception_thrown = false;
+        try {
+            rmq.queryChecked(5, 16);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.queryChecked(9, 3);
+        } catch (const InvalidQueryException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Compile Time", [this]() { testCompileTime(); });
+        runner.runTest("Bitmask Sizes", [this]() { testBitmaskSizes(); });
+        runner.runTest("Sparse Table Sizes", [this]() { testSparseTableSizes(); });
+        runner.runTest("Other Types", [this]() { testOtherTypes(); });
+        runner.runTest("No Heap", [this]() { testNoHeap(); });
+        runner.runTest("Checked Query", [this]() { testCheckedQuery(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Static (Fixed-Size) Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    StaticRMQTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include "../../include/algorithms/rmq_stree.h"
+#include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/algorithms/rmq_stree.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+class RMQSTreeTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, Value low, Value high, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<Value> dis(low, high);
+        for (auto& value : data) {
+            value = dis(gen);
+        }
+        return data;
+    }
+    
+    Value naiveMin(const std::vector<Value>& data, size_t left, size_t right) {
+        return *std::min_element(data.begin() + left, data.begin() + right + 1);
+    }
+    
+    Index naiveMinIndex(const std::vector<Value>& data, size_t left, size_t right) {
+        return std::min_element(data.begin() + left, data.begin() + right + 1) - data.begin();
+    }
+    
+    void verifyRandomQueries(const RMQSTree& rmq, const std::vector<Value>& data, int queries, int seed) {
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < queries; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(rmq.query(left, right) == naiveMin(data, left, right));
+            assert(rmq.queryDetailed(left, right).minimum_index == naiveMinIndex(data, left, right));
+        }
+    }
+
+public:
+    void testBasicFunctionality() {
+        RMQSTree rmq;
+        std::vector<Value> data = {3, 1, 4, 1, 5, 9, 2, 6};
+        rmq.preprocess(data);
+        
+        assert(rmq.query(0, 2) == 1);
+        assert(rmq.query(4, 7) == 2);
+        assert(rmq.query(5, 5) == 9);
+        assert(rmq.queryDetailed(0, 7).minimum_index == 1);  // Leftmost of the two 1s
+        assert(rmq.getLevels() == 1);
+        assert(!rmq.supportsUpdate());
+        assert(rmq.getType() == AlgorithmType::S_TREE);
+    }
+    
+    void testLayout() {
+        // 16^3 + 1 elements need a fourth level with a single root node
+        std::vector<Value> data = generateRandomData(4097, -1000, 1000, 1);
+        RMQSTree rmq;
+        rmq.preprocess(data);
+        
+        assert(rmq.getLevels() == 4);
+        assert(rmq.getNodeCount() == 257 + 17 + 2 + 1);
+        assert(RMQSTree::nodeCount(data.size()) == rmq.getNodeCount());
+        assert(RMQSTree::levelCount(data.size()) == rmq.getLevels());
+        
+        // The levels above the leaves add about 1/15 of the data
+        size_t n = 1 << 20;
+        assert(RMQSTree::nodeCount(n) * 16 - n <= n / 15 + 16);
+    }
+    
+    void testRangesAcrossLevels() {
+        // Sizes around node and level boundaries
+        for (size_t size : {1, 15, 16, 17, 255, 256, 257, 4095, 4096, 4097, 70000}) {
+            std::vector<Value> data = generateRandomData(size, -50, 50, static_cast<int>(size));
+            RMQSTree rmq;
+            rmq.preprocess(data);
+            verifyRandomQueries(rmq, data, 300, 7);
+            
+            // Every range ending at either boundary
+            for (size_t i = 0; i < size; i += std::max<size_t>(1, size / 97)) {
+                assert(rmq.query(0, i) == naiveMin(data, 0, i));
+                assert(rmq.query(i, size - 1) == naiveMin(data, i, size - 1));
+                assert(rmq.queryDetailed(i, size - 1).minimum_index == naiveMinIndex(data, i, size - 1));
+            }
+        }
+    }
+    
+    void testMatchesSparseTable() {
+        // Few distinct values, so most ranges have tied minima
+        std::vector<Value> data = generateRandomData(100000, 0, 7, 3);
+        RMQSTree stree;
+        RMQSparseTable sparse;
+        stree.preprocess(data);
+        sparse.preprocess(data);
+        
+        std::mt19937 gen(11);
+        std::uniform_int_distribution<size_t> dis(0, data.size() - 1);
+        for (int q = 0; q < 2000; ++q) {
+            size_t left = dis(gen);
+            size_t right = dis(gen);
+            if (left > right) std::swap(left, right);
+            assert(stree.query(left, right) == sparse.query(left, right));
+            assert(stree.queryDetailed(left, right).minimum_index ==
+                   sparse.queryDetailed(left, right).minimum_index);
+        }
+        
+        // Extreme values, including the one used for padding
+        std::vector<Value> extremes = {std::numeric_limits<Value>::max(), std::numeric_limits<Value>::min(),
+                                       std::numeric_limits<Value>::max(), 0};
+        extremes.resize(40, std::numeric_limits<Value>::max());
+        stree.preprocess(extremes);
+        assert(stree.query(0, 39) == std::numeric_limits<Value>::min());
+        assert(stree.query(2, 39) == 0);
+        assert(stree.query(4, 39) == std::numeric_limits<Value>::max());
+        assert(stree.queryDetailed(4, 39).minimum_index == 4);
+    }
+    
+    void testSaveLoad() {
+        std::vector<Value> data = generateRandomData(5000, -100000, 100000, 5);
+        RMQSTree rmq;
+        rmq.preprocess(data);
+        
+        std::stringstream stream;
+        rmq.saveIndex(stream);
+        
+        RMQSTree loaded;
+        loaded.loadIndex(stream);
+        assert(loaded.size() == data.size());
+        assert(loaded.getNodeCount() == rmq.getNodeCount());
+        verifyRandomQueries(loaded, data, 500, 9);
+    }
+    
+    void testMemoryUsage() {
+        std::vector<Value> data = generateRandomData(100000, -1000, 1000, 6);
+        RMQSTree rmq;
+        rmq.preprocess(data);
+        
+        // data_ is released: the leaves are the only copy of the data
+        size_t tree_bytes = rmq.getMemoryUsage() - sizeof(RMQSTree);
+        assert(tree_bytes >= data.size() * sizeof(Value));
+        assert(tree_bytes <= data.size() * sizeof(Value) * 16 / 15 + 256);
+        
+        rmq.clear();
+        assert(rmq.getMemoryUsage() == sizeof(RMQSTree));
+        assert(!rmq.isPreprocessed());
+    }
+    
+    void testErrors() {
+        RMQSTree rmq;
+        
+        bool exception_thrown = false;
+        try {
+            rmq.query(0, 0);
+        } catch (const NotPreprocessedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        rmq.preprocess(generateRandomData(100, 0, 10, 8));
+        
+        exception_thrown = false;
+        try {
+            rmq.query(0, 100);
+        } catch (const BoundsException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        exception_thrown = false;
+        try {
+            rmq.update(0, 1);
+        } catch (const NotSupportedException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("Basic Functionality", [this]() { testBasicFunctionality(); });
+        runner.runTest("Layout", [this]() { testLayout(); });
+        runner.runTest("Ranges Across Levels", [this]() { testRangesAcrossLevels(); });
+        runner.runTest("Matches Sparse Table", [this]() { testMatchesSparseTable(); });
+        runner.runTest("Save/Load", [this]() { testSaveLoad(); });
+        runner.runTest("Memory Usage", [this]() { testMemoryUsage(); });
+        runner.runTest("Errors", [this]() { testErrors(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ S-Tree Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQSTreeTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}
@@ -0,0 +1,313 @@
+// Tracing is compiled out by default; the instrumented sources must see the flag
+#define RMQ_ENABLE_TRACING
+
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include "../../include/algorithms/rmq_block.h"
+#include "../../include/algorithms/rmq_dp.h"
+#include "../../include/algorithms/rmq_lca.h"
+#include "../../include/algorithms/rmq_sparse_table.h"
+#include "../../include/core/rmq_trace.h"
+#include "../../src/core/rmq_base.cpp"
+#include "../../src/core/rmq_compressed.cpp"
+#include "../../src/core/rmq_trace.cpp"
+#include "../../src/algorithms/rmq_block.cpp"
+#include "../../src/algorithms/rmq_dp.cpp"
+#include "../../src/algorithms/rmq_lca.cpp"
+#include "../../src/algorithms/rmq_sparse_table.cpp"
+
+using namespace rmq;
+
+class TestRunner {
+private:
+    int tests_passed_;
+    int tests_failed_;
+    std::vector<std::string> failed_tests_;
+
+public:
+    TestRunner() : tests_passed_(0), tests_failed_(0) {}
+    
+    void runTest(const std::string& test_name, std::function<void()> test_func) {
+        std::cout << "Running: " << std::left << std::setw(50) << test_name << " ";
+        try {
+            test_func();
+            std::cout << "[PASSED]" << std::endl;
+            tests_passed_++;
+        } catch (const std::exception& e) {
+            std::cout << "[FAILED] - " << e.what() << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        } catch (...) {
+            std::cout << "[FAILED] - Unknown error" << std::endl;
+            tests_failed_++;
+            failed_tests_.push_back(test_name);
+        }
+    }
+    
+    void printSummary() {
+        std::cout << "\n" << std::string(70, '=') << std::endl;
+        std::cout << "Test Summary:" << std::endl;
+        std::cout << "Passed: " << tests_passed_ << std::endl;
+        std::cout << "Failed: " << tests_failed_ << std::endl;
+        
+        if (!failed_tests_.empty()) {
+            std::cout << "\nFailed tests:" << std::endl;
+            for (const auto& test : failed_tests_) {
+                std::cout << "  - " << test << std::endl;
+            }
+        }
+        std::cout << std::string(70, '=') << std::endl;
+    }
+    
+    bool allTestsPassed() const {
+        return tests_failed_ == 0;
+    }
+};
+
+/**
+ * @brief Tracer that records events in memory
+ */
+class RecordingTracer final : public trace::ITracer {
+public:
+    struct Event {
+        std::string name;
+        char phase;
+        int64_t arg;
+    };
+    
+    std::vector<Event> events;
+    std::mutex mutex;
+    
+    void begin(const char* name, int64_t arg) noexcept override {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back({name, 'B', arg});
+    }
+    
+    void end(const char* name) noexcept override {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back({name, 'E', -1});
+    }
+    
+    size_t count(const std::string& name, char phase) const {
+        return std::count_if(events.begin(), events.end(), [&](const Event& event) {
+            return event.name == name && event.phase == phase;
+        });
+    }
+    
+    int position(const std::string& name, char phase) const {
+        for (size_t i = 0; i < events.size(); ++i) {
+            if (events[i].name == name && events[i].phase == phase) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief Installs a tracer for the lifetime of a test
+ */
+class ScopedTracer {
+public:
+    explicit ScopedTracer(trace::ITracer* tracer) { trace::setTracer(tracer); }
+    ~ScopedTracer() { trace::setTracer(nullptr); }
+};
+
+class RMQTraceTest {
+private:
+    std::vector<Value> generateRandomData(size_t size, int seed) {
+        std::vector<Value> data(size);
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<> dis(-1000, 1000);
+        
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = dis(gen);
+        }
+        return data;
+    }
+    
+    /**
+     * @brief Every begin has a matching end, properly nested
+     */
+    static bool isBalanced(const RecordingTracer& tracer) {
+        std::vector<std::string> open;
+        for (const auto& event : tracer.events) {
+            if (event.phase == 'B') {
+                open.push_back(event.name);
+            } else {
+                if (open.empty() || open.back() != event.name) return false;
+                open.pop_back();
+            }
+        }
+        return open.empty();
+    }
+
+public:
+    void testNoTracerInstalled() {
+        assert(trace::getTracer() == nullptr);
+        
+        std::vector<Value> data = generateRandomData(100, 1);
+        RMQSparseTable rmq;
+        rmq.preprocess(data);
+        assert(rmq.query(0, 99) == *std::min_element(data.begin(), data.end()));
+    }
+    
+    void testLCAPhases() {
+        RecordingTracer tracer;
+        ScopedTracer scoped(&tracer);
+        
+        RMQLCABased rmq;
+        rmq.preprocess(generateRandomData(500, 2));
+        
+        assert(tracer.count("preprocess", 'B') == 1);
+        assert(tracer.count("lca.init_nodes", 'B') == 1);
+        assert(tracer.count("lca.cartesian_tree", 'B') == 1);
+        assert(tracer.count("lca.depths", 'B') == 1);
+        assert(tracer.count("lca.binary_lifting", 'B') == 1);
+        assert(isBalanced(tracer));
+        
+        // Phases run in order, inside the preprocess scope
+        assert(tracer.position("preprocess", 'B') == 0);
+        assert(tracer.events[0].arg == 500);
+        assert(tracer.position("lca.cartesian_tree", 'B') < tracer.position("lca.depths", 'B'));
+        assert(tracer.position("lca.depths", 'E') < tracer.position("lca.binary_lifting", 'B'));
+        assert(tracer.position("preprocess", 'E') == static_cast<int>(tracer.events.size()) - 1);
+    }
+    
+    void testSparseTableLevels() {
+        RecordingTracer tracer;
+        ScopedTracer scoped(&tracer);
+        
+        RMQSparseTable rmq;
+        rmq.preprocess(generateRandomData(1000, 3));
+        
+        // One event per level, numbered 0..9 for n = 1000
+        assert(tracer.count("sparse.allocate", 'B') == 1);
+        assert(tracer.count("sparse.level", 'B') == 10);
+        int64_t expected_level = 0;
+        for (const auto& event : tracer.events) {
+            if (event.name == "sparse.level" && event.phase == 'B') {
+                assert(event.arg == expected_level);
+                expected_level++;
+            }
+        }
+        assert(isBalanced(tracer));
+    }
+    
+    void testBlockAndDPPhases() {
+        RecordingTracer tracer;
+        ScopedTracer scoped(&tracer);
+        
+        RMQBlockDecomposition block;
+        block.preprocess(generateRandomData(400, 4));
+        assert(tracer.count("block.minimums", 'B') == 1);
+        
+        RMQDynamicProgramming dp;
+        dp.preprocess(generateRandomData(200, 5));
+        assert(tracer.count("dp.allocate", 'B') == 1);
+        assert(tracer.count("dp.fill_rows", 'B') >= 1);
+        
+        assert(tracer.count("preprocess", 'B') == 2);
+        assert(isBalanced(tracer));
+    }
+    
+    void testBatchQueryTraced() {
+        RMQSparseTable rmq;
+        rmq.preprocess(generateRandomData(100, 6));
+        
+        RecordingTracer tracer;
+        ScopedTracer scoped(&tracer);
+        
+        std::vector<Query> queries = {Query(0, 10), Query(5, 99), Query(50, 20)};
+        std::vector<QueryOutcome> results(queries.size());
+        assert(rmq.tryQueryBatch(queries.data(), queries.size(), results.data()) == 2);
+        
+        assert(tracer.events.size() == 2);
+        assert(tracer.events[0].name == "query_batch");
+        assert(tracer.events[0].arg == 3);
+        assert(isBalanced(tracer));
+    }
+    
+    void testFailedPreprocessBalanced() {
+        RecordingTracer tracer;
+        ScopedTracer scoped(&tracer);
+        
+        RMQSparseTable rmq;
+        bool exception_thrown = false;
+        try {
+            rmq.preprocess(std::vector<Value>());
+        } catch (const InvalidDataException&) {
+            exception_thrown = true;
+        }
+        assert(exception_thrown);
+        
+        // The scope still closes when preprocess throws
+        assert(tracer.count("preprocess", 'B') == 1);
+        assert(isBalanced(tracer));
+    }
+    
+    void testChromeTraceWriter() {
+        const std::string path = "test_trace_output.json";
+        {
+            trace::ChromeTraceWriter writer(path);
+            ScopedTracer scoped(&writer);
+            
+            RMQLCABased rmq;
+            rmq.preprocess(generateRandomData(300, 7));
+            assert(writer.eventCount() == 10);
+            assert(writer.flush());
+        }
+        
+        std::ifstream in(path);
+        assert(in);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::string json = buffer.str();
+        
+        assert(json.find("\"traceEvents\"") != std::string::npos);
+        assert(json.find("\"name\": \"lca.cartesian_tree\"") != std::string::npos);
+        assert(json.find("\"ph\": \"B\"") != std::string::npos);
+        assert(json.find("\"ph\": \"E\"") != std::string::npos);
+        assert(json.find("\"args\": {\"value\": 300}") != std::string::npos);
+        
+        // Brackets balance and the last event has no trailing comma
+        assert(std::count(json.begin(), json.end(), '{') == std::count(json.begin(), json.end(), '}'));
+        assert(json.find("},\n]") == std::string::npos);
+        
+        std::remove(path.c_str());
+    }
+    
+    void runAllTests(TestRunner& runner) {
+        runner.runTest("No Tracer Installed", [this]() { testNoTracerInstalled(); });
+        runner.runTest("LCA Phases", [this]() { testLCAPhases(); });
+        runner.runTest("Sparse Table Levels", [this]() { testSparseTableLevels(); });
+        runner.runTest("Block And DP Phases", [this]() { testBlockAndDPPhases(); });
+        runner.runTest("Batch Query Traced", [this]() { testBatchQueryTraced(); });
+        runner.runTest("Failed Preprocess Balanced", [this]() { testFailedPreprocessBalanced(); });
+        runner.runTest("Chrome Trace Writer", [this]() { testChromeTraceWriter(); });
+    }
+};
+
+int main() {
+    std::cout << std::string(70, '=') << std::endl;
+    std::cout << "RMQ Tracing Unit Tests" << std::endl;
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+    
+    TestRunner runner;
+    RMQTraceTest test;
+    test.runAllTests(runner);
+    
+    runner.printSummary();
+    
+    return runner.allTestsPassed() ? 0 : 1;
+}